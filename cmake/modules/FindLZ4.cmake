@@ -0,0 +1,61 @@
+## ---------------------------------------------------------------------
+##
+## Copyright (C) 2019 by the deal.II authors
+##
+## This file is part of the deal.II library.
+##
+## The deal.II library is free software; you can use it, redistribute
+## it, and/or modify it under the terms of the GNU Lesser General
+## Public License as published by the Free Software Foundation; either
+## version 2.1 of the License, or (at your option) any later version.
+## The full text of the license can be found in the file LICENSE.md at
+## the top level directory of deal.II.
+##
+## ---------------------------------------------------------------------
+
+#
+# Try to find the LZ4 library
+#
+# This module exports
+#
+#   LZ4_FOUND
+#   LZ4_LIBRARIES
+#   LZ4_INCLUDE_DIRS
+#   LZ4_VERSION
+#
+
+SET(LZ4_DIR "" CACHE PATH "An optional hint to a LZ4 installation")
+SET_IF_EMPTY(LZ4_DIR "$ENV{LZ4_DIR}")
+
+DEAL_II_FIND_LIBRARY(LZ4_LIBRARY
+  NAMES lz4
+  HINTS ${LZ4_DIR}
+  PATH_SUFFIXES lib${LIB_SUFFIX} lib64 lib
+  )
+
+DEAL_II_FIND_PATH(LZ4_INCLUDE_DIR lz4.h
+  HINTS ${LZ4_DIR}
+  PATH_SUFFIXES include
+  )
+
+IF(EXISTS "${LZ4_INCLUDE_DIR}/lz4.h")
+  FOREACH(_part MAJOR MINOR RELEASE)
+    FILE(STRINGS "${LZ4_INCLUDE_DIR}/lz4.h" _line
+      REGEX "#define[ \t]+LZ4_VERSION_${_part}[ \t]"
+      )
+    STRING(REGEX REPLACE ".*LZ4_VERSION_${_part}[ \t]+([0-9]+).*" "\\1"
+      LZ4_VERSION_${_part} "${_line}"
+      )
+  ENDFOREACH()
+  SET(LZ4_VERSION
+    "${LZ4_VERSION_MAJOR}.${LZ4_VERSION_MINOR}.${LZ4_VERSION_RELEASE}"
+    )
+ENDIF()
+
+DEAL_II_PACKAGE_HANDLE(LZ4
+  LIBRARIES
+    REQUIRED LZ4_LIBRARY
+  INCLUDE_DIRS
+    REQUIRED LZ4_INCLUDE_DIR
+  CLEAR LZ4_LIBRARY LZ4_INCLUDE_DIR
+  )
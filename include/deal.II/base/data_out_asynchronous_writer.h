@@ -0,0 +1,165 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_data_out_asynchronous_writer_h
+#define dealii_data_out_asynchronous_writer_h
+
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/data_out_base.h>
+#include <deal.II/base/exceptions.h>
+#include <deal.II/base/thread_management.h>
+
+#include <exception>
+#include <list>
+#include <string>
+
+DEAL_II_NAMESPACE_OPEN
+
+
+/**
+ * A class that writes the output of DataOutInterface objects (for example
+ * DataOut objects) to files in the background, so that a program can go on
+ * computing while its graphical output is being formatted, compressed, and
+ * written to disk.
+ *
+ * Every call to write() takes a snapshot of the patches, the names of the
+ * data sets, and the output flags of the given object, and then writes the
+ * file from this snapshot on a separate task (see Threads::new_task()). The
+ * object given to write() can therefore be modified or destroyed right after
+ * write() returns, for example by calling DataOut::build_patches() for the
+ * next time step. Since each snapshot holds a copy of the patches, the
+ * number of writes that may be in progress at the same time is limited by
+ * the argument given to the constructor: if this limit is reached, write()
+ * waits for the oldest write to finish before it starts a new one.
+ *
+ * Errors that happen while writing a file in the background, such as a file
+ * that can not be opened, can of course not be reported by write() itself.
+ * Rather, they are stored and reported as an exception by the next call to
+ * wait(), which waits for all writes in progress to finish. A typical use in
+ * a time dependent program therefore looks as follows:
+ * @code
+ *   DataOutAsynchronousWriter<dim> writer;
+ *   for (unsigned int step = 0; step < n_steps; ++step)
+ *     {
+ *       ... // compute the solution of this time step
+ *
+ *       DataOut<dim> data_out;
+ *       data_out.attach_dof_handler(dof_handler);
+ *       data_out.add_data_vector(solution, "solution");
+ *       data_out.build_patches();
+ *
+ *       writer.write(data_out,
+ *                    "solution-" + Utilities::int_to_string(step, 4) + ".vtu",
+ *                    DataOutBase::vtu);
+ *     }
+ *   writer.wait();
+ * @endcode
+ *
+ * In parallel programs, every process writes its own files, and process zero
+ * can write a <tt>.pvtu</tt> record referencing them through
+ * DataOutInterface::write_pvtu_record() as usual. There is no asynchronous
+ * version of DataOutInterface::write_vtu_in_parallel(): it writes a single
+ * file using collective MPI I/O operations, which can not safely be called
+ * on a separate thread unless MPI has been initialized with support for
+ * calls from several threads.
+ *
+ * @note If deal.II was configured without support for threads, write()
+ * writes the file before returning.
+ *
+ * @ingroup output
+ */
+template <int dim, int spacedim = dim>
+class DataOutAsynchronousWriter
+{
+public:
+  /**
+   * Constructor. @p max_n_pending_writes is the largest number of writes
+   * that may be in progress at the same time, and consequently the largest
+   * number of snapshots of patches stored by this object.
+   */
+  explicit DataOutAsynchronousWriter(
+    const unsigned int max_n_pending_writes = 2);
+
+  /**
+   * Destructor. Waits for all writes in progress to finish. Since a
+   * destructor can not throw an exception, errors of these writes that have
+   * not been reported by a call to wait() are lost.
+   */
+  ~DataOutAsynchronousWriter();
+
+  /**
+   * Take a snapshot of the output of @p data_out and write it to the file
+   * @p filename in the given format on a separate task. As for
+   * DataOutInterface::write(), DataOutBase::default_format selects the
+   * default format of @p data_out.
+   *
+   * If the number of writes in progress has reached the limit given to the
+   * constructor, this function first waits for the oldest one to finish.
+   */
+  void
+  write(const DataOutInterface<dim, spacedim> &data_out,
+        const std::string &                    filename,
+        const DataOutBase::OutputFormat        output_format =
+          DataOutBase::default_format);
+
+  /**
+   * Wait for all writes in progress to finish. If any of the writes started
+   * since the last call to this function failed, the exception thrown by the
+   * first of them is rethrown here, after all writes have finished.
+   */
+  void
+  wait();
+
+  /**
+   * Return the number of writes that have been started but not yet waited
+   * for, either by wait() or by write() to limit the number of writes in
+   * progress. Some of these may already have finished.
+   */
+  unsigned int
+  n_pending_writes() const;
+
+private:
+  /**
+   * Wait for the oldest write in progress to finish, and store the exception
+   * it threw, if any and if no earlier write failed.
+   */
+  void
+  wait_for_oldest_write();
+
+  /**
+   * The largest number of writes that may be in progress at the same time.
+   */
+  const unsigned int max_n_pending_writes;
+
+  /**
+   * The tasks writing the files, in the order in which they were started.
+   * Each task returns the exception it threw, or a null pointer if it wrote
+   * its file successfully.
+   */
+  std::list<Threads::Task<std::exception_ptr>> pending_writes;
+
+  /**
+   * The exception thrown by the first failed write that has not been
+   * reported by wait() yet.
+   */
+  std::exception_ptr error;
+};
+
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
@@ -43,6 +43,7 @@
 #  include "TECIO.h"
 #endif
 
+#include <istream>
 #include <ostream>
 
 DEAL_II_NAMESPACE_OPEN
@@ -50,6 +51,8 @@ DEAL_II_NAMESPACE_OPEN
 
 class ParameterHandler;
 class XDMFEntry;
+template <int dim, int spacedim>
+class DataOutAsynchronousWriter;
 
 /**
  * This is a base class for output of data on meshes of very general form.
@@ -1154,9 +1157,60 @@ namespace DataOutBase
     /**
      * Flag determining the compression level at which zlib, if available, is
      * run. The default is <tt>best_compression</tt>.
+     *
+     * This flag is ignored if the data is compressed with LZ4 instead (see
+     * #data_format), which always uses its default settings: faster LZ4
+     * settings produce larger output whose base64 encoding takes more time
+     * than the compression saves.
      */
     ZlibCompressionLevel compression_level;
 
+    /**
+     * A data type describing how the data arrays of a VTU file are encoded.
+     */
+    enum DataFormat
+    {
+      /**
+       * Compress the data arrays with zlib and write them inline in base64
+       * encoding. If deal.II was configured without zlib, the data arrays
+       * are written as ASCII text instead. This is the default.
+       */
+      zlib_compressed,
+      /**
+       * Compress the data arrays with LZ4 and write them inline in base64
+       * encoding. LZ4 compresses considerably faster than zlib, even at
+       * zlib's <tt>best_speed</tt> level, at the price of larger files. This
+       * format requires deal.II to be configured with LZ4, and the files can
+       * only be read by visualization programs based on a version of VTK
+       * that is recent enough to support LZ4 compression.
+       */
+      lz4_compressed,
+      /**
+       * Write the data arrays uncompressed and without base64 encoding into a
+       * single raw binary block at the end of the file, as described for
+       * the <tt>AppendedData</tt> section in the VTK file format
+       * documentation. This is the fastest way to write a VTU file and does
+       * not require any external library, but produces the largest files.
+       * The data arrays are not collected in memory: DataOutBase::write_vtu()
+       * first writes the XML description of the grid and then computes the
+       * data arrays one after the other and writes them directly to the
+       * output stream.
+       *
+       * Since the binary block has to follow the XML description of all
+       * pieces, files consisting of several pieces need the versions of
+       * DataOutBase::write_vtu_main() and DataOutBase::write_vtu_footer()
+       * that collect the data arrays in a separate stream, and this format
+       * is not supported by DataOutInterface::write_vtu_in_parallel().
+       */
+      raw_appended
+    };
+
+    /**
+     * Flag determining how the data arrays of a VTU file are encoded. The
+     * default is <tt>zlib_compressed</tt>.
+     */
+    DataFormat data_format;
+
     /**
      * Flag determining whether to write patches as linear cells
      * or as a high-order Lagrange cell.
@@ -1176,6 +1230,22 @@ namespace DataOutBase
      */
     bool write_higher_order_cells;
 
+    /**
+     * The size in bytes of the blocks into which each data array is split
+     * before it is compressed with zlib or LZ4. The blocks are compressed
+     * independently of each other and therefore concurrently on as many
+     * threads as are available, and the compressed sizes of all blocks are
+     * listed in the header of the array as described in the VTK file format
+     * documentation. The output does not depend on the number of threads.
+     *
+     * The default value of zero puts each array into a single block, which
+     * is then compressed on the calling thread. For large outputs, block
+     * sizes between 64 KiB and a few MiB are a good compromise between the
+     * compression ratio and the amount of parallelism. This flag has no
+     * effect if the data is not compressed, see #data_format.
+     */
+    unsigned int compression_block_size;
+
     /**
      * Constructor.
      */
@@ -1184,7 +1254,9 @@ namespace DataOutBase
       const unsigned int cycle = std::numeric_limits<unsigned int>::min(),
       const bool         print_date_and_time              = true,
       const ZlibCompressionLevel compression_level        = best_compression,
-      const bool                 write_higher_order_cells = false);
+      const bool                 write_higher_order_cells = false,
+      const unsigned int         compression_block_size   = 0,
+      const DataFormat           data_format              = zlib_compressed);
   };
 
 
@@ -1436,6 +1508,16 @@ namespace DataOutBase
     unsigned int
     n_data_sets() const;
 
+    /**
+     * Remove all data sets, but keep the nodes and cells. If this object is
+     * then filled again by DataOutBase::write_filtered_data(), only the data
+     * sets are recorded, and the nodes are not filtered again. This is useful
+     * in time dependent computations on a mesh that does not change; see
+     * DataOut::update_patch_data() for an example.
+     */
+    void
+    clear_data_sets();
+
     /**
      * Empty functions to do base class inheritance.
      */
@@ -2221,6 +2303,10 @@ namespace DataOutBase
    * This writes the header for the xml based vtu file format. This routine is
    * used internally together with DataOutInterface::write_vtu_footer() and
    * DataOutInterface::write_vtu_main() by DataOutBase::write_vtu().
+   *
+   * The header includes the time and cycle given in @p flags, if any, so
+   * that they are written only once even if the file consists of several
+   * pieces written by separate calls of write_vtu_main().
    */
   void
   write_vtu_header(std::ostream &out, const VtkFlags &flags);
@@ -2234,6 +2320,18 @@ namespace DataOutBase
   void
   write_vtu_footer(std::ostream &out);
 
+  /**
+   * Same as above, for output in raw binary format: write the footer
+   * together with the section of appended data, whose content is copied
+   * from @p appended_data. The latter are the data arrays written by the
+   * version of write_vtu_main() that takes a separate stream for them,
+   * read from the beginning until its end. They are copied in blocks, so
+   * that they do not need to fit into memory if they are stored in a
+   * temporary file.
+   */
+  void
+  write_vtu_footer(std::ostream &out, std::istream &appended_data);
+
   /**
    * This function writes the main part for the xml based vtu file format. This
    * routine is used internally together with
@@ -2257,6 +2355,15 @@ namespace DataOutBase
    * routine is used internally together with
    * DataOutInterface::write_vtu_header() and
    * DataOutInterface::write_vtu_footer() by DataOutBase::write_vtu().
+   *
+   * Each call of this function writes the given patches as a separate piece
+   * of the file, so it may be called several times between the header and
+   * the footer, for example to write the patches built by
+   * DataOut::build_patches_in_chunks() one chunk at a time.
+   *
+   * Since the data arrays of a VTU file in raw binary format follow the
+   * footer, this function throws an exception if VtkFlags::data_format is
+   * set to VtkFlags::raw_appended. Use the following function instead.
    */
   template <int dim, int spacedim>
   void
@@ -2272,6 +2379,37 @@ namespace DataOutBase
     const VtkFlags &flags,
     std::ostream &  out);
 
+  /**
+   * Same as above, for output in raw binary format (VtkFlags::raw_appended,
+   * which this function requires): the XML description of the piece is
+   * written to @p out, while its data arrays are written to
+   * @p appended_data. The offsets of the data arrays in the XML description
+   * start at @p appended_data_size, which is incremented by the number of
+   * bytes written to @p appended_data.
+   *
+   * Pieces written by several calls of this function, starting with an
+   * @p appended_data_size of zero and passing the same stream and counter
+   * each time, form a valid file once the data arrays are copied behind the
+   * footer with the version of write_vtu_footer() that takes them as an
+   * argument. Only the data arrays of all pieces need to be stored until
+   * then, for example in a temporary file, but not the patches.
+   */
+  template <int dim, int spacedim>
+  void
+  write_vtu_main(
+    const std::vector<Patch<dim, spacedim>> &patches,
+    const std::vector<std::string> &         data_names,
+    const std::vector<
+      std::tuple<unsigned int,
+                 unsigned int,
+                 std::string,
+                 DataComponentInterpretation::DataComponentInterpretation>>
+      &             nonscalar_data_ranges,
+    const VtkFlags &flags,
+    std::ostream &  out,
+    std::ostream &  appended_data,
+    std::size_t &   appended_data_size);
+
   /**
    * Some visualization programs, such as ParaView, can read several separate
    * VTU files that all form part of the same simulation, in order to
@@ -2653,6 +2791,14 @@ namespace DataOutBase
    * data that will be written to files. The object filled by this function
    * can then later be used again to write data in a concrete file format;
    * see, for example, DataOutBase::write_hdf5_parallel().
+   *
+   * If @p filtered_data already contains nodes and cells from an earlier call
+   * to this function, whose data sets have since been removed by
+   * DataOutFilter::clear_data_sets(), the nodes and cells are kept and only
+   * the data sets are recorded. The @p patches must then have the same
+   * vertices as before, as is the case after DataOut::update_patch_data().
+   * An exception is thrown if @p filtered_data still contains data sets, or
+   * if the number of cells does not match.
    */
   template <int dim, int spacedim>
   void
@@ -2980,6 +3126,53 @@ public:
   void
   write_vtu(std::ostream &out) const;
 
+  /**
+   * Write the header of a file in Vtu format to <tt>out</tt>. See
+   * DataOutBase::write_vtu_header.
+   *
+   * Together with write_vtu_main() and write_vtu_footer(), this function
+   * allows to write a file that consists of several pieces, for example one
+   * for each chunk of patches built by DataOut::build_patches_in_chunks().
+   * Calling these three functions in turn is equivalent to calling
+   * write_vtu(). If DataOutBase::VtkFlags::raw_appended is selected, the
+   * versions of write_vtu_main() and write_vtu_footer() that take a
+   * separate stream for the data arrays need to be used.
+   */
+  void
+  write_vtu_header(std::ostream &out) const;
+
+  /**
+   * Obtain data through get_patches() and write it to <tt>out</tt> as one
+   * piece of a file in Vtu format. See DataOutBase::write_vtu_main.
+   */
+  void
+  write_vtu_main(std::ostream &out) const;
+
+  /**
+   * Same as above, for output in raw binary format: write the XML
+   * description of the piece to <tt>out</tt> and its data arrays to
+   * @p appended_data. See DataOutBase::write_vtu_main.
+   */
+  void
+  write_vtu_main(std::ostream &out,
+                 std::ostream &appended_data,
+                 std::size_t & appended_data_size) const;
+
+  /**
+   * Write the footer of a file in Vtu format to <tt>out</tt>. See
+   * DataOutBase::write_vtu_footer.
+   */
+  void
+  write_vtu_footer(std::ostream &out) const;
+
+  /**
+   * Write the footer of a file in Vtu format in raw binary format to
+   * <tt>out</tt>, followed by the data arrays read from @p appended_data.
+   * See DataOutBase::write_vtu_footer.
+   */
+  void
+  write_vtu_footer(std::ostream &out, std::istream &appended_data) const;
+
   /**
    * Collective MPI call to write the solution from all participating nodes
    * (those in the given communicator) to a single compressed .vtu file on a
@@ -2987,6 +3180,12 @@ public:
    * one used by the computation.  This routine uses MPI I/O to achieve high
    * performance on parallel filesystems. Also see
    * DataOutInterface::write_vtu().
+   *
+   * Each process writes its patches as a separate piece of the file, right
+   * after the piece of the previous process. The raw binary format
+   * DataOutBase::VtkFlags::raw_appended is therefore not supported, since it
+   * requires the data arrays of all pieces to follow the XML description of
+   * all pieces. This function throws an exception if it is selected.
    */
   void
   write_vtu_in_parallel(const std::string &filename, MPI_Comm comm) const;
@@ -3063,6 +3262,12 @@ public:
    * Create an XDMFEntry based on the data in the data_filter. This assumes
    * the mesh and solution data were written to separate files. See
    * write_xdmf_file() for an example of usage.
+   *
+   * If the mesh does not change between time steps, the entries of all
+   * time steps can reference the same mesh file, which then only needs to
+   * be written once (see the @p write_mesh_file argument of
+   * write_hdf5_parallel() and the example in the documentation of
+   * DataOut::update_patch_data()).
    */
   XDMFEntry
   create_xdmf_entry(const DataOutBase::DataOutFilter &data_filter,
@@ -3138,6 +3343,10 @@ public:
    * data that will be written to files. The object filled by this function
    * can then later be used again to write data in a concrete file format;
    * see, for example, DataOutBase::write_hdf5_parallel().
+   *
+   * As described in DataOutBase::write_filtered_data(), an object whose data
+   * sets have been removed by DataOutBase::DataOutFilter::clear_data_sets()
+   * keeps its nodes and cells and only records the data sets again.
    */
   void
   write_filtered_data(DataOutBase::DataOutFilter &filtered_data) const;
@@ -3357,6 +3566,13 @@ private:
    * dimension. Can be changed by using the <tt>set_flags</tt> function.
    */
   DataOutBase::Deal_II_IntermediateFlags deal_II_intermediate_flags;
+
+  /**
+   * DataOutAsynchronousWriter needs to access the patches and data set names
+   * of an object of this type to take a snapshot of them.
+   */
+  template <int, int>
+  friend class DataOutAsynchronousWriter;
 };
 
 
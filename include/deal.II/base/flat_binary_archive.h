@@ -0,0 +1,621 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_flat_binary_archive_h
+#define dealii_flat_binary_archive_h
+
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/exceptions.h>
+#include <deal.II/base/std_cxx14/memory.h>
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+DEAL_II_NAMESPACE_OPEN
+
+
+/**
+ * A namespace for the classes that write and read the flat binary checkpoint
+ * format used by Triangulation::save_flat_binary(),
+ * Triangulation::load_flat_binary(), DoFHandler::save_flat_binary(), and
+ * DoFHandler::load_flat_binary().
+ *
+ * The two archive classes in this namespace can be used in place of the
+ * BOOST archives in the <code>serialize()</code>, <code>save()</code>, and
+ * <code>load()</code> functions of deal.II classes, i.e., they support the
+ * <code>ar & member;</code> syntax. Contrary to BOOST binary archives, they
+ * do not store any type or tracking information. Rather, a file consists of
+ * a header followed by the data of the objects in the order in which they
+ * were written:
+ * - The header consists of eight bytes <code>"deal.II"</code> (including the
+ *   terminating zero), the version of the format as a 32 bit integer (see
+ *   FlatBinaryArchive::format_version), the integer
+ *   <code>0x01020304</code> as a 32 bit integer to identify the byte order,
+ *   the size of types::global_dof_index in bytes as a 32 bit integer, and a
+ *   string describing the content of the file, for example
+ *   <code>"Triangulation<2,2>"</code>.
+ * - Numbers and enumerations are stored as they are represented in memory.
+ * - Strings, vectors, and maps are stored as their number of elements as a
+ *   64 bit integer, followed by the elements. The elements of vectors of
+ *   trivially copyable types, which make up the bulk of a Triangulation or a
+ *   DoFHandler, are stored as one contiguous block of memory. Vectors of
+ *   <code>bool</code> are stored with one byte per element.
+ * - Pointers are stored as a <code>bool</code> indicating whether the
+ *   pointer is non-null, followed by the object pointed to, if any.
+ * - Every object is stored at an offset from the start of the file that is a
+ *   multiple of its alignment. The padding bytes are zero.
+ *
+ * The input archive maps the file into memory (on systems that support the
+ * POSIX <code>mmap()</code> function; otherwise, it reads the entire file
+ * into memory). Reading a vector of trivially copyable objects then amounts
+ * to a single copy from the mapped memory, rather than parsing each object
+ * on its own.
+ *
+ * The format does not attempt to be portable between machines with different
+ * byte orders or different sizes of the integer types involved: it is
+ * intended for the fast restart of a simulation on the same machine, or on a
+ * machine of the same kind. These properties are checked when reading a
+ * file, as is the version of the format and the description of its content.
+ */
+namespace FlatBinaryArchive
+{
+  /**
+   * The version of the file format written by OutputArchive. It is
+   * incremented whenever the layout of the files changes. InputArchive
+   * refuses to read files with a different version.
+   */
+  const std::uint32_t format_version = 1;
+
+  /**
+   * An archive that writes objects to a file in the flat binary format
+   * described in the documentation of the FlatBinaryArchive namespace.
+   */
+  class OutputArchive
+  {
+  public:
+    /**
+     * Tags used by the <code>serialize()</code> functions of some classes to
+     * determine whether data is written or read.
+     */
+    using is_saving  = std::true_type;
+    using is_loading = std::false_type;
+
+    /**
+     * Constructor. Open the file @p filename, and write the header of the
+     * format with the given description of the content.
+     */
+    OutputArchive(const std::string &filename,
+                  const std::string &content_description);
+
+    /**
+     * Write an object to the file.
+     */
+    template <typename T>
+    OutputArchive &
+    operator&(const T &t);
+
+    /**
+     * Write an object to the file. Same as operator&().
+     */
+    template <typename T>
+    OutputArchive &
+    operator<<(const T &t);
+
+  private:
+    /**
+     * Write @p n_bytes bytes starting at @p data to the file.
+     */
+    void
+    write_bytes(const void *data, const std::size_t n_bytes);
+
+    /**
+     * Write zeros to the file until its size is a multiple of @p alignment.
+     */
+    void
+    align(const std::size_t alignment);
+
+    /**
+     * Write the size of a container.
+     */
+    void
+    write_size(const std::size_t size);
+
+    /**
+     * Write numbers and enumerations.
+     */
+    template <typename T>
+    void
+    write(const T &t, std::true_type);
+
+    /**
+     * Write objects of class type through their <code>serialize()</code>
+     * function.
+     */
+    template <typename T>
+    void
+    write(const T &t, std::false_type);
+
+    template <typename T, std::size_t N>
+    void
+    write(const T (&t)[N], std::false_type);
+
+    void
+    write(const std::string &t, std::false_type);
+
+    template <typename T, typename U>
+    void
+    write(const std::pair<T, U> &t, std::false_type);
+
+    template <typename T>
+    void
+    write(const std::vector<T> &t, std::false_type);
+
+    void
+    write(const std::vector<bool> &t, std::false_type);
+
+    template <typename Key, typename T>
+    void
+    write(const std::map<Key, T> &t, std::false_type);
+
+    template <typename T>
+    void
+    write(const std::unique_ptr<T> &t, std::false_type);
+
+    /**
+     * The file written to.
+     */
+    std::ofstream out;
+
+    /**
+     * The number of bytes written so far.
+     */
+    std::size_t position;
+  };
+
+
+
+  /**
+   * An archive that reads objects from a file in the flat binary format
+   * described in the documentation of the FlatBinaryArchive namespace. The
+   * objects have to be read in the same order as they were written.
+   */
+  class InputArchive
+  {
+  public:
+    /**
+     * Tags used by the <code>serialize()</code> functions of some classes to
+     * determine whether data is written or read.
+     */
+    using is_saving  = std::false_type;
+    using is_loading = std::true_type;
+
+    /**
+     * Constructor. Map the file @p filename into memory, and check its
+     * header. An exception is thrown if the file was not written in the
+     * current version of the format, on a machine with the same byte order
+     * and size of types::global_dof_index, or with the given description of
+     * the content.
+     */
+    InputArchive(const std::string &filename,
+                 const std::string &content_description);
+
+    /**
+     * Destructor. Release the memory the file was mapped to.
+     */
+    ~InputArchive();
+
+    /**
+     * Read an object from the file.
+     */
+    template <typename T>
+    InputArchive &
+    operator&(T &t);
+
+    /**
+     * Read an object from the file. Same as operator&().
+     */
+    template <typename T>
+    InputArchive &
+    operator>>(T &t);
+
+  private:
+    /**
+     * Return a pointer to the next @p n_bytes bytes of the file, and advance
+     * the current position by this number. Throw an exception if the file is
+     * shorter.
+     */
+    const char *
+    read_bytes(const std::size_t n_bytes);
+
+    /**
+     * Skip the padding bytes up to the next multiple of @p alignment.
+     */
+    void
+    align(const std::size_t alignment);
+
+    /**
+     * Read the size of a container.
+     */
+    std::size_t
+    read_size();
+
+    /**
+     * Read numbers and enumerations.
+     */
+    template <typename T>
+    void
+    read(T &t, std::true_type);
+
+    /**
+     * Read objects of class type through their <code>serialize()</code>
+     * function.
+     */
+    template <typename T>
+    void
+    read(T &t, std::false_type);
+
+    template <typename T, std::size_t N>
+    void
+    read(T (&t)[N], std::false_type);
+
+    void
+    read(std::string &t, std::false_type);
+
+    template <typename T, typename U>
+    void
+    read(std::pair<T, U> &t, std::false_type);
+
+    template <typename T>
+    void
+    read(std::vector<T> &t, std::false_type);
+
+    void
+    read(std::vector<bool> &t, std::false_type);
+
+    template <typename Key, typename T>
+    void
+    read(std::map<Key, T> &t, std::false_type);
+
+    template <typename T>
+    void
+    read(std::unique_ptr<T> &t, std::false_type);
+
+    /**
+     * The name of the file, for error messages.
+     */
+    const std::string filename;
+
+    /**
+     * The start of the memory the file was mapped to, or a null pointer if
+     * the file was read into @p buffer instead.
+     */
+    void *mapped_data;
+
+    /**
+     * A copy of the contents of the file, if it could not be mapped into
+     * memory.
+     */
+    std::vector<char> buffer;
+
+    /**
+     * Pointer to the contents of the file and its size.
+     */
+    const char *data;
+    std::size_t size;
+
+    /**
+     * The number of bytes read so far.
+     */
+    std::size_t position;
+  };
+
+
+
+  /* ------------------------ inline functions ------------------------ */
+
+#ifndef DOXYGEN
+
+  template <typename T>
+  inline OutputArchive &
+  OutputArchive::operator&(const T &t)
+  {
+    using is_number = std::integral_constant<bool,
+                                             std::is_arithmetic<T>::value ||
+                                               std::is_enum<T>::value>;
+    write(t, is_number());
+    return *this;
+  }
+
+
+
+  template <typename T>
+  inline OutputArchive &
+  OutputArchive::operator<<(const T &t)
+  {
+    return *this & t;
+  }
+
+
+
+  inline void
+  OutputArchive::write_size(const std::size_t size)
+  {
+    const std::uint64_t n = size;
+    *this &n;
+  }
+
+
+
+  template <typename T>
+  inline void
+  OutputArchive::write(const T &t, std::true_type)
+  {
+    align(alignof(T));
+    write_bytes(&t, sizeof(T));
+  }
+
+
+
+  template <typename T>
+  inline void
+  OutputArchive::write(const T &t, std::false_type)
+  {
+    // the serialize() functions are not const, but only read from the
+    // object when given an output archive
+    const_cast<T &>(t).serialize(*this, 0);
+  }
+
+
+
+  template <typename T, std::size_t N>
+  inline void
+  OutputArchive::write(const T (&t)[N], std::false_type)
+  {
+    for (std::size_t i = 0; i < N; ++i)
+      *this &t[i];
+  }
+
+
+
+  inline void
+  OutputArchive::write(const std::string &t, std::false_type)
+  {
+    write_size(t.size());
+    write_bytes(t.data(), t.size());
+  }
+
+
+
+  template <typename T, typename U>
+  inline void
+  OutputArchive::write(const std::pair<T, U> &t, std::false_type)
+  {
+    *this &t.first &t.second;
+  }
+
+
+
+  template <typename T>
+  inline void
+  OutputArchive::write(const std::vector<T> &t, std::false_type)
+  {
+    write_size(t.size());
+    if (std::is_trivially_copyable<T>::value)
+      {
+        align(alignof(T));
+        write_bytes(t.data(), t.size() * sizeof(T));
+      }
+    else
+      for (const T &element : t)
+        *this &element;
+  }
+
+
+
+  inline void
+  OutputArchive::write(const std::vector<bool> &t, std::false_type)
+  {
+    write_size(t.size());
+    const std::vector<std::uint8_t> bytes(t.begin(), t.end());
+    write_bytes(bytes.data(), bytes.size());
+  }
+
+
+
+  template <typename Key, typename T>
+  inline void
+  OutputArchive::write(const std::map<Key, T> &t, std::false_type)
+  {
+    write_size(t.size());
+    for (const auto &element : t)
+      *this &element.first &element.second;
+  }
+
+
+
+  template <typename T>
+  inline void
+  OutputArchive::write(const std::unique_ptr<T> &t, std::false_type)
+  {
+    const bool is_nullptr = (t.get() == nullptr);
+    *this &is_nullptr;
+    if (!is_nullptr)
+      *this &*t;
+  }
+
+
+
+  template <typename T>
+  inline InputArchive &
+  InputArchive::operator&(T &t)
+  {
+    using is_number = std::integral_constant<bool,
+                                             std::is_arithmetic<T>::value ||
+                                               std::is_enum<T>::value>;
+    read(t, is_number());
+    return *this;
+  }
+
+
+
+  template <typename T>
+  inline InputArchive &
+  InputArchive::operator>>(T &t)
+  {
+    return *this & t;
+  }
+
+
+
+  inline std::size_t
+  InputArchive::read_size()
+  {
+    std::uint64_t n;
+    *this &n;
+    return n;
+  }
+
+
+
+  template <typename T>
+  inline void
+  InputArchive::read(T &t, std::true_type)
+  {
+    align(alignof(T));
+    std::memcpy(&t, read_bytes(sizeof(T)), sizeof(T));
+  }
+
+
+
+  template <typename T>
+  inline void
+  InputArchive::read(T &t, std::false_type)
+  {
+    t.serialize(*this, 0);
+  }
+
+
+
+  template <typename T, std::size_t N>
+  inline void
+  InputArchive::read(T (&t)[N], std::false_type)
+  {
+    for (std::size_t i = 0; i < N; ++i)
+      *this &t[i];
+  }
+
+
+
+  inline void
+  InputArchive::read(std::string &t, std::false_type)
+  {
+    const std::size_t n = read_size();
+    t.assign(read_bytes(n), n);
+  }
+
+
+
+  template <typename T, typename U>
+  inline void
+  InputArchive::read(std::pair<T, U> &t, std::false_type)
+  {
+    *this &t.first &t.second;
+  }
+
+
+
+  template <typename T>
+  inline void
+  InputArchive::read(std::vector<T> &t, std::false_type)
+  {
+    const std::size_t n = read_size();
+    if (std::is_trivially_copyable<T>::value)
+      {
+        align(alignof(T));
+        const char *const block = read_bytes(n * sizeof(T));
+        t.resize(n);
+        if (n > 0)
+          std::memcpy(static_cast<void *>(t.data()), block, n * sizeof(T));
+      }
+    else
+      {
+        t.clear();
+        t.resize(n);
+        for (T &element : t)
+          *this &element;
+      }
+  }
+
+
+
+  inline void
+  InputArchive::read(std::vector<bool> &t, std::false_type)
+  {
+    const std::size_t   n     = read_size();
+    const std::uint8_t *bytes = reinterpret_cast<const std::uint8_t *>(
+      read_bytes(n * sizeof(std::uint8_t)));
+    t.assign(bytes, bytes + n);
+  }
+
+
+
+  template <typename Key, typename T>
+  inline void
+  InputArchive::read(std::map<Key, T> &t, std::false_type)
+  {
+    const std::size_t n = read_size();
+    t.clear();
+    for (std::size_t i = 0; i < n; ++i)
+      {
+        Key key;
+        *this &key;
+        *this &t[key];
+      }
+  }
+
+
+
+  template <typename T>
+  inline void
+  InputArchive::read(std::unique_ptr<T> &t, std::false_type)
+  {
+    bool is_nullptr;
+    *this &is_nullptr;
+    if (is_nullptr)
+      t.reset();
+    else
+      {
+        t = std_cxx14::make_unique<T>();
+        *this &*t;
+      }
+  }
+
+#endif // DOXYGEN
+
+} // namespace FlatBinaryArchive
+
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
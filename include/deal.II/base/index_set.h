@@ -25,6 +25,8 @@
 #include <boost/serialization/vector.hpp>
 
 #include <algorithm>
+#include <bitset>
+#include <cstdint>
 #include <iterator>
 #include <vector>
 
@@ -69,6 +71,24 @@ DEAL_II_NAMESPACE_OPEN
  * in the
  * @ref distributed_paper "Distributed Computing paper".
  *
+ * If the elements of an index set are spread over many short ranges (as is
+ * often the case for the ghost indices of discontinuous elements or after
+ * renumbering), compress() additionally sets up a bitmap of those parts of
+ * the index range that contain elements, together with the number of
+ * elements preceding each 64-bit word of the bitmap. With it,
+ * is_element(), index_within_set() and nth_index_in_set() no longer need to
+ * search through the list of ranges. The bitmap is stored in addition to the
+ * list of ranges, which remains the representation used by all other
+ * functions, and it does not change the external representation of the set.
+ * It is only created if its words are dense enough: if the words between
+ * the first and the last element are stored contiguously, there may be at
+ * most four of them per range plus four per 64 elements of the set, which
+ * covers ghost indices scattered around a locally owned range; otherwise,
+ * only the words that contain elements are stored, and there may be at most
+ * two of them per range. The bitmap thus takes at most four times the memory
+ * of the list of ranges plus one byte per element of the set.
+ * memory_consumption() includes the bitmap.
+ *
  * @author Wolfgang Bangerth, 2009
  */
 class IndexSet
@@ -460,7 +480,8 @@ public:
 
   /**
    * Determine an estimate for the memory consumption (in bytes) of this
-   * object.
+   * object. This includes the bitmap that compress() sets up for fragmented
+   * index sets, see the general documentation of this class.
    */
   std::size_t
   memory_consumption() const;
@@ -943,6 +964,76 @@ private:
    */
   mutable size_type largest_range;
 
+  /**
+   * A bitmap representation of the elements of a fragmented index set that
+   * is used to speed up lookups. Bit $i$ of the word with index $w$
+   * represents the index $64w+i$. Only words that contain elements are
+   * stored, except for the words that lie completely inside the largest
+   * range: these are never looked at since the largest range is checked
+   * separately.
+   */
+  struct Bitmap
+  {
+    /**
+     * The words of the bitmap.
+     */
+    std::vector<std::uint64_t> words;
+
+    /**
+     * The indices of the stored words, in ascending order. If this array is
+     * empty, all words from @p first_word onward are stored contiguously
+     * (with zero words in gaps), and the position of a word within @p words
+     * can be computed directly.
+     */
+    std::vector<size_type> word_indices;
+
+    /**
+     * The index of the first stored word if @p word_indices is empty.
+     */
+    size_type first_word = 0;
+
+    /**
+     * For each stored word, the number of elements of the index set that
+     * are smaller than the first index the word represents.
+     */
+    std::vector<size_type> ranks;
+
+    /**
+     * Return the position of the word with index @p word within @p words,
+     * or numbers::invalid_dof_index if it is not stored.
+     */
+    size_type
+    position(const size_type word) const;
+
+    /**
+     * Return whether the bitmap has been set up.
+     */
+    bool
+    empty() const;
+
+    /**
+     * Release all memory.
+     */
+    void
+    clear();
+
+    /**
+     * Return the memory consumption of this object in bytes.
+     */
+    std::size_t
+    memory_consumption() const;
+  };
+
+  /**
+   * The bitmap used to speed up lookups in fragmented index sets. It is set
+   * up by do_compress() and is valid whenever @p is_compressed is true.
+   *
+   * The variable is marked "mutable" so that it can be changed by compress(),
+   * though this of course doesn't change anything about the external
+   * representation of this index set.
+   */
+  mutable Bitmap bitmap;
+
   /**
    * A mutex that is used to synchronize operations of the do_compress()
    * function that is called from many 'const' functions via compress().
@@ -954,6 +1045,28 @@ private:
    */
   void
   do_compress() const;
+
+  /**
+   * Set up @p bitmap from @p ranges if the index set is fragmented enough
+   * for it to pay off. Called by do_compress().
+   */
+  void
+  setup_bitmap() const;
+
+  /**
+   * Return the how-manyth element of this set the index @p global_index is,
+   * or numbers::invalid_dof_index if it is not an element, using the bitmap.
+   * The index must not lie in the largest range.
+   */
+  size_type
+  bitmap_index_within_set(const size_type global_index) const;
+
+  /**
+   * Return the @p n th element of this set using the bitmap. The element must
+   * not lie in the largest range.
+   */
+  size_type
+  bitmap_nth_index_in_set(const size_type n) const;
 };
 
 
@@ -1448,11 +1561,13 @@ inline IndexSet::IndexSet(IndexSet &&is) noexcept
   , is_compressed(is.is_compressed)
   , index_space_size(is.index_space_size)
   , largest_range(is.largest_range)
+  , bitmap(std::move(is.bitmap))
 {
   is.ranges.clear();
   is.is_compressed    = true;
   is.index_space_size = 0;
   is.largest_range    = numbers::invalid_unsigned_int;
+  is.bitmap.clear();
 
   compress();
 }
@@ -1466,11 +1581,13 @@ IndexSet::operator=(IndexSet &&is) noexcept
   is_compressed    = is.is_compressed;
   index_space_size = is.index_space_size;
   largest_range    = is.largest_range;
+  bitmap           = std::move(is.bitmap);
 
   is.ranges.clear();
   is.is_compressed    = true;
   is.index_space_size = 0;
   is.largest_range    = numbers::invalid_unsigned_int;
+  is.bitmap.clear();
 
   compress();
 
@@ -1580,6 +1697,7 @@ IndexSet::clear()
   ranges.clear();
   is_compressed = true;
   largest_range = numbers::invalid_unsigned_int;
+  bitmap.clear();
 }
 
 
@@ -1592,6 +1710,7 @@ IndexSet::set_size(const size_type sz)
                     "object does not yet contain any elements."));
   index_space_size = sz;
   is_compressed    = true;
+  bitmap.clear();
 }
 
 
@@ -1674,6 +1793,9 @@ IndexSet::is_element(const size_type index) const
           index < ranges[largest_range].end)
         return true;
 
+      if (bitmap.empty() == false)
+        return (bitmap_index_within_set(index) != numbers::invalid_dof_index);
+
       // get the element after which we would have to insert a range that
       // consists of all elements from this element to the end of the index
       // range plus one. after this call we know that if p!=end() then
@@ -1791,6 +1913,9 @@ IndexSet::nth_index_in_set(const unsigned int n) const
       n < main_range->nth_index_in_set + (main_range->end - main_range->begin))
     return main_range->begin + (n - main_range->nth_index_in_set);
 
+  if (bitmap.empty() == false)
+    return bitmap_nth_index_in_set(n);
+
   // find out which chunk the local index n belongs to by using a binary
   // search. the comparator is based on the end of the ranges. Use the
   // position relative to main_range to subdivide the ranges
@@ -1837,6 +1962,9 @@ IndexSet::index_within_set(const size_type n) const
   if (n >= main_range->begin && n < main_range->end)
     return (n - main_range->begin) + main_range->nth_index_in_set;
 
+  if (bitmap.empty() == false)
+    return bitmap_index_within_set(n);
+
   Range                              r(n, n);
   std::vector<Range>::const_iterator range_begin, range_end;
   if (n < main_range->begin)
@@ -1865,6 +1993,75 @@ IndexSet::index_within_set(const size_type n) const
 
 
 
+inline IndexSet::size_type
+IndexSet::Bitmap::position(const size_type word) const
+{
+  if (word_indices.empty())
+    return ((word >= first_word && word - first_word < words.size()) ?
+              word - first_word :
+              numbers::invalid_dof_index);
+
+  const std::vector<size_type>::const_iterator p =
+    Utilities::lower_bound(word_indices.begin(), word_indices.end(), word);
+  return ((p != word_indices.end() && *p == word) ? p - word_indices.begin() :
+                                                    numbers::invalid_dof_index);
+}
+
+
+
+inline bool
+IndexSet::Bitmap::empty() const
+{
+  return words.empty();
+}
+
+
+
+inline IndexSet::size_type
+IndexSet::bitmap_index_within_set(const size_type global_index) const
+{
+  const size_type position = bitmap.position(global_index / 64);
+  if (position == numbers::invalid_dof_index)
+    return numbers::invalid_dof_index;
+
+  const std::uint64_t word = bitmap.words[position];
+  const unsigned int  bit  = global_index % 64;
+  if (((word >> bit) & 1) == 0)
+    return numbers::invalid_dof_index;
+
+  // add the number of elements before the index within the same word
+  return bitmap.ranks[position] +
+         std::bitset<64>(word & ((std::uint64_t(1) << bit) - 1)).count();
+}
+
+
+
+inline IndexSet::size_type
+IndexSet::bitmap_nth_index_in_set(const size_type n) const
+{
+  // find the last word with at most n elements before it. this is the word
+  // that contains the element we are looking for
+  const size_type position =
+    std::upper_bound(bitmap.ranks.begin(), bitmap.ranks.end(), n) -
+    bitmap.ranks.begin() - 1;
+  Assert(position < bitmap.words.size(), ExcInternalError());
+
+  // remove the elements before the one we are looking for from the word,
+  // then find the lowest bit that is still set
+  std::uint64_t word = bitmap.words[position];
+  for (size_type i = bitmap.ranks[position]; i < n; ++i)
+    word &= word - 1;
+  Assert(word != 0, ExcInternalError());
+  const unsigned int bit = std::bitset<64>((word & (~word + 1)) - 1).count();
+
+  const size_type word_index = (bitmap.word_indices.empty() ?
+                                  bitmap.first_word + position :
+                                  bitmap.word_indices[position]);
+  return 64 * word_index + bit;
+}
+
+
+
 inline bool
 IndexSet::operator==(const IndexSet &is) const
 {
@@ -1946,6 +2143,14 @@ inline void
 IndexSet::serialize(Archive &ar, const unsigned int)
 {
   ar &ranges &is_compressed &index_space_size &largest_range;
+
+  // the bitmap is not stored, but set up again from the ranges
+  if (Archive::is_loading::value)
+    {
+      bitmap.clear();
+      if (is_compressed)
+        do_compress();
+    }
 }
 
 DEAL_II_NAMESPACE_CLOSE
@@ -0,0 +1,516 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_base_mpi_remote_point_evaluation_h
+#define dealii_base_mpi_remote_point_evaluation_h
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/array_view.h>
+#include <deal.II/base/bounding_box.h>
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/point.h>
+#include <deal.II/base/smartpointer.h>
+#include <deal.II/base/subscriptor.h>
+
+#include <deal.II/fe/fe_update_flags.h>
+#include <deal.II/fe/mapping.h>
+
+#include <deal.II/grid/grid_tools_cache.h>
+#include <deal.II/grid/tria.h>
+
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+DEAL_II_NAMESPACE_OPEN
+
+// Forward declarations
+template <int dim, int spacedim>
+class FEValues;
+template <int dim, int spacedim>
+class FiniteElement;
+
+namespace Utilities
+{
+  namespace MPI
+  {
+    /**
+     * A class to evaluate finite element quantities at arbitrary points that
+     * may lie on any process of a (possibly distributed) triangulation.
+     *
+     * A call to reinit() determines, for the points given by the current
+     * process, which process owns the cell surrounding each point and where
+     * the point lies within that cell in reference coordinates. This
+     * information, together with the communication pattern needed to send
+     * the evaluated values back to the process that asked for them, is
+     * stored. Subsequent calls to evaluate_and_process() then only ship the
+     * computed values, without repeating the search or re-sending any point
+     * coordinates or cell information. This makes the class suitable for
+     * situations in which the same points are evaluated many times, e.g.,
+     * for point sensors or particle-in-cell codes with a fixed set of
+     * evaluation points.
+     *
+     * If only a few of the points move between two evaluations, the
+     * function update_points() re-locates only those points and reuses the
+     * information computed for all other points.
+     *
+     * On a parallel::Triangulation (and if deal.II was configured with
+     * MPI), the search uses the bounding boxes of the locally owned parts of
+     * the mesh of all processes together with
+     * GridTools::distributed_compute_point_locations(). On a serial
+     * Triangulation, GridTools::compute_point_locations_try_all() is used
+     * and no communication takes place.
+     *
+     * If a point lies on the boundary between the locally owned parts of
+     * the mesh of several processes, it is found by each of them. In that
+     * case, the value computed by the process with the lowest rank is used.
+     *
+     * @note All functions of this class except the query functions are
+     * collective operations on the communicator of the triangulation.
+     *
+     * @ingroup mpi
+     */
+    template <int dim, int spacedim = dim>
+    class RemotePointEvaluation : public Subscriptor
+    {
+    public:
+      /**
+       * The data handed to the evaluation function of
+       * evaluate_and_process(): the locally owned cells of the current
+       * process that contain at least one point of any process, and the
+       * positions of these points in the reference coordinates of the
+       * respective cell.
+       */
+      struct CellData
+      {
+        /**
+         * Level and index of the cells. A cell iterator can be obtained via
+         * `typename Triangulation<dim, spacedim>::active_cell_iterator
+         * cell(&tria, cells[i].first, cells[i].second)`.
+         */
+        std::vector<std::pair<int, int>> cells;
+
+        /**
+         * Pointers into reference_point_values: the reference points of
+         * the cell cells[i] are stored in the half-open range
+         * [reference_point_ptrs[i], reference_point_ptrs[i+1]). The
+         * evaluation function has to write the value associated with each
+         * reference point to the same position of the output array.
+         */
+        std::vector<unsigned int> reference_point_ptrs;
+
+        /**
+         * The reference points of all cells, stored consecutively.
+         */
+        std::vector<Point<dim>> reference_point_values;
+      };
+
+      /**
+       * Constructor. The object is not usable before reinit() has been
+       * called.
+       */
+      RemotePointEvaluation() = default;
+
+      /**
+       * Destructor.
+       */
+      ~RemotePointEvaluation() override;
+
+      /**
+       * Set up the internal data structures for the points @p points of the
+       * current process: locate them in the triangulation @p tria with
+       * the help of @p mapping and set up the communication pattern used
+       * by evaluate_and_process().
+       *
+       * The triangulation and the mapping are stored as pointers and need
+       * to outlive this object. If the triangulation is changed, reinit()
+       * has to be called again.
+       */
+      void
+      reinit(const std::vector<Point<spacedim>> &points,
+             const Triangulation<dim, spacedim> &tria,
+             const Mapping<dim, spacedim> &      mapping);
+
+      /**
+       * Move the points with the local indices @p indices to the new
+       * positions @p new_points and update the internal data structures.
+       * Only the moved points are searched for again; the information for
+       * all other points is kept. Each process can pass a different (and
+       * possibly empty) set of points.
+       */
+      void
+      update_points(const std::vector<unsigned int> &   indices,
+                    const std::vector<Point<spacedim>> &new_points);
+
+      /**
+       * Evaluate some quantity at the points of all processes that lie in
+       * the locally owned cells of the current process by calling
+       * @p evaluation_function, send the results to the processes that own
+       * the points, and store the values for the points of the current
+       * process in @p output, in the order in which the points were passed
+       * to reinit().
+       *
+       * The evaluation function receives an array of the size of
+       * CellData::reference_point_values times @p n_values_per_point to be
+       * filled, and the CellData object describing the cells and points.
+       * The @p n_values_per_point values of the reference point with index
+       * i are stored starting at position i * @p n_values_per_point, e.g.,
+       * the values of all vector components of a finite element function.
+       * @p output is laid out in the same way. Entries of @p output that
+       * belong to points that have not been found on any process are
+       * value-initialized.
+       *
+       * The values are sent as raw bytes with point-to-point messages
+       * between the processes determined in reinit(), without any further
+       * collective communication. For this reason, @p T has to be
+       * trivially copyable, e.g., a number or a Tensor.
+       */
+      template <typename T>
+      void
+      evaluate_and_process(
+        std::vector<T> &output,
+        const std::function<void(const ArrayView<T> &, const CellData &)>
+          &                evaluation_function,
+        const unsigned int n_values_per_point = 1) const;
+
+      /**
+       * Return whether the point with local index @p i has been found in
+       * the locally owned part of the mesh of any process.
+       */
+      bool
+      point_found(const unsigned int i) const;
+
+      /**
+       * Return whether all points of the current process have been found.
+       */
+      bool
+      all_points_found() const;
+
+      /**
+       * Return the points of the current process.
+       */
+      const std::vector<Point<spacedim>> &
+      get_points() const;
+
+      /**
+       * Return the cells and reference points evaluated on the current
+       * process.
+       */
+      const CellData &
+      get_cell_data() const;
+
+      /**
+       * Return an FEValues object for the finite element @p fe whose
+       * quadrature points are the reference points of the cell with index
+       * @p c in get_cell_data(), set up with (at least) the flags
+       * @p update_flags. The caller still has to call FEValues::reinit()
+       * on the cell before using it.
+       *
+       * The objects are created on first use and stored until the points
+       * change, so that evaluations at the same points, e.g., once per time
+       * step, do not have to set up the shape function tables again.
+       *
+       * @note Since this function modifies the stored objects, it must not
+       * be called on the same object from several threads at once.
+       */
+      FEValues<dim, spacedim> &
+      get_fe_values(const unsigned int                  c,
+                    const FiniteElement<dim, spacedim> &fe,
+                    const UpdateFlags                   update_flags) const;
+
+      /**
+       * Return the triangulation passed to reinit().
+       */
+      const Triangulation<dim, spacedim> &
+      get_triangulation() const;
+
+      /**
+       * Return the mapping passed to reinit().
+       */
+      const Mapping<dim, spacedim> &
+      get_mapping() const;
+
+    private:
+      /**
+       * Locate the points with the local indices @p point_indices, and
+       * append the resulting cells and reference points to
+       * points_for_rank as well as the indices to indices_from_rank.
+       */
+      void
+      locate_points(const std::vector<unsigned int> &point_indices);
+
+      /**
+       * Rebuild cell_data, send_permutation, and the send lists from
+       * points_for_rank, and the receive lists as well as the flags
+       * returned by point_found() from indices_from_rank.
+       */
+      void
+      setup_cell_data();
+
+      /**
+       * The triangulation the points are located in.
+       */
+      SmartPointer<const Triangulation<dim, spacedim>,
+                   RemotePointEvaluation<dim, spacedim>>
+        tria;
+
+      /**
+       * The mapping used to locate the points.
+       */
+      SmartPointer<const Mapping<dim, spacedim>,
+                   RemotePointEvaluation<dim, spacedim>>
+        mapping;
+
+      /**
+       * The communicator of the triangulation, or MPI_COMM_SELF for a
+       * serial triangulation.
+       */
+      MPI_Comm communicator = MPI_COMM_SELF;
+
+      /**
+       * Whether the points are located with the distributed algorithm.
+       */
+      bool distributed = false;
+
+      /**
+       * The cache holding the bounding box tree of the triangulation, kept
+       * for update_points().
+       */
+      std::unique_ptr<GridTools::Cache<dim, spacedim>> cache;
+
+      /**
+       * The bounding boxes of the locally owned parts of the mesh of all
+       * processes.
+       */
+      std::vector<std::vector<BoundingBox<spacedim>>> global_bboxes;
+
+      /**
+       * The points of the current process.
+       */
+      std::vector<Point<spacedim>> points;
+
+      /**
+       * For each process, the cells (as level and index) and reference
+       * points of the points of that process found in the locally owned
+       * cells of the current process, in the order in which the values are
+       * sent to that process.
+       */
+      std::map<unsigned int,
+               std::vector<std::pair<std::pair<int, int>, Point<dim>>>>
+        points_for_rank;
+
+      /**
+       * For each process, the local indices of the points the values
+       * received from that process belong to.
+       */
+      std::map<unsigned int, std::vector<unsigned int>> indices_from_rank;
+
+      /**
+       * For each process, the position in the array filled by the
+       * evaluation function of each value sent to that process.
+       */
+      std::map<unsigned int, std::vector<unsigned int>> send_permutation;
+
+      /**
+       * The processes the values computed on the current process are sent
+       * to, in ascending order. This includes the current process if it
+       * evaluates any of its own points.
+       */
+      std::vector<unsigned int> send_ranks;
+
+      /**
+       * Pointers into send_indices: the values sent to the process
+       * send_ranks[i] are taken from the positions
+       * [send_ptrs[i], send_ptrs[i+1]) of send_indices.
+       */
+      std::vector<unsigned int> send_ptrs;
+
+      /**
+       * The contents of send_permutation for all processes in send_ranks,
+       * stored consecutively.
+       */
+      std::vector<unsigned int> send_indices;
+
+      /**
+       * The processes the current process receives values from, in
+       * ascending order. This includes the current process if it evaluates
+       * any of its own points.
+       */
+      std::vector<unsigned int> recv_ranks;
+
+      /**
+       * Pointers into recv_indices: the values received from the process
+       * recv_ranks[i] are stored in the positions
+       * [recv_ptrs[i], recv_ptrs[i+1]) of the receive buffer.
+       */
+      std::vector<unsigned int> recv_ptrs;
+
+      /**
+       * For each value received, the local index of the point it belongs
+       * to, or numbers::invalid_unsigned_int if the value of that point is
+       * already received from a process with a lower rank.
+       */
+      std::vector<unsigned int> recv_indices;
+
+      /**
+       * The cells and reference points handed to the evaluation function.
+       */
+      CellData cell_data;
+
+      /**
+       * The FEValues objects handed out by get_fe_values(), one per entry
+       * of CellData::cells.
+       */
+      mutable std::vector<std::unique_ptr<FEValues<dim, spacedim>>>
+        fe_values_cache;
+
+      /**
+       * The flags all objects in fe_values_cache are set up with.
+       */
+      mutable UpdateFlags fe_values_cache_flags = update_default;
+
+      /**
+       * Whether each point of the current process has been found.
+       */
+      std::vector<bool> point_found_flags;
+    };
+
+
+
+#ifndef DOXYGEN
+
+    template <int dim, int spacedim>
+    template <typename T>
+    void
+    RemotePointEvaluation<dim, spacedim>::evaluate_and_process(
+      std::vector<T> &output,
+      const std::function<void(const ArrayView<T> &, const CellData &)>
+        &                evaluation_function,
+      const unsigned int n_values_per_point) const
+    {
+      static_assert(std::is_trivially_copyable<T>::value,
+                    "The values are sent as raw bytes and need to be "
+                    "trivially copyable.");
+      Assert(tria != nullptr,
+             ExcMessage("RemotePointEvaluation::reinit() has not been "
+                        "called yet."));
+      Assert(n_values_per_point > 0, ExcZero());
+      const unsigned int n = n_values_per_point;
+
+      std::vector<T> buffer(cell_data.reference_point_values.size() * n);
+      evaluation_function(make_array_view(buffer), cell_data);
+
+      // gather the values for each process in the order the receiving
+      // process expects them
+      std::vector<T> send_buffer(send_indices.size() * n);
+      for (unsigned int i = 0; i < send_indices.size(); ++i)
+        std::copy(buffer.begin() + send_indices[i] * n,
+                  buffer.begin() + (send_indices[i] + 1) * n,
+                  send_buffer.begin() + i * n);
+
+      std::vector<T> recv_buffer(recv_indices.size() * n);
+
+      // the communication pattern is known from reinit(), so only post the
+      // point-to-point messages carrying the values. the values of the
+      // current process are copied directly
+      const unsigned int my_rank =
+        Utilities::MPI::this_mpi_process(communicator);
+#ifdef DEAL_II_WITH_MPI
+      // an arbitrary tag that keeps these messages apart from others sent
+      // on the same communicator
+      const int mpi_tag = 4177;
+
+      std::vector<MPI_Request> requests;
+      requests.reserve(recv_ranks.size() + send_ranks.size());
+      for (unsigned int i = 0; i < recv_ranks.size(); ++i)
+        if (recv_ranks[i] != my_rank)
+          {
+            requests.emplace_back();
+            const int ierr =
+              MPI_Irecv(recv_buffer.data() + recv_ptrs[i] * n,
+                        (recv_ptrs[i + 1] - recv_ptrs[i]) * n * sizeof(T),
+                        MPI_BYTE,
+                        recv_ranks[i],
+                        mpi_tag,
+                        communicator,
+                        &requests.back());
+            AssertThrowMPI(ierr);
+          }
+      for (unsigned int i = 0; i < send_ranks.size(); ++i)
+        if (send_ranks[i] != my_rank)
+          {
+            requests.emplace_back();
+            const int ierr =
+              MPI_Isend(send_buffer.data() + send_ptrs[i] * n,
+                        (send_ptrs[i + 1] - send_ptrs[i]) * n * sizeof(T),
+                        MPI_BYTE,
+                        send_ranks[i],
+                        mpi_tag,
+                        communicator,
+                        &requests.back());
+            AssertThrowMPI(ierr);
+          }
+#else
+      Assert(distributed == false, ExcInternalError());
+#endif
+
+      const auto own_send =
+        std::lower_bound(send_ranks.begin(), send_ranks.end(), my_rank);
+      const auto own_recv =
+        std::lower_bound(recv_ranks.begin(), recv_ranks.end(), my_rank);
+      if (own_send != send_ranks.end() && *own_send == my_rank)
+        {
+          Assert(own_recv != recv_ranks.end() && *own_recv == my_rank,
+                 ExcInternalError());
+          const unsigned int s = own_send - send_ranks.begin();
+          const unsigned int r = own_recv - recv_ranks.begin();
+          AssertDimension(send_ptrs[s + 1] - send_ptrs[s],
+                          recv_ptrs[r + 1] - recv_ptrs[r]);
+          std::copy(send_buffer.begin() + send_ptrs[s] * n,
+                    send_buffer.begin() + send_ptrs[s + 1] * n,
+                    recv_buffer.begin() + recv_ptrs[r] * n);
+        }
+
+#ifdef DEAL_II_WITH_MPI
+      if (requests.size() > 0)
+        {
+          const int ierr = MPI_Waitall(requests.size(),
+                                       requests.data(),
+                                       MPI_STATUSES_IGNORE);
+          AssertThrowMPI(ierr);
+        }
+#endif
+
+      output.assign(points.size() * n, T());
+      for (unsigned int i = 0; i < recv_indices.size(); ++i)
+        if (recv_indices[i] != numbers::invalid_unsigned_int)
+          std::copy(recv_buffer.begin() + i * n,
+                    recv_buffer.begin() + (i + 1) * n,
+                    output.begin() + recv_indices[i] * n);
+    }
+
+#endif
+
+  } // namespace MPI
+} // namespace Utilities
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
@@ -131,6 +131,20 @@ namespace Polynomials
           const unsigned int n_derivatives,
           number *           values) const;
 
+    /**
+     * Same as the previous function, but for an argument of a different
+     * number type. This is used to evaluate the polynomial in several points
+     * at once by passing a VectorizedArray<number> as argument, see
+     * TensorProductPolynomials::compute() for an example. As opposed to the
+     * previous function, this function does not allocate memory for
+     * polynomials in coefficient form.
+     */
+    template <typename Number2>
+    void
+    value(const Number2 &    x,
+          const unsigned int n_derivatives,
+          Number2 *          values) const;
+
     /**
      * Degree of the polynomial. This is the degree reflected by the number of
      * coefficients provided by the constructor. Leading non-zero coefficients
@@ -819,6 +833,59 @@ namespace Polynomials
 
 
 
+  template <typename number>
+  template <typename Number2>
+  inline void
+  Polynomial<number>::value(const Number2 &    x,
+                            const unsigned int n_derivatives,
+                            Number2 *          values) const
+  {
+    if (in_lagrange_product_form == true)
+      {
+        // same algorithm as in the function for the plain number type,
+        // expanding the product rule for (x-x_1)*(x-x_2)*...*(x-x_n)
+        for (unsigned int k = 0; k <= n_derivatives; ++k)
+          values[k] = 0.;
+        values[0] = 1.;
+        for (unsigned int i = 0; i < lagrange_support_points.size(); ++i)
+          {
+            const Number2 v = x - lagrange_support_points[i];
+            for (unsigned int k = n_derivatives; k > 0; --k)
+              values[k] = values[k] * v + values[k - 1];
+            values[0] = values[0] * v;
+          }
+        number k_faculty = 1;
+        for (unsigned int k = 0; k <= n_derivatives; ++k)
+          {
+            values[k] = values[k] * (k_faculty * lagrange_weight);
+            k_faculty *= static_cast<number>(k + 1);
+          }
+      }
+    else
+      {
+        Assert(coefficients.size() > 0, ExcEmptyObject());
+
+        // Horner scheme for the value and all derivatives: after the loop,
+        // values[j] holds the j-th derivative divided by j!
+        for (unsigned int k = 0; k <= n_derivatives; ++k)
+          values[k] = 0.;
+        for (int k = coefficients.size() - 1; k >= 0; --k)
+          {
+            for (unsigned int j = n_derivatives; j > 0; --j)
+              values[j] = values[j] * x + values[j - 1];
+            values[0] = values[0] * x + coefficients[k];
+          }
+        number j_faculty = 1;
+        for (unsigned int j = 2; j <= n_derivatives; ++j)
+          {
+            j_faculty *= static_cast<number>(j);
+            values[j] = values[j] * j_faculty;
+          }
+      }
+  }
+
+
+
   template <typename number>
   template <class Archive>
   inline void
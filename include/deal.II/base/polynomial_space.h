@@ -23,6 +23,7 @@
 #include <deal.II/base/point.h>
 #include <deal.II/base/polynomial.h>
 #include <deal.II/base/smartpointer.h>
+#include <deal.II/base/table.h>
 #include <deal.II/base/tensor.h>
 
 #include <vector>
@@ -149,6 +150,23 @@ public:
           std::vector<Tensor<3, dim>> &third_derivatives,
           std::vector<Tensor<4, dim>> &fourth_derivatives) const;
 
+  /**
+   * Compute the values and the gradients of all polynomials at all points in
+   * <tt>unit_points</tt>. The result for polynomial <tt>i</tt> and point
+   * <tt>q</tt> is stored in <tt>values(i,q)</tt> and <tt>grads(i,q)</tt>,
+   * respectively. Each of the two tables must either be empty or of size n()
+   * times <tt>unit_points.size()</tt>. In the first case, the function will
+   * not compute these values.
+   *
+   * This function evaluates the one-dimensional polynomials for several
+   * points at once with VectorizedArray, which is considerably faster than
+   * calling the function above for each point separately.
+   */
+  void
+  compute(const std::vector<Point<dim>> &unit_points,
+          Table<2, double> &             values,
+          Table<2, Tensor<1, dim>> &     grads) const;
+
   /**
    * Compute the value of the <tt>i</tt>th polynomial at unit point
    * <tt>p</tt>.
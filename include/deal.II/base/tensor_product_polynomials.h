@@ -22,6 +22,7 @@
 #include <deal.II/base/exceptions.h>
 #include <deal.II/base/point.h>
 #include <deal.II/base/polynomial.h>
+#include <deal.II/base/table.h>
 #include <deal.II/base/tensor.h>
 #include <deal.II/base/utilities.h>
 
@@ -125,6 +126,25 @@ public:
           std::vector<Tensor<3, dim>> &third_derivatives,
           std::vector<Tensor<4, dim>> &fourth_derivatives) const;
 
+  /**
+   * Compute the values and the gradients of all tensor product polynomials
+   * at all points in <tt>unit_points</tt>. The result for polynomial
+   * <tt>i</tt> and point <tt>q</tt> is stored in <tt>values(i,q)</tt> and
+   * <tt>grads(i,q)</tt>, respectively. Each of the two tables must either be
+   * empty or of size n() times <tt>unit_points.size()</tt>. In the first
+   * case, the function will not compute these values.
+   *
+   * As opposed to calling the function above for each point separately,
+   * this function evaluates the underlying one-dimensional polynomials for
+   * several points at once with VectorizedArray and reuses the products of
+   * the one-dimensional values in the outer coordinate directions for all
+   * polynomials in the first coordinate direction.
+   */
+  void
+  compute(const std::vector<Point<dim>> &unit_points,
+          Table<2, double> &             values,
+          Table<2, Tensor<1, dim>> &     grads) const;
+
   /**
    * Compute the value of the <tt>i</tt>th tensor product polynomial at
    * <tt>unit_point</tt>. Here <tt>i</tt> is given in tensor product
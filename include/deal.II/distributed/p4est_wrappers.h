@@ -19,12 +19,14 @@
 #include <deal.II/base/geometry_info.h>
 
 #ifdef DEAL_II_WITH_P4EST
+#  include <p4est_algorithms.h>
 #  include <p4est_bits.h>
 #  include <p4est_communication.h>
 #  include <p4est_extended.h>
 #  include <p4est_ghost.h>
 #  include <p4est_iterate.h>
 #  include <p4est_vtk.h>
+#  include <p8est_algorithms.h>
 #  include <p8est_bits.h>
 #  include <p8est_communication.h>
 #  include <p8est_extended.h>
@@ -182,6 +184,10 @@ namespace internal
                                            int partition_for_coarsening,
                                            p4est_weight_t weight_fn);
 
+      static types<2>::gloidx (&partition_given)(
+        types<2>::forest *      p4est,
+        const types<2>::locidx *num_quadrants_in_proc);
+
       static void (&save)(const char *      filename,
                           types<2>::forest *p4est,
                           int               save_data);
@@ -352,6 +358,10 @@ namespace internal
                                            int partition_for_coarsening,
                                            p8est_weight_t weight_fn);
 
+      static types<3>::gloidx (&partition_given)(
+        types<3>::forest *      p8est,
+        const types<3>::locidx *num_quadrants_in_proc);
+
       static void (&save)(const char *      filename,
                           types<3>::forest *p4est,
                           int               save_data);
@@ -30,6 +30,7 @@
 
 #include <boost/range/iterator_range.hpp>
 
+#include <cstdint>
 #include <functional>
 #include <list>
 #include <set>
@@ -490,6 +491,61 @@ namespace parallel
       void
       repartition();
 
+      /**
+       * Statistics about the most recent repartitioning of the mesh, as
+       * returned by get_repartitioning_statistics(). All values are global,
+       * i.e., summed over all processors.
+       */
+      struct RepartitioningStatistics
+      {
+        /**
+         * The ratio of the largest weight (or number of cells) owned by a
+         * single processor and the average weight before and after the
+         * repartitioning.
+         */
+        double imbalance_before = 1.;
+        double imbalance_after  = 1.;
+
+        /**
+         * The number of active cells that have been moved to a different
+         * processor.
+         */
+        std::uint64_t n_migrated_cells = 0;
+
+        /**
+         * The number of bytes of the data attached through
+         * register_data_attach() that belongs to the migrated cells.
+         */
+        std::uint64_t n_migrated_bytes = 0;
+      };
+
+      /**
+       * Select how the cells are distributed among the processors in
+       * repartition() and execute_coarsening_and_refinement().
+       *
+       * By default (a @p tolerance of zero), the cells are distributed by
+       * slicing the space-filling curve of p4est into pieces of equal weight
+       * anew every time, regardless of the previous partition. Even a small
+       * imbalance may then move a large fraction of the cells, together with
+       * any data attached to them.
+       *
+       * For a positive @p tolerance, the partition is only changed if the
+       * weight of some processor exceeds the average weight by more than
+       * the factor $1+\text{tolerance}$, and then each boundary between the
+       * partitions is moved along the space-filling curve only as far as
+       * necessary to bring all processors within this bound. As with the
+       * default partitioning, families of cells that could be coarsened
+       * together are not split where this can be avoided locally.
+       */
+      void
+      set_repartitioning_tolerance(const double tolerance);
+
+      /**
+       * Return statistics about the most recent repartitioning of the mesh.
+       */
+      const RepartitioningStatistics &
+      get_repartitioning_statistics() const;
+
       /**
        * When vertices have been moved locally, for example using code like
        * @code
@@ -868,6 +924,16 @@ namespace parallel
        */
       bool triangulation_has_content;
 
+      /**
+       * The tolerance set by set_repartitioning_tolerance().
+       */
+      double repartitioning_tolerance;
+
+      /**
+       * The statistics returned by get_repartitioning_statistics().
+       */
+      RepartitioningStatistics repartitioning_statistics;
+
       /**
        * A data structure that holds the connectivity between trees. Since
        * each tree is rooted in a coarse grid cell, this data structure holds
@@ -1090,6 +1156,13 @@ namespace parallel
         void
         clear();
 
+        /**
+         * Return the number of bytes packed by pack_data() for the locally
+         * owned quadrants with indices in the range [@p begin, @p end).
+         */
+        std::uint64_t
+        n_packed_bytes(const unsigned int begin, const unsigned int end) const;
+
       private:
         MPI_Comm mpi_communicator;
 
@@ -1195,6 +1268,17 @@ namespace parallel
       std::vector<unsigned int>
       get_cell_weights() const;
 
+      /**
+       * Distribute the quadrants of the p4est forest among the processors,
+       * either with p4est's partitioning or, if a repartitioning tolerance
+       * has been set, by only shifting the current partition boundaries.
+       * Also fill repartitioning_statistics. Called from
+       * execute_coarsening_and_refinement() and repartition() after the
+       * attached data has been packed.
+       */
+      void
+      partition_parallel_forest();
+
       /**
        * Override the implementation in parallel::Triangulation because
        * we can ask p4est about ghost neighbors across periodic boundaries.
@@ -1196,6 +1196,31 @@ public:
 
   BOOST_SERIALIZATION_SPLIT_MEMBER()
 
+  /**
+   * Write the same data as save() to the file @p filename, using the flat
+   * binary format described in the documentation of the FlatBinaryArchive
+   * namespace. The arrays of degree of freedom indices on all levels, faces,
+   * and vertices are stored as contiguous blocks of memory, which
+   * load_flat_binary() can copy directly from the file mapped into memory.
+   * Together with Triangulation::save_flat_binary(), this allows to restart
+   * long running simulations without the cost of calling distribute_dofs()
+   * again or of parsing a BOOST archive.
+   */
+  void
+  save_flat_binary(const std::string &filename) const;
+
+  /**
+   * Read the degrees of freedom from a file written by save_flat_binary().
+   * As for load(), this object must already be associated with the
+   * triangulation the data was stored for, and distribute_dofs() must have
+   * been called with the same finite element as for the DoFHandler that was
+   * stored. An exception is thrown if this is not the case, or if the file
+   * does not contain a DoFHandler of the same dimensions written in the
+   * current version of the format.
+   */
+  void
+  load_flat_binary(const std::string &filename);
+
   /**
    * Exception
    * @ingroup Exceptions
@@ -338,6 +338,20 @@ DEAL_II_NAMESPACE_OPEN
  * freedom numberings. Refer to the actual function declarations to get more
  * information on this.
  *
+ *
+ * <h3>Multithreading</h3>
+ *
+ * The functions in this namespace compute the new numbering on a single
+ * thread. Only applying it through DoFHandler::renumber_dofs(), which
+ * rewrites the indices stored on all vertices, lines, quads, and cells, is
+ * split between several threads for the non-hp DoFHandler. The Cuthill-McKee
+ * algorithm is a breadth-first search in which the position of every degree
+ * of freedom depends on all the ones numbered before it, so it does not lend
+ * itself to a parallel implementation that produces the same numbering. The
+ * other renumberings consist of a sort or a single sweep over the cells whose
+ * cost is small compared to setting up the sparsity pattern or solving the
+ * linear system, and have consequently not been parallelized either.
+ *
  * @ingroup dofs
  * @author Wolfgang Bangerth, Guido Kanschat, 1998, 1999, 2000, 2004, 2007,
  * 2008
@@ -0,0 +1,1067 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_fe_interface_values_h
+#define dealii_fe_interface_values_h
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/quadrature.h>
+#include <deal.II/base/template_constraints.h>
+
+#include <deal.II/fe/fe_values.h>
+#include <deal.II/fe/mapping_q1.h>
+
+#include <algorithm>
+#include <array>
+#include <utility>
+#include <vector>
+
+DEAL_II_NAMESPACE_OPEN
+
+/**
+ * FEInterfaceValues is a data structure to access and assemble finite element
+ * data on interfaces between two cells of a mesh.
+ *
+ * It provides a way to access averages, jump terms, and similar operations
+ * used in Discontinuous Galerkin methods on a face between two neighboring
+ * cells. This allows the computation of a typical mesh-dependent linear or
+ * bilinear form in a similar way as one would use FEValues objects for
+ * cells and FEFaceValues objects for faces.
+ *
+ * Internally, this class provides an abstraction for two FEFaceValues
+ * objects (or FESubfaceValues when using adaptive refinement). The class
+ * introduces a new "interface dof index" that walks over the union of the
+ * dof indices of the two FEFaceValues objects. Helper functions allow
+ * translating between the new "interface dof index" and the corresponding
+ * "cell index" (0 for the first cell, 1 for the second cell) and "dof index"
+ * within that cell. The interface dofs are numbered such that the dofs of
+ * the first cell come first, in the order of that cell, followed by those
+ * dofs of the second cell that are not shared with the first cell. For
+ * elements without degrees of freedom on faces (such as FE_DGQ), the two
+ * cells never share degrees of freedom and the interface dofs are simply the
+ * dofs of the first cell followed by those of the second cell.
+ *
+ * Quantities that agree on both sides of the interface, i.e., the
+ * quadrature points, the JxW values, and the normal vectors, are only
+ * computed on the first cell and are available through the functions of
+ * this class. The FEFaceValues objects for the second cell are set up
+ * without these update flags, and they should not be queried for these
+ * quantities. The normal vectors point from the first into the second
+ * cell.
+ *
+ * The arguments of the reinit() function that sets up both sides of an
+ * interior face are the same as the ones MeshWorker::mesh_loop() hands to
+ * its face worker, so that a DG face worker typically looks like this:
+ * @code
+ *   const auto face_worker = [&](const Iterator &   cell,
+ *                                const unsigned int f,
+ *                                const unsigned int sf,
+ *                                const Iterator &   ncell,
+ *                                const unsigned int nf,
+ *                                const unsigned int nsf,
+ *                                ScratchData &      scratch,
+ *                                CopyData &         copy) {
+ *     FEInterfaceValues<dim> &fe_iv = scratch.fe_interface_values;
+ *     fe_iv.reinit(cell, f, sf, ncell, nf, nsf);
+ *
+ *     const unsigned int n_dofs = fe_iv.n_current_interface_dofs();
+ *     copy.local_dof_indices    = fe_iv.get_interface_dof_indices();
+ *     copy.cell_matrix.reinit(n_dofs, n_dofs);
+ *
+ *     for (unsigned int q = 0; q < fe_iv.n_quadrature_points; ++q)
+ *       for (unsigned int i = 0; i < n_dofs; ++i)
+ *         for (unsigned int j = 0; j < n_dofs; ++j)
+ *           copy.cell_matrix(i, j) += penalty * fe_iv.jump(i, q) *
+ *                                     fe_iv.jump(j, q) * fe_iv.JxW(q);
+ *   };
+ * @endcode
+ * The boundary worker can use the reinit() function that only takes a cell
+ * and a face number.
+ *
+ * @ingroup feaccess
+ */
+template <int dim, int spacedim = dim>
+class FEInterfaceValues
+{
+public:
+  /**
+   * Number of quadrature points.
+   */
+  const unsigned int n_quadrature_points;
+
+  /**
+   * Construct the FEInterfaceValues with a single FiniteElement (same on
+   * both sides of the facet). The FEFaceValues objects will be initialized
+   * with the given @p mapping, @p quadrature, and @p update_flags.
+   */
+  FEInterfaceValues(const Mapping<dim, spacedim> &      mapping,
+                    const FiniteElement<dim, spacedim> &fe,
+                    const Quadrature<dim - 1> &         quadrature,
+                    const UpdateFlags                   update_flags);
+
+  /**
+   * Construct the FEInterfaceValues with a single FiniteElement and
+   * a Q1 Mapping.
+   *
+   * See the constructor above.
+   */
+  FEInterfaceValues(const FiniteElement<dim, spacedim> &fe,
+                    const Quadrature<dim - 1> &         quadrature,
+                    const UpdateFlags                   update_flags);
+
+  /**
+   * Re-initialize this object to be used on a new interface given by two
+   * faces of two neighboring cells. The `cell` and `cell_neighbor` cells
+   * will be referred to through `cell_index` zero and one after this call
+   * in all places where one needs to identify the two cells adjacent to
+   * the interface.
+   *
+   * Use numbers::invalid_unsigned_int for @p sub_face_no or @p
+   * sub_face_no_neighbor to indicate that you want to work on the entire
+   * face, not a sub-face.
+   *
+   * The arguments (including their order) are identical to the @p face_worker
+   * arguments in MeshWorker::mesh_loop().
+   *
+   * @param[in] cell An iterator to the first cell adjacent to the interface.
+   * @param[in] face_no An integer identifying which face of the first cell
+   *   the interface is on.
+   * @param[in] sub_face_no An integer identifying the subface (child) of the
+   *   face (identified by the previous two arguments) that the interface
+   *   corresponds to. If equal to numbers::invalid_unsigned_int, then the
+   *   interface is considered to be the entire face.
+   * @param[in] cell_neighbor An iterator to the second cell adjacent to
+   *   the interface. The type of this iterator does not have to equal that
+   *   of `cell`, but must be convertible to it. This allows using an
+   *   active cell iterator for `cell`, and `cell->neighbor(f)` for
+   *   `cell_neighbor`, since the return type of `cell->neighbor(f)` is
+   *   simply a cell iterator (not necessarily an active cell iterator).
+   * @param[in] face_no_neighbor Like `face_no`, just for the neighboring
+   *   cell.
+   * @param[in] sub_face_no_neighbor Like `sub_face_no`, just for the
+   *   neighboring cell.
+   */
+  template <class CellIteratorType>
+  void
+  reinit(const CellIteratorType &                         cell,
+         const unsigned int                               face_no,
+         const unsigned int                               sub_face_no,
+         const typename identity<CellIteratorType>::type &cell_neighbor,
+         const unsigned int                               face_no_neighbor,
+         const unsigned int                               sub_face_no_neighbor);
+
+  /**
+   * Re-initialize this object to be used on an interface given by a single
+   * face @p face_no of the cell @p cell. This is useful to use
+   * FEInterfaceValues on boundaries of the domain.
+   *
+   * As a consequence, members like jump() will assume a value of zero for
+   * the values on the "other" side. Note that no sub-face number is needed
+   * as such an interface can not be on a face that is further refined.
+   */
+  template <class CellIteratorType>
+  void
+  reinit(const CellIteratorType &cell, const unsigned int face_no);
+
+  /**
+   * Return a reference to the FEFaceValues or FESubfaceValues object
+   * of the specified cell of the interface.
+   *
+   * The @p cell_index is either 0 or 1 and corresponds to the cell index
+   * returned by interface_dof_to_cell_and_dof_index().
+   */
+  const FEFaceValuesBase<dim, spacedim> &
+  get_fe_face_values(const unsigned int cell_index) const;
+
+  /**
+   * Return a reference to the used mapping.
+   */
+  const Mapping<dim, spacedim> &
+  get_mapping() const;
+
+  /**
+   * Return a reference to the selected finite element object.
+   */
+  const FiniteElement<dim, spacedim> &
+  get_fe() const;
+
+  /**
+   * Return a reference to the quadrature object in use.
+   */
+  const Quadrature<dim - 1> &
+  get_quadrature() const;
+
+  /**
+   * Return the update flags set.
+   */
+  UpdateFlags
+  get_update_flags() const;
+
+  /**
+   * @name Functions to query information on a given interface
+   */
+  //@{
+
+  /**
+   * Return if the current interface is a boundary face or an internal
+   * face with two adjacent cells.
+   *
+   * See the corresponding reinit() functions for details.
+   */
+  bool
+  at_boundary() const;
+
+  /**
+   * Mapped quadrature weight. This value equals the
+   * mapped surface element times the weight of the quadrature
+   * point.
+   *
+   * You can think of the quantity returned by this function as the
+   * surface element $ds$ in the integral that we implement here by
+   * quadrature.
+   *
+   * @dealiiRequiresUpdateFlags{update_JxW_values}
+   */
+  double
+  JxW(const unsigned int quadrature_point) const;
+
+  /**
+   * Return the vector of JxW values for each quadrature point.
+   *
+   * @dealiiRequiresUpdateFlags{update_JxW_values}
+   */
+  const std::vector<double> &
+  get_JxW_values() const;
+
+  /**
+   * Return the normal vector of the interface in each quadrature point.
+   *
+   * The return value is identical to get_fe_face_values(0).get_normal_vectors()
+   * and therefore, are outside normal vectors from the perspective of the
+   * first cell of this interface.
+   *
+   * @dealiiRequiresUpdateFlags{update_normal_vectors}
+   */
+  const std::vector<Tensor<1, spacedim>> &
+  get_normal_vectors() const;
+
+  /**
+   * Return a reference to the quadrature points in real space.
+   *
+   * @dealiiRequiresUpdateFlags{update_quadrature_points}
+   */
+  const std::vector<Point<spacedim>> &
+  get_quadrature_points() const;
+
+  /**
+   * Return the number of DoFs (or shape functions) on the current interface.
+   *
+   * @note This number is only available after a call to reinit() and can
+   * change from one call to reinit() to the next. For example, on a boundary
+   * interface it is equal to the number of dofs of the single FEFaceValues
+   * object, while it is twice that for an interior interface for a DG
+   * element. For a continuous element, it is slightly smaller because the
+   * two cells on the interface share some of the dofs.
+   */
+  unsigned int
+  n_current_interface_dofs() const;
+
+  /**
+   * Return the set of joint DoF indices. This includes indices from both
+   * cells. If reinit was called with an active cell iterator, the indices
+   * are based on the active indices (returned by
+   * DoFCellAccessor::get_dof_indices() ), in case of level cell (that is, if
+   * is_level_cell() return true ) the mg dof indices are returned.
+   *
+   * @note This function is only available after a call to reinit() and can
+   * change from one call to reinit() to the next.
+   */
+  const std::vector<types::global_dof_index> &
+  get_interface_dof_indices() const;
+
+  /**
+   * Convert an interface dof index into the corresponding local DoF indices
+   * of the two cells. If an interface DoF is only active on one of the
+   * cells, the other index will be numbers::invalid_unsigned_int.
+   *
+   * For discontinuous finite elements each interface dof will correspond to
+   * exactly one DoF index.
+   *
+   * @note This function is only available after a call to reinit() and can
+   * change from one call to reinit() to the next.
+   */
+  std::array<unsigned int, 2>
+  interface_dof_to_dof_indices(const unsigned int interface_dof_index) const;
+
+  /**
+   * Return the normal in a given quadrature point.
+   *
+   * The normal points in outwards direction as seen from the first cell of
+   * this interface.
+   *
+   * @dealiiRequiresUpdateFlags{update_normal_vectors}
+   */
+  Tensor<1, spacedim>
+  normal(const unsigned int q_point_index) const;
+
+  //@}
+
+  /**
+   * @name Functions to evaluate data of the shape functions
+   */
+  //@{
+
+  /**
+   * Return component @p component of the value of the shape function
+   * with interface dof index @p interface_dof_index in
+   * quadrature point @p q_point.
+   *
+   * The argument @p here_or_there selects between the value on cell 0 (here,
+   * @p true) and cell 1 (there, @p false). You can also interpret it as
+   * "upstream" (@p true) and "downstream" (@p false) as defined by the
+   * direction of the normal vector in this quadrature point. If
+   * @p here_or_there is true, the shape functions from the first cell of the
+   * interface is used.
+   *
+   * In other words, this function returns the limit of the value of the
+   * shape function in the given quadrature point when approaching it from
+   * one of the two cells of the interface.
+   *
+   * @note This function is typically used to pick the upstream or downstream
+   * value based on a direction. This can be achieved by using
+   * <code>(direction * normal)>0</code> as the first argument of this
+   * function.
+   *
+   * @dealiiRequiresUpdateFlags{update_values}
+   */
+  double
+  shape_value(const bool         here_or_there,
+              const unsigned int interface_dof_index,
+              const unsigned int q_point,
+              const unsigned int component = 0) const;
+
+  //@}
+
+  /**
+   * @name Functions to evaluate jumps and averages of shape functions
+   */
+  //@{
+
+  /**
+   * Return the jump $\jump{u}=u_{\text{cell0}} - u_{\text{cell1}}$ on the
+   * interface for the shape function @p interface_dof_index at the
+   * quadrature point @p q_point of component @p component.
+   *
+   * Note that one can define the jump in different ways (the value "there"
+   * minus the value "here", or the other way around; both are used in the
+   * finite element literature). The definition here uses "value here minus
+   * value there", as seen from the first cell.
+   *
+   * If this is a boundary face (at_boundary() returns true), then
+   * $\jump{u}=u_{\text{cell0}}$.
+   *
+   * @dealiiRequiresUpdateFlags{update_values}
+   */
+  double
+  jump(const unsigned int interface_dof_index,
+       const unsigned int q_point,
+       const unsigned int component = 0) const;
+
+  /**
+   * Return the average $\average{u}=\frac{1}{2}u_{\text{cell0}} +
+   * \frac{1}{2}u_{\text{cell1}}$ on the interface for the shape function @p
+   * interface_dof_index at the quadrature point @p q_point of component @p
+   * component.
+   *
+   * If this is a boundary face (at_boundary() returns true), then
+   * $\average{u}=u_{\text{cell0}}$.
+   *
+   * @dealiiRequiresUpdateFlags{update_values}
+   */
+  double
+  average(const unsigned int interface_dof_index,
+          const unsigned int q_point,
+          const unsigned int component = 0) const;
+
+  /**
+   * Return the average of the gradient $\average{\nabla u}$ on the interface
+   * for the shape function @p interface_dof_index at the quadrature point @p
+   * q_point of component @p component.
+   *
+   * If this is a boundary face (at_boundary() returns true), then
+   * $\average{\nabla u}=\nabla u_{\text{cell0}}$.
+   *
+   * @dealiiRequiresUpdateFlags{update_gradients}
+   */
+  Tensor<1, spacedim>
+  average_gradient(const unsigned int interface_dof_index,
+                   const unsigned int q_point,
+                   const unsigned int component = 0) const;
+
+  /**
+   * Return the jump of the gradient $\jump{\nabla u}$ on the interface for
+   * the shape function @p interface_dof_index at the quadrature point @p
+   * q_point of component @p component.
+   *
+   * If this is a boundary face (at_boundary() returns true), then
+   * $\jump{\nabla u}=\nabla u_{\text{cell0}}$.
+   *
+   * @dealiiRequiresUpdateFlags{update_gradients}
+   */
+  Tensor<1, spacedim>
+  jump_gradient(const unsigned int interface_dof_index,
+                const unsigned int q_point,
+                const unsigned int component = 0) const;
+
+  /**
+   * Return the average of the Hessian $\average{\nabla^2 u} =
+   * \frac{1}{2}\nabla^2 u_{\text{cell0}} + \frac{1}{2} \nabla^2
+   * u_{\text{cell1}}$ on the interface
+   * for the shape function @p interface_dof_index at the quadrature point @p
+   * q_point of component @p component.
+   *
+   * If this is a boundary face (at_boundary() returns true), then
+   * $\average{\nabla^2 u}=\nabla^2 u_{\text{cell0}}$.
+   *
+   * @dealiiRequiresUpdateFlags{update_hessians}
+   */
+  Tensor<2, spacedim>
+  average_hessian(const unsigned int interface_dof_index,
+                  const unsigned int q_point,
+                  const unsigned int component = 0) const;
+
+  /**
+   * Return the jump in the Hessian $\jump{\nabla^2 u} = \nabla^2
+   * u_{\text{cell0}} - \nabla^2 u_{\text{cell1}}$ on the interface for the
+   * shape function
+   * @p interface_dof_index at the quadrature point @p q_point of component
+   * @p component.
+   *
+   * If this is a boundary face (at_boundary() returns true), then
+   * $\jump{\nabla^2 u} = \nabla^2 u_{\text{cell0}}$.
+   *
+   * @dealiiRequiresUpdateFlags{update_hessians}
+   */
+  Tensor<2, spacedim>
+  jump_hessian(const unsigned int interface_dof_index,
+               const unsigned int q_point,
+               const unsigned int component = 0) const;
+
+  //@}
+
+private:
+  /**
+   * Set up interface_dof_indices and dofmap from the dof indices of the
+   * cells handed to reinit(). The cells share degrees of freedom only if
+   * the finite element has degrees of freedom on faces; otherwise, the
+   * lookup of shared indices is skipped.
+   */
+  void
+  setup_interface_dofs(const bool interior_face);
+
+  /**
+   * The list of DoF indices for the current interface, filled in reinit().
+   */
+  std::vector<types::global_dof_index> interface_dof_indices;
+
+  /**
+   * The mapping from interface dof to the two local dof indices of the
+   * FeFaceValues objects. If an interface DoF is only active on one of the
+   * cells, the other one will have numbers::invalid_unsigned_int.
+   */
+  std::vector<std::array<unsigned int, 2>> dofmap;
+
+  /**
+   * The dof indices of the two cells, and the sorted pairs of global and
+   * local dof indices of the first cell used to find the shared dofs. These
+   * are members to avoid allocating memory on every call to reinit().
+   */
+  std::vector<types::global_dof_index> dof_indices_here, dof_indices_there;
+
+  /**
+   * See above.
+   */
+  std::vector<std::pair<types::global_dof_index, unsigned int>>
+    sorted_dof_indices_here;
+
+  /**
+   * The FEFaceValues object for the current cell.
+   */
+  FEFaceValues<dim, spacedim> internal_fe_face_values;
+
+  /**
+   * The FEFaceValues object for the current cell if the cell is refined.
+   */
+  FESubfaceValues<dim, spacedim> internal_fe_subface_values;
+
+  /**
+   * The FEFaceValues object for the neighboring cell. It does not compute
+   * the quadrature points, JxW values, and normal vectors that are taken
+   * from the current cell.
+   */
+  FEFaceValues<dim, spacedim> internal_fe_face_values_neighbor;
+
+  /**
+   * The FEFaceValues object for the neighboring cell if the cell is refined.
+   */
+  FESubfaceValues<dim, spacedim> internal_fe_subface_values_neighbor;
+
+  /**
+   * Pointer to internal_fe_face_values or internal_fe_subface_values,
+   * respectively as determined in reinit().
+   */
+  FEFaceValuesBase<dim, spacedim> *fe_face_values;
+
+  /**
+   * Pointer to internal_fe_face_values_neighbor,
+   * internal_fe_subface_values_neighbor, or nullptr, respectively
+   * as determined in reinit().
+   */
+  FEFaceValuesBase<dim, spacedim> *fe_face_values_neighbor;
+};
+
+
+
+#ifndef DOXYGEN
+
+/*---------------------- Inline functions ---------------------*/
+
+namespace internal
+{
+  namespace FEInterfaceValuesImplementation
+  {
+    /**
+     * Return the update flags for the FEFaceValues objects of the
+     * neighboring cell: the quantities that are the same on both sides of
+     * the interface are only computed on the first cell.
+     */
+    inline UpdateFlags
+    neighbor_update_flags(const UpdateFlags update_flags)
+    {
+      return update_flags &
+             static_cast<UpdateFlags>(
+               ~(update_quadrature_points | update_JxW_values |
+                 update_normal_vectors | update_boundary_forms));
+    }
+  } // namespace FEInterfaceValuesImplementation
+} // namespace internal
+
+
+
+template <int dim, int spacedim>
+FEInterfaceValues<dim, spacedim>::FEInterfaceValues(
+  const Mapping<dim, spacedim> &      mapping,
+  const FiniteElement<dim, spacedim> &fe,
+  const Quadrature<dim - 1> &         quadrature,
+  const UpdateFlags                   update_flags)
+  : n_quadrature_points(quadrature.size())
+  , internal_fe_face_values(mapping, fe, quadrature, update_flags)
+  , internal_fe_subface_values(mapping, fe, quadrature, update_flags)
+  , internal_fe_face_values_neighbor(
+      mapping,
+      fe,
+      quadrature,
+      internal::FEInterfaceValuesImplementation::neighbor_update_flags(
+        update_flags))
+  , internal_fe_subface_values_neighbor(
+      mapping,
+      fe,
+      quadrature,
+      internal::FEInterfaceValuesImplementation::neighbor_update_flags(
+        update_flags))
+  , fe_face_values(nullptr)
+  , fe_face_values_neighbor(nullptr)
+{}
+
+
+
+template <int dim, int spacedim>
+FEInterfaceValues<dim, spacedim>::FEInterfaceValues(
+  const FiniteElement<dim, spacedim> &fe,
+  const Quadrature<dim - 1> &         quadrature,
+  const UpdateFlags                   update_flags)
+  : FEInterfaceValues(StaticMappingQ1<dim, spacedim>::mapping,
+                      fe,
+                      quadrature,
+                      update_flags)
+{}
+
+
+
+template <int dim, int spacedim>
+template <class CellIteratorType>
+void
+FEInterfaceValues<dim, spacedim>::reinit(
+  const CellIteratorType &                         cell,
+  const unsigned int                               face_no,
+  const unsigned int                               sub_face_no,
+  const typename identity<CellIteratorType>::type &cell_neighbor,
+  const unsigned int                               face_no_neighbor,
+  const unsigned int                               sub_face_no_neighbor)
+{
+  if (sub_face_no == numbers::invalid_unsigned_int)
+    {
+      internal_fe_face_values.reinit(cell, face_no);
+      fe_face_values = &internal_fe_face_values;
+    }
+  else
+    {
+      internal_fe_subface_values.reinit(cell, face_no, sub_face_no);
+      fe_face_values = &internal_fe_subface_values;
+    }
+  if (sub_face_no_neighbor == numbers::invalid_unsigned_int)
+    {
+      internal_fe_face_values_neighbor.reinit(cell_neighbor, face_no_neighbor);
+      fe_face_values_neighbor = &internal_fe_face_values_neighbor;
+    }
+  else
+    {
+      internal_fe_subface_values_neighbor.reinit(cell_neighbor,
+                                                 face_no_neighbor,
+                                                 sub_face_no_neighbor);
+      fe_face_values_neighbor = &internal_fe_subface_values_neighbor;
+    }
+
+  dof_indices_here.resize(fe_face_values->get_fe().dofs_per_cell);
+  cell->get_active_or_mg_dof_indices(dof_indices_here);
+  dof_indices_there.resize(fe_face_values_neighbor->get_fe().dofs_per_cell);
+  cell_neighbor->get_active_or_mg_dof_indices(dof_indices_there);
+
+  setup_interface_dofs(true);
+}
+
+
+
+template <int dim, int spacedim>
+template <class CellIteratorType>
+void
+FEInterfaceValues<dim, spacedim>::reinit(const CellIteratorType &cell,
+                                         const unsigned int      face_no)
+{
+  internal_fe_face_values.reinit(cell, face_no);
+  fe_face_values          = &internal_fe_face_values;
+  fe_face_values_neighbor = nullptr;
+
+  dof_indices_here.resize(fe_face_values->get_fe().dofs_per_cell);
+  cell->get_active_or_mg_dof_indices(dof_indices_here);
+
+  setup_interface_dofs(false);
+}
+
+
+
+template <int dim, int spacedim>
+void
+FEInterfaceValues<dim, spacedim>::setup_interface_dofs(
+  const bool interior_face)
+{
+  const unsigned int n_dofs_here = dof_indices_here.size();
+
+  interface_dof_indices.assign(dof_indices_here.begin(),
+                               dof_indices_here.end());
+  dofmap.resize(n_dofs_here);
+  for (unsigned int i = 0; i < n_dofs_here; ++i)
+    dofmap[i] = {{i, numbers::invalid_unsigned_int}};
+
+  if (interior_face == false)
+    return;
+
+  // the two cells can only share degrees of freedom if the elements have
+  // degrees of freedom on their faces. otherwise, the dofs of the neighbor
+  // are simply appended
+  const bool may_share_dofs =
+    fe_face_values->get_fe().dofs_per_face > 0 &&
+    fe_face_values_neighbor->get_fe().dofs_per_face > 0;
+
+  if (may_share_dofs)
+    {
+      sorted_dof_indices_here.resize(n_dofs_here);
+      for (unsigned int i = 0; i < n_dofs_here; ++i)
+        sorted_dof_indices_here[i] = std::make_pair(dof_indices_here[i], i);
+      std::sort(sorted_dof_indices_here.begin(),
+                sorted_dof_indices_here.end());
+    }
+
+  for (unsigned int i = 0; i < dof_indices_there.size(); ++i)
+    {
+      if (may_share_dofs)
+        {
+          const auto shared_dof = std::lower_bound(
+            sorted_dof_indices_here.begin(),
+            sorted_dof_indices_here.end(),
+            std::make_pair(dof_indices_there[i], 0U));
+          if (shared_dof != sorted_dof_indices_here.end() &&
+              shared_dof->first == dof_indices_there[i])
+            {
+              dofmap[shared_dof->second][1] = i;
+              continue;
+            }
+        }
+
+      interface_dof_indices.push_back(dof_indices_there[i]);
+      dofmap.push_back({{numbers::invalid_unsigned_int, i}});
+    }
+}
+
+
+
+template <int dim, int spacedim>
+inline unsigned int
+FEInterfaceValues<dim, spacedim>::n_current_interface_dofs() const
+{
+  Assert(
+    interface_dof_indices.size() > 0,
+    ExcMessage(
+      "n_current_interface_dofs() is only available after a call to reinit()."));
+  return interface_dof_indices.size();
+}
+
+
+
+template <int dim, int spacedim>
+inline bool
+FEInterfaceValues<dim, spacedim>::at_boundary() const
+{
+  return fe_face_values_neighbor == nullptr;
+}
+
+
+
+template <int dim, int spacedim>
+inline double
+FEInterfaceValues<dim, spacedim>::JxW(const unsigned int q) const
+{
+  Assert(fe_face_values != nullptr,
+         ExcMessage("This call requires a call to reinit() first."));
+  return fe_face_values->JxW(q);
+}
+
+
+
+template <int dim, int spacedim>
+inline const std::vector<double> &
+FEInterfaceValues<dim, spacedim>::get_JxW_values() const
+{
+  Assert(fe_face_values != nullptr,
+         ExcMessage("This call requires a call to reinit() first."));
+  return fe_face_values->get_JxW_values();
+}
+
+
+
+template <int dim, int spacedim>
+inline const std::vector<Tensor<1, spacedim>> &
+FEInterfaceValues<dim, spacedim>::get_normal_vectors() const
+{
+  Assert(fe_face_values != nullptr,
+         ExcMessage("This call requires a call to reinit() first."));
+  return fe_face_values->get_normal_vectors();
+}
+
+
+
+template <int dim, int spacedim>
+inline const Mapping<dim, spacedim> &
+FEInterfaceValues<dim, spacedim>::get_mapping() const
+{
+  return internal_fe_face_values.get_mapping();
+}
+
+
+
+template <int dim, int spacedim>
+inline const FiniteElement<dim, spacedim> &
+FEInterfaceValues<dim, spacedim>::get_fe() const
+{
+  return internal_fe_face_values.get_fe();
+}
+
+
+
+template <int dim, int spacedim>
+inline const Quadrature<dim - 1> &
+FEInterfaceValues<dim, spacedim>::get_quadrature() const
+{
+  return internal_fe_face_values.get_quadrature();
+}
+
+
+
+template <int dim, int spacedim>
+inline const std::vector<Point<spacedim>> &
+FEInterfaceValues<dim, spacedim>::get_quadrature_points() const
+{
+  Assert(fe_face_values != nullptr,
+         ExcMessage("This call requires a call to reinit() first."));
+  return fe_face_values->get_quadrature_points();
+}
+
+
+
+template <int dim, int spacedim>
+inline UpdateFlags
+FEInterfaceValues<dim, spacedim>::get_update_flags() const
+{
+  return internal_fe_face_values.get_update_flags();
+}
+
+
+
+template <int dim, int spacedim>
+inline const std::vector<types::global_dof_index> &
+FEInterfaceValues<dim, spacedim>::get_interface_dof_indices() const
+{
+  return interface_dof_indices;
+}
+
+
+
+template <int dim, int spacedim>
+inline std::array<unsigned int, 2>
+FEInterfaceValues<dim, spacedim>::interface_dof_to_dof_indices(
+  const unsigned int interface_dof_index) const
+{
+  AssertIndexRange(interface_dof_index, dofmap.size());
+  return dofmap[interface_dof_index];
+}
+
+
+
+template <int dim, int spacedim>
+inline const FEFaceValuesBase<dim, spacedim> &
+FEInterfaceValues<dim, spacedim>::get_fe_face_values(
+  const unsigned int cell_index) const
+{
+  AssertIndexRange(cell_index, 2);
+  Assert(
+    cell_index == 0 || !at_boundary(),
+    ExcMessage(
+      "You are on a boundary, so you can only ask for the first FEFaceValues object."));
+
+  return (cell_index == 0) ? *fe_face_values : *fe_face_values_neighbor;
+}
+
+
+
+template <int dim, int spacedim>
+Tensor<1, spacedim>
+FEInterfaceValues<dim, spacedim>::normal(const unsigned int q_point_index) const
+{
+  return fe_face_values->normal_vector(q_point_index);
+}
+
+
+
+template <int dim, int spacedim>
+double
+FEInterfaceValues<dim, spacedim>::shape_value(
+  const bool         here_or_there,
+  const unsigned int interface_dof_index,
+  const unsigned int q_point,
+  const unsigned int component) const
+{
+  const auto dof_pair = dofmap[interface_dof_index];
+
+  if (here_or_there && dof_pair[0] != numbers::invalid_unsigned_int)
+    return get_fe_face_values(0).shape_value_component(dof_pair[0],
+                                                       q_point,
+                                                       component);
+  if (!here_or_there && dof_pair[1] != numbers::invalid_unsigned_int)
+    return get_fe_face_values(1).shape_value_component(dof_pair[1],
+                                                       q_point,
+                                                       component);
+
+  return 0.0;
+}
+
+
+
+template <int dim, int spacedim>
+double
+FEInterfaceValues<dim, spacedim>::jump(const unsigned int interface_dof_index,
+                                       const unsigned int q_point,
+                                       const unsigned int component) const
+{
+  const auto dof_pair = dofmap[interface_dof_index];
+
+  double value = 0.0;
+
+  if (dof_pair[0] != numbers::invalid_unsigned_int)
+    value += get_fe_face_values(0).shape_value_component(dof_pair[0],
+                                                         q_point,
+                                                         component);
+  if (dof_pair[1] != numbers::invalid_unsigned_int)
+    value -= get_fe_face_values(1).shape_value_component(dof_pair[1],
+                                                         q_point,
+                                                         component);
+  return value;
+}
+
+
+
+template <int dim, int spacedim>
+double
+FEInterfaceValues<dim, spacedim>::average(
+  const unsigned int interface_dof_index,
+  const unsigned int q_point,
+  const unsigned int component) const
+{
+  const auto dof_pair = dofmap[interface_dof_index];
+
+  if (at_boundary())
+    return get_fe_face_values(0).shape_value_component(dof_pair[0],
+                                                       q_point,
+                                                       component);
+
+  double value = 0.0;
+
+  if (dof_pair[0] != numbers::invalid_unsigned_int)
+    value += 0.5 * get_fe_face_values(0).shape_value_component(dof_pair[0],
+                                                               q_point,
+                                                               component);
+  if (dof_pair[1] != numbers::invalid_unsigned_int)
+    value += 0.5 * get_fe_face_values(1).shape_value_component(dof_pair[1],
+                                                               q_point,
+                                                               component);
+
+  return value;
+}
+
+
+
+template <int dim, int spacedim>
+Tensor<1, spacedim>
+FEInterfaceValues<dim, spacedim>::average_gradient(
+  const unsigned int interface_dof_index,
+  const unsigned int q_point,
+  const unsigned int component) const
+{
+  const auto dof_pair = dofmap[interface_dof_index];
+
+  if (at_boundary())
+    return get_fe_face_values(0).shape_grad_component(dof_pair[0],
+                                                      q_point,
+                                                      component);
+
+  Tensor<1, spacedim> value;
+
+  if (dof_pair[0] != numbers::invalid_unsigned_int)
+    value += 0.5 * get_fe_face_values(0).shape_grad_component(dof_pair[0],
+                                                              q_point,
+                                                              component);
+  if (dof_pair[1] != numbers::invalid_unsigned_int)
+    value += 0.5 * get_fe_face_values(1).shape_grad_component(dof_pair[1],
+                                                              q_point,
+                                                              component);
+
+  return value;
+}
+
+
+
+template <int dim, int spacedim>
+Tensor<1, spacedim>
+FEInterfaceValues<dim, spacedim>::jump_gradient(
+  const unsigned int interface_dof_index,
+  const unsigned int q_point,
+  const unsigned int component) const
+{
+  const auto dof_pair = dofmap[interface_dof_index];
+
+  if (at_boundary())
+    return get_fe_face_values(0).shape_grad_component(dof_pair[0],
+                                                      q_point,
+                                                      component);
+
+  Tensor<1, spacedim> value;
+
+  if (dof_pair[0] != numbers::invalid_unsigned_int)
+    value += get_fe_face_values(0).shape_grad_component(dof_pair[0],
+                                                        q_point,
+                                                        component);
+  if (dof_pair[1] != numbers::invalid_unsigned_int)
+    value -= get_fe_face_values(1).shape_grad_component(dof_pair[1],
+                                                        q_point,
+                                                        component);
+
+  return value;
+}
+
+
+
+template <int dim, int spacedim>
+Tensor<2, spacedim>
+FEInterfaceValues<dim, spacedim>::average_hessian(
+  const unsigned int interface_dof_index,
+  const unsigned int q_point,
+  const unsigned int component) const
+{
+  const auto dof_pair = dofmap[interface_dof_index];
+
+  if (at_boundary())
+    return get_fe_face_values(0).shape_hessian_component(dof_pair[0],
+                                                         q_point,
+                                                         component);
+
+  Tensor<2, spacedim> value;
+
+  if (dof_pair[0] != numbers::invalid_unsigned_int)
+    value += 0.5 * get_fe_face_values(0).shape_hessian_component(dof_pair[0],
+                                                                 q_point,
+                                                                 component);
+  if (dof_pair[1] != numbers::invalid_unsigned_int)
+    value += 0.5 * get_fe_face_values(1).shape_hessian_component(dof_pair[1],
+                                                                 q_point,
+                                                                 component);
+
+  return value;
+}
+
+
+
+template <int dim, int spacedim>
+Tensor<2, spacedim>
+FEInterfaceValues<dim, spacedim>::jump_hessian(
+  const unsigned int interface_dof_index,
+  const unsigned int q_point,
+  const unsigned int component) const
+{
+  const auto dof_pair = dofmap[interface_dof_index];
+
+  if (at_boundary())
+    return get_fe_face_values(0).shape_hessian_component(dof_pair[0],
+                                                         q_point,
+                                                         component);
+
+  Tensor<2, spacedim> value;
+
+  if (dof_pair[0] != numbers::invalid_unsigned_int)
+    value += get_fe_face_values(0).shape_hessian_component(dof_pair[0],
+                                                           q_point,
+                                                           component);
+  if (dof_pair[1] != numbers::invalid_unsigned_int)
+    value -= get_fe_face_values(1).shape_hessian_component(dof_pair[1],
+                                                           q_point,
+                                                           component);
+
+  return value;
+}
+
+#endif // DOXYGEN
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
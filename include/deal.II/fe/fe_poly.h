@@ -17,13 +17,63 @@
 #define dealii_fe_poly_h
 
 
+#include <deal.II/base/polynomial_space.h>
 #include <deal.II/base/quadrature.h>
 #include <deal.II/base/std_cxx14/memory.h>
+#include <deal.II/base/table.h>
+#include <deal.II/base/tensor_product_polynomials.h>
 
 #include <deal.II/fe/fe.h>
+#include <deal.II/fe/fe_tools.h>
 
 DEAL_II_NAMESPACE_OPEN
 
+namespace internal
+{
+  /**
+   * Compute the values and gradients of all polynomials of @p poly_space in
+   * all @p points at once, if the type of polynomial space provides such a
+   * function, and return whether this was the case. The general version
+   * returns false, in which case the caller evaluates the polynomials one
+   * point at a time. This is also the case for classes derived from
+   * TensorProductPolynomials or PolynomialSpace, which may evaluate their
+   * polynomials differently.
+   */
+  template <class PolynomialType, int dim>
+  inline bool
+  compute_values_and_gradients_batched(const PolynomialType &,
+                                       const std::vector<Point<dim>> &,
+                                       Table<2, double> &,
+                                       Table<2, Tensor<1, dim>> &)
+  {
+    return false;
+  }
+
+  template <int dim, typename PolynomialType>
+  inline bool
+  compute_values_and_gradients_batched(
+    const TensorProductPolynomials<dim, PolynomialType> &poly_space,
+    const std::vector<Point<dim>> &                      points,
+    Table<2, double> &                                   values,
+    Table<2, Tensor<1, dim>> &                           grads)
+  {
+    poly_space.compute(points, values, grads);
+    return true;
+  }
+
+  template <int dim>
+  inline bool
+  compute_values_and_gradients_batched(
+    const PolynomialSpace<dim> &   poly_space,
+    const std::vector<Point<dim>> &points,
+    Table<2, double> &             values,
+    Table<2, Tensor<1, dim>> &     grads)
+  {
+    poly_space.compute(points, values, grads);
+    return true;
+  }
+} // namespace internal
+
 /*!@addtogroup febase */
 /*@{*/
 
@@ -250,97 +300,102 @@ protected:
 
     const unsigned int n_q_points = quadrature.size();
 
-    // initialize some scratch arrays. we need them for the underlying
-    // polynomial to put the values and derivatives of shape functions
-    // to put there, depending on what the user requested
-    std::vector<double> values(
-      update_flags & update_values ? this->dofs_per_cell : 0);
-    std::vector<Tensor<1, dim>> grads(
-      update_flags & update_gradients ? this->dofs_per_cell : 0);
-    std::vector<Tensor<2, dim>> grad_grads(
-      update_flags & update_hessians ? this->dofs_per_cell : 0);
-    std::vector<Tensor<3, dim>> third_derivatives(
-      update_flags & update_3rd_derivatives ? this->dofs_per_cell : 0);
-    std::vector<Tensor<4, dim>>
-      fourth_derivatives; // won't be needed, so leave empty
-
-    // now also initialize fields the fields of this class's own
-    // temporary storage, depending on what we need for the given
-    // update flags.
-    //
-    // there is one exception from the rule: if we are dealing with
-    // cells (i.e., if this function is not called via
-    // get_(sub)face_data()), then we can already store things in the
-    // final location where FEValues::reinit() later wants to see
-    // things. we then don't need the intermediate space. we determine
-    // whether we are on a cell by asking whether the number of
-    // elements in the output array equals the number of quadrature
-    // points (yes, it's a cell) or not (because in that case the
-    // number of quadrature points we use here equals the number of
-    // quadrature points summed over *all* faces or subfaces, whereas
-    // the number of output slots equals the number of quadrature
-    // points on only *one* face)
+    // the values and derivatives of the shape functions in the quadrature
+    // points on the unit cell are the same for all objects created for
+    // this element, quadrature, and update flags, so get them from the
+    // cache shared with all of these objects. only compute them if they
+    // are not there yet
+    data.shape_tables = FETools::get_shared_shape_tables<dim, spacedim>(
+      *this,
+      quadrature,
+      update_flags,
+      [&](FETools::ShapeTables<dim> &tables) {
+        if (update_flags & update_values)
+          tables.values.reinit(this->dofs_per_cell, n_q_points);
+
+        if (update_flags & update_gradients)
+          tables.gradients.reinit(this->dofs_per_cell, n_q_points);
+
+        if (update_flags & update_hessians)
+          tables.hessians.reinit(this->dofs_per_cell, n_q_points);
+
+        if (update_flags & update_3rd_derivatives)
+          tables.third_derivatives.reinit(this->dofs_per_cell, n_q_points);
+
+        // if only values and gradients are requested, let the polynomial
+        // space evaluate all quadrature points at once if it can do so
+        if (!(update_flags & (update_hessians | update_3rd_derivatives)) &&
+            internal::compute_values_and_gradients_batched(
+              poly_space,
+              quadrature.get_points(),
+              tables.values,
+              tables.gradients))
+          return;
+
+        // initialize some scratch arrays. we need them for the underlying
+        // polynomial to put the values and derivatives of shape functions
+        // to put there, depending on what the user requested
+        std::vector<double> values(
+          update_flags & update_values ? this->dofs_per_cell : 0);
+        std::vector<Tensor<1, dim>> grads(
+          update_flags & update_gradients ? this->dofs_per_cell : 0);
+        std::vector<Tensor<2, dim>> grad_grads(
+          update_flags & update_hessians ? this->dofs_per_cell : 0);
+        std::vector<Tensor<3, dim>> third_derivatives(
+          update_flags & update_3rd_derivatives ? this->dofs_per_cell : 0);
+        std::vector<Tensor<4, dim>>
+          fourth_derivatives; // won't be needed, so leave empty
+
+        // note that the shape gradients are only those on the unit cell,
+        // and need to be transformed when visiting an actual cell
+        if (update_flags & (update_values | update_gradients |
+                            update_hessians | update_3rd_derivatives))
+          for (unsigned int i = 0; i < n_q_points; ++i)
+            {
+              poly_space.compute(quadrature.point(i),
+                                 values,
+                                 grads,
+                                 grad_grads,
+                                 third_derivatives,
+                                 fourth_derivatives);
+
+              if (update_flags & update_values)
+                for (unsigned int k = 0; k < this->dofs_per_cell; ++k)
+                  tables.values[k][i] = values[k];
+
+              if (update_flags & update_gradients)
+                for (unsigned int k = 0; k < this->dofs_per_cell; ++k)
+                  tables.gradients[k][i] = grads[k];
+
+              if (update_flags & update_hessians)
+                for (unsigned int k = 0; k < this->dofs_per_cell; ++k)
+                  tables.hessians[k][i] = grad_grads[k];
+
+              if (update_flags & update_3rd_derivatives)
+                for (unsigned int k = 0; k < this->dofs_per_cell; ++k)
+                  tables.third_derivatives[k][i] = third_derivatives[k];
+            }
+      });
+
+    // the values of shape functions at quadrature points don't change.
+    // consequently, write these values right into the output array if we
+    // can, i.e., if the output array has the correct size. this is the
+    // case on cells (i.e., if this function is not called via
+    // get_(sub)face_data()). we determine whether we are on a cell by
+    // asking whether the number of elements in the output array equals
+    // the number of quadrature points (yes, it's a cell) or not (because
+    // in that case the number of quadrature points we use here equals the
+    // number of quadrature points summed over *all* faces or subfaces,
+    // whereas the number of output slots equals the number of quadrature
+    // points on only *one* face). on faces, fill_fe_face_values() later
+    // copies only a portion of the shared values into the output object
     if ((update_flags & update_values) &&
-        !((output_data.shape_values.n_rows() > 0) &&
-          (output_data.shape_values.n_cols() == n_q_points)))
-      data.shape_values.reinit(this->dofs_per_cell, n_q_points);
-
-    if (update_flags & update_gradients)
-      data.shape_gradients.reinit(this->dofs_per_cell, n_q_points);
-
-    if (update_flags & update_hessians)
-      data.shape_hessians.reinit(this->dofs_per_cell, n_q_points);
-
-    if (update_flags & update_3rd_derivatives)
-      data.shape_3rd_derivatives.reinit(this->dofs_per_cell, n_q_points);
-
-    // next already fill those fields of which we have information by
-    // now. note that the shape gradients are only those on the unit
-    // cell, and need to be transformed when visiting an actual cell
-    if (update_flags & (update_values | update_gradients | update_hessians |
-                        update_3rd_derivatives))
-      for (unsigned int i = 0; i < n_q_points; ++i)
-        {
-          poly_space.compute(quadrature.point(i),
-                             values,
-                             grads,
-                             grad_grads,
-                             third_derivatives,
-                             fourth_derivatives);
-
-          // the values of shape functions at quadrature points don't change.
-          // consequently, write these values right into the output array if
-          // we can, i.e., if the output array has the correct size. this is
-          // the case on cells. on faces, we already precompute data on *all*
-          // faces and subfaces, but we later on copy only a portion of it
-          // into the output object; in that case, copy the data from all
-          // faces into the scratch object
-          if (update_flags & update_values)
-            if (output_data.shape_values.n_rows() > 0)
-              {
-                if (output_data.shape_values.n_cols() == n_q_points)
-                  for (unsigned int k = 0; k < this->dofs_per_cell; ++k)
-                    output_data.shape_values[k][i] = values[k];
-                else
-                  for (unsigned int k = 0; k < this->dofs_per_cell; ++k)
-                    data.shape_values[k][i] = values[k];
-              }
-
-          // for everything else, derivatives need to be transformed,
-          // so we write them into our scratch space and only later
-          // copy stuff into where FEValues wants it
-          if (update_flags & update_gradients)
-            for (unsigned int k = 0; k < this->dofs_per_cell; ++k)
-              data.shape_gradients[k][i] = grads[k];
-
-          if (update_flags & update_hessians)
-            for (unsigned int k = 0; k < this->dofs_per_cell; ++k)
-              data.shape_hessians[k][i] = grad_grads[k];
-
-          if (update_flags & update_3rd_derivatives)
-            for (unsigned int k = 0; k < this->dofs_per_cell; ++k)
-              data.shape_3rd_derivatives[k][i] = third_derivatives[k];
-        }
+        (output_data.shape_values.n_rows() > 0) &&
+        (output_data.shape_values.n_cols() == n_q_points))
+      for (unsigned int k = 0; k < this->dofs_per_cell; ++k)
+        for (unsigned int i = 0; i < n_q_points; ++i)
+          output_data.shape_values[k][i] = data.shape_tables->values[k][i];
+
     return data_ptr;
   }
 
@@ -400,48 +455,21 @@ protected:
   {
   public:
     /**
-     * Array with shape function values in quadrature points. There is one row
-     * for each shape function, containing values for each quadrature point.
-     *
-     * In this array, we store the values of the shape function in the
-     * quadrature points on the unit cell. Since these values do not change
-     * under transformation to the real cell, we only need to copy them over
-     * when visiting a concrete cell.
-     */
-    Table<2, double> shape_values;
-
-    /**
-     * Array with shape function gradients in quadrature points. There is one
-     * row for each shape function, containing values for each quadrature
-     * point.
-     *
-     * We store the gradients in the quadrature points on the unit cell. We
-     * then only have to apply the transformation (which is a matrix-vector
-     * multiplication) when visiting an actual cell.
-     */
-    Table<2, Tensor<1, dim>> shape_gradients;
-
-    /**
-     * Array with shape function hessians in quadrature points. There is one
-     * row for each shape function, containing values for each quadrature
-     * point.
+     * Tables with the values, gradients, hessians, and third derivatives of
+     * the shape functions in the quadrature points on the unit cell, as far
+     * as they were requested. There is one row for each shape function,
+     * containing values for each quadrature point.
      *
-     * We store the hessians in the quadrature points on the unit cell. We
-     * then only have to apply the transformation when visiting an actual
-     * cell.
-     */
-    Table<2, Tensor<2, dim>> shape_hessians;
-
-    /**
-     * Array with shape function third derivatives in quadrature points. There
-     * is one row for each shape function, containing values for each
-     * quadrature point.
+     * Since the values of the shape functions do not change under
+     * transformation to the real cell, we only need to copy them over when
+     * visiting a concrete cell. For the derivatives, we then only have to
+     * apply the transformation.
      *
-     * We store the third derivatives in the quadrature points on the unit
-     * cell. We then only have to apply the transformation when visiting an
-     * actual cell.
+     * The tables are shared with all other objects created for an element of
+     * the same type and name, the same quadrature formula, and the same
+     * update flags, see FETools::get_shared_shape_tables().
      */
-    Table<2, Tensor<3, dim>> shape_3rd_derivatives;
+    std::shared_ptr<const FETools::ShapeTables<dim>> shape_tables;
   };
 
   /**
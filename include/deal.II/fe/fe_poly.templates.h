@@ -244,6 +244,7 @@ FE_Poly<PolynomialType, dim, spacedim>::fill_fe_values(
   Assert(dynamic_cast<const InternalData *>(&fe_internal) != nullptr,
          ExcInternalError());
   const InternalData &fe_data = static_cast<const InternalData &>(fe_internal);
+  const FETools::ShapeTables<dim> &shape_tables = *fe_data.shape_tables;
 
   const UpdateFlags flags(fe_data.update_each);
 
@@ -253,7 +254,7 @@ FE_Poly<PolynomialType, dim, spacedim>::fill_fe_values(
   if (flags & update_gradients &&
       cell_similarity != CellSimilarity::translation)
     for (unsigned int k = 0; k < this->dofs_per_cell; ++k)
-      mapping.transform(make_array_view(fe_data.shape_gradients, k),
+      mapping.transform(make_array_view(shape_tables.gradients, k),
                         mapping_covariant,
                         mapping_internal,
                         make_array_view(output_data.shape_gradients, k));
@@ -261,7 +262,7 @@ FE_Poly<PolynomialType, dim, spacedim>::fill_fe_values(
   if (flags & update_hessians && cell_similarity != CellSimilarity::translation)
     {
       for (unsigned int k = 0; k < this->dofs_per_cell; ++k)
-        mapping.transform(make_array_view(fe_data.shape_hessians, k),
+        mapping.transform(make_array_view(shape_tables.hessians, k),
                           mapping_covariant_gradient,
                           mapping_internal,
                           make_array_view(output_data.shape_hessians, k));
@@ -278,7 +279,7 @@ FE_Poly<PolynomialType, dim, spacedim>::fill_fe_values(
       cell_similarity != CellSimilarity::translation)
     {
       for (unsigned int k = 0; k < this->dofs_per_cell; ++k)
-        mapping.transform(make_array_view(fe_data.shape_3rd_derivatives, k),
+        mapping.transform(make_array_view(shape_tables.third_derivatives, k),
                           mapping_covariant_hessian,
                           mapping_internal,
                           make_array_view(output_data.shape_3rd_derivatives,
@@ -317,6 +318,7 @@ FE_Poly<PolynomialType, dim, spacedim>::fill_fe_face_values(
   Assert(dynamic_cast<const InternalData *>(&fe_internal) != nullptr,
          ExcInternalError());
   const InternalData &fe_data = static_cast<const InternalData &>(fe_internal);
+  const FETools::ShapeTables<dim> &shape_tables = *fe_data.shape_tables;
 
   // offset determines which data set
   // to take (all data sets for all
@@ -337,12 +339,12 @@ FE_Poly<PolynomialType, dim, spacedim>::fill_fe_face_values(
   if (flags & update_values)
     for (unsigned int k = 0; k < this->dofs_per_cell; ++k)
       for (unsigned int i = 0; i < quadrature.size(); ++i)
-        output_data.shape_values(k, i) = fe_data.shape_values[k][i + offset];
+        output_data.shape_values(k, i) = shape_tables.values[k][i + offset];
 
   if (flags & update_gradients)
     for (unsigned int k = 0; k < this->dofs_per_cell; ++k)
       mapping.transform(
-        make_array_view(fe_data.shape_gradients, k, offset, quadrature.size()),
+        make_array_view(shape_tables.gradients, k, offset, quadrature.size()),
         mapping_covariant,
         mapping_internal,
         make_array_view(output_data.shape_gradients, k));
@@ -351,7 +353,7 @@ FE_Poly<PolynomialType, dim, spacedim>::fill_fe_face_values(
     {
       for (unsigned int k = 0; k < this->dofs_per_cell; ++k)
         mapping.transform(
-          make_array_view(fe_data.shape_hessians, k, offset, quadrature.size()),
+          make_array_view(shape_tables.hessians, k, offset, quadrature.size()),
           mapping_covariant_gradient,
           mapping_internal,
           make_array_view(output_data.shape_hessians, k));
@@ -367,7 +369,7 @@ FE_Poly<PolynomialType, dim, spacedim>::fill_fe_face_values(
   if (flags & update_3rd_derivatives)
     {
       for (unsigned int k = 0; k < this->dofs_per_cell; ++k)
-        mapping.transform(make_array_view(fe_data.shape_3rd_derivatives,
+        mapping.transform(make_array_view(shape_tables.third_derivatives,
                                           k,
                                           offset,
                                           quadrature.size()),
@@ -410,6 +412,7 @@ FE_Poly<PolynomialType, dim, spacedim>::fill_fe_subface_values(
   Assert(dynamic_cast<const InternalData *>(&fe_internal) != nullptr,
          ExcInternalError());
   const InternalData &fe_data = static_cast<const InternalData &>(fe_internal);
+  const FETools::ShapeTables<dim> &shape_tables = *fe_data.shape_tables;
 
   // offset determines which data set
   // to take (all data sets for all
@@ -432,12 +435,12 @@ FE_Poly<PolynomialType, dim, spacedim>::fill_fe_subface_values(
   if (flags & update_values)
     for (unsigned int k = 0; k < this->dofs_per_cell; ++k)
       for (unsigned int i = 0; i < quadrature.size(); ++i)
-        output_data.shape_values(k, i) = fe_data.shape_values[k][i + offset];
+        output_data.shape_values(k, i) = shape_tables.values[k][i + offset];
 
   if (flags & update_gradients)
     for (unsigned int k = 0; k < this->dofs_per_cell; ++k)
       mapping.transform(
-        make_array_view(fe_data.shape_gradients, k, offset, quadrature.size()),
+        make_array_view(shape_tables.gradients, k, offset, quadrature.size()),
         mapping_covariant,
         mapping_internal,
         make_array_view(output_data.shape_gradients, k));
@@ -446,7 +449,7 @@ FE_Poly<PolynomialType, dim, spacedim>::fill_fe_subface_values(
     {
       for (unsigned int k = 0; k < this->dofs_per_cell; ++k)
         mapping.transform(
-          make_array_view(fe_data.shape_hessians, k, offset, quadrature.size()),
+          make_array_view(shape_tables.hessians, k, offset, quadrature.size()),
           mapping_covariant_gradient,
           mapping_internal,
           make_array_view(output_data.shape_hessians, k));
@@ -462,7 +465,7 @@ FE_Poly<PolynomialType, dim, spacedim>::fill_fe_subface_values(
   if (flags & update_3rd_derivatives)
     {
       for (unsigned int k = 0; k < this->dofs_per_cell; ++k)
-        mapping.transform(make_array_view(fe_data.shape_3rd_derivatives,
+        mapping.transform(make_array_view(shape_tables.third_derivatives,
                                           k,
                                           offset,
                                           quadrature.size()),
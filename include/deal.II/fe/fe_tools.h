@@ -25,14 +25,18 @@
 #include <deal.II/base/std_cxx14/memory.h>
 #include <deal.II/base/subscriptor.h>
 #include <deal.II/base/symmetric_tensor.h>
+#include <deal.II/base/table.h>
 #include <deal.II/base/tensor.h>
 
 #include <deal.II/distributed/tria.h>
 
 #include <deal.II/fe/component_mask.h>
+#include <deal.II/fe/fe_update_flags.h>
 
 #include <deal.II/lac/la_parallel_vector.h>
 
+#include <functional>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -1347,6 +1351,120 @@ namespace FETools
   add_fe_name(const std::string &                 name,
               const FEFactoryBase<dim, spacedim> *factory);
 
+  /**
+   * Return a finite element object for the given @p name from a process-wide
+   * cache of finite elements. When the function is called for the first time
+   * with a given name, the element is created with get_fe_by_name() and
+   * stored in the cache; later calls with the same name, or with the name
+   * returned by FiniteElement::get_name() for this element, return a pointer
+   * to the same object.
+   *
+   * The point of this function is to avoid the cost of constructing
+   * expensive elements, such as FE_Q objects of high degree in 3D or systems
+   * of them, as well as the memory of several copies of the same element, in
+   * programs that set up many solver objects with the same element. Since
+   * the finite element classes compute their interface constraints in the
+   * constructor and the prolongation and restriction matrices upon first
+   * request (in a thread-safe way), all users of the returned object share
+   * these tables.
+   *
+   * @note The cache is secured by a lock, so this function may be called
+   * concurrently from several threads. Note that the cache exists once for
+   * each combination of @p dim and @p spacedim. The elements are kept alive
+   * until the end of the program or until clear_shared_fe_cache() is called.
+   */
+  template <int dim, int spacedim = dim>
+  std::shared_ptr<const FiniteElement<dim, spacedim>>
+  get_shared_fe_by_name(const std::string &name);
+
+  /**
+   * Same as get_shared_fe_by_name(), but look up the element by the name
+   * returned by <code>fe.get_name()</code>. If no element of this name is in
+   * the cache yet, a copy of @p fe is stored. This function hence assumes
+   * that elements with equal names are identical.
+   */
+  template <int dim, int spacedim>
+  std::shared_ptr<const FiniteElement<dim, spacedim>>
+  get_shared_fe(const FiniteElement<dim, spacedim> &fe);
+
+  /**
+   * Remove all elements from the cache used by get_shared_fe_by_name() and
+   * get_shared_fe() for the given dimensions. Objects still referenced
+   * elsewhere stay alive until the last pointer to them is released.
+   */
+  template <int dim, int spacedim = dim>
+  void
+  clear_shared_fe_cache();
+
+  /**
+   * The values and derivatives of the shape functions of a finite element in
+   * the points of a quadrature formula on the reference cell, as returned by
+   * get_shared_shape_tables(). Each table has one row for each shape
+   * function and one column for each quadrature point. Tables that were not
+   * requested are empty.
+   */
+  template <int dim>
+  struct ShapeTables
+  {
+    /**
+     * The values of the shape functions.
+     */
+    Table<2, double> values;
+
+    /**
+     * The gradients of the shape functions.
+     */
+    Table<2, Tensor<1, dim>> gradients;
+
+    /**
+     * The second derivatives of the shape functions.
+     */
+    Table<2, Tensor<2, dim>> hessians;
+
+    /**
+     * The third derivatives of the shape functions.
+     */
+    Table<2, Tensor<3, dim>> third_derivatives;
+  };
+
+  /**
+   * Return the values and derivatives of the shape functions of @p fe in the
+   * points of @p quadrature on the reference cell, as far as they are
+   * requested by the @p update_flags update_values, update_gradients,
+   * update_hessians, and update_3rd_derivatives.
+   *
+   * The tables are shared between all users that ask for them with an
+   * element of the same type and name, an equal quadrature formula, and the
+   * same flags. If such tables are still in use somewhere, the function
+   * returns a pointer to them. Otherwise, it creates new tables, fills them
+   * by calling @p compute_tables, and remembers them for later requests.
+   * The finite element classes call this function when they set up the
+   * data for an FEValues object, so that the many FEValues objects that
+   * are, for example, created for the threads of a WorkStream::run() loop
+   * compute and store the tables only once.
+   *
+   * The cache only holds weak references to the tables, i.e., the tables
+   * are released as soon as the last user releases them. This way, the
+   * cache does not grow when FEValues objects are created for many
+   * different quadrature formulas, as done when evaluating finite element
+   * functions at arbitrary points.
+   *
+   * @note The cache is secured by a lock, so this function may be called
+   * concurrently from several threads. The lock is not held while
+   * @p compute_tables runs; if several threads ask for the same new tables at
+   * the same time, each of them may compute them, but all of them get the
+   * object that was stored first. The function assumes that elements of
+   * the same type and with the same name, as returned by
+   * FiniteElement::get_name(), have the same shape functions.
+   */
+  template <int dim, int spacedim>
+  std::shared_ptr<const ShapeTables<dim>>
+  get_shared_shape_tables(
+    const FiniteElement<dim, spacedim> &                   fe,
+    const Quadrature<dim> &                                quadrature,
+    const UpdateFlags                                      update_flags,
+    const std::function<void(ShapeTables<dim> &tables)> &compute_tables);
+
   /**
    * The string used for get_fe_by_name() cannot be translated to a finite
    * element.
@@ -63,9 +63,12 @@
 #include <deal.II/lac/full_matrix.h>
 #include <deal.II/lac/householder.h>
 
+#include <algorithm>
 #include <cctype>
 #include <iostream>
 #include <memory>
+#include <tuple>
+#include <typeindex>
 
 
 DEAL_II_NAMESPACE_OPEN
@@ -2783,6 +2786,190 @@ namespace FETools
 
 
 
+  namespace internal
+  {
+    namespace FEToolsSharedFEHelper
+    {
+      // the cache used by FETools::get_shared_fe_by_name and
+      // FETools::get_shared_fe, together with the lock that protects it. As
+      // the map holds elements of one pair dim/spacedim, there is one
+      // object for each instantiation of this function
+      template <int dim, int spacedim>
+      std::pair<
+        Threads::Mutex,
+        std::map<std::string,
+                 std::shared_ptr<const FiniteElement<dim, spacedim>>>> &
+      get_shared_fe_map()
+      {
+        static std::pair<
+          Threads::Mutex,
+          std::map<std::string,
+                   std::shared_ptr<const FiniteElement<dim, spacedim>>>>
+          shared_fe_map;
+        return shared_fe_map;
+      }
+
+
+
+      // the cache used by FETools::get_shared_shape_tables, together with
+      // the lock that protects it. the tables are looked up by the type and
+      // the name of the element, the update flags, and the number of
+      // quadrature points, and then by comparing the quadrature formulas
+      template <int dim, int spacedim>
+      std::pair<
+        Threads::Mutex,
+        std::map<std::tuple<std::type_index, std::string, UpdateFlags,
+                            unsigned int>,
+                 std::vector<
+                   std::pair<Quadrature<dim>,
+                             std::weak_ptr<const ShapeTables<dim>>>>>> &
+      get_shape_tables_map()
+      {
+        static std::pair<
+          Threads::Mutex,
+          std::map<
+            std::tuple<std::type_index, std::string, UpdateFlags, unsigned int>,
+            std::vector<std::pair<Quadrature<dim>,
+                                  std::weak_ptr<const ShapeTables<dim>>>>>>
+          shape_tables_map;
+        return shape_tables_map;
+      }
+    } // namespace FEToolsSharedFEHelper
+  }   // namespace internal
+
+
+
+  template <int dim, int spacedim>
+  std::shared_ptr<const FiniteElement<dim, spacedim>>
+  get_shared_fe_by_name(const std::string &name)
+  {
+    auto &cache =
+      internal::FEToolsSharedFEHelper::get_shared_fe_map<dim, spacedim>();
+
+    // keep the lock while creating the element, such that several threads
+    // asking for the same new element do not create it more than once
+    std::lock_guard<std::mutex> lock(cache.first);
+
+    const auto entry = cache.second.find(name);
+    if (entry != cache.second.end())
+      return entry->second;
+
+    std::shared_ptr<const FiniteElement<dim, spacedim>> fe =
+      get_fe_by_name<dim, spacedim>(name);
+
+    // also make the element available under its canonical name, unless an
+    // element of that name exists already
+    const auto inserted = cache.second.emplace(fe->get_name(), fe);
+    if (inserted.second == false)
+      fe = inserted.first->second;
+    cache.second[name] = fe;
+
+    return fe;
+  }
+
+
+
+  template <int dim, int spacedim>
+  std::shared_ptr<const FiniteElement<dim, spacedim>>
+  get_shared_fe(const FiniteElement<dim, spacedim> &fe)
+  {
+    auto &cache =
+      internal::FEToolsSharedFEHelper::get_shared_fe_map<dim, spacedim>();
+    std::lock_guard<std::mutex> lock(cache.first);
+
+    std::shared_ptr<const FiniteElement<dim, spacedim>> &entry =
+      cache.second[fe.get_name()];
+    if (entry.get() == nullptr)
+      entry = fe.clone();
+
+    return entry;
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  clear_shared_fe_cache()
+  {
+    auto &cache =
+      internal::FEToolsSharedFEHelper::get_shared_fe_map<dim, spacedim>();
+    std::lock_guard<std::mutex> lock(cache.first);
+    cache.second.clear();
+  }
+
+
+
+  template <int dim, int spacedim>
+  std::shared_ptr<const ShapeTables<dim>>
+  get_shared_shape_tables(
+    const FiniteElement<dim, spacedim> &                   fe,
+    const Quadrature<dim> &                                quadrature,
+    const UpdateFlags                                      update_flags,
+    const std::function<void(ShapeTables<dim> &tables)> &compute_tables)
+  {
+    auto &cache =
+      internal::FEToolsSharedFEHelper::get_shape_tables_map<dim, spacedim>();
+
+    // only these flags determine which tables are computed
+    const UpdateFlags table_flags =
+      update_flags & (update_values | update_gradients | update_hessians |
+                      update_3rd_derivatives);
+    const auto key = std::make_tuple(std::type_index(typeid(fe)),
+                                     fe.get_name(),
+                                     table_flags,
+                                     quadrature.size());
+
+    {
+      std::lock_guard<std::mutex> lock(cache.first);
+      const auto entry = cache.second.find(key);
+      if (entry != cache.second.end())
+        for (const auto &tables : entry->second)
+          if (tables.first == quadrature)
+            if (std::shared_ptr<const ShapeTables<dim>> shared_tables =
+                  tables.second.lock())
+              return shared_tables;
+    }
+
+    // compute the tables without holding the lock. allocate them separately
+    // from the reference count, such that their memory is released as soon
+    // as the last user is gone even though the cache still refers to them
+    std::shared_ptr<ShapeTables<dim>> new_tables(new ShapeTables<dim>());
+    compute_tables(*new_tables);
+
+    std::lock_guard<std::mutex> lock(cache.first);
+
+    // remove the tables that are not used any more
+    for (auto entry = cache.second.begin(); entry != cache.second.end();)
+      {
+        entry->second.erase(
+          std::remove_if(
+            entry->second.begin(),
+            entry->second.end(),
+            [](const std::pair<Quadrature<dim>,
+                               std::weak_ptr<const ShapeTables<dim>>> &tables) {
+              return tables.second.expired();
+            }),
+          entry->second.end());
+        if (entry->second.empty())
+          entry = cache.second.erase(entry);
+        else
+          ++entry;
+      }
+
+    // another thread might have stored the same tables in the meantime
+    auto &entry = cache.second[key];
+    for (const auto &tables : entry)
+      if (tables.first == quadrature)
+        if (std::shared_ptr<const ShapeTables<dim>> shared_tables =
+              tables.second.lock())
+          return shared_tables;
+
+    entry.emplace_back(quadrature, new_tables);
+    return new_tables;
+  }
+
+
+
   template <int dim, int spacedim>
   void
   compute_projection_from_quadrature_points_matrix(
@@ -58,6 +58,12 @@ class FEValuesBase;
 
 namespace internal
 {
+  namespace FEValuesImplementation
+  {
+    template <int dim>
+    class TensorProductEvaluator;
+  }
+
   /**
    * A class whose specialization is used to define what type the curl of a
    * vector valued function corresponds to.
@@ -526,6 +532,17 @@ namespace FEValuesViews
                     third_derivative_type> &third_derivatives) const;
 
 
+    /**
+     * Return the indices of the shape functions that are nonzero in at least
+     * one of the components selected by this view, in ascending order. This
+     * list is computed once when the view is created. For an FESystem with
+     * many components, assembly loops that only involve this view can run
+     * over these indices rather than over all shape functions of the cell,
+     * which skips the shape functions of the other components.
+     */
+    const std::vector<unsigned int> &
+    get_nonzero_shape_function_indices() const;
+
   private:
     /**
      * A pointer to the FEValuesBase object we operate on.
@@ -542,6 +559,12 @@ namespace FEValuesViews
      * Store the data about shape functions.
      */
     std::vector<ShapeFunctionData> shape_function_data;
+
+    /**
+     * The indices of the shape functions that are nonzero in at least one of
+     * the components of this view, in ascending order.
+     */
+    std::vector<unsigned int> nonzero_shape_functions;
   };
 
 
@@ -1206,6 +1229,12 @@ namespace FEValuesViews
       std::vector<typename OutputType<typename InputVector::value_type>::
                     third_derivative_type> &third_derivatives) const;
 
+    /**
+     * @copydoc FEValuesViews::Scalar::get_nonzero_shape_function_indices()
+     */
+    const std::vector<unsigned int> &
+    get_nonzero_shape_function_indices() const;
+
   private:
     /**
      * A pointer to the FEValuesBase object we operate on.
@@ -1222,6 +1251,12 @@ namespace FEValuesViews
      * Store the data about shape functions.
      */
     std::vector<ShapeFunctionData> shape_function_data;
+
+    /**
+     * The indices of the shape functions that are nonzero in at least one of
+     * the components of this view, in ascending order.
+     */
+    std::vector<unsigned int> nonzero_shape_functions;
   };
 
 
@@ -1499,6 +1534,12 @@ namespace FEValuesViews
         typename OutputType<typename InputVector::value_type>::divergence_type>
         &divergences) const;
 
+    /**
+     * @copydoc FEValuesViews::Scalar::get_nonzero_shape_function_indices()
+     */
+    const std::vector<unsigned int> &
+    get_nonzero_shape_function_indices() const;
+
   private:
     /**
      * A pointer to the FEValuesBase object we operate on.
@@ -1515,6 +1556,12 @@ namespace FEValuesViews
      * Store the data about shape functions.
      */
     std::vector<ShapeFunctionData> shape_function_data;
+
+    /**
+     * The indices of the shape functions that are nonzero in at least one of
+     * the components of this view, in ascending order.
+     */
+    std::vector<unsigned int> nonzero_shape_functions;
   };
 
 
@@ -1846,6 +1893,12 @@ namespace FEValuesViews
         typename OutputType<typename InputVector::value_type>::gradient_type>
         &gradients) const;
 
+    /**
+     * @copydoc FEValuesViews::Scalar::get_nonzero_shape_function_indices()
+     */
+    const std::vector<unsigned int> &
+    get_nonzero_shape_function_indices() const;
+
   private:
     /**
      * A pointer to the FEValuesBase object we operate on.
@@ -1862,6 +1915,12 @@ namespace FEValuesViews
      * Store the data about shape functions.
      */
     std::vector<ShapeFunctionData> shape_function_data;
+
+    /**
+     * The indices of the shape functions that are nonzero in at least one of
+     * the components of this view, in ascending order.
+     */
+    std::vector<unsigned int> nonzero_shape_functions;
   };
 
 } // namespace FEValuesViews
@@ -3429,6 +3488,20 @@ protected:
                                                                      spacedim>
     finite_element_output;
 
+  /**
+   * An object that evaluates finite element functions in the quadrature
+   * points with sum factorization. It is set up by FEValues if the finite
+   * element is an FE_Q or FE_DGQ element of degree two or higher (or an
+   * FESystem made up of copies of a single such element) and the quadrature
+   * formula is the tensor product of identical one-dimensional formulas. The
+   * get_function_values() and get_function_gradients() functions then use it
+   * in place of a product with the full matrix of shape function values or
+   * gradients. Otherwise, this pointer is empty.
+   */
+  std::unique_ptr<
+    const internal::FEValuesImplementation::TensorProductEvaluator<dim>>
+    tensor_product_evaluator;
+
 
   /**
    * Original update flags handed to the constructor of FEValues.
@@ -3948,6 +4021,42 @@ private:
 
 namespace FEValuesViews
 {
+  template <int dim, int spacedim>
+  inline const std::vector<unsigned int> &
+  Scalar<dim, spacedim>::get_nonzero_shape_function_indices() const
+  {
+    return nonzero_shape_functions;
+  }
+
+
+
+  template <int dim, int spacedim>
+  inline const std::vector<unsigned int> &
+  Vector<dim, spacedim>::get_nonzero_shape_function_indices() const
+  {
+    return nonzero_shape_functions;
+  }
+
+
+
+  template <int dim, int spacedim>
+  inline const std::vector<unsigned int> &
+  SymmetricTensor<2, dim, spacedim>::get_nonzero_shape_function_indices() const
+  {
+    return nonzero_shape_functions;
+  }
+
+
+
+  template <int dim, int spacedim>
+  inline const std::vector<unsigned int> &
+  Tensor<2, dim, spacedim>::get_nonzero_shape_function_indices() const
+  {
+    return nonzero_shape_functions;
+  }
+
+
+
   template <int dim, int spacedim>
   inline typename Scalar<dim, spacedim>::value_type
   Scalar<dim, spacedim>::value(const unsigned int shape_function,
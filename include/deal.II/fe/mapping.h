@@ -456,6 +456,36 @@ public:
     const typename Triangulation<dim, spacedim>::cell_iterator &cell,
     const Point<spacedim> &                                     p) const = 0;
 
+  /**
+   * Map the points @p real_points on the real @p cell to the corresponding
+   * points on the unit cell, and store them in @p unit_points. The result is
+   * the same as calling transform_real_to_unit_cell() for each point, but
+   * derived classes can implement this function more efficiently by
+   * computing the data that only depends on the cell once and by treating
+   * several points at the same time. MappingQGeneric, for example, runs the
+   * Newton iteration for several points jointly on the lanes of a
+   * VectorizedArray.
+   *
+   * Unlike transform_real_to_unit_cell(), this function never throws an
+   * exception of type Mapping::ExcTransformationFailed. Rather, if the
+   * transformation fails for <tt>real_points[i]</tt>, the first coordinate
+   * of <tt>unit_points[i]</tt> is set to
+   * <tt>std::numeric_limits<double>::infinity()</tt>.
+   *
+   * The default implementation calls transform_real_to_unit_cell() for each
+   * point.
+   *
+   * @param cell Iterator to the cell that will be used to define the mapping.
+   * @param real_points Locations of the points on the given cell.
+   * @param unit_points Output: the reference cell locations of the points.
+   * Must have the same size as @p real_points.
+   */
+  virtual void
+  transform_points_real_to_unit_cell(
+    const typename Triangulation<dim, spacedim>::cell_iterator &cell,
+    const ArrayView<const Point<spacedim>> &                    real_points,
+    const ArrayView<Point<dim>> &unit_points) const;
+
   /**
    * Transform the point @p p on the real @p cell to the corresponding point
    * on the unit cell, and then projects it to a dim-1  point on the face with
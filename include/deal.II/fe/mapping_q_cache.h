@@ -19,10 +19,16 @@
 
 #include <deal.II/base/config.h>
 
+#include <deal.II/base/mg_level_object.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
 #include <deal.II/fe/mapping_q_generic.h>
 
 #include <deal.II/grid/tria.h>
 
+#include <functional>
+
 
 DEAL_II_NAMESPACE_OPEN
 
@@ -81,11 +87,76 @@ public:
    * cells (on all levels) of the given triangulation. Note that the cache is
    * invalidated upon the signal Triangulation::Signals::any_change of the
    * underlying triangulation.
+   *
+   * The support points of the cells are computed in parallel with the
+   * WorkStream framework.
    */
   void
   initialize(const Triangulation<dim, spacedim> &  triangulation,
              const MappingQGeneric<dim, spacedim> &mapping);
 
+  /**
+   * Initialize the data cache by calling the function @p compute_points_on_cell
+   * on all cells (on all levels) of the given triangulation. The function
+   * must return the positions of the mapping support points of the given
+   * cell, in the order used by MappingQGeneric, i.e., the vertices first,
+   * then the points on lines, quads, and hexes, with
+   * <code>Utilities::pow(this->get_degree()+1, dim)</code> points in total.
+   * The function is called from several threads in parallel, so it must be
+   * thread-safe.
+   *
+   * As for the other initialize() functions, the cache is invalidated upon
+   * the signal Triangulation::Signals::any_change of the underlying
+   * triangulation.
+   */
+  void
+  initialize(const Triangulation<dim, spacedim> &triangulation,
+             const std::function<std::vector<Point<spacedim>>(
+               const typename Triangulation<dim, spacedim>::cell_iterator &)>
+               &compute_points_on_cell);
+
+  /**
+   * Initialize the data cache with the support points of @p mapping, shifted
+   * by the displacement field described by @p displacement on the active
+   * cells of @p dof_handler. The finite element of @p dof_handler must have
+   * @p spacedim components, which are interpreted as the displacement in
+   * the respective coordinate direction, and is evaluated in the mapping
+   * support points of each cell. A typical use case is an
+   * arbitrary Lagrangian-Eulerian (ALE) method where the mesh is moved by a
+   * displacement field in every time step. The cells on coarser levels are
+   * filled with the support points of @p mapping without displacement. In
+   * parallel computations, the vector must have ghost values set on the
+   * locally relevant degrees of freedom. Artificial cells are not displaced.
+   *
+   * If this function (or the multigrid variant below) has been called before
+   * on the same triangulation and the triangulation has not changed in the
+   * meantime, the cache is updated incrementally: The support points are only
+   * re-computed on the cells where the local displacement values differ from
+   * the ones used in the previous call. This requires that @p mapping and the
+   * finite element of @p dof_handler are the same as in the previous call.
+   * Note that the update modifies the cache in place, so all objects created
+   * from this one via clone() see the new positions, too.
+   */
+  template <typename VectorType>
+  void
+  initialize(const MappingQGeneric<dim, spacedim> &mapping,
+             const DoFHandler<dim, spacedim> &     dof_handler,
+             const VectorType &                    displacement);
+
+  /**
+   * Same as above, but with the displacement field given on all levels of a
+   * multigrid hierarchy. The vector on level @p l is evaluated with the
+   * level degrees of freedom of @p dof_handler on all cells of that level,
+   * which requires that DoFHandler::distribute_mg_dofs() has been called. The
+   * cells on levels not present in @p displacement are filled with the
+   * support points of @p mapping without displacement.
+   */
+  template <typename VectorType>
+  void
+  initialize(const MappingQGeneric<dim, spacedim> &mapping,
+             const DoFHandler<dim, spacedim> &     dof_handler,
+             const MGLevelObject<VectorType> &     displacement);
+
   /**
    * Return the memory consumption (in bytes) of the cache.
    */
@@ -102,6 +173,20 @@ protected:
     const override;
 
 private:
+  /**
+   * Implementation of the two initialize() functions that take a DoFHandler
+   * argument. The function @p get_local_values fills the local displacement
+   * values of the given cell and returns @p false if the cell is not
+   * displaced.
+   */
+  void
+  initialize_with_displacement(
+    const MappingQGeneric<dim, spacedim> &mapping,
+    const DoFHandler<dim, spacedim> &     dof_handler,
+    const std::function<bool(
+      const typename Triangulation<dim, spacedim>::cell_iterator &,
+      std::vector<double> &)> &get_local_values);
+
   /**
    * The point cache filled upon calling initialize(). It is made a shared
    * pointer to allow several instances (created via clone()) to share this
@@ -110,6 +195,16 @@ private:
   std::shared_ptr<std::vector<std::vector<std::vector<Point<spacedim>>>>>
     support_point_cache;
 
+  /**
+   * The local displacement values of each cell used in the last call to one
+   * of the initialize() functions taking a DoFHandler, which allow to skip
+   * the cells whose displacement did not change upon the next call. An empty
+   * vector denotes a cell without displacement. The pointer is empty if the
+   * cache has been filled by another initialize() function.
+   */
+  std::shared_ptr<std::vector<std::vector<std::vector<double>>>>
+    displacement_cache;
+
   /**
    * The connection to Triangulation::signals::any that must be reset once
    * this class goes out of scope.
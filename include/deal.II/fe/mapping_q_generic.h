@@ -183,6 +183,27 @@ public:
     const typename Triangulation<dim, spacedim>::cell_iterator &cell,
     const Point<spacedim> &p) const override;
 
+  /**
+   * Transform the points @p real_points on the real @p cell to the unit
+   * cell. See Mapping::transform_points_real_to_unit_cell() for the
+   * semantics.
+   *
+   * For dim == spacedim, the mapping support points of the cell are computed
+   * only once for all points. If the cell is the image of the reference cell
+   * under an affine map, the points are transformed with the inverse of that
+   * map. For a $Q_1$ mapping in 2D, the explicit formula used by
+   * transform_real_to_unit_cell() is tried first. All other points are
+   * treated by a Newton iteration that runs on VectorizedArray lanes for
+   * several points at the same time, evaluating the tensor product
+   * polynomials of the mapping directly at the current iterates. For
+   * dim < spacedim, the implementation of the base class is used.
+   */
+  virtual void
+  transform_points_real_to_unit_cell(
+    const typename Triangulation<dim, spacedim>::cell_iterator &cell,
+    const ArrayView<const Point<spacedim>> &                    real_points,
+    const ArrayView<Point<dim>> &unit_points) const override;
+
   /**
    * @}
    */
@@ -263,7 +284,11 @@ public:
      *
      * The function also calls compute_shape_function_values() to actually set
      * the member variables related to the values and derivatives of the
-     * mapping shape functions.
+     * mapping shape functions. If the quadrature formula is a tensor product
+     * and the mapping is of degree two or higher, the quadrature points, the
+     * Jacobians, and their first derivatives are computed by sum
+     * factorization, and the tables of the values, first and second
+     * derivatives of the shape functions are not set up.
      */
     void
     initialize(const UpdateFlags      update_flags,
@@ -494,6 +519,40 @@ public:
      */
     bool tensor_product_quadrature;
 
+    /**
+     * Indicates whether the quadrature points, the Jacobians and their
+     * first derivatives on faces and subfaces are evaluated by sum
+     * factorization from the one-dimensional polynomials stored in @p
+     * polynomial_values_1d rather than from the shape function tables. This
+     * is set by initialize_face() for mappings of degree two and higher, in
+     * which case @p shape_values, @p shape_derivatives, and @p
+     * shape_second_derivatives are not allocated.
+     */
+    bool evaluate_from_1d_polynomials;
+
+    /**
+     * The values and the first and second derivatives of the one-dimensional
+     * Lagrange polynomials underlying the mapping, evaluated in each
+     * coordinate direction of each quadrature point. The derivative @p k of
+     * polynomial @p i in direction @p d at point @p q is stored at position
+     * ((q * dim + d) * (polynomial_degree + 1) + i) * 3 + k. Only filled if
+     * @p evaluate_from_1d_polynomials is set.
+     */
+    std::vector<double> polynomial_values_1d;
+
+    /**
+     * The hierarchic number of each mapping support point, in the
+     * lexicographic order used by the sum factorization. Only filled if @p
+     * evaluate_from_1d_polynomials is set.
+     */
+    std::vector<unsigned int> lexicographic_to_hierarchic;
+
+    /**
+     * Temporary storage for the sum factorization based on @p
+     * polynomial_values_1d.
+     */
+    mutable std::vector<Tensor<1, spacedim>> sum_factorization_scratch;
+
     /**
      * Tensors of covariant transformation at each of the quadrature points.
      * The matrix stored is the Jacobian * G^{-1}, where G = Jacobian^{t} *
@@ -536,6 +595,48 @@ public:
      * #update_volume_elements.
      */
     mutable std::vector<double> volume_elements;
+
+    /**
+     * The positions of the mapping support points on the reference cell, in
+     * the same order as in @p mapping_support_points. They are used to
+     * detect whether the mapping of a cell is affine.
+     */
+    std::vector<Point<dim>> unit_support_points;
+
+    /**
+     * Whether the mapping of the cell last passed to fill_fe_values() was
+     * found to be affine. In that case, its constant Jacobian is stored in
+     * @p affine_jacobian, and the Jacobians and derived quantities computed
+     * for that cell can be reused on the next cell if its Jacobian is
+     * exactly the same.
+     */
+    mutable bool affine_jacobian_is_current;
+
+    /**
+     * The Jacobian of the last cell passed to fill_fe_values() if
+     * @p affine_jacobian_is_current is set. For the objects used by
+     * fill_fe_face_values() and fill_fe_subface_values(), the Jacobian of
+     * @p cell_of_current_support_points if @p current_cell_is_affine is set.
+     */
+    mutable DerivativeForm<1, dim, spacedim> affine_jacobian;
+
+    /**
+     * Whether the mapping of @p cell_of_current_support_points is affine.
+     * This is determined once per cell by fill_fe_face_values() and
+     * fill_fe_subface_values() when the support points are computed, such
+     * that the faces of an affine cell can be evaluated from the constant
+     * Jacobian stored in @p affine_jacobian.
+     */
+    mutable bool current_cell_is_affine;
+
+    /**
+     * The quadrature points on all faces (or subfaces) of the reference cell
+     * and in all orientations, as computed by QProjector, in the order given
+     * by QProjector::DataSetDescriptor. They are used to compute the
+     * quadrature points on the faces of affine cells and are only filled for
+     * face and subface data if #update_quadrature_points is requested.
+     */
+    std::vector<Point<dim>> face_quadrature_points;
   };
 
 
@@ -732,6 +833,23 @@ protected:
     const typename Triangulation<dim, spacedim>::cell_iterator &cell,
     std::vector<Point<spacedim>> &                              a) const;
 
+  /**
+   * The part of fill_fe_values() for cells whose mapping is affine, i.e.,
+   * has the constant Jacobian @p jacobian. If the Jacobian is exactly the
+   * same as the one of the cell previously passed to fill_fe_values() with
+   * the same @p data, nothing but the quadrature points is computed and
+   * CellSimilarity::translation is returned.
+   */
+  CellSimilarity::Similarity
+  fill_fe_values_affine(
+    const typename Triangulation<dim, spacedim>::cell_iterator &cell,
+    const CellSimilarity::Similarity                            cell_similarity,
+    const DerivativeForm<1, dim, spacedim> &                    jacobian,
+    const Quadrature<dim> &                                     quadrature,
+    const InternalData &                                        data,
+    dealii::internal::FEValuesImplementation::MappingRelatedData<dim, spacedim>
+      &output_data) const;
+
   // Make MappingQ a friend since it needs to call the fill_fe_values()
   // functions on its MappingQGeneric(1) sub-object.
   template <int, int>
@@ -395,6 +395,12 @@ public:
    * The companion GridOut::write_vtk function can be used to write VTK files
    * compatible with this method.
    *
+   * Besides the ASCII variant, this function also reads the binary variant
+   * of the legacy VTK format, which stores all numbers in big endian byte
+   * order right after the line that describes them. Binary files are
+   * considerably faster to read for large meshes. The stream @p in should be
+   * opened in binary mode in this case.
+   *
    * @author Mayank Sabharwal, Andreas Putz, 2013
    * @author Luca Heltai, 2018
    */
@@ -484,6 +490,13 @@ public:
    * file format. The Gmsh formats are documented at
    * http://www.geuz.org/gmsh/.
    *
+   * Files in version 4.1 of the format may also be stored in Gmsh's binary
+   * variant (<tt>-bin</tt> option of Gmsh), which is considerably faster to
+   * read for large meshes since no numbers need to be converted from text.
+   * Binary files need to have been written on a machine with the same byte
+   * order as the one reading them. The stream @p in should be opened in
+   * binary mode in this case.
+   *
    * @note The input function of deal.II does not distinguish between newline
    * and other whitespace. Therefore, deal.II will be able to read files in a
    * slightly more general format than Gmsh.
@@ -1261,6 +1261,58 @@ namespace GridTools
                              cell_hint = typename Triangulation<dim, spacedim>::active_cell_iterator(),
     const std::vector<bool> &marked_vertices = {});
 
+  /**
+   * Find the active cells around many points at once, exploiting a guess
+   * for the cell around each of the points. This function is meant for
+   * points that only move a fraction of a cell between successive calls, as
+   * is the case for particles or for the points of a Lagrangian
+   * post-processing step, where the cell found in the previous step is an
+   * excellent guess for the current one.
+   *
+   * For each point, the function first checks the cell given in
+   * @p cell_hints, then the active face neighbors of that cell, and only if
+   * the point lies in none of these cells it falls back to the search done
+   * by find_active_cell_around_point(), which uses the vertex-to-cell
+   * information and the RTree of vertices stored in @p cache. The points
+   * are processed in groups sharing the same hint cell, and the points of
+   * each group are transformed to the reference coordinates of the hint
+   * cell with a single call to Mapping::transform_points_real_to_unit_cell(),
+   * such that the data of each cell is only computed once.
+   *
+   * @param[in] cache The triangulation's GridTools::Cache, which also
+   * provides the mapping used to compute reference coordinates.
+   * @param[in] points The points to be located.
+   * @param[in] cell_hints Either empty or a vector with one entry per point,
+   * containing a cell that likely contains that point. Invalid iterators
+   * (e.g., default-constructed ones) signal that no guess is available for a
+   * point. The cells returned by a previous call to this function are
+   * suitable hints.
+   * @param[in] tolerance The tolerance in reference coordinates used to
+   * decide whether a point lies inside a hint cell or one of its neighbors.
+   *
+   * @return A vector with one entry per point, containing the active cell
+   * around the point together with the reference coordinates of the point
+   * in that cell. Unlike the functions above, this function does not throw
+   * an exception if a point cannot be found in the mesh. Instead, the cell
+   * iterator returned for that point is invalid, i.e., its state() is not
+   * IteratorState::valid.
+   */
+  template <int dim, int spacedim>
+#  ifndef DOXYGEN
+  std::vector<
+    std::pair<typename Triangulation<dim, spacedim>::active_cell_iterator,
+              Point<dim>>>
+#  else
+  return_type
+#  endif
+  find_active_cells_around_points(
+    const Cache<dim, spacedim> &        cache,
+    const std::vector<Point<spacedim>> &points,
+    const std::vector<
+      typename Triangulation<dim, spacedim>::active_cell_iterator>
+      &          cell_hints = {},
+    const double tolerance  = 1e-10);
+
   /**
    * A variant of the previous find_active_cell_around_point() function that,
    * instead of returning only the first matching cell, identifies all cells
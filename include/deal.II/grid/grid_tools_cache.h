@@ -19,6 +19,7 @@
 
 #include <deal.II/base/config.h>
 
+#include <deal.II/base/bounding_box.h>
 #include <deal.II/base/exceptions.h>
 #include <deal.II/base/point.h>
 #include <deal.II/base/subscriptor.h>
@@ -36,6 +37,9 @@
 #include <boost/signals2.hpp>
 
 #include <cmath>
+#include <set>
+#include <utility>
+#include <vector>
 
 DEAL_II_NAMESPACE_OPEN
 
@@ -55,6 +59,19 @@ namespace GridTools
    * changed due to a Triangulation::Signals::any_change() signal being
    * triggered.
    *
+   * If the change is the result of
+   * Triangulation::execute_coarsening_and_refinement() and the mapping
+   * preserves vertex locations, the vertex to cell map, the map of used
+   * vertices, the RTree of the used vertices, and the RTree of the cell
+   * bounding boxes are not recomputed from scratch. Instead, the cache
+   * records which cells have been refined or coarsened (through the
+   * Triangulation::Signals::post_refinement_on_cell() and
+   * Triangulation::Signals::pre_coarsening_on_cell() signals), and only the
+   * entries associated with these cells and their vertices are updated the
+   * next time one of these objects is requested. The functions
+   * n_full_updates() and n_incremental_updates() allow checking which of
+   * the two paths has been taken.
+   *
    * If the triangulation changes for other reasons, for example because you
    * use it in conjunction with a MappingQEulerian object that sees the
    * vertices through its own transformation, or because you manually change
@@ -186,7 +203,57 @@ namespace GridTools
     get_vertex_kdtree() const;
 #endif
 
+    /**
+     * Return how many times one of the objects that support incremental
+     * updates (the vertex to cell map, the map of used vertices, and the
+     * RTrees of the used vertices and of the cell bounding boxes) has been
+     * computed from scratch since this object was created.
+     */
+    unsigned int
+    n_full_updates() const;
+
+    /**
+     * Return how many times the objects that support incremental updates
+     * have been brought up to date after a refinement step by only
+     * touching the entries of the refined and coarsened cells.
+     */
+    unsigned int
+    n_incremental_updates() const;
+
   private:
+    /**
+     * Return whether changes of the triangulation are recorded for an
+     * incremental update, i.e., whether at least one of the objects that
+     * support incremental updates is up to date and the mapping preserves
+     * vertex locations.
+     */
+    bool
+    records_changes() const;
+
+    /**
+     * Record that @p cell is about to be removed from the set of active
+     * cells. This function must be called while the cell and its
+     * vertices are still valid.
+     */
+    void
+    record_removed_cell(
+      const typename Triangulation<dim, spacedim>::cell_iterator &cell);
+
+    /**
+     * Record that @p cell has become active.
+     */
+    void
+    record_added_cell(
+      const typename Triangulation<dim, spacedim>::cell_iterator &cell);
+
+    /**
+     * Apply the changes recorded by record_removed_cell() and
+     * record_added_cell() to those objects that support incremental
+     * updates and are not marked for a full update anyway.
+     */
+    void
+    apply_recorded_changes() const;
+
     /**
      * Keep track of what needs to be updated next.
      */
@@ -252,9 +319,45 @@ namespace GridTools
       cell_bounding_boxes_rtree;
 
     /**
-     * Storage for the status of the triangulation signal.
+     * Level and index of the cells that have become active since the last
+     * call to apply_recorded_changes().
+     */
+    mutable std::set<std::pair<int, int>> added_cells;
+
+    /**
+     * Level and index of the cells that have been removed from the set of
+     * active cells since the last call to apply_recorded_changes().
+     */
+    mutable std::set<std::pair<int, int>> removed_cells;
+
+    /**
+     * The bounding boxes of those removed cells that are stored in
+     * cell_bounding_boxes_rtree, used to find their entries.
+     */
+    mutable std::vector<std::pair<BoundingBox<spacedim>, std::pair<int, int>>>
+      removed_cell_boxes;
+
+    /**
+     * The vertices of the removed cells.
+     */
+    mutable std::vector<unsigned int> affected_vertices;
+
+    /**
+     * Whether Triangulation::execute_coarsening_and_refinement() is
+     * currently running.
+     */
+    bool refinement_in_progress;
+
+    /**
+     * The counters returned by n_full_updates() and n_incremental_updates().
+     */
+    mutable unsigned int n_full_updates_counter;
+    mutable unsigned int n_incremental_updates_counter;
+
+    /**
+     * Storage for the status of the triangulation signals.
      */
-    boost::signals2::connection tria_signal;
+    std::vector<boost::signals2::connection> tria_signals;
   };
 
 
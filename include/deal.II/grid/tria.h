@@ -2082,6 +2082,12 @@ public:
    * distorted (see the extensive discussion on
    * @ref GlossDistorted "distorted cells").
    *
+   * @note The new objects are numbered exactly as if the cells were refined
+   * one after the other, but the locations of the new vertices are computed
+   * afterwards on several threads. The manifolds attached to the
+   * triangulation must therefore allow calling their functions for new
+   * points concurrently, as all manifolds in the library do.
+   *
    * @note This function is <tt>virtual</tt> to allow derived classes to
    * insert hooks, such as saving refinement flags and the like (see e.g. the
    * PersistentTriangulation class).
@@ -2246,6 +2252,9 @@ public:
      *
      * @note The signal parameter @p cell corresponds to the immediate parent
      * cell of a set of newly created active cells.
+     *
+     * @note The signal is triggered once all cells have been refined, for
+     * one cell after the other in the order in which they were refined.
      */
     boost::signals2::signal<void(
       const typename Triangulation<dim, spacedim>::cell_iterator &cell)>
@@ -3454,6 +3463,39 @@ public:
   void
   load(Archive &ar, const unsigned int version);
 
+  /**
+   * Write the same data as save() to the file @p filename, using the flat
+   * binary format described in the documentation of the FlatBinaryArchive
+   * namespace. In this format, the arrays that describe the cells and faces
+   * of all levels of the triangulation as well as its vertices are stored as
+   * contiguous blocks of memory, which load_flat_binary() can copy directly
+   * from the file mapped into memory. Reading a triangulation from such a
+   * file is therefore much faster than reading it from a BOOST archive, in
+   * particular for large meshes.
+   *
+   * The format is intended for checkpointing and restarting long running
+   * simulations on the same machine, not for the long-term storage of
+   * meshes: files can only be read by a deal.II installation that writes the
+   * same version of the format on a machine with the same byte order.
+   *
+   * @note Like save(), this function does not store the manifolds attached
+   * to the triangulation, and can not be used for
+   * parallel::distributed::Triangulation objects.
+   */
+  void
+  save_flat_binary(const std::string &filename) const;
+
+  /**
+   * Read a triangulation from a file written by save_flat_binary(). As for
+   * load(), the previous content of this object is thrown away, and the
+   * setting with regard to distorted cells must be the same as the one of
+   * the triangulation that was stored. An exception is thrown if the file
+   * does not contain a triangulation of the same dimensions written in the
+   * current version of the format.
+   */
+  void
+  load_flat_binary(const std::string &filename);
+
 
   /**
    * Declare the (coarse) face pairs given in the argument of this function as
@@ -18,6 +18,7 @@
 
 #include <deal.II/base/cuda_size.h>
 #include <deal.II/base/memory_consumption.h>
+#include <deal.II/base/parallel.h>
 #include <deal.II/base/table.h>
 #include <deal.II/base/thread_local_storage.h>
 
@@ -331,244 +332,260 @@ AffineConstraints<number>::close()
              ExcInternalError());
 
   // first, strip zero entries, as we have to do that only once
-  for (ConstraintLine &line : lines)
-    // first remove zero entries. that would mean that in the linear
-    // constraint for a node, x_i = ax_1 + bx_2 + ..., another node times 0
-    // appears. obviously, 0*something can be omitted
-    line.entries.erase(std::remove_if(line.entries.begin(),
-                                      line.entries.end(),
-                                      [](
-                                        const std::pair<size_type, number> &p) {
-                                        return p.second == number(0.);
-                                      }),
-                       line.entries.end());
-
-
-
-#ifdef DEBUG
-  // In debug mode we are computing an estimate for the maximum number
-  // of constraints so that we can bail out if there is a cycle in the
-  // constraints (which is easier than searching for cycles in the graph).
-  //
-  // Let us figure out the largest dof index. This is an upper bound for the
-  // number of constraints because it is an approximation for the number of dofs
-  // in our system.
-  size_type largest_idx = 0;
-  for (const ConstraintLine &line : lines)
-    for (const std::pair<size_type, number> &entry : line.entries)
-      largest_idx = std::max(largest_idx, entry.first);
-#endif
+  const auto strip_zero_entries = [&](const size_type begin,
+                                      const size_type end) {
+    for (size_type i = begin; i < end; ++i)
+      // first remove zero entries. that would mean that in the linear
+      // constraint for a node, x_i = ax_1 + bx_2 + ..., another node times 0
+      // appears. obviously, 0*something can be omitted
+      lines[i].entries.erase(
+        std::remove_if(lines[i].entries.begin(),
+                       lines[i].entries.end(),
+                       [](const std::pair<size_type, number> &p) {
+                         return p.second == number(0.);
+                       }),
+        lines[i].entries.end());
+  };
+  parallel::apply_to_subranges(size_type(0),
+                               static_cast<size_type>(lines.size()),
+                               strip_zero_entries,
+                               /*grainsize=*/1024);
+
+  // entries that refer to dofs which are themselves constrained need to be
+  // replaced by the constraint of that dof. ignore elements that we don't
+  // store on the current processor. make sure local_lines is compressed so
+  // that it can be queried from several threads
+  local_lines.compress();
+  const auto is_chained = [&](const size_type dof_index) -> bool {
+    return ((local_lines.size() == 0) || local_lines.is_element(dof_index)) &&
+           is_constrained(dof_index);
+  };
+  const auto constraint_line = [&](const size_type dof_index) -> size_type {
+    return lines_cache[calculate_line_index(dof_index)];
+  };
 
   // replace references to dofs that are themselves constrained. note that
   // because we may replace references to other dofs that may themselves be
-  // constrained to third ones, we have to iterate over all this until we
-  // replace no chains of constraints any more
+  // constrained to third ones, we have to resolve chains of constraints
   //
-  // the iteration replaces references to constrained degrees of freedom by
-  // second-order references. for example if x3=x0/2+x2/2 and x2=x0/2+x1/2,
-  // then the new list will be x3=x0/2+x0/4+x1/4. note that x0 appear
-  // twice. we will throw this duplicate out in the following step, where
-  // we sort the list so that throwing out duplicates becomes much more
-  // efficient. also, we have to do it only once, rather than in each
-  // iteration
-  size_type iteration = 0;
-  while (true)
-    {
-      bool chained_constraint_replaced = false;
+  // to this end, we first sort the lines into levels: a line is on level
+  // zero if none of its entries is constrained, and otherwise on the level
+  // one above the highest level of the lines its entries refer to. this is
+  // done by a depth-first search that also detects cycles in the
+  // constraints
+  std::vector<unsigned int> line_levels(lines.size(),
+                                        numbers::invalid_unsigned_int);
+  unsigned int              max_level = 0;
+  {
+    // the lines on the current search path, each with the next entry to
+    // look at
+    std::vector<std::pair<size_type, size_type>> path;
+    std::vector<bool>                            on_path(lines.size(), false);
+    for (size_type start = 0; start < lines.size(); ++start)
+      {
+        if (line_levels[start] != numbers::invalid_unsigned_int)
+          continue;
 
-      for (ConstraintLine &line : lines)
-        {
-#ifdef DEBUG
-          // we need to keep track of how many replacements we do in this line,
-          // because we can end up in a cycle A->B->C->A without the number of
-          // entries growing.
-          size_type n_replacements = 0;
-#endif
+        path.emplace_back(start, 0);
+        on_path[start] = true;
+        while (path.empty() == false)
+          {
+            const size_type       line_no = path.back().first;
+            size_type &           entry   = path.back().second;
+            const ConstraintLine &line    = lines[line_no];
+
+            // skip to the next entry that is constrained and whose level is
+            // not yet known
+            for (; entry < line.entries.size(); ++entry)
+              if (is_chained(line.entries[entry].first))
+                {
+                  const size_type other =
+                    constraint_line(line.entries[entry].first);
+                  // a cycle would make the search descend forever, so
+                  // this check must also be done in release mode
+                  AssertThrow(on_path[other] == false,
+                              ExcMessage("Cycle in constraints detected!"));
+                  if (line_levels[other] == numbers::invalid_unsigned_int)
+                    break;
+                }
 
-          // loop over all entries of this line (including ones that we
-          // have appended in this go around) and see whether they are
-          // further constrained. ignore elements that we don't store on
-          // the current processor
-          size_type entry = 0;
-          while (entry < line.entries.size())
-            if (((local_lines.size() == 0) ||
-                 (local_lines.is_element(line.entries[entry].first))) &&
-                is_constrained(line.entries[entry].first))
+            if (entry < line.entries.size())
               {
-                // ok, this entry is further constrained:
-                chained_constraint_replaced = true;
-
-                // look up the chain of constraints for this entry
-                const size_type dof_index = line.entries[entry].first;
-                const number    weight    = line.entries[entry].second;
-
-                Assert(dof_index != line.index,
-                       ExcMessage("Cycle in constraints detected!"));
-
-                const ConstraintLine &constrained_line =
-                  lines[lines_cache[calculate_line_index(dof_index)]];
-                Assert(constrained_line.index == dof_index, ExcInternalError());
-
-                // now we have to replace an entry by its expansion. we do
-                // that by overwriting the entry by the first entry of the
-                // expansion and adding the remaining ones to the end,
-                // where we will later process them once more
-                //
-                // we can of course only do that if the DoF that we are
-                // currently handle is constrained by a linear combination
-                // of other dofs:
-                if (constrained_line.entries.size() > 0)
-                  {
-                    for (size_type i = 0; i < constrained_line.entries.size();
-                         ++i)
-                      Assert(dof_index != constrained_line.entries[i].first,
-                             ExcMessage("Cycle in constraints detected!"));
-
-                    // replace first entry, then tack the rest to the end
-                    // of the list
-                    line.entries[entry] = std::pair<size_type, number>(
-                      constrained_line.entries[0].first,
-                      constrained_line.entries[0].second * weight);
-
-                    for (size_type i = 1; i < constrained_line.entries.size();
-                         ++i)
-                      line.entries.emplace_back(
-                        constrained_line.entries[i].first,
-                        constrained_line.entries[i].second * weight);
-
-#ifdef DEBUG
-                    // keep track of how many entries we replace in this
-                    // line. If we do more than there are constraints or
-                    // dofs in our system, we must have a cycle.
-                    ++n_replacements;
-                    Assert(n_replacements / 2 < largest_idx,
-                           ExcMessage("Cycle in constraints detected!"));
-                    if (n_replacements / 2 >= largest_idx)
-                      return; // this enables us to test for this Exception.
-#endif
-                  }
-                else
-                  // the DoF that we encountered is not constrained by a
-                  // linear combination of other dofs but is equal to just
-                  // the inhomogeneity (i.e. its chain of entries is
-                  // empty). in that case, we can't just overwrite the
-                  // current entry, but we have to actually eliminate it
-                  {
-                    line.entries.erase(line.entries.begin() + entry);
-                  }
-
-                line.inhomogeneity += constrained_line.inhomogeneity * weight;
-
-                // now that we're here, do not increase index by one but
-                // rather make another pass for the present entry because
-                // we have replaced the present entry by another one, or
-                // because we have deleted it and shifted all following
-                // ones one forward
+                // descend into the line this entry is constrained to
+                const size_type other =
+                  constraint_line(line.entries[entry].first);
+                path.emplace_back(other, 0);
+                on_path[other] = true;
               }
             else
-              // entry not further constrained. just move ahead by one
-              ++entry;
-        }
-
-      // if we didn't do anything in this round, then quit the loop
-      if (chained_constraint_replaced == false)
-        break;
-
-      // increase iteration count. note that we should not iterate more
-      // times than there are constraints, since this puts a natural upper
-      // bound on the length of constraint chains
-      ++iteration;
-      Assert(iteration <= lines.size(), ExcInternalError());
-    }
-
-  // finally sort the entries and re-scale them if necessary. in this step,
-  // we also throw out duplicates as mentioned above. moreover, as some
-  // entries might have had zero weights, we replace them by a vector with
-  // sharp sizes.
-  for (ConstraintLine &line : lines)
-    {
-      std::sort(line.entries.begin(),
-                line.entries.end(),
-                [](const std::pair<unsigned int, number> &a,
-                   const std::pair<unsigned int, number> &b) -> bool {
-                  // Let's use lexicogrpahic ordering with std::abs for number
-                  // type (it might be complex valued).
-                  return (a.first < b.first) ||
-                         (a.first == b.first &&
-                          std::abs(a.second) < std::abs(b.second));
-                });
-
-      // loop over the now sorted list and see whether any of the entries
-      // references the same dofs more than once in order to find how many
-      // non-duplicate entries we have. This lets us allocate the correct
-      // amount of memory for the constraint entries.
-      size_type duplicates = 0;
-      for (size_type i = 1; i < line.entries.size(); ++i)
-        if (line.entries[i].first == line.entries[i - 1].first)
-          duplicates++;
-
-      if (duplicates > 0 || line.entries.size() < line.entries.capacity())
-        {
-          typename ConstraintLine::Entries new_entries;
+              {
+                // all lines this line depends on have a level by now
+                unsigned int level = 0;
+                for (const std::pair<size_type, number> &e : line.entries)
+                  if (is_chained(e.first))
+                    level = std::max(level,
+                                     line_levels[constraint_line(e.first)] + 1);
+                line_levels[line_no] = level;
+                max_level            = std::max(max_level, level);
+
+                on_path[line_no] = false;
+                path.pop_back();
+              }
+          }
+      }
+  }
 
-          // if we have no duplicates, copy verbatim the entries. this way,
-          // the final size is of the vector is correct.
-          if (duplicates == 0)
-            new_entries = line.entries;
-          else
-            {
-              // otherwise, we need to go through the list and resolve the
-              // duplicates
-              new_entries.reserve(line.entries.size() - duplicates);
-              new_entries.push_back(line.entries[0]);
-              for (size_type j = 1; j < line.entries.size(); ++j)
-                if (line.entries[j].first == line.entries[j - 1].first)
-                  {
-                    Assert(new_entries.back().first == line.entries[j].first,
-                           ExcInternalError());
-                    new_entries.back().second += line.entries[j].second;
-                  }
-                else
-                  new_entries.push_back(line.entries[j]);
+  // group the lines by level
+  std::vector<size_type> level_starts(max_level + 2, 0);
+  for (const unsigned int level : line_levels)
+    ++level_starts[level + 1];
+  std::partial_sum(level_starts.begin(),
+                   level_starts.end(),
+                   level_starts.begin());
+  std::vector<size_type> lines_by_level(lines.size());
+  {
+    std::vector<size_type> next_position(level_starts.begin(),
+                                         level_starts.end() - 1);
+    for (size_type i = 0; i < lines.size(); ++i)
+      lines_by_level[next_position[line_levels[i]]++] = i;
+  }
 
-              Assert(new_entries.size() == line.entries.size() - duplicates,
-                     ExcInternalError());
+  // sort the entries of a line and re-scale them if necessary. in this
+  // step, we also throw out duplicates that may have been created when
+  // replacing entries by their constraints. moreover, as some entries might
+  // have had zero weights, we replace them by a vector with sharp sizes.
+  const auto finalize_line = [](ConstraintLine &line) {
+    std::sort(line.entries.begin(),
+              line.entries.end(),
+              [](const std::pair<unsigned int, number> &a,
+                 const std::pair<unsigned int, number> &b) -> bool {
+                // Let's use lexicogrpahic ordering with std::abs for number
+                // type (it might be complex valued).
+                return (a.first < b.first) ||
+                       (a.first == b.first &&
+                        std::abs(a.second) < std::abs(b.second));
+              });
+
+    // loop over the now sorted list and see whether any of the entries
+    // references the same dofs more than once in order to find how many
+    // non-duplicate entries we have. This lets us allocate the correct
+    // amount of memory for the constraint entries.
+    size_type duplicates = 0;
+    for (size_type i = 1; i < line.entries.size(); ++i)
+      if (line.entries[i].first == line.entries[i - 1].first)
+        duplicates++;
+
+    if (duplicates > 0 || line.entries.size() < line.entries.capacity())
+      {
+        typename ConstraintLine::Entries new_entries;
 
-              // make sure there are really no duplicates left and that the
-              // list is still sorted
-              for (size_type j = 1; j < new_entries.size(); ++j)
+        // if we have no duplicates, copy verbatim the entries. this way,
+        // the final size is of the vector is correct.
+        if (duplicates == 0)
+          new_entries = line.entries;
+        else
+          {
+            // otherwise, we need to go through the list and resolve the
+            // duplicates
+            new_entries.reserve(line.entries.size() - duplicates);
+            new_entries.push_back(line.entries[0]);
+            for (size_type j = 1; j < line.entries.size(); ++j)
+              if (line.entries[j].first == line.entries[j - 1].first)
                 {
-                  Assert(new_entries[j].first != new_entries[j - 1].first,
-                         ExcInternalError());
-                  Assert(new_entries[j].first > new_entries[j - 1].first,
+                  Assert(new_entries.back().first == line.entries[j].first,
                          ExcInternalError());
+                  new_entries.back().second += line.entries[j].second;
                 }
-            }
+              else
+                new_entries.push_back(line.entries[j]);
 
-          // replace old list of constraints for this dof by the new one
-          line.entries.swap(new_entries);
-        }
+            Assert(new_entries.size() == line.entries.size() - duplicates,
+                   ExcInternalError());
 
-      // Finally do the following check: if the sum of weights for the
-      // constraints is close to one, but not exactly one, then rescale all
-      // the weights so that they sum up to 1. this adds a little numerical
-      // stability and avoids all sorts of problems where the actual value
-      // is close to, but not quite what we expected
-      //
-      // the case where the weights don't quite sum up happens when we
-      // compute the interpolation weights "on the fly", i.e. not from
-      // precomputed tables. in this case, the interpolation weights are
-      // also subject to round-off
-      number sum = 0.;
-      for (const std::pair<size_type, number> &entry : line.entries)
-        sum += entry.second;
-      if (std::abs(sum - number(1.)) < 1.e-13)
-        {
-          for (std::pair<size_type, number> &entry : line.entries)
-            entry.second /= sum;
-          line.inhomogeneity /= sum;
-        }
-    } // end of loop over all constraint lines
+            // make sure there are really no duplicates left and that the
+            // list is still sorted
+            for (size_type j = 1; j < new_entries.size(); ++j)
+              {
+                Assert(new_entries[j].first != new_entries[j - 1].first,
+                       ExcInternalError());
+                Assert(new_entries[j].first > new_entries[j - 1].first,
+                       ExcInternalError());
+              }
+          }
+
+        // replace old list of constraints for this dof by the new one
+        line.entries.swap(new_entries);
+      }
+
+    // Finally do the following check: if the sum of weights for the
+    // constraints is close to one, but not exactly one, then rescale all
+    // the weights so that they sum up to 1. this adds a little numerical
+    // stability and avoids all sorts of problems where the actual value
+    // is close to, but not quite what we expected
+    //
+    // the case where the weights don't quite sum up happens when we
+    // compute the interpolation weights "on the fly", i.e. not from
+    // precomputed tables. in this case, the interpolation weights are
+    // also subject to round-off
+    number sum = 0.;
+    for (const std::pair<size_type, number> &entry : line.entries)
+      sum += entry.second;
+    if (std::abs(sum - number(1.)) < 1.e-13)
+      {
+        for (std::pair<size_type, number> &entry : line.entries)
+          entry.second /= sum;
+        line.inhomogeneity /= sum;
+      }
+  };
+
+  // now work on the lines level by level. the lines on one level only refer
+  // to lines on lower levels that have already been resolved completely, so
+  // each entry needs to be replaced only once, and all lines on one level
+  // can be treated in parallel. for example, if x3=x0/2+x2/2 and
+  // x2=x0/2+x1/2, then x2 is resolved first and x3 becomes
+  // x3=x0/2+x0/4+x1/4, where finalize_line() then merges the two entries
+  // for x0
+  for (unsigned int level = 0; level <= max_level; ++level)
+    parallel::apply_to_subranges(
+      level_starts[level],
+      level_starts[level + 1],
+      [&](const size_type begin, const size_type end) {
+        typename ConstraintLine::Entries new_entries;
+        for (size_type i = begin; i < end; ++i)
+          {
+            ConstraintLine &line = lines[lines_by_level[i]];
+            if (level > 0)
+              {
+                new_entries.clear();
+                for (const std::pair<size_type, number> &entry : line.entries)
+                  if (is_chained(entry.first))
+                    {
+                      // replace the entry by the (already resolved)
+                      // constraint of the dof it refers to. if that dof is
+                      // not constrained by a linear combination of other
+                      // dofs but is equal to just the inhomogeneity, the
+                      // entry simply disappears
+                      const ConstraintLine &constrained_line =
+                        lines[constraint_line(entry.first)];
+                      Assert(constrained_line.index == entry.first,
+                             ExcInternalError());
+                      for (const std::pair<size_type, number> &other_entry :
+                           constrained_line.entries)
+                        new_entries.emplace_back(other_entry.first,
+                                                 other_entry.second *
+                                                   entry.second);
+                      line.inhomogeneity +=
+                        constrained_line.inhomogeneity * entry.second;
+                    }
+                  else
+                    new_entries.push_back(entry);
+                line.entries.assign(new_entries.begin(), new_entries.end());
+              }
+
+            finalize_line(line);
+          }
+      },
+      /*grainsize=*/256);
 
 #ifdef DEBUG
   // if in debug mode: check that no dof is constrained to another dof that
@@ -22,6 +22,7 @@
 
 #include <deal.II/numerics/data_out_dof_data.h>
 
+#include <functional>
 #include <memory>
 
 DEAL_II_NAMESPACE_OPEN
@@ -95,6 +96,20 @@ namespace internal
  * the same data in more than one format without having to rebuild the
  * patches.
  *
+ * Since build_patches() stores the patches of all cells at once, the memory
+ * needed for output can exceed the memory needed for the solution itself on
+ * large meshes. In that case, build_patches_in_chunks() can be used to build
+ * the patches in chunks of a given size, each of which is written before the
+ * next one is built.
+ *
+ * In time dependent computations on a mesh that does not change, most of the
+ * work of build_patches() is spent on things that are the same in every time
+ * step: the evaluation of the mapping to find the vertices and (for curved
+ * cells) the interior points of the patches, and the connectivity of the
+ * patches. In that case, build_patches() only needs to be called once, and
+ * update_patch_data() can be called in all later time steps to only
+ * re-evaluate the data vectors on the existing patches.
+ *
  *
  * <h3>User interface information</h3>
  *
@@ -219,6 +234,16 @@ public:
     curved_inner_cells
   };
 
+  /**
+   * Constructor.
+   */
+  DataOut();
+
+  /**
+   * Destructor.
+   */
+  virtual ~DataOut() override;
+
   /**
    * This is the central function of this class since it builds the list of
    * patches to be written by the low-level functions of the base class. A
@@ -316,6 +341,144 @@ public:
                 const unsigned int     n_subdivisions = 0,
                 const CurvedCellRegion curved_region  = curved_boundary);
 
+  /**
+   * Same as build_patches(), except that the patches are not all built at
+   * once. Rather, the cells are split into consecutive chunks of at most
+   * @p max_patches_per_chunk cells, and the patches of one chunk are built
+   * (in parallel, as in build_patches()) and then handed to
+   * @p process_chunk before those of the next chunk are built. During the
+   * call of @p process_chunk, the patches of the current chunk are the ones
+   * that the output functions of the base class DataOutInterface see, so
+   * the peak memory needed for the patches is bounded by the chunk size
+   * rather than by the number of cells. When this function returns, no
+   * patches are stored any more.
+   *
+   * The patches of a chunk form a self-contained collection: their
+   * DataOutBase::Patch::patch_index counts from zero within the chunk, and
+   * neighbors that belong to other chunks are not recorded. The output
+   * function therefore needs to be able to append the data of several
+   * chunks to the same file. For VTU output, each chunk can be written as a
+   * separate piece of the same file:
+   * @code
+   *   std::ofstream output("solution.vtu");
+   *   data_out.write_vtu_header(output);
+   *   data_out.build_patches_in_chunks(mapping,
+   *                                    n_subdivisions,
+   *                                    DataOut<dim>::curved_boundary,
+   *                                    100000,
+   *                                    [&]() {
+   *                                      data_out.write_vtu_main(output);
+   *                                    });
+   *   data_out.write_vtu_footer(output);
+   * @endcode
+   * In raw binary format (DataOutBase::VtkFlags::raw_appended), the data
+   * arrays of all pieces follow the footer. They are then collected in a
+   * separate stream, for example a temporary file, and copied behind the
+   * footer at the end:
+   * @code
+   *   std::ofstream output("solution.vtu");
+   *   std::fstream  appended_data("solution.vtu.data",
+   *                              std::ios::in | std::ios::out |
+   *                                std::ios::trunc | std::ios::binary);
+   *   std::size_t   appended_data_size = 0;
+   *   data_out.write_vtu_header(output);
+   *   data_out.build_patches_in_chunks(mapping,
+   *                                    n_subdivisions,
+   *                                    DataOut<dim>::curved_boundary,
+   *                                    100000,
+   *                                    [&]() {
+   *                                      data_out.write_vtu_main(
+   *                                        output,
+   *                                        appended_data,
+   *                                        appended_data_size);
+   *                                    });
+   *   appended_data.seekg(0);
+   *   data_out.write_vtu_footer(output, appended_data);
+   * @endcode
+   *
+   * The other output formats need all patches at once and can not be used
+   * with this function. In particular, this applies to HDF5 output, since
+   * DataOutBase::DataOutFilter merges the vertices of all patches before
+   * anything is written.
+   */
+  void
+  build_patches_in_chunks(
+    const Mapping<DoFHandlerType::dimension, DoFHandlerType::space_dimension>
+      &                          mapping,
+    const unsigned int           n_subdivisions,
+    const CurvedCellRegion       curved_region,
+    const unsigned int           max_patches_per_chunk,
+    const std::function<void()> &process_chunk);
+
+  /**
+   * Re-evaluate the data vectors on the patches created by the last call to
+   * build_patches(), without recomputing the vertices, the points of curved
+   * cells, or the neighborship information of the patches. This is useful in
+   * time dependent computations on a fixed mesh where only the values of the
+   * data vectors change from one output to the next: rather than calling
+   * build_patches() in each time step, call it once and then only this
+   * function, whose cost is proportional to the size of the data only. If
+   * the data vectors only contain values (i.e., they are not postprocessed
+   * using derivatives or the locations of points), the mapping is not even
+   * evaluated on the cells. For HDF5 output, the mesh then only needs to be
+   * written once as well, and the DataOutFilter only needs to filter the
+   * nodes once:
+   * @code
+   *   data_out.build_patches(mapping, n_subdivisions);
+   *   DataOutBase::DataOutFilter data_filter(
+   *     DataOutBase::DataOutFilterFlags(true, true));
+   *   for (unsigned int step = 0; step < n_steps; ++step)
+   *     {
+   *       ... // compute the solution of this time step
+   *
+   *       if (step > 0)
+   *         {
+   *           data_out.update_patch_data(mapping);
+   *           data_filter.clear_data_sets();
+   *         }
+   *
+   *       data_out.write_filtered_data(data_filter);
+   *       const std::string solution_filename =
+   *         "solution-" + Utilities::int_to_string(step, 4) + ".h5";
+   *       data_out.write_hdf5_parallel(data_filter,
+   *                                    step == 0,
+   *                                    "mesh.h5",
+   *                                    solution_filename,
+   *                                    MPI_COMM_WORLD);
+   *       xdmf_entries.push_back(data_out.create_xdmf_entry(
+   *         data_filter, "mesh.h5", solution_filename, time, MPI_COMM_WORLD));
+   *       data_out.write_xdmf_file(xdmf_entries,
+   *                                "solution.xdmf",
+   *                                MPI_COMM_WORLD);
+   *     }
+   * @endcode
+   *
+   * The values of the data vectors attached to this object may have changed
+   * since the last call to build_patches(), but the triangulation, the
+   * DoFHandler objects, and the mapping must not have. The @p mapping
+   * argument needs to be the same as the one given to build_patches(); it is
+   * used for the evaluation of postprocessed quantities such as gradients.
+   * An exception is thrown if the data vectors are now based on other
+   * DoFHandler objects or another triangulation than when the patches were
+   * built, or if the triangulation has been changed in the meantime, e.g.,
+   * refined or coarsened, cleared, or its vertices moved. Call
+   * build_patches() again in these cases.
+   *
+   * This function can not be called after build_patches_in_chunks(), since
+   * the patches of the chunks are not stored.
+   */
+  void
+  update_patch_data(
+    const Mapping<DoFHandlerType::dimension, DoFHandlerType::space_dimension>
+      &mapping);
+
+  /**
+   * Same as above, for patches created by the version of build_patches()
+   * that does not take a mapping argument, i.e., using a MappingQ1.
+   */
+  void
+  update_patch_data();
+
   /**
    * Return the first cell which we want output for. The default
    * implementation returns the first active cell, but you might want to
@@ -355,6 +518,21 @@ private:
   virtual cell_iterator
   next_locally_owned_cell(const cell_iterator &cell);
 
+  /**
+   * Build the patches of all cells in chunks of at most
+   * @p max_patches_per_chunk cells and call @p process_chunk, if it is not
+   * empty, after each chunk. This is the implementation of both
+   * build_patches() and build_patches_in_chunks().
+   */
+  void
+  build_patches_chunkwise(
+    const Mapping<DoFHandlerType::dimension, DoFHandlerType::space_dimension>
+      &                          mapping,
+    const unsigned int           n_subdivisions,
+    const CurvedCellRegion       curved_region,
+    const unsigned int           max_patches_per_chunk,
+    const std::function<void()> &process_chunk);
+
   /**
    * Build one patch. This function is called in a WorkStream context.
    *
@@ -363,6 +541,13 @@ private:
    * WorkStream::run(). The function does not take a CopyData object but
    * rather allocates one on its own stack for memory access efficiency
    * reasons.
+   *
+   * The patch is stored in the position of the patches array given by its
+   * index among all patches minus @p first_patch_index, the index of the
+   * first patch of the chunk currently being built.
+   *
+   * If @p update_data_only is true, the patch already exists and only its
+   * data is recomputed, as described in update_patch_data().
    */
   void
   build_one_patch(const std::pair<cell_iterator, unsigned int> *cell_and_index,
@@ -370,7 +555,42 @@ private:
                     DoFHandlerType::dimension,
                     DoFHandlerType::space_dimension> &scratch_data,
                   const unsigned int                  n_subdivisions,
-                  const CurvedCellRegion              curved_cell_region);
+                  const CurvedCellRegion              curved_cell_region,
+                  const unsigned int                  first_patch_index,
+                  const bool                          update_data_only);
+
+  /**
+   * The cells from which the patches were created by the last call to
+   * build_patches(), along with their active cell indices, in the order of
+   * the patches. This is used by update_patch_data() and is empty if the
+   * patches were built using build_patches_in_chunks().
+   */
+  std::vector<std::pair<cell_iterator, unsigned int>> patch_cells;
+
+  /**
+   * The triangulation, its number of active cells, and the DoFHandler objects
+   * of all data vectors at the time the patches in #patch_cells were built.
+   * update_patch_data() uses them to make sure that the patches still belong
+   * to the same mesh and DoFHandler objects.
+   */
+  const Triangulation<DoFHandlerType::dimension,
+                      DoFHandlerType::space_dimension> *patch_triangulation;
+  unsigned int                                          patch_n_active_cells;
+  std::vector<const DoFHandlerType *>                   patch_dof_handlers;
+
+  /**
+   * Whether the triangulation has been changed (e.g., refined, cleared, or
+   * its vertices moved) since the patches in #patch_cells were built. This
+   * flag is set through #patch_triangulation_listener.
+   */
+  bool patch_triangulation_changed;
+
+  /**
+   * The connection to Triangulation::Signals::any_change of
+   * #patch_triangulation, which must be reset once this class goes out of
+   * scope.
+   */
+  boost::signals2::connection patch_triangulation_listener;
 };
 
 
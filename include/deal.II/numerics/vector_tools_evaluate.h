@@ -0,0 +1,246 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_vector_tools_evaluate_h
+#define dealii_vector_tools_evaluate_h
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/array_view.h>
+#include <deal.II/base/mpi_remote_point_evaluation.h>
+#include <deal.II/base/quadrature.h>
+#include <deal.II/base/tensor.h>
+
+#include <deal.II/dofs/dof_accessor.h>
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_values.h>
+
+#include <deal.II/lac/vector.h>
+
+#include <algorithm>
+#include <functional>
+#include <vector>
+
+DEAL_II_NAMESPACE_OPEN
+
+namespace VectorTools
+{
+  /**
+   * Evaluate the finite element function described by @p dof_handler and
+   * @p vector at the points set up in @p evaluation, which may lie on any
+   * process of a distributed triangulation. The values are computed by the
+   * processes owning the cells around the points, using the cells, reference
+   * points, and communication pattern stored in @p evaluation, and are
+   * returned in the order in which the points were passed to
+   * Utilities::MPI::RemotePointEvaluation::reinit() on the current process.
+   * Each entry has one element per vector component of the finite element.
+   * The entries of points that have not been found on any process are zero.
+   *
+   * @p evaluation must have been set up on the triangulation of
+   * @p dof_handler. On a distributed triangulation, @p vector must contain
+   * the values of all degrees of freedom of the locally owned cells, i.e.,
+   * it must be ghosted, as for any other evaluation of a finite element
+   * function on the locally owned cells.
+   *
+   * @note This function is a collective operation on the communicator of
+   * the triangulation, and each call evaluates the finite element function
+   * anew. Calling it repeatedly, for example once per time step, neither
+   * repeats the search for the points nor any collective communication:
+   * the values are sent with the communication pattern set up by
+   * Utilities::MPI::RemotePointEvaluation::reinit(), and the FEValues
+   * objects at the reference points are set up on the first call and then
+   * reused from @p evaluation.
+   */
+  template <int dim, int spacedim, typename VectorType>
+  std::vector<Vector<typename VectorType::value_type>>
+  point_values(
+    const Utilities::MPI::RemotePointEvaluation<dim, spacedim> &evaluation,
+    const DoFHandler<dim, spacedim> &                           dof_handler,
+    const VectorType &                                          vector);
+
+  /**
+   * Same as point_values(), but evaluate the gradients of the finite element
+   * function. Each entry of the returned vector holds the gradients of all
+   * vector components of the finite element at one point.
+   */
+  template <int dim, int spacedim, typename VectorType>
+  std::vector<std::vector<Tensor<1, spacedim, typename VectorType::value_type>>>
+  point_gradients(
+    const Utilities::MPI::RemotePointEvaluation<dim, spacedim> &evaluation,
+    const DoFHandler<dim, spacedim> &                           dof_handler,
+    const VectorType &                                          vector);
+
+
+
+#ifndef DOXYGEN
+
+  namespace internal
+  {
+    /**
+     * Evaluate some quantity with @p n_values values per point at the
+     * points of all processes that lie in the locally owned cells of the
+     * current process, and return the values at the points of the current
+     * process, stored consecutively for each point. For each cell,
+     * @p evaluate_cell is handed the local degree of freedom values of
+     * @p vector, the FEValues object stored in @p evaluation for that cell
+     * after it has been set up with @p update_flags and reinitialized, and
+     * the array to which the values at the reference points of that cell
+     * are added.
+     */
+    template <int dim, int spacedim, typename T, typename VectorType>
+    std::vector<T>
+    evaluate_at_remote_points(
+      const Utilities::MPI::RemotePointEvaluation<dim, spacedim> &evaluation,
+      const DoFHandler<dim, spacedim> &                           dof_handler,
+      const VectorType &                                          vector,
+      const unsigned int                                          n_values,
+      const UpdateFlags                                           update_flags,
+      const std::function<
+        void(const Vector<typename VectorType::value_type> &,
+             const FEValues<dim, spacedim> &,
+             T *)> &evaluate_cell)
+    {
+      Assert(&evaluation.get_triangulation() ==
+               &dof_handler.get_triangulation(),
+             ExcMessage("The RemotePointEvaluation object must have been set "
+                        "up on the triangulation of the DoFHandler."));
+
+      const auto evaluation_function =
+        [&](const ArrayView<T> &values,
+            const typename Utilities::MPI::RemotePointEvaluation<dim,
+                                                                 spacedim>::
+              CellData &cell_data) {
+          Vector<typename VectorType::value_type> local_values;
+          for (unsigned int c = 0; c < cell_data.cells.size(); ++c)
+            {
+              const typename DoFHandler<dim, spacedim>::active_cell_iterator
+                cell(&dof_handler.get_triangulation(),
+                     cell_data.cells[c].first,
+                     cell_data.cells[c].second,
+                     &dof_handler);
+
+              FEValues<dim, spacedim> &fe_values =
+                evaluation.get_fe_values(c, cell->get_fe(), update_flags);
+              fe_values.reinit(cell);
+
+              local_values.reinit(cell->get_fe().dofs_per_cell);
+              cell->get_dof_values(vector, local_values);
+
+              evaluate_cell(local_values,
+                            fe_values,
+                            values.data() +
+                              cell_data.reference_point_ptrs[c] * n_values);
+            }
+        };
+
+      std::vector<T> output;
+      evaluation.template evaluate_and_process<T>(output,
+                                                  evaluation_function,
+                                                  n_values);
+      return output;
+    }
+  } // namespace internal
+
+
+
+  template <int dim, int spacedim, typename VectorType>
+  std::vector<Vector<typename VectorType::value_type>>
+  point_values(
+    const Utilities::MPI::RemotePointEvaluation<dim, spacedim> &evaluation,
+    const DoFHandler<dim, spacedim> &                           dof_handler,
+    const VectorType &                                          vector)
+  {
+    using Number                    = typename VectorType::value_type;
+    const unsigned int n_components = dof_handler.get_fe().n_components();
+
+    const std::vector<Number> values =
+      internal::evaluate_at_remote_points<dim, spacedim, Number>(
+        evaluation,
+        dof_handler,
+        vector,
+        n_components,
+        update_values,
+        [&](const Vector<Number> &           local_values,
+            const FEValues<dim, spacedim> &fe_values,
+            Number *                       cell_values) {
+          const FiniteElement<dim, spacedim> &fe = fe_values.get_fe();
+          for (unsigned int i = 0; i < fe.dofs_per_cell; ++i)
+            for (unsigned int c = 0; c < n_components; ++c)
+              if (fe.get_nonzero_components(i)[c])
+                for (unsigned int q = 0; q < fe_values.n_quadrature_points;
+                     ++q)
+                  cell_values[q * n_components + c] +=
+                    local_values(i) *
+                    fe_values.shape_value_component(i, q, c);
+        });
+
+    std::vector<Vector<Number>> output(evaluation.get_points().size(),
+                                       Vector<Number>(n_components));
+    for (unsigned int i = 0; i < output.size(); ++i)
+      std::copy(values.begin() + i * n_components,
+                values.begin() + (i + 1) * n_components,
+                output[i].begin());
+    return output;
+  }
+
+
+
+  template <int dim, int spacedim, typename VectorType>
+  std::vector<std::vector<Tensor<1, spacedim, typename VectorType::value_type>>>
+  point_gradients(
+    const Utilities::MPI::RemotePointEvaluation<dim, spacedim> &evaluation,
+    const DoFHandler<dim, spacedim> &                           dof_handler,
+    const VectorType &                                          vector)
+  {
+    using Number                    = typename VectorType::value_type;
+    using Gradient                  = Tensor<1, spacedim, Number>;
+    const unsigned int n_components = dof_handler.get_fe().n_components();
+
+    const std::vector<Gradient> gradients =
+      internal::evaluate_at_remote_points<dim, spacedim, Gradient>(
+        evaluation,
+        dof_handler,
+        vector,
+        n_components,
+        update_gradients,
+        [&](const Vector<Number> &           local_values,
+            const FEValues<dim, spacedim> &fe_values,
+            Gradient *                     cell_gradients) {
+          const FiniteElement<dim, spacedim> &fe = fe_values.get_fe();
+          for (unsigned int i = 0; i < fe.dofs_per_cell; ++i)
+            for (unsigned int c = 0; c < n_components; ++c)
+              if (fe.get_nonzero_components(i)[c])
+                for (unsigned int q = 0; q < fe_values.n_quadrature_points;
+                     ++q)
+                  cell_gradients[q * n_components + c] +=
+                    local_values(i) *
+                    Gradient(fe_values.shape_grad_component(i, q, c));
+        });
+
+    std::vector<std::vector<Gradient>> output(evaluation.get_points().size());
+    for (unsigned int i = 0; i < output.size(); ++i)
+      output[i].assign(gradients.begin() + i * n_components,
+                       gradients.begin() + (i + 1) * n_components);
+    return output;
+  }
+
+#endif
+
+} // namespace VectorTools
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
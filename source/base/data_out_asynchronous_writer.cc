@@ -0,0 +1,202 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+#include <deal.II/base/data_out_asynchronous_writer.h>
+
+#include <fstream>
+#include <memory>
+#include <tuple>
+#include <vector>
+
+DEAL_II_NAMESPACE_OPEN
+
+
+namespace internal
+{
+  namespace DataOutAsynchronousWriterImplementation
+  {
+    /**
+     * A copy of the patches, data set names, and output flags of a
+     * DataOutInterface object, from which a file can be written while the
+     * original object is modified or destroyed.
+     */
+    template <int dim, int spacedim>
+    class Snapshot : public DataOutInterface<dim, spacedim>
+    {
+    public:
+      Snapshot(
+        const DataOutInterface<dim, spacedim> &                 data_out,
+        const std::vector<DataOutBase::Patch<dim, spacedim>> &patches,
+        const std::vector<std::string> &                      dataset_names,
+        const std::vector<
+          std::tuple<unsigned int,
+                     unsigned int,
+                     std::string,
+                     DataComponentInterpretation::DataComponentInterpretation>>
+          &nonscalar_data_ranges)
+        : DataOutInterface<dim, spacedim>(data_out)
+        , patches(patches)
+        , dataset_names(dataset_names)
+        , nonscalar_data_ranges(nonscalar_data_ranges)
+      {}
+
+    protected:
+      virtual const std::vector<DataOutBase::Patch<dim, spacedim>> &
+      get_patches() const override
+      {
+        return patches;
+      }
+
+      virtual std::vector<std::string>
+      get_dataset_names() const override
+      {
+        return dataset_names;
+      }
+
+      virtual std::vector<
+        std::tuple<unsigned int,
+                   unsigned int,
+                   std::string,
+                   DataComponentInterpretation::DataComponentInterpretation>>
+      get_nonscalar_data_ranges() const override
+      {
+        return nonscalar_data_ranges;
+      }
+
+    private:
+      const std::vector<DataOutBase::Patch<dim, spacedim>> patches;
+      const std::vector<std::string>                       dataset_names;
+      const std::vector<
+        std::tuple<unsigned int,
+                   unsigned int,
+                   std::string,
+                   DataComponentInterpretation::DataComponentInterpretation>>
+        nonscalar_data_ranges;
+    };
+  } // namespace DataOutAsynchronousWriterImplementation
+} // namespace internal
+
+
+
+template <int dim, int spacedim>
+DataOutAsynchronousWriter<dim, spacedim>::DataOutAsynchronousWriter(
+  const unsigned int max_n_pending_writes)
+  : max_n_pending_writes(max_n_pending_writes)
+{
+  Assert(max_n_pending_writes > 0,
+         ExcMessage("At least one write needs to be allowed to be in "
+                    "progress at any given time."));
+}
+
+
+
+template <int dim, int spacedim>
+DataOutAsynchronousWriter<dim, spacedim>::~DataOutAsynchronousWriter()
+{
+  // the tasks catch all exceptions themselves, so this can not throw
+  for (const auto &task : pending_writes)
+    task.join();
+}
+
+
+
+template <int dim, int spacedim>
+void
+DataOutAsynchronousWriter<dim, spacedim>::write(
+  const DataOutInterface<dim, spacedim> &data_out,
+  const std::string &                    filename,
+  const DataOutBase::OutputFormat        output_format)
+{
+  // make room for the new write before taking the snapshot, so that there
+  // are never more than max_n_pending_writes snapshots at the same time
+  while (pending_writes.size() >= max_n_pending_writes)
+    wait_for_oldest_write();
+
+  using Snapshot =
+    internal::DataOutAsynchronousWriterImplementation::Snapshot<dim, spacedim>;
+  const std::shared_ptr<const Snapshot> snapshot =
+    std::make_shared<Snapshot>(data_out,
+                               data_out.get_patches(),
+                               data_out.get_dataset_names(),
+                               data_out.get_nonscalar_data_ranges());
+
+  // exceptions can not propagate out of a task, so catch them and hand them
+  // back to wait() as the return value of the task
+  pending_writes.push_back(Threads::new_task(
+    [snapshot, filename, output_format]() -> std::exception_ptr {
+      try
+        {
+          std::ofstream out(filename);
+          AssertThrow(out, ExcFileNotOpen(filename));
+          snapshot->write(out, output_format);
+          out.close();
+          AssertThrow(out, ExcIO());
+        }
+      catch (...)
+        {
+          return std::current_exception();
+        }
+      return nullptr;
+    }));
+}
+
+
+
+template <int dim, int spacedim>
+void
+DataOutAsynchronousWriter<dim, spacedim>::wait()
+{
+  while (pending_writes.size() > 0)
+    wait_for_oldest_write();
+
+  if (error)
+    {
+      std::exception_ptr first_error;
+      std::swap(first_error, error);
+      std::rethrow_exception(first_error);
+    }
+}
+
+
+
+template <int dim, int spacedim>
+unsigned int
+DataOutAsynchronousWriter<dim, spacedim>::n_pending_writes() const
+{
+  return pending_writes.size();
+}
+
+
+
+template <int dim, int spacedim>
+void
+DataOutAsynchronousWriter<dim, spacedim>::wait_for_oldest_write()
+{
+  Assert(pending_writes.size() > 0, ExcInternalError());
+
+  const std::exception_ptr write_error = pending_writes.front().return_value();
+  pending_writes.pop_front();
+
+  if (write_error && !error)
+    error = write_error;
+}
+
+
+// explicit instantiations
+#include "data_out_asynchronous_writer.inst"
+
+
+DEAL_II_NAMESPACE_CLOSE
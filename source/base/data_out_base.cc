@@ -34,6 +34,7 @@
 #include <deal.II/base/data_out_base.h>
 #include <deal.II/base/memory_consumption.h>
 #include <deal.II/base/mpi.h>
+#include <deal.II/base/parallel.h>
 #include <deal.II/base/parameter_handler.h>
 #include <deal.II/base/thread_management.h>
 #include <deal.II/base/utilities.h>
@@ -57,6 +58,10 @@
 #  include <zlib.h>
 #endif
 
+#ifdef DEAL_II_WITH_LZ4
+#  include <lz4.h>
+#endif
+
 #ifdef DEAL_II_WITH_HDF5
 #  include <hdf5.h>
 #endif
@@ -78,7 +83,6 @@ namespace
 
 namespace
 {
-#ifdef DEAL_II_WITH_ZLIB
   // the functions in this namespace are
   // taken from the libb64 project, see
   // http://sourceforge.net/projects/libb64
@@ -226,6 +230,7 @@ namespace
   }
 
 
+#ifdef DEAL_II_WITH_ZLIB
   /**
    * Convert between the enum specified inside VtkFlags and the preprocessor
    * constant defined by zlib.
@@ -249,10 +254,87 @@ namespace
           return Z_NO_COMPRESSION;
       }
   }
+#endif
+
+
+  /**
+   * Compress the given block of data with the algorithm selected by
+   * VtkFlags::data_format and put the result into @p compressed_data.
+   */
+  void
+  compress_block(const char *                 data,
+                 const std::size_t            data_size,
+                 const DataOutBase::VtkFlags &flags,
+                 std::vector<char> &          compressed_data)
+  {
+    switch (flags.data_format)
+      {
+        case DataOutBase::VtkFlags::zlib_compressed:
+          {
+#ifdef DEAL_II_WITH_ZLIB
+            uLongf compressed_length = compressBound(data_size);
+            compressed_data.resize(compressed_length);
+            const int err =
+              compress2(reinterpret_cast<Bytef *>(compressed_data.data()),
+                        &compressed_length,
+                        reinterpret_cast<const Bytef *>(data),
+                        data_size,
+                        get_zlib_compression_level(flags.compression_level));
+            (void)err;
+            Assert(err == Z_OK, ExcInternalError());
+            compressed_data.resize(compressed_length);
+#else
+            (void)data;
+            (void)data_size;
+            (void)compressed_data;
+            Assert(false, ExcInternalError());
+#endif
+            break;
+          }
+
+        case DataOutBase::VtkFlags::lz4_compressed:
+          {
+#ifdef DEAL_II_WITH_LZ4
+            AssertThrow(
+              data_size <= static_cast<std::size_t>(LZ4_MAX_INPUT_SIZE),
+              ExcMessage("The data array is too large to be compressed with "
+                         "LZ4 as a single block. Set "
+                         "VtkFlags::compression_block_size to a smaller "
+                         "value."));
+            compressed_data.resize(LZ4_compressBound(data_size));
+            const int compressed_length =
+              LZ4_compress_default(data,
+                                   compressed_data.data(),
+                                   data_size,
+                                   compressed_data.size());
+            Assert(compressed_length > 0, ExcInternalError());
+            compressed_data.resize(compressed_length);
+#else
+            (void)data;
+            (void)data_size;
+            (void)compressed_data;
+            Assert(false, ExcInternalError());
+#endif
+            break;
+          }
+
+        default:
+          Assert(false, ExcNotImplemented());
+      }
+  }
+
 
   /**
-   * Do a zlib compression followed by a base64 encoding of the given data. The
+   * Do a compression followed by a base64 encoding of the given data. The
    * result is then written to the given stream.
+   *
+   * The data is split into blocks of VtkFlags::compression_block_size bytes
+   * (or a single block if that is zero) that are compressed independently
+   * and in parallel. The header lists the number of blocks, the
+   * uncompressed size of each but the last block, the uncompressed size of
+   * the last block, and the compressed sizes of all blocks. Since the
+   * compressed blocks are written in order, the output does not depend on
+   * how the work is distributed among threads.
    */
   template <typename T>
   void
@@ -262,43 +344,111 @@ namespace
   {
     if (data.size() != 0)
       {
-        // allocate a buffer for compressing data and do so
-        uLongf compressed_data_length = compressBound(data.size() * sizeof(T));
-        char * compressed_data        = new char[compressed_data_length];
-        int    err =
-          compress2(reinterpret_cast<Bytef *>(compressed_data),
-                    &compressed_data_length,
-                    reinterpret_cast<const Bytef *>(data.data()),
-                    data.size() * sizeof(T),
-                    get_zlib_compression_level(flags.compression_level));
-        (void)err;
-        Assert(err == Z_OK, ExcInternalError());
+        const std::size_t data_size = data.size() * sizeof(T);
+        const std::size_t block_size =
+          (flags.compression_block_size == 0 ||
+               flags.compression_block_size > data_size ?
+             data_size :
+             flags.compression_block_size);
+        const std::size_t n_blocks = (data_size + block_size - 1) / block_size;
+        const std::size_t last_block_size =
+          data_size - (n_blocks - 1) * block_size;
+        AssertThrow(block_size <= std::numeric_limits<uint32_t>::max(),
+                    ExcMessage("The data array is too large to be written "
+                               "as a single compressed block. Set "
+                               "VtkFlags::compression_block_size to a "
+                               "smaller value."));
+
+        // compress the blocks concurrently, each into its own buffer
+        const char *raw_data = reinterpret_cast<const char *>(data.data());
+        std::vector<std::vector<char>> compressed_blocks(n_blocks);
+        parallel::apply_to_subranges(
+          std::size_t(0),
+          n_blocks,
+          [&](const std::size_t begin, const std::size_t end) {
+            for (std::size_t b = begin; b < end; ++b)
+              compress_block(raw_data + b * block_size,
+                             (b == n_blocks - 1 ? last_block_size : block_size),
+                             flags,
+                             compressed_blocks[b]);
+          },
+          1);
 
         // now encode the compression header
-        const uint32_t compression_header[4] = {
-          1,                                              /* number of blocks */
-          static_cast<uint32_t>(data.size() * sizeof(T)), /* size of block */
-          static_cast<uint32_t>(data.size() *
-                                sizeof(T)), /* size of last block */
-          static_cast<uint32_t>(
-            compressed_data_length)}; /* list of compressed sizes of blocks */
+        std::vector<uint32_t> compression_header(3 + n_blocks);
+        compression_header[0] = n_blocks;        /* number of blocks */
+        compression_header[1] = block_size;      /* size of block */
+        compression_header[2] = last_block_size; /* size of last block */
+        std::size_t compressed_data_length = 0;
+        for (std::size_t b = 0; b < n_blocks; ++b)
+          {
+            /* list of compressed sizes of blocks */
+            compression_header[3 + b] = compressed_blocks[b].size();
+            compressed_data_length += compressed_blocks[b].size();
+          }
 
         char *encoded_header =
           encode_block(reinterpret_cast<const char *>(&compression_header[0]),
-                       4 * sizeof(compression_header[0]));
+                       compression_header.size() *
+                         sizeof(compression_header[0]));
         output_stream << encoded_header;
         delete[] encoded_header;
 
-        // next do the compressed data encoding in base64
+        // next do the compressed data encoding in base64. the blocks are
+        // concatenated first because the base64 encoding of a block depends
+        // on the number of bytes that precede it
+        std::vector<char> compressed_data;
+        compressed_data.reserve(compressed_data_length);
+        for (const std::vector<char> &block : compressed_blocks)
+          compressed_data.insert(compressed_data.end(),
+                                 block.begin(),
+                                 block.end());
+        compressed_blocks.clear();
+
         char *encoded_data =
-          encode_block(compressed_data, compressed_data_length);
-        delete[] compressed_data;
+          encode_block(compressed_data.data(), compressed_data.size());
 
         output_stream << encoded_data;
         delete[] encoded_data;
       }
   }
-#endif
+
+
+  /**
+   * Return the number of bytes a data array of @p n_values elements of type
+   * @p T takes in the raw encoding of the <tt>AppendedData</tt> section of a
+   * VTU file, i.e., including the number of bytes of the data array that
+   * precedes the array itself.
+   */
+  template <typename T>
+  std::size_t
+  raw_block_size(const std::size_t n_values)
+  {
+    const std::size_t data_size = n_values * sizeof(T);
+    AssertThrow(data_size <= std::numeric_limits<uint32_t>::max(),
+                ExcMessage("The data array is too large to be written in "
+                           "raw binary format."));
+    return sizeof(uint32_t) + data_size;
+  }
+
+
+  /**
+   * Write the given data to @p output_stream in the raw encoding of the
+   * <tt>AppendedData</tt> section of a VTU file, i.e., as the number of bytes
+   * of the data array followed by the bytes themselves.
+   */
+  template <typename T>
+  void
+  write_raw_block(const std::vector<T> &data, std::ostream &output_stream)
+  {
+    const uint32_t header =
+      raw_block_size<T>(data.size()) - sizeof(uint32_t);
+    output_stream.write(reinterpret_cast<const char *>(&header),
+                        sizeof(header));
+    if (header > 0)
+      output_stream.write(reinterpret_cast<const char *>(data.data()),
+                          header);
+  }
 } // namespace
 
 
@@ -585,6 +735,16 @@ namespace DataOutBase
 
 
 
+  void
+  DataOutFilter::clear_data_sets()
+  {
+    data_set_names.clear();
+    data_set_dims.clear();
+    data_sets.clear();
+  }
+
+
+
   void
   DataOutFilter::flush_points()
   {}
@@ -1223,7 +1383,60 @@ namespace
   class VtuStream : public StreamBase<DataOutBase::VtkFlags>
   {
   public:
-    VtuStream(std::ostream &stream, const DataOutBase::VtkFlags &flags);
+    /**
+     * Constructor. If the data is to be written in raw binary format (see
+     * DataOutBase::VtkFlags::raw_appended), the data arrays are written to
+     * @p appended_data rather than to @p stream, which then only receives
+     * the XML description. If @p appended_data is a null pointer in this
+     * case, the data arrays are not written at all, but only their sizes are
+     * added up to compute the offset attributes in the XML description.
+     * @p appended_data_size is the number of bytes of appended data that
+     * precede the data arrays written to this stream.
+     */
+    VtuStream(std::ostream &               stream,
+              const DataOutBase::VtkFlags &flags,
+              std::ostream *               appended_data      = nullptr,
+              const std::size_t            appended_data_size = 0);
+
+    /**
+     * Return the <tt>format</tt> attribute, and for appended data also the
+     * <tt>offset</tt> attribute, of the XML tag of the next data array
+     * written to this stream.
+     */
+    std::string
+    format_attributes() const;
+
+    /**
+     * Return whether the data is written as ASCII text rather than in one
+     * of the binary formats.
+     */
+    bool
+    writes_ascii() const;
+
+    /**
+     * Return whether the data arrays written to this stream end up
+     * somewhere, i.e., whether this is not the pass over the data in raw
+     * binary format that only computes the offsets of the data arrays.
+     */
+    bool
+    writes_data() const;
+
+    /**
+     * Return the number of bytes of appended data in raw binary format,
+     * including the ones that preceded the data arrays written to this
+     * stream, i.e., the offset of the next data array.
+     */
+    std::size_t
+    get_appended_data_size() const;
+
+    /**
+     * Account for a data array of @p n_values elements of type @p T as if it
+     * had been written to this stream. This function may only be called if
+     * writes_data() returns false.
+     */
+    template <typename T>
+    void
+    skip_data(const std::size_t n_values);
 
     template <int dim>
     void
@@ -1271,9 +1484,11 @@ namespace
     /**
      * Forwarding of output stream.
      *
-     * If libz was found during configuration, this operator compresses and
-     * encodes the entire data block. Otherwise, it simply writes it element by
-     * element.
+     * Depending on DataOutBase::VtkFlags::data_format, this operator
+     * compresses and encodes the entire data block, or appends it in raw
+     * binary format to the appended data. If zlib compression was requested
+     * but libz was not found during configuration, it simply writes the data
+     * element by element.
      */
     template <typename T>
     std::ostream &
@@ -1281,8 +1496,26 @@ namespace
 
   private:
     /**
-     * A list of vertices and cells, to be used in case we want to compress the
-     * data.
+     * Whether the data is written as ASCII text rather than in one of the
+     * binary formats.
+     */
+    const bool write_ascii;
+
+    /**
+     * The destination of the data arrays in raw binary format, or a null
+     * pointer if only their offsets are computed.
+     */
+    std::ostream *appended_data;
+
+    /**
+     * The number of bytes of data arrays in raw binary format written to
+     * this stream so far, i.e., the offset of the next data array.
+     */
+    std::size_t appended_data_size;
+
+    /**
+     * A list of vertices and cells, to be used in case we want to write the
+     * data in one of the binary formats.
      *
      * The data types of these arrays needs to match what we print in the
      * XML-preamble to the respective parts of VTU files (e.g. Float32 and
@@ -1609,41 +1842,106 @@ namespace
     stream << '\n';
   }
 
-  VtuStream::VtuStream(std::ostream &out, const DataOutBase::VtkFlags &f)
+  VtuStream::VtuStream(std::ostream &               out,
+                       const DataOutBase::VtkFlags &f,
+                       std::ostream *               appended_data,
+                       const std::size_t            appended_data_size)
     : StreamBase<DataOutBase::VtkFlags>(out, f)
-  {}
+#ifdef DEAL_II_WITH_ZLIB
+    , write_ascii(false)
+#else
+    , write_ascii(f.data_format == DataOutBase::VtkFlags::zlib_compressed)
+#endif
+    , appended_data(appended_data)
+    , appended_data_size(appended_data_size)
+  {
+#ifndef DEAL_II_WITH_LZ4
+    AssertThrow(f.data_format != DataOutBase::VtkFlags::lz4_compressed,
+                ExcMessage("You have requested VTU output compressed with "
+                           "LZ4, but deal.II was configured without LZ4."));
+#endif
+  }
+
+
+  std::string
+  VtuStream::format_attributes() const
+  {
+    if (write_ascii)
+      return "format=\"ascii\"";
+    else if (flags.data_format == DataOutBase::VtkFlags::raw_appended)
+      return "format=\"appended\" offset=\"" +
+             std::to_string(appended_data_size) + "\"";
+    else
+      return "format=\"binary\"";
+  }
+
+
+  bool
+  VtuStream::writes_ascii() const
+  {
+    return write_ascii;
+  }
+
+
+  bool
+  VtuStream::writes_data() const
+  {
+    return flags.data_format != DataOutBase::VtkFlags::raw_appended ||
+           appended_data != nullptr;
+  }
+
+
+  std::size_t
+  VtuStream::get_appended_data_size() const
+  {
+    return appended_data_size;
+  }
+
+
+  template <typename T>
+  void
+  VtuStream::skip_data(const std::size_t n_values)
+  {
+    Assert(!writes_data(), ExcInternalError());
+    appended_data_size += raw_block_size<T>(n_values);
+  }
 
 
   template <int dim>
   void
   VtuStream::write_point(const unsigned int, const Point<dim> &p)
   {
-#if !defined(DEAL_II_WITH_ZLIB)
-    // write out coordinates
-    stream << p;
-    // fill with zeroes
-    for (unsigned int i = dim; i < 3; ++i)
-      stream << " 0";
-    stream << '\n';
-#else
-    // if we want to compress, then first collect all the data in an array
-    for (unsigned int i = 0; i < dim; ++i)
-      vertices.push_back(p[i]);
-    for (unsigned int i = dim; i < 3; ++i)
-      vertices.push_back(0);
-#endif
+    if (write_ascii)
+      {
+        // write out coordinates
+        stream << p;
+        // fill with zeroes
+        for (unsigned int i = dim; i < 3; ++i)
+          stream << " 0";
+        stream << '\n';
+      }
+    else
+      {
+        // if we want to write binary data, then first collect all the data in
+        // an array
+        for (unsigned int i = 0; i < dim; ++i)
+          vertices.push_back(p[i]);
+        for (unsigned int i = dim; i < 3; ++i)
+          vertices.push_back(0);
+      }
   }
 
 
   void
   VtuStream::flush_points()
   {
-#ifdef DEAL_II_WITH_ZLIB
-    // compress the data we have in memory and write them to the stream. then
-    // release the data
-    *this << vertices << '\n';
-    vertices.clear();
-#endif
+    if (!write_ascii)
+      {
+        // compress the data we have in memory and write them to the stream.
+        // then release the data
+        *this << vertices << '\n';
+        vertices.clear();
+      }
   }
 
 
@@ -1655,41 +1953,45 @@ namespace
                         unsigned int d2,
                         unsigned int d3)
   {
-#if !defined(DEAL_II_WITH_ZLIB)
-    stream << start;
-    if (dim >= 1)
+    if (write_ascii)
       {
-        stream << '\t' << start + d1;
-        if (dim >= 2)
+        stream << start;
+        if (dim >= 1)
           {
-            stream << '\t' << start + d2 + d1 << '\t' << start + d2;
-            if (dim >= 3)
+            stream << '\t' << start + d1;
+            if (dim >= 2)
               {
-                stream << '\t' << start + d3 << '\t' << start + d3 + d1 << '\t'
-                       << start + d3 + d2 + d1 << '\t' << start + d3 + d2;
+                stream << '\t' << start + d2 + d1 << '\t' << start + d2;
+                if (dim >= 3)
+                  {
+                    stream << '\t' << start + d3 << '\t' << start + d3 + d1
+                           << '\t' << start + d3 + d2 + d1 << '\t'
+                           << start + d3 + d2;
+                  }
               }
           }
+        stream << '\n';
       }
-    stream << '\n';
-#else
-    cells.push_back(start);
-    if (dim >= 1)
+    else
       {
-        cells.push_back(start + d1);
-        if (dim >= 2)
+        cells.push_back(start);
+        if (dim >= 1)
           {
-            cells.push_back(start + d2 + d1);
-            cells.push_back(start + d2);
-            if (dim >= 3)
+            cells.push_back(start + d1);
+            if (dim >= 2)
               {
-                cells.push_back(start + d3);
-                cells.push_back(start + d3 + d1);
-                cells.push_back(start + d3 + d2 + d1);
-                cells.push_back(start + d3 + d2);
+                cells.push_back(start + d2 + d1);
+                cells.push_back(start + d2);
+                if (dim >= 3)
+                  {
+                    cells.push_back(start + d3);
+                    cells.push_back(start + d3 + d1);
+                    cells.push_back(start + d3 + d2 + d1);
+                    cells.push_back(start + d3 + d2);
+                  }
               }
           }
       }
-#endif
   }
 
   template <int dim>
@@ -1698,25 +2000,29 @@ namespace
                                    const unsigned int           start,
                                    const std::vector<unsigned> &connectivity)
   {
-#if !defined(DEAL_II_WITH_ZLIB)
-    for (const auto &c : connectivity)
-      stream << '\t' << start + c;
-    stream << '\n';
-#else
-    for (const auto &c : connectivity)
-      cells.push_back(start + c);
-#endif
+    if (write_ascii)
+      {
+        for (const auto &c : connectivity)
+          stream << '\t' << start + c;
+        stream << '\n';
+      }
+    else
+      {
+        for (const auto &c : connectivity)
+          cells.push_back(start + c);
+      }
   }
 
   void
   VtuStream::flush_cells()
   {
-#ifdef DEAL_II_WITH_ZLIB
-    // compress the data we have in memory and write them to the stream. then
-    // release the data
-    *this << cells << '\n';
-    cells.clear();
-#endif
+    if (!write_ascii)
+      {
+        // compress the data we have in memory and write them to the stream.
+        // then release the data
+        *this << cells << '\n';
+        cells.clear();
+      }
   }
 
 
@@ -1724,14 +2030,18 @@ namespace
   std::ostream &
   VtuStream::operator<<(const std::vector<T> &data)
   {
-#ifdef DEAL_II_WITH_ZLIB
-    // compress the data we have in memory and write them to the stream. then
-    // release the data
-    write_compressed_block(data, flags, stream);
-#else
-    for (unsigned int i = 0; i < data.size(); ++i)
-      stream << data[i] << ' ';
-#endif
+    if (write_ascii)
+      for (unsigned int i = 0; i < data.size(); ++i)
+        stream << data[i] << ' ';
+    else if (flags.data_format == DataOutBase::VtkFlags::raw_appended)
+      {
+        if (appended_data != nullptr)
+          write_raw_block(data, *appended_data);
+        appended_data_size += raw_block_size<T>(data.size());
+      }
+    else
+      // compress the data we have in memory and write them to the stream
+      write_compressed_block(data, flags, stream);
 
     return stream;
   }
@@ -2409,12 +2719,16 @@ namespace DataOutBase
                      const unsigned int                   cycle,
                      const bool                           print_date_and_time,
                      const VtkFlags::ZlibCompressionLevel compression_level,
-                     const bool write_higher_order_cells)
+                     const bool                 write_higher_order_cells,
+                     const unsigned int         compression_block_size,
+                     const VtkFlags::DataFormat data_format)
     : time(time)
     , cycle(cycle)
     , print_date_and_time(print_date_and_time)
     , compression_level(compression_level)
+    , data_format(data_format)
     , write_higher_order_cells(write_higher_order_cells)
+    , compression_block_size(compression_block_size)
   {}
 
 
@@ -5429,8 +5743,11 @@ namespace DataOutBase
       out << ".";
     out << "\n-->\n";
     out << "<VTKFile type=\"UnstructuredGrid\" version=\"0.1\"";
+    if (flags.data_format == VtkFlags::lz4_compressed)
+      out << " compressor=\"vtkLZ4DataCompressor\"";
 #ifdef DEAL_II_WITH_ZLIB
-    out << " compressor=\"vtkZLibDataCompressor\"";
+    else if (flags.data_format == VtkFlags::zlib_compressed)
+      out << " compressor=\"vtkZLibDataCompressor\"";
 #endif
 #ifdef DEAL_II_WORDS_BIGENDIAN
     out << " byte_order=\"BigEndian\"";
@@ -5441,6 +5758,33 @@ namespace DataOutBase
     out << '\n';
     out << "<UnstructuredGrid>";
     out << '\n';
+
+    // if desired, output time and cycle of the simulation, following the
+    // instructions at
+    // http://www.visitusers.org/index.php?title=Time_and_Cycle_in_VTK_files
+    {
+      const unsigned int n_metadata =
+        ((flags.cycle != std::numeric_limits<unsigned int>::min() ? 1 : 0) +
+         (flags.time != std::numeric_limits<double>::min() ? 1 : 0));
+      if (n_metadata > 0)
+        out << "<FieldData>\n";
+
+      if (flags.cycle != std::numeric_limits<unsigned int>::min())
+        {
+          out
+            << "<DataArray type=\"Float32\" Name=\"CYCLE\" NumberOfTuples=\"1\" format=\"ascii\">"
+            << flags.cycle << "</DataArray>\n";
+        }
+      if (flags.time != std::numeric_limits<double>::min())
+        {
+          out
+            << "<DataArray type=\"Float32\" Name=\"TIME\" NumberOfTuples=\"1\" format=\"ascii\">"
+            << flags.time << "</DataArray>\n";
+        }
+
+      if (n_metadata > 0)
+        out << "</FieldData>\n";
+    }
   }
 
 
@@ -5455,44 +5799,26 @@ namespace DataOutBase
 
 
 
-  template <int dim, int spacedim>
   void
-  write_vtu(
-    const std::vector<Patch<dim, spacedim>> &patches,
-    const std::vector<std::string> &         data_names,
-    const std::vector<std::tuple<unsigned int, unsigned int, std::string>>
-      &             nonscalar_data_ranges,
-    const VtkFlags &flags,
-    std::ostream &  out)
+  write_vtu_footer(std::ostream &out, std::istream &appended_data)
   {
-    write_vtu_header(out, flags);
-    write_vtu_main(patches, data_names, nonscalar_data_ranges, flags, out);
-    write_vtu_footer(out);
-
-    out << std::flush;
-  }
-
-
+    AssertThrow(out, ExcIO());
+    out << " </UnstructuredGrid>\n";
+    out << "<AppendedData encoding=\"raw\">\n_";
 
-  template <int dim, int spacedim>
-  void
-  write_vtu(
-    const std::vector<Patch<dim, spacedim>> &patches,
-    const std::vector<std::string> &         data_names,
-    const std::vector<
-      std::tuple<unsigned int,
-                 unsigned int,
-                 std::string,
-                 DataComponentInterpretation::DataComponentInterpretation>>
-      &             nonscalar_data_ranges,
-    const VtkFlags &flags,
-    std::ostream &  out)
-  {
-    write_vtu_header(out, flags);
-    write_vtu_main(patches, data_names, nonscalar_data_ranges, flags, out);
-    write_vtu_footer(out);
+    // copy the data arrays in blocks rather than all at once, so that they
+    // need not fit into memory if they are stored in a file
+    std::vector<char> buffer(1 << 16);
+    while (appended_data)
+      {
+        appended_data.read(buffer.data(), buffer.size());
+        out.write(buffer.data(), appended_data.gcount());
+      }
+    AssertThrow(appended_data.eof(), ExcIO());
 
-    out << std::flush;
+    out << "\n</AppendedData>\n";
+    out << "</VTKFile>\n";
+    AssertThrow(out, ExcIO());
   }
 
 
@@ -5532,9 +5858,18 @@ namespace DataOutBase
 
 
 
+  /**
+   * Write the main part of a VTU file. If the data is to be written in raw
+   * binary format, the data arrays are written to @p appended_data instead
+   * of @p out. If @p appended_data is a null pointer in this case, the data
+   * arrays are not computed at all, and only the XML description with the
+   * offsets of the data arrays is written to @p out. The offsets start at
+   * @p appended_data_size, which is incremented by the size of the data
+   * arrays of the patches.
+   */
   template <int dim, int spacedim>
   void
-  write_vtu_main(
+  do_write_vtu_main(
     const std::vector<Patch<dim, spacedim>> &patches,
     const std::vector<std::string> &         data_names,
     const std::vector<
@@ -5542,9 +5877,11 @@ namespace DataOutBase
                  unsigned int,
                  std::string,
                  DataComponentInterpretation::DataComponentInterpretation>>
-      &             nonscalar_data_ranges,
+      &                nonscalar_data_ranges,
     const VtkFlags &flags,
-    std::ostream &  out)
+    std::ostream &  out,
+    std::ostream *  appended_data,
+    std::size_t &   appended_data_size)
   {
     AssertThrow(out, ExcIO());
 
@@ -5611,37 +5948,7 @@ namespace DataOutBase
       }
 #endif
 
-    // first up: metadata
-    //
-    // if desired, output time and cycle of the simulation, following the
-    // instructions at
-    // http://www.visitusers.org/index.php?title=Time_and_Cycle_in_VTK_files
-    {
-      const unsigned int n_metadata =
-        ((flags.cycle != std::numeric_limits<unsigned int>::min() ? 1 : 0) +
-         (flags.time != std::numeric_limits<double>::min() ? 1 : 0));
-      if (n_metadata > 0)
-        out << "<FieldData>\n";
-
-      if (flags.cycle != std::numeric_limits<unsigned int>::min())
-        {
-          out
-            << "<DataArray type=\"Float32\" Name=\"CYCLE\" NumberOfTuples=\"1\" format=\"ascii\">"
-            << flags.cycle << "</DataArray>\n";
-        }
-      if (flags.time != std::numeric_limits<double>::min())
-        {
-          out
-            << "<DataArray type=\"Float32\" Name=\"TIME\" NumberOfTuples=\"1\" format=\"ascii\">"
-            << flags.time << "</DataArray>\n";
-        }
-
-      if (n_metadata > 0)
-        out << "</FieldData>\n";
-    }
-
-
-    VtuStream vtu_out(out, flags);
+    VtuStream vtu_out(out, flags, appended_data, appended_data_size);
 
     const unsigned int n_data_sets = data_names.size();
     // check against # of data sets in first patch. checks against all other
@@ -5655,13 +5962,6 @@ namespace DataOutBase
         AssertDimension(n_data_sets, patches[0].data.n_rows())
       }
 
-#ifdef DEAL_II_WITH_ZLIB
-    const char *ascii_or_binary = "binary";
-#else
-    const char *ascii_or_binary = "ascii";
-#endif
-
-
     // first count the number of cells and cells for later use
     unsigned int n_nodes;
     unsigned int n_cells;
@@ -5689,13 +5989,20 @@ namespace DataOutBase
     // this copying of data vectors can be done while we already output the
     // vertices, so do this on a separate task and when wanting to write out the
     // data, we wait for that task to finish
-    Table<2, float> data_vectors(n_data_sets, n_nodes);
+    //
+    // none of this is necessary if we only compute the offsets of the data
+    // arrays in raw binary format
+    Table<2, float> data_vectors;
+    Threads::Task<> reorder_task;
+    if (vtu_out.writes_data())
+      {
+        data_vectors.reinit(n_data_sets, n_nodes);
 
-    void (*fun_ptr)(const std::vector<Patch<dim, spacedim>> &,
-                    Table<2, float> &) =
-      &write_gmv_reorder_data_vectors<dim, spacedim, float>;
-    Threads::Task<> reorder_task =
-      Threads::new_task(fun_ptr, patches, data_vectors);
+        void (*fun_ptr)(const std::vector<Patch<dim, spacedim>> &,
+                        Table<2, float> &) =
+          &write_gmv_reorder_data_vectors<dim, spacedim, float>;
+        reorder_task = Threads::new_task(fun_ptr, patches, data_vectors);
+      }
 
     ///////////////////////////////
     // first make up a list of used vertices along with their coordinates
@@ -5705,16 +6012,16 @@ namespace DataOutBase
     out << "<Piece NumberOfPoints=\"" << n_nodes << "\" NumberOfCells=\""
         << n_cells << "\" >\n";
     out << "  <Points>\n";
-    out << "    <DataArray type=\"Float32\" NumberOfComponents=\"3\" format=\""
-        << ascii_or_binary << "\">\n";
+    out << "    <DataArray type=\"Float32\" NumberOfComponents=\"3\" "
+        << vtu_out.format_attributes() << ">\n";
     write_nodes(patches, vtu_out);
     out << "    </DataArray>\n";
     out << "  </Points>\n\n";
     /////////////////////////////////
     // now for the cells
     out << "  <Cells>\n";
-    out << "    <DataArray type=\"Int32\" Name=\"connectivity\" format=\""
-        << ascii_or_binary << "\">\n";
+    out << "    <DataArray type=\"Int32\" Name=\"connectivity\" "
+        << vtu_out.format_attributes() << ">\n";
     if (flags.write_higher_order_cells)
       write_high_order_cells(patches, vtu_out);
     else
@@ -5723,8 +6030,8 @@ namespace DataOutBase
 
     // XML VTU format uses offsets; this is different than the VTK format, which
     // puts the number of nodes per cell in front of the connectivity list.
-    out << "    <DataArray type=\"Int32\" Name=\"offsets\" format=\""
-        << ascii_or_binary << "\">\n";
+    out << "    <DataArray type=\"Int32\" Name=\"offsets\" "
+        << vtu_out.format_attributes() << ">\n";
 
     std::vector<int32_t> offsets(n_cells);
     for (unsigned int i = 0; i < n_cells; ++i)
@@ -5735,8 +6042,8 @@ namespace DataOutBase
 
     // next output the types of the cells. since all cells are the same, this is
     // simple
-    out << "    <DataArray type=\"UInt8\" Name=\"types\" format=\""
-        << ascii_or_binary << "\">\n";
+    out << "    <DataArray type=\"UInt8\" Name=\"types\" "
+        << vtu_out.format_attributes() << ">\n";
 
     {
       // need to distinguish between linear and high order cells
@@ -5746,14 +6053,18 @@ namespace DataOutBase
 
       // uint8_t might be an alias to unsigned char which is then not printed
       // as ascii integers
-#ifdef DEAL_II_WITH_ZLIB
-      std::vector<uint8_t> cell_types(n_cells,
-                                      static_cast<uint8_t>(vtk_cell_id));
-#else
-      std::vector<unsigned int> cell_types(n_cells, vtk_cell_id);
-#endif
-      // this should compress well :-)
-      vtu_out << cell_types;
+      if (vtu_out.writes_ascii())
+        {
+          std::vector<unsigned int> cell_types(n_cells, vtk_cell_id);
+          vtu_out << cell_types;
+        }
+      else
+        {
+          std::vector<uint8_t> cell_types(n_cells,
+                                          static_cast<uint8_t>(vtk_cell_id));
+          // this should compress well :-)
+          vtu_out << cell_types;
+        }
     }
     out << "\n";
     out << "    </DataArray>\n";
@@ -5765,7 +6076,8 @@ namespace DataOutBase
 
     // now write the data vectors to @p{out} first make sure that all data is in
     // place
-    reorder_task.join();
+    if (reorder_task.joinable())
+      reorder_task.join();
 
     // then write data.  the 'POINT_DATA' means: node data (as opposed to cell
     // data, which we do not support explicitly here). all following data sets
@@ -5820,8 +6132,15 @@ namespace DataOutBase
             out << data_names[last_component];
           }
 
-        out << "\" NumberOfComponents=\"" << n_components << "\" format=\""
-            << ascii_or_binary << "\">\n";
+        out << "\" NumberOfComponents=\"" << n_components << "\" "
+            << vtu_out.format_attributes() << ">\n";
+
+        if (!vtu_out.writes_data())
+          {
+            vtu_out.skip_data<float>(n_nodes * n_components);
+            out << "    </DataArray>\n";
+            continue;
+          }
 
         // now write data. pad all vectors to have three components
         std::vector<float> data;
@@ -5902,12 +6221,17 @@ namespace DataOutBase
       if (data_set_written[data_set] == false)
         {
           out << "    <DataArray type=\"Float32\" Name=\""
-              << data_names[data_set] << "\" format=\"" << ascii_or_binary
-              << "\">\n";
+              << data_names[data_set] << "\" " << vtu_out.format_attributes()
+              << ">\n";
 
-          std::vector<float> data(data_vectors[data_set].begin(),
-                                  data_vectors[data_set].end());
-          vtu_out << data;
+          if (vtu_out.writes_data())
+            {
+              std::vector<float> data(data_vectors[data_set].begin(),
+                                      data_vectors[data_set].end());
+              vtu_out << data;
+            }
+          else
+            vtu_out.skip_data<float>(n_nodes);
           out << "    </DataArray>\n";
         }
 
@@ -5916,6 +6240,8 @@ namespace DataOutBase
     // Finish up writing a valid XML file
     out << " </Piece>\n";
 
+    appended_data_size = vtu_out.get_appended_data_size();
+
     // make sure everything now gets to disk
     out.flush();
 
@@ -5925,6 +6251,164 @@ namespace DataOutBase
 
 
 
+  template <int dim, int spacedim>
+  void
+  write_vtu_main(
+    const std::vector<Patch<dim, spacedim>> &patches,
+    const std::vector<std::string> &         data_names,
+    const std::vector<
+      std::tuple<unsigned int,
+                 unsigned int,
+                 std::string,
+                 DataComponentInterpretation::DataComponentInterpretation>>
+      &             nonscalar_data_ranges,
+    const VtkFlags &flags,
+    std::ostream &  out)
+  {
+    AssertThrow(flags.data_format != VtkFlags::raw_appended,
+                ExcMessage("VTU output in raw binary format needs a separate "
+                           "stream for the data arrays. Use the version of "
+                           "write_vtu_main() that takes one."));
+
+    std::size_t appended_data_size = 0;
+    do_write_vtu_main(patches,
+                      data_names,
+                      nonscalar_data_ranges,
+                      flags,
+                      out,
+                      nullptr,
+                      appended_data_size);
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  write_vtu_main(
+    const std::vector<Patch<dim, spacedim>> &patches,
+    const std::vector<std::string> &         data_names,
+    const std::vector<
+      std::tuple<unsigned int,
+                 unsigned int,
+                 std::string,
+                 DataComponentInterpretation::DataComponentInterpretation>>
+      &             nonscalar_data_ranges,
+    const VtkFlags &flags,
+    std::ostream &  out,
+    std::ostream &  appended_data,
+    std::size_t &   appended_data_size)
+  {
+    AssertThrow(flags.data_format == VtkFlags::raw_appended,
+                ExcMessage("A separate stream for the data arrays can only be "
+                           "used for VTU output in raw binary format."));
+    AssertThrow(appended_data, ExcIO());
+
+    do_write_vtu_main(patches,
+                      data_names,
+                      nonscalar_data_ranges,
+                      flags,
+                      out,
+                      &appended_data,
+                      appended_data_size);
+
+    AssertThrow(appended_data, ExcIO());
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  write_vtu(
+    const std::vector<Patch<dim, spacedim>> &patches,
+    const std::vector<std::string> &         data_names,
+    const std::vector<std::tuple<unsigned int, unsigned int, std::string>>
+      &             nonscalar_data_ranges,
+    const VtkFlags &flags,
+    std::ostream &  out)
+  {
+    const unsigned int size = nonscalar_data_ranges.size();
+    std::vector<
+      std::tuple<unsigned int,
+                 unsigned int,
+                 std::string,
+                 DataComponentInterpretation::DataComponentInterpretation>>
+      new_nonscalar_data_ranges(size);
+    for (unsigned int i = 0; i < size; ++i)
+      {
+        new_nonscalar_data_ranges[i] =
+          std::tuple<unsigned int,
+                     unsigned int,
+                     std::string,
+                     DataComponentInterpretation::DataComponentInterpretation>(
+            std::get<0>(nonscalar_data_ranges[i]),
+            std::get<1>(nonscalar_data_ranges[i]),
+            std::get<2>(nonscalar_data_ranges[i]),
+            DataComponentInterpretation::component_is_part_of_vector);
+      }
+
+    write_vtu(patches, data_names, new_nonscalar_data_ranges, flags, out);
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  write_vtu(
+    const std::vector<Patch<dim, spacedim>> &patches,
+    const std::vector<std::string> &         data_names,
+    const std::vector<
+      std::tuple<unsigned int,
+                 unsigned int,
+                 std::string,
+                 DataComponentInterpretation::DataComponentInterpretation>>
+      &             nonscalar_data_ranges,
+    const VtkFlags &flags,
+    std::ostream &  out)
+  {
+    write_vtu_header(out, flags);
+    if (flags.data_format == VtkFlags::raw_appended)
+      {
+        // the data arrays form a single block that follows the XML
+        // description of the grid and is prefixed by an underscore. rather
+        // than collecting them in memory, go over the patches twice: first
+        // write the XML description with the offsets of the data arrays
+        // without computing the arrays, then compute the arrays and write
+        // them directly to the output stream. the XML description written in
+        // the second pass is the same as in the first one and is discarded
+        std::size_t appended_data_size = 0;
+        do_write_vtu_main(patches,
+                          data_names,
+                          nonscalar_data_ranges,
+                          flags,
+                          out,
+                          nullptr,
+                          appended_data_size);
+
+        out << " </UnstructuredGrid>\n";
+        out << "<AppendedData encoding=\"raw\">\n_";
+        std::ostringstream xml_out;
+        appended_data_size = 0;
+        do_write_vtu_main(patches,
+                          data_names,
+                          nonscalar_data_ranges,
+                          flags,
+                          xml_out,
+                          &out,
+                          appended_data_size);
+        out << "\n</AppendedData>\n";
+        out << "</VTKFile>\n";
+      }
+    else
+      {
+        write_vtu_main(patches, data_names, nonscalar_data_ranges, flags, out);
+        write_vtu_footer(out);
+      }
+
+    out << std::flush;
+  }
+
+
+
   void
   write_pvtu_record(
     std::ostream &                  out,
@@ -7429,6 +7913,56 @@ DataOutInterface<dim, spacedim>::write_vtu(std::ostream &out) const
                          out);
 }
 
+template <int dim, int spacedim>
+void
+DataOutInterface<dim, spacedim>::write_vtu_header(std::ostream &out) const
+{
+  DataOutBase::write_vtu_header(out, vtk_flags);
+}
+
+template <int dim, int spacedim>
+void
+DataOutInterface<dim, spacedim>::write_vtu_main(std::ostream &out) const
+{
+  DataOutBase::write_vtu_main(get_patches(),
+                              get_dataset_names(),
+                              get_nonscalar_data_ranges(),
+                              vtk_flags,
+                              out);
+}
+
+template <int dim, int spacedim>
+void
+DataOutInterface<dim, spacedim>::write_vtu_main(
+  std::ostream &out,
+  std::ostream &appended_data,
+  std::size_t & appended_data_size) const
+{
+  DataOutBase::write_vtu_main(get_patches(),
+                              get_dataset_names(),
+                              get_nonscalar_data_ranges(),
+                              vtk_flags,
+                              out,
+                              appended_data,
+                              appended_data_size);
+}
+
+template <int dim, int spacedim>
+void
+DataOutInterface<dim, spacedim>::write_vtu_footer(std::ostream &out) const
+{
+  DataOutBase::write_vtu_footer(out);
+}
+
+template <int dim, int spacedim>
+void
+DataOutInterface<dim, spacedim>::write_vtu_footer(
+  std::ostream &out,
+  std::istream &appended_data) const
+{
+  DataOutBase::write_vtu_footer(out, appended_data);
+}
+
 template <int dim, int spacedim>
 void
 DataOutInterface<dim, spacedim>::write_svg(std::ostream &out) const
@@ -7446,6 +7980,11 @@ DataOutInterface<dim, spacedim>::write_vtu_in_parallel(
   const std::string &filename,
   MPI_Comm           comm) const
 {
+  // check this before opening the file, on all processes
+  AssertThrow(vtk_flags.data_format != DataOutBase::VtkFlags::raw_appended,
+              ExcMessage("VTU output in raw binary format is not supported "
+                         "by write_vtu_in_parallel()."));
+
 #ifndef DEAL_II_WITH_MPI
   // without MPI fall back to the normal way to write a vtu file:
   (void)comm;
@@ -7773,6 +8312,20 @@ DataOutBase::write_filtered_data(
 
   compute_sizes<dim, spacedim>(patches, n_node, n_cell);
 
+  // if the filter still has the nodes and cells from an earlier call, keep
+  // them and only record the data sets
+  const bool write_nodes_and_cells = (filtered_data.n_nodes() == 0);
+  if (!write_nodes_and_cells)
+    {
+      AssertThrow(filtered_data.n_data_sets() == 0,
+                  ExcMessage("The DataOutFilter object already contains data "
+                             "sets. Call DataOutFilter::clear_data_sets() "
+                             "before filling it again."));
+      AssertThrow(filtered_data.n_cells() == n_cell,
+                  ExcMessage("The patches do not match the cells stored in "
+                             "the DataOutFilter object."));
+    }
+
   data_vectors = Table<2, double>(n_data_sets, n_node);
   void (*fun_ptr)(const std::vector<Patch<dim, spacedim>> &,
                   Table<2, double> &) =
@@ -7780,8 +8333,11 @@ DataOutBase::write_filtered_data(
   reorder_task = Threads::new_task(fun_ptr, patches, data_vectors);
 
   // Write the nodes/cells to the DataOutFilter object.
-  write_nodes(patches, filtered_data);
-  write_cells(patches, filtered_data);
+  if (write_nodes_and_cells)
+    {
+      write_nodes(patches, filtered_data);
+      write_cells(patches, filtered_data);
+    }
 
   // Ensure reordering is done before we output data set values
   reorder_task.join();
@@ -0,0 +1,195 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#include <deal.II/base/flat_binary_archive.h>
+#include <deal.II/base/types.h>
+
+#include <algorithm>
+#include <iterator>
+
+#ifdef DEAL_II_HAVE_UNISTD_H
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+
+DEAL_II_NAMESPACE_OPEN
+
+
+namespace FlatBinaryArchive
+{
+  namespace
+  {
+    // the eight bytes every file starts with, including the terminating
+    // zero of the string
+    const char magic_number[8] = "deal.II";
+
+    // written as a 32 bit integer to identify the byte order
+    const std::uint32_t byte_order_mark = 0x01020304;
+  } // namespace
+
+
+
+  OutputArchive::OutputArchive(const std::string &filename,
+                               const std::string &content_description)
+    : out(filename, std::ios::out | std::ios::binary)
+    , position(0)
+  {
+    AssertThrow(out, ExcFileNotOpen(filename));
+
+    write_bytes(magic_number, sizeof(magic_number));
+    *this &format_version;
+    *this &byte_order_mark;
+    const std::uint32_t dof_index_size = sizeof(types::global_dof_index);
+    *this &dof_index_size;
+    *this &content_description;
+  }
+
+
+
+  void
+  OutputArchive::write_bytes(const void *data, const std::size_t n_bytes)
+  {
+    out.write(static_cast<const char *>(data), n_bytes);
+    AssertThrow(out, ExcIO());
+    position += n_bytes;
+  }
+
+
+
+  void
+  OutputArchive::align(const std::size_t alignment)
+  {
+    static const char zeros[16] = {};
+    Assert(alignment <= sizeof(zeros), ExcNotImplemented());
+
+    const std::size_t n_padding_bytes =
+      (alignment - position % alignment) % alignment;
+    write_bytes(zeros, n_padding_bytes);
+  }
+
+
+
+  InputArchive::InputArchive(const std::string &filename,
+                             const std::string &content_description)
+    : filename(filename)
+    , mapped_data(nullptr)
+    , data(nullptr)
+    , size(0)
+    , position(0)
+  {
+#ifdef DEAL_II_HAVE_UNISTD_H
+    const int file_descriptor = open(filename.c_str(), O_RDONLY);
+    AssertThrow(file_descriptor != -1, ExcFileNotOpen(filename));
+
+    struct stat file_status;
+    if (fstat(file_descriptor, &file_status) == 0 && file_status.st_size > 0)
+      {
+        void *const mapping = mmap(nullptr,
+                                   file_status.st_size,
+                                   PROT_READ,
+                                   MAP_PRIVATE,
+                                   file_descriptor,
+                                   0);
+        if (mapping != MAP_FAILED)
+          {
+            mapped_data = mapping;
+            data        = static_cast<const char *>(mapping);
+            size        = file_status.st_size;
+          }
+      }
+    close(file_descriptor);
+#endif
+
+    // if the file could not be mapped into memory, read it instead
+    if (mapped_data == nullptr)
+      {
+        std::ifstream in(filename, std::ios::in | std::ios::binary);
+        AssertThrow(in, ExcFileNotOpen(filename));
+        buffer.assign(std::istreambuf_iterator<char>(in),
+                      std::istreambuf_iterator<char>());
+        data = buffer.data();
+        size = buffer.size();
+      }
+
+    const char *const file_magic_number = read_bytes(sizeof(magic_number));
+    AssertThrow(std::equal(magic_number,
+                           magic_number + sizeof(magic_number),
+                           file_magic_number),
+                ExcMessage("The file <" + filename +
+                           "> is not a flat binary archive."));
+
+    std::uint32_t file_format_version;
+    *this &file_format_version;
+    AssertThrow(file_format_version == format_version,
+                ExcMessage("The file <" + filename +
+                           "> was written in version " +
+                           std::to_string(file_format_version) +
+                           " of the flat binary format, but this version of "
+                           "deal.II can only read version " +
+                           std::to_string(format_version) + "."));
+
+    std::uint32_t file_byte_order_mark, file_dof_index_size;
+    *this &file_byte_order_mark &file_dof_index_size;
+    AssertThrow(file_byte_order_mark == byte_order_mark &&
+                  file_dof_index_size == sizeof(types::global_dof_index),
+                ExcMessage("The file <" + filename +
+                           "> was written on a machine with a different byte "
+                           "order or by a deal.II installation with a "
+                           "different size of types::global_dof_index."));
+
+    std::string file_content_description;
+    *this &file_content_description;
+    AssertThrow(file_content_description == content_description,
+                ExcMessage("The file <" + filename + "> contains a " +
+                           file_content_description + " object, but a " +
+                           content_description + " object was expected."));
+  }
+
+
+
+  InputArchive::~InputArchive()
+  {
+#ifdef DEAL_II_HAVE_UNISTD_H
+    if (mapped_data != nullptr)
+      munmap(mapped_data, size);
+#endif
+  }
+
+
+
+  const char *
+  InputArchive::read_bytes(const std::size_t n_bytes)
+  {
+    AssertThrow(n_bytes <= size - position,
+                ExcMessage("The file <" + filename +
+                           "> ends before all data could be read from it."));
+    const char *const bytes = data + position;
+    position += n_bytes;
+    return bytes;
+  }
+
+
+
+  void
+  InputArchive::align(const std::size_t alignment)
+  {
+    read_bytes((alignment - position % alignment) % alignment);
+  }
+} // namespace FlatBinaryArchive
+
+
+DEAL_II_NAMESPACE_CLOSE
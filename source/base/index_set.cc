@@ -179,6 +179,8 @@ IndexSet::do_compress() const
           largest_range      = i - ranges.begin();
         }
     }
+
+  setup_bitmap();
   is_compressed = true;
 
   // check that next_index is correct. needs to be after the previous
@@ -348,6 +350,10 @@ IndexSet::pop_back()
   if (ranges.back().begin == ranges.back().end)
     ranges.pop_back();
 
+  // the ranges remain compressed, but the bitmap would have to be updated.
+  // simply fall back to searching the ranges
+  bitmap.clear();
+
   return index;
 }
 
@@ -467,6 +473,183 @@ IndexSet::read(std::istream &in)
 }
 
 
+void
+IndexSet::setup_bitmap() const
+{
+  bitmap.clear();
+
+  // for index sets with only a few ranges, a binary search over the ranges
+  // is cheap enough
+  const unsigned int min_n_ranges = 16;
+  if (ranges.size() < min_n_ranges)
+    return;
+
+  const Range &main_range = ranges[largest_range];
+
+  // the bitmap is only worth its memory if its words are dense enough. if
+  // the words are stored contiguously, we allow them to span up to four
+  // words per range plus four words per 64 elements of the set, so that
+  // ghost indices scattered around a locally owned range are still
+  // covered. if only the words that contain elements are stored, there may
+  // be at most two of them per range. either way, the bitmap takes at most
+  // four times the memory of the ranges plus one byte per element
+  const size_type n_elements =
+    ranges.back().nth_index_in_set + (ranges.back().end - ranges.back().begin);
+  const std::size_t max_n_contiguous_words =
+    4 * (ranges.size() + n_elements / 64);
+  const std::size_t max_n_stored_words = 2 * ranges.size();
+  const std::size_t max_n_words =
+    std::max(max_n_contiguous_words, max_n_stored_words);
+
+  // first count the number of words that contain elements. words that are
+  // completely covered by the largest range do not need to be stored. give
+  // up as soon as there are more words than either layout allows
+  std::size_t n_words    = 0;
+  size_type   last_word  = numbers::invalid_dof_index;
+  const auto  count_word = [&](const size_type word) {
+    if (word != last_word)
+      {
+        ++n_words;
+        last_word = word;
+      }
+  };
+  for (const Range &range : ranges)
+    {
+      const size_type first_word_of_range = range.begin / 64;
+      const size_type last_word_of_range  = (range.end - 1) / 64;
+      if (&range == &main_range)
+        {
+          count_word(first_word_of_range);
+          count_word(last_word_of_range);
+        }
+      else
+        for (size_type word = first_word_of_range; word <= last_word_of_range;
+             ++word)
+          {
+            count_word(word);
+            if (n_words > max_n_words)
+              return;
+          }
+      if (n_words > max_n_words)
+        return;
+    }
+
+  const size_type first_word = ranges.front().begin / 64;
+  const size_type n_contiguous_words =
+    (ranges.back().end - 1) / 64 - first_word + 1;
+  const bool store_contiguously =
+    (n_contiguous_words <= max_n_contiguous_words);
+  if (!store_contiguously && n_words > max_n_stored_words)
+    return;
+
+  // now fill the words. since the ranges are sorted, the words are
+  // created in ascending order
+  bitmap.words.reserve(n_words);
+  bitmap.word_indices.reserve(n_words);
+  bitmap.ranks.reserve(n_words);
+  const auto set_bits = [&](const Range &   range,
+                            const size_type word,
+                            const size_type begin,
+                            const size_type end) {
+    if (bitmap.word_indices.empty() || bitmap.word_indices.back() != word)
+      {
+        // the number of elements before the word: those in earlier
+        // ranges (which cannot reach into this word, since we would then
+        // have created it already) and those of the current range
+        const size_type word_begin = 64 * word;
+        bitmap.words.push_back(0);
+        bitmap.word_indices.push_back(word);
+        bitmap.ranks.push_back(range.nth_index_in_set +
+                               (word_begin > range.begin ?
+                                  word_begin - range.begin :
+                                  0));
+      }
+
+    const unsigned int first_bit = begin - 64 * word;
+    const unsigned int n_bits    = end - begin;
+    const std::uint64_t mask =
+      (n_bits == 64 ? ~std::uint64_t(0) :
+                      ((std::uint64_t(1) << n_bits) - 1) << first_bit);
+    bitmap.words.back() |= mask;
+  };
+  for (const Range &range : ranges)
+    {
+      const size_type first_word_of_range = range.begin / 64;
+      const size_type last_word_of_range  = (range.end - 1) / 64;
+      for (size_type word = first_word_of_range; word <= last_word_of_range;
+           ++word)
+        {
+          if (&range == &main_range && word != first_word_of_range &&
+              word != last_word_of_range)
+            continue;
+          set_bits(range,
+                   word,
+                   std::max(range.begin, 64 * word),
+                   std::min(range.end, 64 * (word + 1)));
+        }
+    }
+  Assert(bitmap.words.size() == n_words, ExcInternalError());
+
+  // if the stored words are dense, store them contiguously so that the
+  // position of a word can be computed rather than searched for
+  Assert(bitmap.word_indices.front() == first_word &&
+           bitmap.word_indices.back() == first_word + n_contiguous_words - 1,
+         ExcInternalError());
+  if (store_contiguously)
+    {
+      std::vector<std::uint64_t> words(n_contiguous_words, 0);
+      std::vector<size_type>     ranks(n_contiguous_words);
+      std::size_t                next = 0;
+      for (size_type w = 0; w < n_contiguous_words; ++w)
+        {
+          const size_type word = first_word + w;
+          if (bitmap.word_indices[next] == word)
+            {
+              words[w] = bitmap.words[next];
+              ranks[w] = bitmap.ranks[next];
+              ++next;
+            }
+          else if (64 * word > main_range.begin && 64 * word < main_range.end)
+            // an omitted word inside the largest range
+            ranks[w] =
+              main_range.nth_index_in_set + (64 * word - main_range.begin);
+          else
+            // an empty word: all elements before it also come before the
+            // next stored word
+            ranks[w] = bitmap.ranks[next];
+        }
+
+      bitmap.words.swap(words);
+      bitmap.ranks.swap(ranks);
+      bitmap.word_indices.clear();
+      bitmap.word_indices.shrink_to_fit();
+      bitmap.first_word = first_word;
+    }
+}
+
+
+
+void
+IndexSet::Bitmap::clear()
+{
+  words.clear();
+  word_indices.clear();
+  ranks.clear();
+  first_word = 0;
+}
+
+
+
+std::size_t
+IndexSet::Bitmap::memory_consumption() const
+{
+  return (MemoryConsumption::memory_consumption(words) +
+          MemoryConsumption::memory_consumption(word_indices) +
+          MemoryConsumption::memory_consumption(ranks) + sizeof(first_word));
+}
+
+
+
 void
 IndexSet::block_write(std::ostream &out) const
 {
@@ -727,6 +910,7 @@ std::size_t
 IndexSet::memory_consumption() const
 {
   return (MemoryConsumption::memory_consumption(ranges) +
+          bitmap.memory_consumption() +
           MemoryConsumption::memory_consumption(is_compressed) +
           MemoryConsumption::memory_consumption(index_space_size) +
           sizeof(compress_mutex));
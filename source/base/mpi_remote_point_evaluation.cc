@@ -0,0 +1,480 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/mpi_remote_point_evaluation.h>
+#include <deal.II/base/std_cxx14/memory.h>
+
+#include <deal.II/distributed/tria_base.h>
+
+#include <deal.II/fe/fe.h>
+#include <deal.II/fe/fe_values.h>
+
+#include <deal.II/grid/filtered_iterator.h>
+#include <deal.II/grid/grid_tools.h>
+
+#include <algorithm>
+#include <numeric>
+#include <tuple>
+
+DEAL_II_NAMESPACE_OPEN
+
+namespace Utilities
+{
+  namespace MPI
+  {
+    template <int dim, int spacedim>
+    RemotePointEvaluation<dim, spacedim>::~RemotePointEvaluation()
+    {
+      // release the caches before the pointers to the triangulation and
+      // the mapping they depend on
+      fe_values_cache.clear();
+      cache.reset();
+    }
+
+
+
+    template <int dim, int spacedim>
+    void
+    RemotePointEvaluation<dim, spacedim>::reinit(
+      const std::vector<Point<spacedim>> &points,
+      const Triangulation<dim, spacedim> &tria,
+      const Mapping<dim, spacedim> &      mapping)
+    {
+      fe_values_cache.clear();
+      this->cache.reset();
+      this->tria    = &tria;
+      this->mapping = &mapping;
+      this->points  = points;
+
+      points_for_rank.clear();
+      indices_from_rank.clear();
+
+      cache =
+        std_cxx14::make_unique<GridTools::Cache<dim, spacedim>>(tria, mapping);
+
+      distributed  = false;
+      communicator = MPI_COMM_SELF;
+      global_bboxes.clear();
+
+#ifdef DEAL_II_WITH_MPI
+      if (const auto parallel_tria =
+            dynamic_cast<const parallel::Triangulation<dim, spacedim> *>(
+              &tria))
+        {
+          distributed  = true;
+          communicator = parallel_tria->get_communicator();
+
+          const std::vector<BoundingBox<spacedim>> local_bboxes =
+            GridTools::compute_mesh_predicate_bounding_box(
+              tria,
+              std::function<bool(
+                const typename Triangulation<dim, spacedim>::
+                  active_cell_iterator &)>(IteratorFilters::LocallyOwnedCell()),
+              1,
+              true,
+              4);
+          global_bboxes = Utilities::MPI::all_gather(communicator, local_bboxes);
+        }
+#endif
+
+      std::vector<unsigned int> point_indices(points.size());
+      std::iota(point_indices.begin(), point_indices.end(), 0U);
+      locate_points(point_indices);
+
+      setup_cell_data();
+    }
+
+
+
+    template <int dim, int spacedim>
+    void
+    RemotePointEvaluation<dim, spacedim>::update_points(
+      const std::vector<unsigned int> &   indices,
+      const std::vector<Point<spacedim>> &new_points)
+    {
+      Assert(tria != nullptr,
+             ExcMessage("RemotePointEvaluation::reinit() has not been "
+                        "called yet."));
+      AssertDimension(indices.size(), new_points.size());
+
+      const unsigned int my_rank = Utilities::MPI::this_mpi_process(communicator);
+
+      std::vector<bool> moved(points.size(), false);
+      for (unsigned int i = 0; i < indices.size(); ++i)
+        {
+          AssertIndexRange(indices[i], points.size());
+          moved[indices[i]]  = true;
+          points[indices[i]] = new_points[i];
+        }
+
+      // drop the moved points from the lists of values we receive and
+      // record, for each evaluating process, which of the values it sends
+      // to us are no longer needed
+      std::map<unsigned int, std::vector<unsigned int>> positions_to_remove;
+      for (auto &rank_and_indices : indices_from_rank)
+        {
+          std::vector<unsigned int> kept_indices;
+          kept_indices.reserve(rank_and_indices.second.size());
+          for (unsigned int i = 0; i < rank_and_indices.second.size(); ++i)
+            if (moved[rank_and_indices.second[i]])
+              positions_to_remove[rank_and_indices.first].push_back(i);
+            else
+              kept_indices.push_back(rank_and_indices.second[i]);
+          rank_and_indices.second.swap(kept_indices);
+        }
+
+      std::vector<unsigned int> own_positions;
+      {
+        const auto own = positions_to_remove.find(my_rank);
+        if (own != positions_to_remove.end())
+          {
+            own_positions.swap(own->second);
+            positions_to_remove.erase(own);
+          }
+      }
+
+      std::map<unsigned int, std::vector<unsigned int>> received_positions;
+      if (distributed)
+        received_positions =
+          Utilities::MPI::some_to_some(communicator, positions_to_remove);
+      if (own_positions.size() > 0)
+        received_positions[my_rank].swap(own_positions);
+
+      for (const auto &rank_and_positions : received_positions)
+        {
+          auto &entries = points_for_rank[rank_and_positions.first];
+
+          std::vector<bool> removed(entries.size(), false);
+          for (const unsigned int position : rank_and_positions.second)
+            {
+              AssertIndexRange(position, entries.size());
+              removed[position] = true;
+            }
+
+          unsigned int n_kept = 0;
+          for (unsigned int i = 0; i < entries.size(); ++i)
+            if (removed[i] == false)
+              entries[n_kept++] = entries[i];
+          entries.resize(n_kept);
+        }
+
+      // now search only for the moved points
+      locate_points(indices);
+
+      setup_cell_data();
+    }
+
+
+
+    template <int dim, int spacedim>
+    void
+    RemotePointEvaluation<dim, spacedim>::locate_points(
+      const std::vector<unsigned int> &point_indices)
+    {
+      const unsigned int my_rank = Utilities::MPI::this_mpi_process(communicator);
+
+      std::vector<Point<spacedim>> local_points(point_indices.size());
+      for (unsigned int i = 0; i < point_indices.size(); ++i)
+        local_points[i] = points[point_indices[i]];
+
+      if (distributed)
+        {
+#ifdef DEAL_II_WITH_MPI
+          const auto result = GridTools::distributed_compute_point_locations(
+            *cache, local_points, global_bboxes);
+          const auto &cells   = std::get<0>(result);
+          const auto &qpoints = std::get<1>(result);
+          const auto &maps    = std::get<2>(result);
+          const auto &owners  = std::get<4>(result);
+
+          // for each owning process, the positions within its list of
+          // searched points of the points we found, in the same order as
+          // the entries appended to points_for_rank
+          std::map<unsigned int, std::vector<unsigned int>> found_positions;
+          for (unsigned int c = 0; c < cells.size(); ++c)
+            {
+              const std::pair<int, int> cell(cells[c]->level(),
+                                             cells[c]->index());
+              for (unsigned int q = 0; q < qpoints[c].size(); ++q)
+                {
+                  points_for_rank[owners[c][q]].emplace_back(cell,
+                                                             qpoints[c][q]);
+                  found_positions[owners[c][q]].push_back(maps[c][q]);
+                }
+            }
+
+          std::vector<unsigned int> own_positions;
+          {
+            const auto own = found_positions.find(my_rank);
+            if (own != found_positions.end())
+              {
+                own_positions.swap(own->second);
+                found_positions.erase(own);
+              }
+          }
+
+          auto received_positions =
+            Utilities::MPI::some_to_some(communicator, found_positions);
+          if (own_positions.size() > 0)
+            received_positions[my_rank].swap(own_positions);
+
+          for (const auto &rank_and_positions : received_positions)
+            {
+              auto &indices = indices_from_rank[rank_and_positions.first];
+              for (const unsigned int position : rank_and_positions.second)
+                {
+                  AssertIndexRange(position, point_indices.size());
+                  indices.push_back(point_indices[position]);
+                }
+            }
+#else
+          Assert(false, ExcInternalError());
+#endif
+        }
+      else
+        {
+          const auto result =
+            GridTools::compute_point_locations_try_all(*cache, local_points);
+          const auto &cells   = std::get<0>(result);
+          const auto &qpoints = std::get<1>(result);
+          const auto &maps    = std::get<2>(result);
+
+          auto &entries = points_for_rank[my_rank];
+          auto &indices = indices_from_rank[my_rank];
+          for (unsigned int c = 0; c < cells.size(); ++c)
+            {
+              const std::pair<int, int> cell(cells[c]->level(),
+                                             cells[c]->index());
+              for (unsigned int q = 0; q < qpoints[c].size(); ++q)
+                {
+                  entries.emplace_back(cell, qpoints[c][q]);
+                  indices.push_back(point_indices[maps[c][q]]);
+                }
+            }
+        }
+    }
+
+
+
+    template <int dim, int spacedim>
+    void
+    RemotePointEvaluation<dim, spacedim>::setup_cell_data()
+    {
+      // remove processes we no longer exchange data with, so that the
+      // lists on the sending and the receiving side stay in sync
+      for (auto it = points_for_rank.begin(); it != points_for_rank.end();)
+        if (it->second.empty())
+          it = points_for_rank.erase(it);
+        else
+          ++it;
+      for (auto it = indices_from_rank.begin(); it != indices_from_rank.end();)
+        if (it->second.empty())
+          it = indices_from_rank.erase(it);
+        else
+          ++it;
+
+      // sort all points evaluated on this process by the cell they lie in
+      // (and then by the process and position they are sent to), so that
+      // the evaluation function can visit every cell exactly once
+      std::vector<std::tuple<std::pair<int, int>, unsigned int, unsigned int>>
+        entries;
+      for (const auto &rank_and_entries : points_for_rank)
+        for (unsigned int i = 0; i < rank_and_entries.second.size(); ++i)
+          entries.emplace_back(rank_and_entries.second[i].first,
+                               rank_and_entries.first,
+                               i);
+      std::sort(entries.begin(), entries.end());
+
+      cell_data.cells.clear();
+      cell_data.reference_point_ptrs.assign(1, 0);
+      cell_data.reference_point_values.resize(entries.size());
+
+      send_permutation.clear();
+      for (const auto &rank_and_entries : points_for_rank)
+        send_permutation[rank_and_entries.first].resize(
+          rank_and_entries.second.size());
+
+      for (unsigned int i = 0; i < entries.size(); ++i)
+        {
+          const std::pair<int, int> &cell = std::get<0>(entries[i]);
+          const unsigned int         rank = std::get<1>(entries[i]);
+          const unsigned int         pos  = std::get<2>(entries[i]);
+
+          if (cell_data.cells.empty() || cell_data.cells.back() != cell)
+            {
+              if (cell_data.cells.size() > 0)
+                cell_data.reference_point_ptrs.push_back(i);
+              cell_data.cells.push_back(cell);
+            }
+
+          cell_data.reference_point_values[i] =
+            points_for_rank[rank][pos].second;
+          send_permutation[rank][pos] = i;
+        }
+      if (cell_data.cells.size() > 0)
+        cell_data.reference_point_ptrs.push_back(entries.size());
+
+      // the reference points have changed
+      fe_values_cache.clear();
+      fe_values_cache.resize(cell_data.cells.size());
+      fe_values_cache_flags = update_default;
+
+      // store the communication pattern in flat arrays, so that
+      // evaluate_and_process() only has to post the messages
+      send_ranks.clear();
+      send_ptrs.assign(1, 0);
+      send_indices.clear();
+      for (const auto &rank_and_permutation : send_permutation)
+        {
+          send_ranks.push_back(rank_and_permutation.first);
+          send_indices.insert(send_indices.end(),
+                              rank_and_permutation.second.begin(),
+                              rank_and_permutation.second.end());
+          send_ptrs.push_back(send_indices.size());
+        }
+
+      // a point found by several processes takes the value of the process
+      // with the lowest rank; since the processes are sorted, this is the
+      // first one listing the point
+      point_found_flags.assign(points.size(), false);
+      recv_ranks.clear();
+      recv_ptrs.assign(1, 0);
+      recv_indices.clear();
+      for (const auto &rank_and_indices : indices_from_rank)
+        {
+          recv_ranks.push_back(rank_and_indices.first);
+          for (const unsigned int index : rank_and_indices.second)
+            if (point_found_flags[index] == false)
+              {
+                recv_indices.push_back(index);
+                point_found_flags[index] = true;
+              }
+            else
+              recv_indices.push_back(numbers::invalid_unsigned_int);
+          recv_ptrs.push_back(recv_indices.size());
+        }
+    }
+
+
+
+    template <int dim, int spacedim>
+    bool
+    RemotePointEvaluation<dim, spacedim>::point_found(
+      const unsigned int i) const
+    {
+      AssertIndexRange(i, point_found_flags.size());
+      return point_found_flags[i];
+    }
+
+
+
+    template <int dim, int spacedim>
+    bool
+    RemotePointEvaluation<dim, spacedim>::all_points_found() const
+    {
+      return std::find(point_found_flags.begin(),
+                       point_found_flags.end(),
+                       false) == point_found_flags.end();
+    }
+
+
+
+    template <int dim, int spacedim>
+    const std::vector<Point<spacedim>> &
+    RemotePointEvaluation<dim, spacedim>::get_points() const
+    {
+      return points;
+    }
+
+
+
+    template <int dim, int spacedim>
+    const typename RemotePointEvaluation<dim, spacedim>::CellData &
+    RemotePointEvaluation<dim, spacedim>::get_cell_data() const
+    {
+      return cell_data;
+    }
+
+
+
+    template <int dim, int spacedim>
+    FEValues<dim, spacedim> &
+    RemotePointEvaluation<dim, spacedim>::get_fe_values(
+      const unsigned int                  c,
+      const FiniteElement<dim, spacedim> &fe,
+      const UpdateFlags                   update_flags) const
+    {
+      Assert(mapping != nullptr,
+             ExcMessage("RemotePointEvaluation::reinit() has not been "
+                        "called yet."));
+      AssertIndexRange(c, fe_values_cache.size());
+
+      // if new flags are requested, set up all objects again with the
+      // union of the old and the new flags, so that alternating requests
+      // for, e.g., values and gradients do not keep discarding them
+      if ((fe_values_cache_flags | update_flags) != fe_values_cache_flags)
+        {
+          for (auto &fe_values : fe_values_cache)
+            fe_values.reset();
+          fe_values_cache_flags |= update_flags;
+        }
+
+      std::unique_ptr<FEValues<dim, spacedim>> &fe_values = fe_values_cache[c];
+      if (fe_values == nullptr || &fe_values->get_fe() != &fe)
+        {
+          const unsigned int begin = cell_data.reference_point_ptrs[c];
+          const unsigned int end   = cell_data.reference_point_ptrs[c + 1];
+          fe_values = std_cxx14::make_unique<FEValues<dim, spacedim>>(
+            *mapping,
+            fe,
+            Quadrature<dim>(std::vector<Point<dim>>(
+              cell_data.reference_point_values.begin() + begin,
+              cell_data.reference_point_values.begin() + end)),
+            fe_values_cache_flags);
+        }
+      return *fe_values;
+    }
+
+
+
+    template <int dim, int spacedim>
+    const Triangulation<dim, spacedim> &
+    RemotePointEvaluation<dim, spacedim>::get_triangulation() const
+    {
+      Assert(tria != nullptr,
+             ExcMessage("RemotePointEvaluation::reinit() has not been "
+                        "called yet."));
+      return *tria;
+    }
+
+
+
+    template <int dim, int spacedim>
+    const Mapping<dim, spacedim> &
+    RemotePointEvaluation<dim, spacedim>::get_mapping() const
+    {
+      Assert(mapping != nullptr,
+             ExcMessage("RemotePointEvaluation::reinit() has not been "
+                        "called yet."));
+      return *mapping;
+    }
+
+  } // namespace MPI
+} // namespace Utilities
+
+#include "mpi_remote_point_evaluation.inst"
+
+DEAL_II_NAMESPACE_CLOSE
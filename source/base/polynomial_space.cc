@@ -13,9 +13,11 @@
 //
 // ---------------------------------------------------------------------
 
+#include <deal.II/base/aligned_vector.h>
 #include <deal.II/base/exceptions.h>
 #include <deal.II/base/polynomial_space.h>
 #include <deal.II/base/table.h>
+#include <deal.II/base/vectorization.h>
 
 DEAL_II_NAMESPACE_OPEN
 
@@ -396,6 +398,102 @@ PolynomialSpace<dim>::compute(
 }
 
 
+
+template <int dim>
+void
+PolynomialSpace<dim>::compute(const std::vector<Point<dim>> &unit_points,
+                              Table<2, double> &             values,
+                              Table<2, Tensor<1, dim>> &     grads) const
+{
+  const unsigned int n_points = unit_points.size();
+  Assert(values.n_rows() == n_pols || values.n_rows() == 0,
+         ExcDimensionMismatch2(values.n_rows(), n_pols, 0));
+  Assert(values.n_rows() == 0 || values.n_cols() == n_points,
+         ExcDimensionMismatch(values.n_cols(), n_points));
+  Assert(grads.n_rows() == n_pols || grads.n_rows() == 0,
+         ExcDimensionMismatch2(grads.n_rows(), n_pols, 0));
+  Assert(grads.n_rows() == 0 || grads.n_cols() == n_points,
+         ExcDimensionMismatch(grads.n_cols(), n_points));
+
+  const bool update_values = (values.n_rows() == n_pols),
+             update_grads  = (grads.n_rows() == n_pols);
+  if (update_values == false && update_grads == false)
+    return;
+
+  const unsigned int n_derivatives = update_grads ? 1 : 0;
+  const unsigned int n_lanes = VectorizedArray<double>::n_array_elements;
+  const unsigned int n_1d    = polynomials.size();
+
+  // values and first derivatives of the 1d polynomials for one batch of
+  // points, stored at index (i*dim+d)*2+k for polynomial i, coordinate
+  // direction d and derivative k
+  AlignedVector<VectorizedArray<double>> v(n_1d * dim * 2);
+
+  for (unsigned int q0 = 0; q0 < n_points; q0 += n_lanes)
+    {
+      // fill the unused lanes of the last batch with the last point
+      const unsigned int n_filled = std::min(n_points - q0, n_lanes);
+      std::array<VectorizedArray<double>, dim> p;
+      for (unsigned int d = 0; d < dim; ++d)
+        for (unsigned int l = 0; l < n_lanes; ++l)
+          p[d][l] = unit_points[q0 + std::min(l, n_filled - 1)][d];
+
+      for (unsigned int i = 0; i < n_1d; ++i)
+        for (unsigned int d = 0; d < dim; ++d)
+          polynomials[i].value(p[d], n_derivatives, &v[(i * dim + d) * 2]);
+
+      unsigned int k = 0;
+      for (unsigned int iz = 0; iz < ((dim > 2) ? n_1d : 1); ++iz)
+        for (unsigned int iy = 0; iy < ((dim > 1) ? n_1d - iz : 1); ++iy)
+          {
+            // the products in y and z direction are shared by all
+            // polynomials in x direction
+            VectorizedArray<double> value_y = 1., value_z = 1.;
+            VectorizedArray<double> derivative_y = 0., derivative_z = 0.;
+            if (dim > 1)
+              {
+                value_y = v[(iy * dim + 1) * 2];
+                if (update_grads)
+                  derivative_y = v[(iy * dim + 1) * 2 + 1];
+              }
+            if (dim > 2)
+              {
+                value_z = v[(iz * dim + 2) * 2];
+                if (update_grads)
+                  derivative_z = v[(iz * dim + 2) * 2 + 1];
+              }
+            const VectorizedArray<double> value_yz = value_y * value_z;
+            const VectorizedArray<double> grad_y   = derivative_y * value_z;
+            const VectorizedArray<double> grad_z   = value_y * derivative_z;
+
+            for (unsigned int ix = 0; ix < n_1d - iy - iz; ++ix)
+              {
+                const unsigned int            k2      = index_map_inverse[k++];
+                const VectorizedArray<double> value_x = v[ix * dim * 2];
+
+                if (update_values)
+                  {
+                    const VectorizedArray<double> value = value_x * value_yz;
+                    for (unsigned int l = 0; l < n_filled; ++l)
+                      values(k2, q0 + l) = value[l];
+                  }
+
+                if (update_grads)
+                  {
+                    std::array<VectorizedArray<double>, 3> grad;
+                    grad[0] = v[ix * dim * 2 + 1] * value_yz;
+                    grad[1] = value_x * grad_y;
+                    grad[2] = value_x * grad_z;
+                    for (unsigned int l = 0; l < n_filled; ++l)
+                      for (unsigned int d = 0; d < dim; ++d)
+                        grads(k2, q0 + l)[d] = grad[d][l];
+                  }
+              }
+          }
+    }
+}
+
+
 template class PolynomialSpace<1>;
 template class PolynomialSpace<2>;
 template class PolynomialSpace<3>;
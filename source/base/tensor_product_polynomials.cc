@@ -13,9 +13,11 @@
 //
 // ---------------------------------------------------------------------
 
+#include <deal.II/base/aligned_vector.h>
 #include <deal.II/base/exceptions.h>
 #include <deal.II/base/polynomials_piecewise.h>
 #include <deal.II/base/tensor_product_polynomials.h>
+#include <deal.II/base/vectorization.h>
 
 #include <boost/container/small_vector.hpp>
 
@@ -405,6 +407,148 @@ TensorProductPolynomials<dim, PolynomialType>::compute(
 
 
 
+namespace internal
+{
+  namespace
+  {
+    // evaluate the value and possibly the first derivative of a 1d
+    // polynomial in all lanes of a vectorized argument. the general version
+    // evaluates lane by lane, whereas polynomials of type
+    // Polynomials::Polynomial work on all lanes at once
+    template <typename PolynomialType>
+    inline void
+    evaluate_polynomial_vectorized(const PolynomialType &         polynomial,
+                                   const VectorizedArray<double> &x,
+                                   const unsigned int             n_derivatives,
+                                   VectorizedArray<double> *      values)
+    {
+      Assert(n_derivatives < 2, ExcInternalError());
+      double scalar_values[2];
+      for (unsigned int v = 0; v < VectorizedArray<double>::n_array_elements;
+           ++v)
+        {
+          polynomial.value(x[v], n_derivatives, scalar_values);
+          for (unsigned int k = 0; k <= n_derivatives; ++k)
+            values[k][v] = scalar_values[k];
+        }
+    }
+
+
+
+    inline void
+    evaluate_polynomial_vectorized(
+      const Polynomials::Polynomial<double> &polynomial,
+      const VectorizedArray<double> &        x,
+      const unsigned int                     n_derivatives,
+      VectorizedArray<double> *              values)
+    {
+      polynomial.value(x, n_derivatives, values);
+    }
+  } // namespace
+} // namespace internal
+
+
+
+template <int dim, typename PolynomialType>
+void
+TensorProductPolynomials<dim, PolynomialType>::compute(
+  const std::vector<Point<dim>> &unit_points,
+  Table<2, double> &             values,
+  Table<2, Tensor<1, dim>> &     grads) const
+{
+  Assert(dim <= 3, ExcNotImplemented());
+  const unsigned int n_points = unit_points.size();
+  Assert(values.n_rows() == n_tensor_pols || values.n_rows() == 0,
+         ExcDimensionMismatch2(values.n_rows(), n_tensor_pols, 0));
+  Assert(values.n_rows() == 0 || values.n_cols() == n_points,
+         ExcDimensionMismatch(values.n_cols(), n_points));
+  Assert(grads.n_rows() == n_tensor_pols || grads.n_rows() == 0,
+         ExcDimensionMismatch2(grads.n_rows(), n_tensor_pols, 0));
+  Assert(grads.n_rows() == 0 || grads.n_cols() == n_points,
+         ExcDimensionMismatch(grads.n_cols(), n_points));
+
+  const bool update_values = (values.n_rows() == n_tensor_pols),
+             update_grads  = (grads.n_rows() == n_tensor_pols);
+  if (update_values == false && update_grads == false)
+    return;
+
+  const unsigned int n_derivatives = update_grads ? 1 : 0;
+  const unsigned int n_lanes = VectorizedArray<double>::n_array_elements;
+  const unsigned int n_polynomials = polynomials.size();
+
+  // values and first derivatives of all 1d polynomials in all coordinate
+  // directions for one batch of points, stored at index (i*dim+d)*2+k for
+  // polynomial i, direction d and derivative k
+  AlignedVector<VectorizedArray<double>> values_1d(n_polynomials * dim * 2);
+
+  for (unsigned int q0 = 0; q0 < n_points; q0 += n_lanes)
+    {
+      // fill the unused lanes of the last batch with the last point
+      const unsigned int n_filled = std::min(n_points - q0, n_lanes);
+      std::array<VectorizedArray<double>, dim> p;
+      for (unsigned int d = 0; d < dim; ++d)
+        for (unsigned int v = 0; v < n_lanes; ++v)
+          p[d][v] = unit_points[q0 + std::min(v, n_filled - 1)][d];
+
+      for (unsigned int i = 0; i < n_polynomials; ++i)
+        for (unsigned int d = 0; d < dim; ++d)
+          internal::evaluate_polynomial_vectorized(
+            polynomials[i], p[d], n_derivatives, &values_1d[(i * dim + d) * 2]);
+
+      unsigned int ind = 0;
+      for (unsigned int i2 = 0; i2 < (dim > 2 ? n_polynomials : 1); ++i2)
+        for (unsigned int i1 = 0; i1 < (dim > 1 ? n_polynomials : 1); ++i1)
+          {
+            // the products of the values and derivatives in the directions 1
+            // and 2 are shared by all polynomials in direction 0
+            VectorizedArray<double> value_1 = 1., value_2 = 1.;
+            VectorizedArray<double> derivative_1 = 0., derivative_2 = 0.;
+            if (dim > 1)
+              {
+                value_1 = values_1d[(i1 * dim + 1) * 2];
+                if (update_grads)
+                  derivative_1 = values_1d[(i1 * dim + 1) * 2 + 1];
+              }
+            if (dim > 2)
+              {
+                value_2 = values_1d[(i2 * dim + 2) * 2];
+                if (update_grads)
+                  derivative_2 = values_1d[(i2 * dim + 2) * 2 + 1];
+              }
+            const VectorizedArray<double> value_12 = value_1 * value_2;
+            const VectorizedArray<double> grad_1   = derivative_1 * value_2;
+            const VectorizedArray<double> grad_2   = value_1 * derivative_2;
+
+            for (unsigned int i0 = 0; i0 < n_polynomials; ++i0, ++ind)
+              {
+                const unsigned int            i = index_map_inverse[ind];
+                const VectorizedArray<double> value_0 =
+                  values_1d[i0 * dim * 2];
+
+                if (update_values)
+                  {
+                    const VectorizedArray<double> value = value_0 * value_12;
+                    for (unsigned int v = 0; v < n_filled; ++v)
+                      values(i, q0 + v) = value[v];
+                  }
+
+                if (update_grads)
+                  {
+                    std::array<VectorizedArray<double>, 3> grad;
+                    grad[0] = values_1d[i0 * dim * 2 + 1] * value_12;
+                    grad[1] = value_0 * grad_1;
+                    grad[2] = value_0 * grad_2;
+                    for (unsigned int v = 0; v < n_filled; ++v)
+                      for (unsigned int d = 0; d < dim; ++d)
+                        grads(i, q0 + v)[d] = grad[d][v];
+                  }
+              }
+          }
+    }
+}
+
+
+
 /* ------------------- AnisotropicPolynomials -------------- */
 
 
@@ -30,6 +30,8 @@
 #include <deal.II/lac/sparsity_tools.h>
 
 #include <algorithm>
+#include <cmath>
+#include <cstdint>
 #include <fstream>
 #include <iostream>
 #include <numeric>
@@ -2115,6 +2117,29 @@ namespace parallel
 
 
 
+    template <int dim, int spacedim>
+    std::uint64_t
+    Triangulation<dim, spacedim>::DataTransfer::n_packed_bytes(
+      const unsigned int begin,
+      const unsigned int end) const
+    {
+      if (begin >= end || sizes_fixed_cumulative.empty())
+        return 0;
+
+      std::uint64_t n_bytes =
+        static_cast<std::uint64_t>(end - begin) * sizes_fixed_cumulative.back();
+      if (variable_size_data_stored)
+        {
+          AssertIndexRange(end - 1, src_sizes_variable.size());
+          n_bytes += std::accumulate(src_sizes_variable.begin() + begin,
+                                     src_sizes_variable.begin() + end,
+                                     std::uint64_t(0));
+        }
+      return n_bytes;
+    }
+
+
+
     /* ----------------- class Triangulation<dim,spacedim> ----------------- */
 
 
@@ -2138,6 +2163,7 @@ namespace parallel
         false)
       , settings(settings_)
       , triangulation_has_content(false)
+      , repartitioning_tolerance(0.)
       , connectivity(nullptr)
       , parallel_forest(nullptr)
       , cell_attached_data({0, 0, {}, {}})
@@ -3922,39 +3948,7 @@ namespace parallel
         }
 
       if (!(settings & no_automatic_repartitioning))
-        {
-          // partition the new mesh between all processors. If cell weights have
-          // not been given balance the number of cells.
-          if (this->signals.cell_weight.num_slots() == 0)
-            dealii::internal::p4est::functions<dim>::partition(
-              parallel_forest,
-              /* prepare coarsening */ 1,
-              /* weight_callback */ nullptr);
-          else
-            {
-              // get cell weights for a weighted repartitioning.
-              const std::vector<unsigned int> cell_weights = get_cell_weights();
-
-              PartitionWeights<dim, spacedim> partition_weights(cell_weights);
-
-              // attach (temporarily) a pointer to the cell weights through
-              // p4est's user_pointer object
-              Assert(parallel_forest->user_pointer == this, ExcInternalError());
-              parallel_forest->user_pointer = &partition_weights;
-
-              dealii::internal::p4est::functions<dim>::partition(
-                parallel_forest,
-                /* prepare coarsening */ 1,
-                /* weight_callback */
-                &PartitionWeights<dim, spacedim>::cell_weight);
-
-              // release data
-              dealii::internal::p4est::functions<dim>::reset_data(
-                parallel_forest, 0, nullptr, nullptr);
-              // reset the user pointer to its previous state
-              parallel_forest->user_pointer = this;
-            }
-        }
+        partition_parallel_forest();
 
       // finally copy back from local part of tree to deal.II
       // triangulation. before doing so, make sure there are no refine or
@@ -4097,36 +4091,7 @@ namespace parallel
                         (parallel_forest->mpisize + 1));
         }
 
-      if (this->signals.cell_weight.num_slots() == 0)
-        {
-          // no cell weights given -- call p4est's 'partition' without a
-          // callback for cell weights
-          dealii::internal::p4est::functions<dim>::partition(
-            parallel_forest,
-            /* prepare coarsening */ 1,
-            /* weight_callback */ nullptr);
-        }
-      else
-        {
-          // get cell weights for a weighted repartitioning.
-          const std::vector<unsigned int> cell_weights = get_cell_weights();
-
-          PartitionWeights<dim, spacedim> partition_weights(cell_weights);
-
-          // attach (temporarily) a pointer to the cell weights through p4est's
-          // user_pointer object
-          Assert(parallel_forest->user_pointer == this, ExcInternalError());
-          parallel_forest->user_pointer = &partition_weights;
-
-          dealii::internal::p4est::functions<dim>::partition(
-            parallel_forest,
-            /* prepare coarsening */ 1,
-            /* weight_callback */
-            &PartitionWeights<dim, spacedim>::cell_weight);
-
-          // reset the user pointer to its previous state
-          parallel_forest->user_pointer = this;
-        }
+      partition_parallel_forest();
 
       try
         {
@@ -4159,6 +4124,280 @@ namespace parallel
 
 
 
+    template <int dim, int spacedim>
+    void
+    Triangulation<dim, spacedim>::set_repartitioning_tolerance(
+      const double tolerance)
+    {
+      Assert(tolerance >= 0.,
+             ExcMessage("The repartitioning tolerance must not be negative."));
+      repartitioning_tolerance = tolerance;
+    }
+
+
+
+    template <int dim, int spacedim>
+    const typename Triangulation<dim, spacedim>::RepartitioningStatistics &
+    Triangulation<dim, spacedim>::get_repartitioning_statistics() const
+    {
+      return repartitioning_statistics;
+    }
+
+
+
+    template <int dim, int spacedim>
+    void
+    Triangulation<dim, spacedim>::partition_parallel_forest()
+    {
+      using gloidx = typename dealii::internal::p4est::types<dim>::gloidx;
+      using locidx = typename dealii::internal::p4est::types<dim>::locidx;
+
+      const unsigned int n_procs = parallel_forest->mpisize;
+      const unsigned int my_rank = parallel_forest->mpirank;
+      const locidx       n_local_quadrants =
+        parallel_forest->local_num_quadrants;
+
+      const std::vector<gloidx> old_first_quadrant(
+        parallel_forest->global_first_quadrant,
+        parallel_forest->global_first_quadrant + n_procs + 1);
+
+      // the weights of the locally owned quadrants in the order p4est
+      // encounters them, and their sums over the quadrants preceding each
+      // of them
+      const bool weighted = (this->signals.cell_weight.num_slots() > 0);
+      const std::vector<unsigned int> cell_weights =
+        weighted ? get_cell_weights() :
+                   std::vector<unsigned int>(n_local_quadrants, 1U);
+      AssertDimension(cell_weights.size(), n_local_quadrants);
+
+      std::vector<std::uint64_t> local_weight_prefix(n_local_quadrants + 1, 0);
+      for (locidx i = 0; i < n_local_quadrants; ++i)
+        local_weight_prefix[i + 1] = local_weight_prefix[i] + cell_weights[i];
+
+      // the total weight of each processor, and the weight preceding the
+      // quadrants of each processor along the space-filling curve
+      const std::vector<std::uint64_t> weight_per_proc =
+        Utilities::MPI::all_gather(this->mpi_communicator,
+                                   local_weight_prefix.back());
+      std::vector<std::uint64_t> old_weight_boundaries(n_procs + 1, 0);
+      std::partial_sum(weight_per_proc.begin(),
+                       weight_per_proc.end(),
+                       old_weight_boundaries.begin() + 1);
+      const std::uint64_t total_weight   = old_weight_boundaries.back();
+      const double        average_weight = static_cast<double>(total_weight) /
+                                    std::max(n_procs, 1U);
+
+      const auto imbalance =
+        [&](const std::vector<std::uint64_t> &weight_boundaries) {
+          std::uint64_t max_weight = 0;
+          for (unsigned int p = 0; p < n_procs; ++p)
+            max_weight = std::max(max_weight,
+                                  weight_boundaries[p + 1] -
+                                    weight_boundaries[p]);
+          return (average_weight > 0 ? max_weight / average_weight : 1.);
+        };
+
+      repartitioning_statistics = RepartitioningStatistics();
+      repartitioning_statistics.imbalance_before =
+        imbalance(old_weight_boundaries);
+
+      if (repartitioning_tolerance == 0.)
+        {
+          // slice the space-filling curve anew. If cell weights have not
+          // been given balance the number of cells.
+          if (weighted == false)
+            dealii::internal::p4est::functions<dim>::partition(
+              parallel_forest,
+              /* prepare coarsening */ 1,
+              /* weight_callback */ nullptr);
+          else
+            {
+              PartitionWeights<dim, spacedim> partition_weights(cell_weights);
+
+              // attach (temporarily) a pointer to the cell weights through
+              // p4est's user_pointer object
+              Assert(parallel_forest->user_pointer == this, ExcInternalError());
+              parallel_forest->user_pointer = &partition_weights;
+
+              dealii::internal::p4est::functions<dim>::partition(
+                parallel_forest,
+                /* prepare coarsening */ 1,
+                /* weight_callback */
+                &PartitionWeights<dim, spacedim>::cell_weight);
+
+              // release data
+              dealii::internal::p4est::functions<dim>::reset_data(
+                parallel_forest, 0, nullptr, nullptr);
+              // reset the user pointer to its previous state
+              parallel_forest->user_pointer = this;
+            }
+        }
+      else if (repartitioning_statistics.imbalance_before >
+               1. + repartitioning_tolerance)
+        {
+          // move each boundary between two processors, measured as the
+          // weight of all quadrants preceding it, into the interval of
+          // half the admissible excess around its ideal position. this
+          // bounds the weight of every processor by (1+tolerance) times the
+          // average, and boundaries that are already in this interval stay
+          // where they are.
+          const double slack = repartitioning_tolerance * average_weight / 2.;
+
+          // return the local quadrant index closest to i at which the
+          // partition can be cut without splitting a family of quadrants
+          // that lies completely on this processor and could be coarsened
+          const auto align_to_family = [&](const locidx i) {
+            if (i <= 0 || i >= n_local_quadrants)
+              return i;
+
+            for (int t = parallel_forest->first_local_tree;
+                 t <= parallel_forest->last_local_tree;
+                 ++t)
+              {
+                auto *tree = static_cast<
+                  typename dealii::internal::p4est::types<dim>::tree *>(
+                  sc_array_index(parallel_forest->trees, t));
+                const locidx offset = tree->quadrants_offset;
+                const locidx n_quadrants_in_tree =
+                  static_cast<locidx>(tree->quadrants.elem_count);
+                if (i < offset || i >= offset + n_quadrants_in_tree)
+                  continue;
+
+                const auto quadrant = [&](const locidx j) {
+                  return static_cast<
+                    typename dealii::internal::p4est::types<dim>::quadrant *>(
+                    sc_array_index(&tree->quadrants, j - offset));
+                };
+
+                const auto *q = quadrant(i);
+                if (q->level == 0)
+                  return i;
+                const int child =
+                  dealii::internal::p4est::functions<dim>::quadrant_ancestor_id(
+                    q, q->level);
+                const locidx first = i - child;
+                const locidx last =
+                  first +
+                  static_cast<locidx>(GeometryInfo<dim>::max_children_per_cell);
+                if (child == 0 || first < offset ||
+                    last > offset + n_quadrants_in_tree)
+                  return i;
+
+                for (locidx j = first; j < last; ++j)
+                  if (j != i &&
+                      !dealii::internal::p4est::functions<dim>::
+                        quadrant_is_sibling(quadrant(j), q))
+                    return i;
+
+                return (i - first <= last - i) ? first : last;
+              }
+
+            return i;
+          };
+
+          std::vector<gloidx> new_first_quadrant(n_procs + 1, 0);
+          for (unsigned int p = 1; p < n_procs; ++p)
+            {
+              const double ideal    = average_weight * p;
+              const double position = std::min(
+                std::max(static_cast<double>(old_weight_boundaries[p]),
+                         ideal - slack),
+                ideal + slack);
+              const std::uint64_t weight_boundary =
+                std::min(static_cast<std::uint64_t>(std::ceil(position)),
+                         total_weight);
+
+              if (weight_boundary == total_weight)
+                new_first_quadrant[p] = old_first_quadrant[n_procs];
+              else if (weight_boundary >= old_weight_boundaries[my_rank] &&
+                       weight_boundary < old_weight_boundaries[my_rank + 1])
+                {
+                  // the first of our quadrants that is preceded by at least
+                  // the given weight
+                  const locidx i = std::lower_bound(local_weight_prefix.begin(),
+                                                    local_weight_prefix.end(),
+                                                    weight_boundary -
+                                                      old_weight_boundaries
+                                                        [my_rank]) -
+                                   local_weight_prefix.begin();
+                  new_first_quadrant[p] =
+                    old_first_quadrant[my_rank] + align_to_family(i);
+                }
+            }
+          new_first_quadrant[n_procs] = old_first_quadrant[n_procs];
+
+          // every boundary has been determined by exactly one processor
+          Utilities::MPI::max(new_first_quadrant,
+                              this->mpi_communicator,
+                              new_first_quadrant);
+          for (unsigned int p = 1; p <= n_procs; ++p)
+            new_first_quadrant[p] =
+              std::max(new_first_quadrant[p], new_first_quadrant[p - 1]);
+
+          std::vector<locidx> n_quadrants_per_proc(n_procs);
+          for (unsigned int p = 0; p < n_procs; ++p)
+            n_quadrants_per_proc[p] =
+              new_first_quadrant[p + 1] - new_first_quadrant[p];
+
+          dealii::internal::p4est::functions<dim>::partition_given(
+            parallel_forest, n_quadrants_per_proc.data());
+        }
+
+      // gather statistics: the weight preceding each new boundary is known
+      // to the processor that owned the first quadrant after it before the
+      // repartitioning
+      const gloidx *new_first_quadrant = parallel_forest->global_first_quadrant;
+
+      std::vector<std::uint64_t> new_weight_boundaries(n_procs + 1, 0);
+      for (unsigned int p = 0; p <= n_procs; ++p)
+        if (new_first_quadrant[p] == old_first_quadrant[n_procs])
+          new_weight_boundaries[p] = total_weight;
+        else if (new_first_quadrant[p] >= old_first_quadrant[my_rank] &&
+                 new_first_quadrant[p] < old_first_quadrant[my_rank + 1])
+          new_weight_boundaries[p] =
+            old_weight_boundaries[my_rank] +
+            local_weight_prefix[new_first_quadrant[p] -
+                                old_first_quadrant[my_rank]];
+      Utilities::MPI::max(new_weight_boundaries,
+                          this->mpi_communicator,
+                          new_weight_boundaries);
+      repartitioning_statistics.imbalance_after =
+        imbalance(new_weight_boundaries);
+
+      for (unsigned int p = 0; p < n_procs; ++p)
+        {
+          const gloidx overlap =
+            std::max<gloidx>(0,
+                             std::min(old_first_quadrant[p + 1],
+                                      new_first_quadrant[p + 1]) -
+                               std::max(old_first_quadrant[p],
+                                        new_first_quadrant[p]));
+          repartitioning_statistics.n_migrated_cells +=
+            old_first_quadrant[p + 1] - old_first_quadrant[p] - overlap;
+        }
+
+      if (cell_attached_data.n_attached_data_sets > 0)
+        {
+          // our quadrants that precede and follow the new range of this
+          // processor, in local numbering
+          const gloidx old_first = old_first_quadrant[my_rank];
+          const auto   clamp     = [&](const gloidx i) {
+            return static_cast<unsigned int>(
+              std::min<gloidx>(std::max<gloidx>(i - old_first, 0),
+                               n_local_quadrants));
+          };
+          const std::uint64_t local_bytes =
+            data_transfer.n_packed_bytes(0,
+                                         clamp(new_first_quadrant[my_rank])) +
+            data_transfer.n_packed_bytes(clamp(new_first_quadrant[my_rank + 1]),
+                                         n_local_quadrants);
+          repartitioning_statistics.n_migrated_bytes =
+            Utilities::MPI::sum(local_bytes, this->mpi_communicator);
+        }
+    }
+
+
+
     template <int dim, int spacedim>
     void
     Triangulation<dim, spacedim>::communicate_locally_moved_vertices(
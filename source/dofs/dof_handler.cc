@@ -13,9 +13,11 @@
 //
 // ---------------------------------------------------------------------
 
+#include <deal.II/base/flat_binary_archive.h>
 #include <deal.II/base/geometry_info.h>
 #include <deal.II/base/memory_consumption.h>
 #include <deal.II/base/std_cxx14/memory.h>
+#include <deal.II/base/utilities.h>
 
 #include <deal.II/distributed/shared_tria.h>
 #include <deal.II/distributed/tria.h>
@@ -1197,6 +1199,32 @@ DoFHandler<dim, spacedim>::memory_consumption() const
 
 
 
+template <int dim, int spacedim>
+void
+DoFHandler<dim, spacedim>::save_flat_binary(const std::string &filename) const
+{
+  FlatBinaryArchive::OutputArchive archive(
+    filename,
+    "DoFHandler<" + Utilities::int_to_string(dim) + "," +
+      Utilities::int_to_string(spacedim) + ">");
+  save(archive, 0);
+}
+
+
+
+template <int dim, int spacedim>
+void
+DoFHandler<dim, spacedim>::load_flat_binary(const std::string &filename)
+{
+  FlatBinaryArchive::InputArchive archive(
+    filename,
+    "DoFHandler<" + Utilities::int_to_string(dim) + "," +
+      Utilities::int_to_string(spacedim) + ">");
+  load(archive, 0);
+}
+
+
+
 template <int dim, int spacedim>
 void
 DoFHandler<dim, spacedim>::set_fe(const FiniteElement<dim, spacedim> &ff)
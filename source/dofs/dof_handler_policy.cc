@@ -16,6 +16,8 @@
 
 #include <deal.II/base/geometry_info.h>
 #include <deal.II/base/memory_consumption.h>
+#include <deal.II/base/multithread_info.h>
+#include <deal.II/base/parallel.h>
 #include <deal.II/base/partitioner.h>
 #include <deal.II/base/thread_management.h>
 #include <deal.II/base/utilities.h>
@@ -45,6 +47,7 @@
 #endif
 
 #include <algorithm>
+#include <atomic>
 #include <memory>
 #include <numeric>
 #include <set>
@@ -2031,6 +2034,353 @@ namespace internal
 
 
 
+        /**
+         * The three passes over the cells performed by the multithreaded
+         * version of distribute_dofs(). See there for details.
+         */
+        enum class DoFDistributionPass
+        {
+          claim,
+          count,
+          number
+        };
+
+
+
+        /**
+         * For each vertex, line, and quad of the triangulation, the position
+         * (in the list of cells dofs are distributed on) of the first cell
+         * that touches it. This is the cell that assigns the dof indices on
+         * that object when the cells are processed one after the other.
+         */
+        struct DoFObjectOwners
+        {
+          std::vector<std::atomic<unsigned int>> vertices;
+          std::vector<std::atomic<unsigned int>> lines;
+          std::vector<std::atomic<unsigned int>> quads;
+        };
+
+
+
+        /**
+         * In the DoFDistributionPass::claim pass, record that the cell at
+         * position @p position touches the object whose owner is stored in
+         * @p owner and return false. In the other passes, return whether the
+         * cell at position @p position is the owner of that object.
+         */
+        static bool
+        claim_or_check_dof_object(std::atomic<unsigned int> &owner,
+                                  const unsigned int         position,
+                                  const DoFDistributionPass  pass)
+        {
+          if (pass == DoFDistributionPass::claim)
+            {
+              // atomically replace the owner by the current cell if the
+              // latter comes first
+              unsigned int current_owner =
+                owner.load(std::memory_order_relaxed);
+              while ((position < current_owner) &&
+                     !owner.compare_exchange_weak(current_owner,
+                                                  position,
+                                                  std::memory_order_relaxed))
+                ;
+              return false;
+            }
+          else
+            return (owner.load(std::memory_order_relaxed) == position);
+        }
+
+
+
+        /**
+         * Perform one pass of the multithreaded version of distribute_dofs()
+         * on the given cell, which is the cell with index @p position in the
+         * list of cells dofs are distributed on. In the
+         * DoFDistributionPass::count and DoFDistributionPass::number passes,
+         * return @p next_free_dof plus the number of dofs the cell assigns;
+         * in the latter pass, these dofs are also stored.
+         *
+         * The order in which the dofs of the objects owned by the cell are
+         * numbered is the same as in distribute_dofs_on_cell().
+         */
+        template <int spacedim>
+        static types::global_dof_index
+        process_dofs_on_cell(
+          const DoFDistributionPass      pass,
+          const DoFHandler<1, spacedim> &dof_handler,
+          const typename DoFHandler<1, spacedim>::active_cell_iterator &cell,
+          const unsigned int      position,
+          DoFObjectOwners &       owners,
+          types::global_dof_index next_free_dof)
+        {
+          const FiniteElement<1, spacedim> &fe = dof_handler.get_fe();
+
+          if (fe.dofs_per_vertex > 0)
+            for (unsigned int v = 0; v < GeometryInfo<1>::vertices_per_cell;
+                 ++v)
+              if (claim_or_check_dof_object(
+                    owners.vertices[cell->vertex_index(v)], position, pass))
+                for (unsigned int d = 0; d < fe.dofs_per_vertex;
+                     ++d, ++next_free_dof)
+                  if (pass == DoFDistributionPass::number)
+                    cell->set_vertex_dof_index(v, d, next_free_dof);
+
+          if (pass != DoFDistributionPass::claim)
+            for (unsigned int d = 0; d < fe.dofs_per_line;
+                 ++d, ++next_free_dof)
+              if (pass == DoFDistributionPass::number)
+                cell->set_dof_index(d, next_free_dof);
+
+          return next_free_dof;
+        }
+
+
+
+        template <int spacedim>
+        static types::global_dof_index
+        process_dofs_on_cell(
+          const DoFDistributionPass      pass,
+          const DoFHandler<2, spacedim> &dof_handler,
+          const typename DoFHandler<2, spacedim>::active_cell_iterator &cell,
+          const unsigned int      position,
+          DoFObjectOwners &       owners,
+          types::global_dof_index next_free_dof)
+        {
+          const FiniteElement<2, spacedim> &fe = dof_handler.get_fe();
+
+          if (fe.dofs_per_vertex > 0)
+            for (unsigned int v = 0; v < GeometryInfo<2>::vertices_per_cell;
+                 ++v)
+              if (claim_or_check_dof_object(
+                    owners.vertices[cell->vertex_index(v)], position, pass))
+                for (unsigned int d = 0; d < fe.dofs_per_vertex;
+                     ++d, ++next_free_dof)
+                  if (pass == DoFDistributionPass::number)
+                    cell->set_vertex_dof_index(v, d, next_free_dof);
+
+          if (fe.dofs_per_line > 0)
+            for (unsigned int l = 0; l < GeometryInfo<2>::lines_per_cell; ++l)
+              {
+                const typename DoFHandler<2, spacedim>::line_iterator line =
+                  cell->line(l);
+                if (claim_or_check_dof_object(owners.lines[line->index()],
+                                              position,
+                                              pass))
+                  for (unsigned int d = 0; d < fe.dofs_per_line;
+                       ++d, ++next_free_dof)
+                    if (pass == DoFDistributionPass::number)
+                      line->set_dof_index(d, next_free_dof);
+              }
+
+          if (pass != DoFDistributionPass::claim)
+            for (unsigned int d = 0; d < fe.dofs_per_quad;
+                 ++d, ++next_free_dof)
+              if (pass == DoFDistributionPass::number)
+                cell->set_dof_index(d, next_free_dof);
+
+          return next_free_dof;
+        }
+
+
+
+        template <int spacedim>
+        static types::global_dof_index
+        process_dofs_on_cell(
+          const DoFDistributionPass      pass,
+          const DoFHandler<3, spacedim> &dof_handler,
+          const typename DoFHandler<3, spacedim>::active_cell_iterator &cell,
+          const unsigned int      position,
+          DoFObjectOwners &       owners,
+          types::global_dof_index next_free_dof)
+        {
+          const FiniteElement<3, spacedim> &fe = dof_handler.get_fe();
+
+          if (fe.dofs_per_vertex > 0)
+            for (unsigned int v = 0; v < GeometryInfo<3>::vertices_per_cell;
+                 ++v)
+              if (claim_or_check_dof_object(
+                    owners.vertices[cell->vertex_index(v)], position, pass))
+                for (unsigned int d = 0; d < fe.dofs_per_vertex;
+                     ++d, ++next_free_dof)
+                  if (pass == DoFDistributionPass::number)
+                    cell->set_vertex_dof_index(v, d, next_free_dof);
+
+          if (fe.dofs_per_line > 0)
+            for (unsigned int l = 0; l < GeometryInfo<3>::lines_per_cell; ++l)
+              {
+                const typename DoFHandler<3, spacedim>::line_iterator line =
+                  cell->line(l);
+                if (claim_or_check_dof_object(owners.lines[line->index()],
+                                              position,
+                                              pass))
+                  for (unsigned int d = 0; d < fe.dofs_per_line;
+                       ++d, ++next_free_dof)
+                    if (pass == DoFDistributionPass::number)
+                      line->set_dof_index(d, next_free_dof);
+              }
+
+          if (fe.dofs_per_quad > 0)
+            for (unsigned int q = 0; q < GeometryInfo<3>::quads_per_cell; ++q)
+              {
+                const typename DoFHandler<3, spacedim>::quad_iterator quad =
+                  cell->quad(q);
+                if (claim_or_check_dof_object(owners.quads[quad->index()],
+                                              position,
+                                              pass))
+                  for (unsigned int d = 0; d < fe.dofs_per_quad;
+                       ++d, ++next_free_dof)
+                    if (pass == DoFDistributionPass::number)
+                      quad->set_dof_index(d, next_free_dof);
+              }
+
+          if (pass != DoFDistributionPass::claim)
+            for (unsigned int d = 0; d < fe.dofs_per_hex;
+                 ++d, ++next_free_dof)
+              if (pass == DoFDistributionPass::number)
+                cell->set_dof_index(d, next_free_dof);
+
+          return next_free_dof;
+        }
+
+
+
+        /**
+         * Distribute degrees of freedom on the given list of cells, in the
+         * order of the list, and return the number of dofs distributed.
+         *
+         * If the list is long enough, the work is split between several
+         * threads. The result is the same as if distribute_dofs_on_cell()
+         * had been called for each cell in turn: the dofs on a vertex, line,
+         * or quad are numbered by the first cell in the list that touches
+         * the object, and the dofs of each cell are numbered consecutively
+         * in the order of the list. To achieve this without serializing the
+         * work, we make three passes over the cells:
+         * - In the first pass, every cell records itself as owner of each of
+         *   its objects, unless a cell earlier in the list already did so.
+         * - In the second pass, each cell counts the dofs on the objects it
+         *   owns. An exclusive prefix sum over these counts yields the first
+         *   dof index of each cell.
+         * - In the third pass, each cell numbers the dofs on the objects it
+         *   owns, starting at this index.
+         * All three passes are independent for different cells.
+         */
+        template <int dim, int spacedim>
+        static types::global_dof_index
+        distribute_dofs_on_cells(
+          const std::vector<
+            typename DoFHandler<dim, spacedim>::active_cell_iterator> &cells,
+          DoFHandler<dim, spacedim> &dof_handler)
+        {
+          // the number of cells per task. for small meshes, the overhead of
+          // the three passes is not worth it
+          const unsigned int grainsize = 1024;
+          if ((MultithreadInfo::n_threads() == 1) ||
+              (cells.size() < 4 * grainsize))
+            {
+              types::global_dof_index next_free_dof = 0;
+              for (const auto &cell : cells)
+                next_free_dof =
+                  distribute_dofs_on_cell(dof_handler, cell, next_free_dof);
+              return next_free_dof;
+            }
+
+          const FiniteElement<dim, spacedim> &fe = dof_handler.get_fe();
+          const dealii::Triangulation<dim, spacedim> &tria =
+            dof_handler.get_triangulation();
+
+          // only set up the owners for objects that actually carry dofs
+          DoFObjectOwners owners;
+          if (fe.dofs_per_vertex > 0)
+            owners.vertices =
+              std::vector<std::atomic<unsigned int>>(tria.n_vertices());
+          if (dim > 1 && fe.dofs_per_line > 0)
+            owners.lines =
+              std::vector<std::atomic<unsigned int>>(tria.n_raw_lines());
+          if (dim > 2 && fe.dofs_per_quad > 0)
+            owners.quads =
+              std::vector<std::atomic<unsigned int>>(tria.n_raw_quads());
+          for (auto *object_owners :
+               {&owners.vertices, &owners.lines, &owners.quads})
+            for (auto &owner : *object_owners)
+              owner.store(numbers::invalid_unsigned_int,
+                          std::memory_order_relaxed);
+
+          const unsigned int n_cells = cells.size();
+          std::vector<types::global_dof_index> first_dof(n_cells + 1, 0);
+
+          parallel::apply_to_subranges(
+            0U,
+            n_cells,
+            [&](const unsigned int begin, const unsigned int end) {
+              for (unsigned int c = begin; c < end; ++c)
+                process_dofs_on_cell(DoFDistributionPass::claim,
+                                     dof_handler,
+                                     cells[c],
+                                     c,
+                                     owners,
+                                     0);
+            },
+            grainsize);
+
+          parallel::apply_to_subranges(
+            0U,
+            n_cells,
+            [&](const unsigned int begin, const unsigned int end) {
+              for (unsigned int c = begin; c < end; ++c)
+                first_dof[c + 1] =
+                  process_dofs_on_cell(DoFDistributionPass::count,
+                                       dof_handler,
+                                       cells[c],
+                                       c,
+                                       owners,
+                                       0);
+            },
+            grainsize);
+
+          std::partial_sum(first_dof.begin(),
+                           first_dof.end(),
+                           first_dof.begin());
+
+          parallel::apply_to_subranges(
+            0U,
+            n_cells,
+            [&](const unsigned int begin, const unsigned int end) {
+              for (unsigned int c = begin; c < end; ++c)
+                process_dofs_on_cell(DoFDistributionPass::number,
+                                     dof_handler,
+                                     cells[c],
+                                     c,
+                                     owners,
+                                     first_dof[c]);
+            },
+            grainsize);
+
+          return first_dof[n_cells];
+        }
+
+
+
+        /**
+         * Same as above for the hp::DoFHandler. Here, the dofs are always
+         * distributed sequentially.
+         */
+        template <int dim, int spacedim>
+        static types::global_dof_index
+        distribute_dofs_on_cells(
+          const std::vector<
+            typename hp::DoFHandler<dim, spacedim>::active_cell_iterator>
+            &                            cells,
+          hp::DoFHandler<dim, spacedim> &dof_handler)
+        {
+          types::global_dof_index next_free_dof = 0;
+          for (const auto &cell : cells)
+            next_free_dof =
+              distribute_dofs_on_cell(dof_handler, cell, next_free_dof);
+          return next_free_dof;
+        }
+
+
+
         /**
          * Distribute degrees of freedom on all cells, or on cells with the
          * correct subdomain_id if the corresponding argument is not equal to
@@ -2047,19 +2397,16 @@ namespace internal
 
           // Step 1: distribute dofs on all cells, but definitely
           // exclude artificial cells
-          types::global_dof_index next_free_dof = 0;
-          typename DoFHandlerType::active_cell_iterator
-            cell = dof_handler.begin_active(),
-            endc = dof_handler.end();
-
-          for (; cell != endc; ++cell)
+          std::vector<typename DoFHandlerType::active_cell_iterator> cells;
+          cells.reserve(dof_handler.get_triangulation().n_active_cells());
+          for (const auto &cell : dof_handler.active_cell_iterators())
             if (!cell->is_artificial())
               if ((subdomain_id == numbers::invalid_subdomain_id) ||
                   (cell->subdomain_id() == subdomain_id))
-                next_free_dof =
-                  Implementation::distribute_dofs_on_cell(dof_handler,
-                                                          cell,
-                                                          next_free_dof);
+                cells.push_back(cell);
+
+          const types::global_dof_index next_free_dof =
+            distribute_dofs_on_cells(cells, dof_handler);
 
           update_all_active_cell_dof_indices_caches(dof_handler);
 
@@ -2420,6 +2767,35 @@ namespace internal
         /* --------------------- renumber_dofs functionality ---------------- */
 
 
+        /**
+         * Replace every valid DoF index in @p dof_indices by its new number.
+         * The array is split into chunks that are treated in parallel.
+         *
+         * See renumber_dofs() for the meaning of the other arguments.
+         */
+        static void
+        renumber_dof_indices(
+          const std::vector<types::global_dof_index> &new_numbers,
+          const IndexSet &                            indices_we_care_about,
+          std::vector<types::global_dof_index> &      dof_indices)
+        {
+          parallel::apply_to_subranges(
+            std::size_t(0),
+            dof_indices.size(),
+            [&](const std::size_t begin, const std::size_t end) {
+              for (std::size_t i = begin; i < end; ++i)
+                if (dof_indices[i] != numbers::invalid_dof_index)
+                  dof_indices[i] =
+                    ((indices_we_care_about.size() == 0) ?
+                       new_numbers[dof_indices[i]] :
+                       new_numbers[indices_we_care_about.index_within_set(
+                         dof_indices[i])]);
+            },
+            /*grainsize=*/8192);
+        }
+
+
+
         /**
          * The part of the renumber_dofs() functionality that is dimension
          * independent because it renumbers the DoF indices on vertices
@@ -2441,21 +2817,26 @@ namespace internal
           // correct but also faster; note, however, that dof numbers
           // may be invalid_dof_index, namely when the appropriate
           // vertex/line/etc is unused
-          for (std::vector<types::global_dof_index>::iterator i =
-                 dof_handler.vertex_dofs.begin();
-               i != dof_handler.vertex_dofs.end();
-               ++i)
-            if (*i != numbers::invalid_dof_index)
-              *i = (indices_we_care_about.size() == 0) ?
-                     (new_numbers[*i]) :
-                     (new_numbers[indices_we_care_about.index_within_set(*i)]);
-            else if (check_validity)
-              // if index is invalid_dof_index: check if this one
-              // really is unused
-              Assert(dof_handler.get_triangulation().vertex_used(
-                       (i - dof_handler.vertex_dofs.begin()) /
-                       dof_handler.get_fe().dofs_per_vertex) == false,
-                     ExcInternalError());
+#ifdef DEBUG
+          if (check_validity)
+            for (std::vector<types::global_dof_index>::iterator i =
+                   dof_handler.vertex_dofs.begin();
+                 i != dof_handler.vertex_dofs.end();
+                 ++i)
+              if (*i == numbers::invalid_dof_index)
+                // if index is invalid_dof_index: check if this one
+                // really is unused
+                Assert(dof_handler.get_triangulation().vertex_used(
+                         (i - dof_handler.vertex_dofs.begin()) /
+                         dof_handler.get_fe().dofs_per_vertex) == false,
+                       ExcInternalError());
+#else
+          (void)check_validity;
+#endif
+
+          renumber_dof_indices(new_numbers,
+                               indices_we_care_about,
+                               dof_handler.vertex_dofs);
         }
 
 
@@ -2476,15 +2857,9 @@ namespace internal
         {
           for (unsigned int level = 0; level < dof_handler.levels.size();
                ++level)
-            for (std::vector<types::global_dof_index>::iterator i =
-                   dof_handler.levels[level]->dof_object.dofs.begin();
-                 i != dof_handler.levels[level]->dof_object.dofs.end();
-                 ++i)
-              if (*i != numbers::invalid_dof_index)
-                *i =
-                  ((indices_we_care_about.size() == 0) ?
-                     new_numbers[*i] :
-                     new_numbers[indices_we_care_about.index_within_set(*i)]);
+            renumber_dof_indices(new_numbers,
+                                 indices_we_care_about,
+                                 dof_handler.levels[level]->dof_object.dofs);
         }
 
 
@@ -2516,14 +2891,9 @@ namespace internal
           DoFHandler<2, spacedim> &                   dof_handler)
         {
           // treat dofs on lines
-          for (std::vector<types::global_dof_index>::iterator i =
-                 dof_handler.faces->lines.dofs.begin();
-               i != dof_handler.faces->lines.dofs.end();
-               ++i)
-            if (*i != numbers::invalid_dof_index)
-              *i = ((indices_we_care_about.size() == 0) ?
-                      new_numbers[*i] :
-                      new_numbers[indices_we_care_about.index_within_set(*i)]);
+          renumber_dof_indices(new_numbers,
+                               indices_we_care_about,
+                               dof_handler.faces->lines.dofs);
         }
 
 
@@ -2536,24 +2906,14 @@ namespace internal
           DoFHandler<3, spacedim> &                   dof_handler)
         {
           // treat dofs on lines
-          for (std::vector<types::global_dof_index>::iterator i =
-                 dof_handler.faces->lines.dofs.begin();
-               i != dof_handler.faces->lines.dofs.end();
-               ++i)
-            if (*i != numbers::invalid_dof_index)
-              *i = ((indices_we_care_about.size() == 0) ?
-                      new_numbers[*i] :
-                      new_numbers[indices_we_care_about.index_within_set(*i)]);
+          renumber_dof_indices(new_numbers,
+                               indices_we_care_about,
+                               dof_handler.faces->lines.dofs);
 
           // treat dofs on quads
-          for (std::vector<types::global_dof_index>::iterator i =
-                 dof_handler.faces->quads.dofs.begin();
-               i != dof_handler.faces->quads.dofs.end();
-               ++i)
-            if (*i != numbers::invalid_dof_index)
-              *i = ((indices_we_care_about.size() == 0) ?
-                      new_numbers[*i] :
-                      new_numbers[indices_we_care_about.index_within_set(*i)]);
+          renumber_dof_indices(new_numbers,
+                               indices_we_care_about,
+                               dof_handler.faces->quads.dofs);
         }
 
 
@@ -13,6 +13,7 @@
 //
 // ---------------------------------------------------------------------
 
+#include <deal.II/base/parallel.h>
 #include <deal.II/base/table.h>
 #include <deal.II/base/template_constraints.h>
 #include <deal.II/base/thread_management.h>
@@ -46,6 +47,7 @@
 
 #include <algorithm>
 #include <array>
+#include <functional>
 #include <memory>
 #include <numeric>
 
@@ -547,6 +549,80 @@ namespace DoFTools
             }
       }
 
+
+      /**
+       * The constraints for the dofs on the children of one refined face:
+       * each of the dofs on the children is constrained to the dofs on the
+       * mother face, with the weights given by the respective row of the
+       * matrix @p weights.
+       */
+      struct HangingFaceConstraints
+      {
+        std::vector<types::global_dof_index> dofs_on_mother;
+        std::vector<types::global_dof_index> dofs_on_children;
+        const FullMatrix<double> *           weights;
+      };
+
+
+
+      /**
+       * Call @p collect_on_cell for all non-artificial active cells to
+       * collect the constraints on the refined faces of each cell, and add
+       * them to @p constraints. The cells are split into chunks that are
+       * worked on in parallel, but the constraints are added in the order of
+       * the cells, so that the result does not depend on the number of
+       * threads.
+       */
+      template <typename DoFHandlerType, typename number>
+      void
+      add_hanging_face_constraints(
+        const DoFHandlerType &dof_handler,
+        const std::function<
+          void(const typename DoFHandlerType::active_cell_iterator &,
+               std::vector<HangingFaceConstraints> &)> &collect_on_cell,
+        AffineConstraints<number> &                     constraints)
+      {
+        // artificial cells can at best neighbor ghost cells, but we're not
+        // interested in these interfaces
+        std::vector<typename DoFHandlerType::active_cell_iterator> cells;
+        for (const auto &cell : dof_handler.active_cell_iterators())
+          if (!cell->is_artificial())
+            cells.push_back(cell);
+
+        const std::size_t chunk_size = 256;
+        const std::size_t n_chunks =
+          (cells.size() + chunk_size - 1) / chunk_size;
+        std::vector<std::vector<HangingFaceConstraints>> face_constraints(
+          n_chunks);
+        parallel::apply_to_subranges(
+          std::size_t(0),
+          n_chunks,
+          [&](const std::size_t begin, const std::size_t end) {
+            for (std::size_t chunk = begin; chunk < end; ++chunk)
+              for (std::size_t c = chunk * chunk_size;
+                   c < std::min((chunk + 1) * chunk_size, cells.size());
+                   ++c)
+                collect_on_cell(cells[c], face_constraints[chunk]);
+          },
+          1);
+
+        for (const auto &chunk : face_constraints)
+          for (const HangingFaceConstraints &face : chunk)
+            // for each row in the AffineConstraints object for this face:
+            for (unsigned int row = 0; row != face.dofs_on_children.size();
+                 ++row)
+              {
+                constraints.add_line(face.dofs_on_children[row]);
+                for (unsigned int i = 0; i != face.dofs_on_mother.size(); ++i)
+                  constraints.add_entry(face.dofs_on_children[row],
+                                        face.dofs_on_mother[i],
+                                        (*face.weights)(row, i));
+
+                constraints.set_inhomogeneity(face.dofs_on_children[row], 0.);
+              }
+      }
+
+
     } // namespace
 
 
@@ -646,9 +722,6 @@ namespace DoFTools
 
       const unsigned int spacedim = DoFHandlerType::space_dimension;
 
-      std::vector<types::global_dof_index> dofs_on_mother;
-      std::vector<types::global_dof_index> dofs_on_children;
-
       // loop over all lines; only on lines there can be constraints. We do so
       // by looping over all active cells and checking whether any of the faces
       // are refined which can only be from the neighboring cell because this
@@ -657,15 +730,11 @@ namespace DoFTools
       // note that even though we may visit a face twice if the neighboring
       // cells are equally refined, we can only visit each face with hanging
       // nodes once
-      typename DoFHandlerType::active_cell_iterator cell = dof_handler
-                                                             .begin_active(),
-                                                    endc = dof_handler.end();
-      for (; cell != endc; ++cell)
-        {
-          // artificial cells can at best neighbor ghost cells, but we're not
-          // interested in these interfaces
-          if (cell->is_artificial())
-            continue;
+      const auto collect_on_cell =
+        [&](const typename DoFHandlerType::active_cell_iterator &cell,
+            std::vector<HangingFaceConstraints> &face_constraints) {
+          std::vector<types::global_dof_index> dofs_on_mother;
+          std::vector<types::global_dof_index> dofs_on_children;
 
           for (unsigned int face = 0; face < GeometryInfo<dim>::faces_per_cell;
                ++face)
@@ -752,18 +821,8 @@ namespace DoFTools
                 Assert(dofs_on_children.size() <= n_dofs_on_children,
                        ExcInternalError());
 
-                // for each row in the AffineConstraints object for this line:
-                for (unsigned int row = 0; row != dofs_on_children.size();
-                     ++row)
-                  {
-                    constraints.add_line(dofs_on_children[row]);
-                    for (unsigned int i = 0; i != dofs_on_mother.size(); ++i)
-                      constraints.add_entry(dofs_on_children[row],
-                                            dofs_on_mother[i],
-                                            fe.constraints()(row, i));
-
-                    constraints.set_inhomogeneity(dofs_on_children[row], 0.);
-                  }
+                face_constraints.push_back(
+                  {dofs_on_mother, dofs_on_children, &fe.constraints()});
               }
             else
               {
@@ -781,7 +840,9 @@ namespace DoFTools
                            ExcInternalError());
                   }
               }
-        }
+        };
+
+      add_hanging_face_constraints(dof_handler, collect_on_cell, constraints);
     }
 
 
@@ -795,9 +856,6 @@ namespace DoFTools
     {
       const unsigned int dim = 3;
 
-      std::vector<types::global_dof_index> dofs_on_mother;
-      std::vector<types::global_dof_index> dofs_on_children;
-
       // loop over all quads; only on quads there can be constraints. We do so
       // by looping over all active cells and checking whether any of the faces
       // are refined which can only be from the neighboring cell because this
@@ -806,15 +864,11 @@ namespace DoFTools
       // note that even though we may visit a face twice if the neighboring
       // cells are equally refined, we can only visit each face with hanging
       // nodes once
-      typename DoFHandlerType::active_cell_iterator cell = dof_handler
-                                                             .begin_active(),
-                                                    endc = dof_handler.end();
-      for (; cell != endc; ++cell)
-        {
-          // artificial cells can at best neighbor ghost cells, but we're not
-          // interested in these interfaces
-          if (cell->is_artificial())
-            continue;
+      const auto collect_on_cell =
+        [&](const typename DoFHandlerType::active_cell_iterator &cell,
+            std::vector<HangingFaceConstraints> &face_constraints) {
+          std::vector<types::global_dof_index> dofs_on_mother;
+          std::vector<types::global_dof_index> dofs_on_children;
 
           for (unsigned int face = 0; face < GeometryInfo<dim>::faces_per_cell;
                ++face)
@@ -992,18 +1046,8 @@ namespace DoFTools
                 Assert(dofs_on_children.size() <= n_dofs_on_children,
                        ExcInternalError());
 
-                // for each row in the AffineConstraints object for this line:
-                for (unsigned int row = 0; row != dofs_on_children.size();
-                     ++row)
-                  {
-                    constraints.add_line(dofs_on_children[row]);
-                    for (unsigned int i = 0; i != dofs_on_mother.size(); ++i)
-                      constraints.add_entry(dofs_on_children[row],
-                                            dofs_on_mother[i],
-                                            fe.constraints()(row, i));
-
-                    constraints.set_inhomogeneity(dofs_on_children[row], 0.);
-                  }
+                face_constraints.push_back(
+                  {dofs_on_mother, dofs_on_children, &fe.constraints()});
               }
             else
               {
@@ -1021,7 +1065,9 @@ namespace DoFTools
                            ExcInternalError());
                   }
               }
-        }
+        };
+
+      add_hanging_face_constraints(dof_handler, collect_on_cell, constraints);
     }
 
 
@@ -49,6 +49,7 @@ FE_Poly<TensorProductPolynomials<1>, 1, 2>::fill_fe_values(
          ExcInternalError());
   const InternalData &fe_data =
     static_cast<const InternalData &>(fe_internal); // NOLINT
+  const FETools::ShapeTables<1> &shape_tables = *fe_data.shape_tables;
 
   // transform gradients and higher derivatives. there is nothing to do
   // for values since we already emplaced them into output_data when
@@ -56,7 +57,7 @@ FE_Poly<TensorProductPolynomials<1>, 1, 2>::fill_fe_values(
   if (fe_data.update_each & update_gradients &&
       cell_similarity != CellSimilarity::translation)
     for (unsigned int k = 0; k < this->dofs_per_cell; ++k)
-      mapping.transform(make_array_view(fe_data.shape_gradients, k),
+      mapping.transform(make_array_view(shape_tables.gradients, k),
                         mapping_covariant,
                         mapping_internal,
                         make_array_view(output_data.shape_gradients, k));
@@ -65,7 +66,7 @@ FE_Poly<TensorProductPolynomials<1>, 1, 2>::fill_fe_values(
       cell_similarity != CellSimilarity::translation)
     {
       for (unsigned int k = 0; k < this->dofs_per_cell; ++k)
-        mapping.transform(make_array_view(fe_data.shape_hessians, k),
+        mapping.transform(make_array_view(shape_tables.hessians, k),
                           mapping_covariant_gradient,
                           mapping_internal,
                           make_array_view(output_data.shape_hessians, k));
@@ -82,7 +83,7 @@ FE_Poly<TensorProductPolynomials<1>, 1, 2>::fill_fe_values(
       cell_similarity != CellSimilarity::translation)
     {
       for (unsigned int k = 0; k < this->dofs_per_cell; ++k)
-        mapping.transform(make_array_view(fe_data.shape_3rd_derivatives, k),
+        mapping.transform(make_array_view(shape_tables.third_derivatives, k),
                           mapping_covariant_hessian,
                           mapping_internal,
                           make_array_view(output_data.shape_3rd_derivatives,
@@ -118,6 +119,7 @@ FE_Poly<TensorProductPolynomials<2>, 2, 3>::fill_fe_values(
          ExcInternalError());
   const InternalData &fe_data =
     static_cast<const InternalData &>(fe_internal); // NOLINT
+  const FETools::ShapeTables<2> &shape_tables = *fe_data.shape_tables;
 
   // transform gradients and higher derivatives. there is nothing to do
   // for values since we already emplaced them into output_data when
@@ -125,7 +127,7 @@ FE_Poly<TensorProductPolynomials<2>, 2, 3>::fill_fe_values(
   if (fe_data.update_each & update_gradients &&
       cell_similarity != CellSimilarity::translation)
     for (unsigned int k = 0; k < this->dofs_per_cell; ++k)
-      mapping.transform(make_array_view(fe_data.shape_gradients, k),
+      mapping.transform(make_array_view(shape_tables.gradients, k),
                         mapping_covariant,
                         mapping_internal,
                         make_array_view(output_data.shape_gradients, k));
@@ -134,7 +136,7 @@ FE_Poly<TensorProductPolynomials<2>, 2, 3>::fill_fe_values(
       cell_similarity != CellSimilarity::translation)
     {
       for (unsigned int k = 0; k < this->dofs_per_cell; ++k)
-        mapping.transform(make_array_view(fe_data.shape_hessians, k),
+        mapping.transform(make_array_view(shape_tables.hessians, k),
                           mapping_covariant_gradient,
                           mapping_internal,
                           make_array_view(output_data.shape_hessians, k));
@@ -151,7 +153,7 @@ FE_Poly<TensorProductPolynomials<2>, 2, 3>::fill_fe_values(
       cell_similarity != CellSimilarity::translation)
     {
       for (unsigned int k = 0; k < this->dofs_per_cell; ++k)
-        mapping.transform(make_array_view(fe_data.shape_3rd_derivatives, k),
+        mapping.transform(make_array_view(shape_tables.third_derivatives, k),
                           mapping_covariant_hessian,
                           mapping_internal,
                           make_array_view(output_data.shape_3rd_derivatives,
@@ -186,6 +188,7 @@ FE_Poly<PolynomialSpace<1>, 1, 2>::fill_fe_values(
          ExcInternalError());
   const InternalData &fe_data =
     static_cast<const InternalData &>(fe_internal); // NOLINT
+  const FETools::ShapeTables<1> &shape_tables = *fe_data.shape_tables;
 
   // transform gradients and higher derivatives. there is nothing to do
   // for values since we already emplaced them into output_data when
@@ -193,7 +196,7 @@ FE_Poly<PolynomialSpace<1>, 1, 2>::fill_fe_values(
   if (fe_data.update_each & update_gradients &&
       cell_similarity != CellSimilarity::translation)
     for (unsigned int k = 0; k < this->dofs_per_cell; ++k)
-      mapping.transform(make_array_view(fe_data.shape_gradients, k),
+      mapping.transform(make_array_view(shape_tables.gradients, k),
                         mapping_covariant,
                         mapping_internal,
                         make_array_view(output_data.shape_gradients, k));
@@ -202,7 +205,7 @@ FE_Poly<PolynomialSpace<1>, 1, 2>::fill_fe_values(
       cell_similarity != CellSimilarity::translation)
     {
       for (unsigned int k = 0; k < this->dofs_per_cell; ++k)
-        mapping.transform(make_array_view(fe_data.shape_hessians, k),
+        mapping.transform(make_array_view(shape_tables.hessians, k),
                           mapping_covariant_gradient,
                           mapping_internal,
                           make_array_view(output_data.shape_hessians, k));
@@ -219,7 +222,7 @@ FE_Poly<PolynomialSpace<1>, 1, 2>::fill_fe_values(
       cell_similarity != CellSimilarity::translation)
     {
       for (unsigned int k = 0; k < this->dofs_per_cell; ++k)
-        mapping.transform(make_array_view(fe_data.shape_3rd_derivatives, k),
+        mapping.transform(make_array_view(shape_tables.third_derivatives, k),
                           mapping_covariant_hessian,
                           mapping_internal,
                           make_array_view(output_data.shape_3rd_derivatives,
@@ -254,6 +257,7 @@ FE_Poly<PolynomialSpace<2>, 2, 3>::fill_fe_values(
          ExcInternalError());
   const InternalData &fe_data =
     static_cast<const InternalData &>(fe_internal); // NOLINT
+  const FETools::ShapeTables<2> &shape_tables = *fe_data.shape_tables;
 
   // transform gradients and higher derivatives. there is nothing to do
   // for values since we already emplaced them into output_data when
@@ -261,7 +265,7 @@ FE_Poly<PolynomialSpace<2>, 2, 3>::fill_fe_values(
   if (fe_data.update_each & update_gradients &&
       cell_similarity != CellSimilarity::translation)
     for (unsigned int k = 0; k < this->dofs_per_cell; ++k)
-      mapping.transform(make_array_view(fe_data.shape_gradients, k),
+      mapping.transform(make_array_view(shape_tables.gradients, k),
                         mapping_covariant,
                         mapping_internal,
                         make_array_view(output_data.shape_gradients, k));
@@ -270,7 +274,7 @@ FE_Poly<PolynomialSpace<2>, 2, 3>::fill_fe_values(
       cell_similarity != CellSimilarity::translation)
     {
       for (unsigned int k = 0; k < this->dofs_per_cell; ++k)
-        mapping.transform(make_array_view(fe_data.shape_hessians, k),
+        mapping.transform(make_array_view(shape_tables.hessians, k),
                           mapping_covariant_gradient,
                           mapping_internal,
                           make_array_view(output_data.shape_hessians, k));
@@ -287,7 +291,7 @@ FE_Poly<PolynomialSpace<2>, 2, 3>::fill_fe_values(
       cell_similarity != CellSimilarity::translation)
     {
       for (unsigned int k = 0; k < this->dofs_per_cell; ++k)
-        mapping.transform(make_array_view(fe_data.shape_3rd_derivatives, k),
+        mapping.transform(make_array_view(shape_tables.third_derivatives, k),
                           mapping_covariant_hessian,
                           mapping_internal,
                           make_array_view(output_data.shape_3rd_derivatives,
@@ -20,12 +20,15 @@
 #include <deal.II/base/quadrature.h>
 #include <deal.II/base/signaling_nan.h>
 #include <deal.II/base/std_cxx14/memory.h>
+#include <deal.II/base/thread_local_storage.h>
 
 #include <deal.II/differentiation/ad.h>
 
 #include <deal.II/dofs/dof_accessor.h>
 
 #include <deal.II/fe/fe.h>
+#include <deal.II/fe/fe_dgq.h>
+#include <deal.II/fe/fe_q.h>
 #include <deal.II/fe/fe_values.h>
 #include <deal.II/fe/mapping_q1.h>
 
@@ -45,6 +48,9 @@
 #include <deal.II/lac/vector.h>
 #include <deal.II/lac/vector_element_access.h>
 
+#include <deal.II/matrix_free/evaluation_selector.h>
+#include <deal.II/matrix_free/shape_info.h>
+
 #include <boost/container/small_vector.hpp>
 
 #include <iomanip>
@@ -173,6 +179,10 @@ namespace FEValuesViews
         else
           shape_function_data[i].row_index = numbers::invalid_unsigned_int;
       }
+
+    for (unsigned int i = 0; i < fe.dofs_per_cell; ++i)
+      if (shape_function_data[i].is_nonzero_shape_function_component)
+        nonzero_shape_functions.push_back(i);
   }
 
 
@@ -254,6 +264,10 @@ namespace FEValuesViews
                 }
           }
       }
+
+    for (unsigned int i = 0; i < fe.dofs_per_cell; ++i)
+      if (shape_function_data[i].single_nonzero_component != -2)
+        nonzero_shape_functions.push_back(i);
   }
 
 
@@ -344,6 +358,10 @@ namespace FEValuesViews
                 }
           }
       }
+
+    for (unsigned int i = 0; i < fe.dofs_per_cell; ++i)
+      if (shape_function_data[i].single_nonzero_component != -2)
+        nonzero_shape_functions.push_back(i);
   }
 
 
@@ -424,6 +442,10 @@ namespace FEValuesViews
                 }
           }
       }
+
+    for (unsigned int i = 0; i < fe.dofs_per_cell; ++i)
+      if (shape_function_data[i].single_nonzero_component != -2)
+        nonzero_shape_functions.push_back(i);
   }
 
 
@@ -449,6 +471,7 @@ namespace FEValuesViews
       const Table<2, double> & shape_values,
       const std::vector<typename Scalar<dim, spacedim>::ShapeFunctionData>
         &shape_function_data,
+      const std::vector<unsigned int> &nonzero_shape_functions,
       std::vector<typename ProductType<Number, double>::type> &values)
     {
       const unsigned int dofs_per_cell = dof_values.size();
@@ -460,24 +483,21 @@ namespace FEValuesViews
                 values.end(),
                 dealii::internal::NumberType<Number>::value(0.0));
 
-      for (unsigned int shape_function = 0; shape_function < dofs_per_cell;
-           ++shape_function)
-        if (shape_function_data[shape_function]
-              .is_nonzero_shape_function_component)
-          {
-            const Number &value = dof_values[shape_function];
-            // For auto-differentiable numbers, the fact that a DoF value is
-            // zero does not imply that its derivatives are zero as well. So we
-            // can't filter by value for these number types.
-            if (dealii::internal::CheckForZero<Number>::value(value) == true)
-              continue;
-
-            const double *shape_value_ptr =
-              &shape_values(shape_function_data[shape_function].row_index, 0);
-            for (unsigned int q_point = 0; q_point < n_quadrature_points;
-                 ++q_point)
-              values[q_point] += value * (*shape_value_ptr++);
-          }
+      for (const unsigned int shape_function : nonzero_shape_functions)
+        {
+          const Number &value = dof_values[shape_function];
+          // For auto-differentiable numbers, the fact that a DoF value is
+          // zero does not imply that its derivatives are zero as well. So we
+          // can't filter by value for these number types.
+          if (dealii::internal::CheckForZero<Number>::value(value) == true)
+            continue;
+
+          const double *shape_value_ptr =
+            &shape_values(shape_function_data[shape_function].row_index, 0);
+          for (unsigned int q_point = 0; q_point < n_quadrature_points;
+               ++q_point)
+            values[q_point] += value * (*shape_value_ptr++);
+        }
     }
 
 
@@ -491,6 +511,7 @@ namespace FEValuesViews
       const Table<2, dealii::Tensor<order, spacedim>> &shape_derivatives,
       const std::vector<typename Scalar<dim, spacedim>::ShapeFunctionData>
         &shape_function_data,
+      const std::vector<unsigned int> &nonzero_shape_functions,
       std::vector<
         typename ProductType<Number, dealii::Tensor<order, spacedim>>::type>
         &derivatives)
@@ -505,25 +526,22 @@ namespace FEValuesViews
         derivatives.end(),
         typename ProductType<Number, dealii::Tensor<order, spacedim>>::type());
 
-      for (unsigned int shape_function = 0; shape_function < dofs_per_cell;
-           ++shape_function)
-        if (shape_function_data[shape_function]
-              .is_nonzero_shape_function_component)
-          {
-            const Number &value = dof_values[shape_function];
-            // For auto-differentiable numbers, the fact that a DoF value is
-            // zero does not imply that its derivatives are zero as well. So we
-            // can't filter by value for these number types.
-            if (dealii::internal::CheckForZero<Number>::value(value) == true)
-              continue;
-
-            const dealii::Tensor<order, spacedim> *shape_derivative_ptr =
-              &shape_derivatives[shape_function_data[shape_function].row_index]
-                                [0];
-            for (unsigned int q_point = 0; q_point < n_quadrature_points;
-                 ++q_point)
-              derivatives[q_point] += value * (*shape_derivative_ptr++);
-          }
+      for (const unsigned int shape_function : nonzero_shape_functions)
+        {
+          const Number &value = dof_values[shape_function];
+          // For auto-differentiable numbers, the fact that a DoF value is
+          // zero does not imply that its derivatives are zero as well. So we
+          // can't filter by value for these number types.
+          if (dealii::internal::CheckForZero<Number>::value(value) == true)
+            continue;
+
+          const dealii::Tensor<order, spacedim> *shape_derivative_ptr =
+            &shape_derivatives[shape_function_data[shape_function].row_index]
+                              [0];
+          for (unsigned int q_point = 0; q_point < n_quadrature_points;
+               ++q_point)
+            derivatives[q_point] += value * (*shape_derivative_ptr++);
+        }
     }
 
 
@@ -535,6 +553,7 @@ namespace FEValuesViews
       const Table<2, dealii::Tensor<2, spacedim>> &shape_hessians,
       const std::vector<typename Scalar<dim, spacedim>::ShapeFunctionData>
         &                         shape_function_data,
+      const std::vector<unsigned int> &nonzero_shape_functions,
       std::vector<typename Scalar<dim, spacedim>::template OutputType<
         Number>::laplacian_type> &laplacians)
     {
@@ -548,24 +567,21 @@ namespace FEValuesViews
                 typename Scalar<dim, spacedim>::template OutputType<
                   Number>::laplacian_type());
 
-      for (unsigned int shape_function = 0; shape_function < dofs_per_cell;
-           ++shape_function)
-        if (shape_function_data[shape_function]
-              .is_nonzero_shape_function_component)
-          {
-            const Number &value = dof_values[shape_function];
-            // For auto-differentiable numbers, the fact that a DoF value is
-            // zero does not imply that its derivatives are zero as well. So we
-            // can't filter by value for these number types.
-            if (dealii::internal::CheckForZero<Number>::value(value) == true)
-              continue;
-
-            const dealii::Tensor<2, spacedim> *shape_hessian_ptr =
-              &shape_hessians[shape_function_data[shape_function].row_index][0];
-            for (unsigned int q_point = 0; q_point < n_quadrature_points;
-                 ++q_point)
-              laplacians[q_point] += value * trace(*shape_hessian_ptr++);
-          }
+      for (const unsigned int shape_function : nonzero_shape_functions)
+        {
+          const Number &value = dof_values[shape_function];
+          // For auto-differentiable numbers, the fact that a DoF value is
+          // zero does not imply that its derivatives are zero as well. So we
+          // can't filter by value for these number types.
+          if (dealii::internal::CheckForZero<Number>::value(value) == true)
+            continue;
+
+          const dealii::Tensor<2, spacedim> *shape_hessian_ptr =
+            &shape_hessians[shape_function_data[shape_function].row_index][0];
+          for (unsigned int q_point = 0; q_point < n_quadrature_points;
+               ++q_point)
+            laplacians[q_point] += value * trace(*shape_hessian_ptr++);
+        }
     }
 
 
@@ -579,6 +595,7 @@ namespace FEValuesViews
       const Table<2, double> & shape_values,
       const std::vector<typename Vector<dim, spacedim>::ShapeFunctionData>
         &shape_function_data,
+      const std::vector<unsigned int> &nonzero_shape_functions,
       std::vector<
         typename ProductType<Number, dealii::Tensor<1, spacedim>>::type>
         &values)
@@ -593,16 +610,11 @@ namespace FEValuesViews
         values.end(),
         typename ProductType<Number, dealii::Tensor<1, spacedim>>::type());
 
-      for (unsigned int shape_function = 0; shape_function < dofs_per_cell;
-           ++shape_function)
+      for (const unsigned int shape_function : nonzero_shape_functions)
         {
           const int snc =
             shape_function_data[shape_function].single_nonzero_component;
 
-          if (snc == -2)
-            // shape function is zero for the selected components
-            continue;
-
           const Number &value = dof_values[shape_function];
           // For auto-differentiable numbers, the fact that a DoF value is zero
           // does not imply that its derivatives are zero as well. So we
@@ -642,6 +654,7 @@ namespace FEValuesViews
       const Table<2, dealii::Tensor<order, spacedim>> &shape_derivatives,
       const std::vector<typename Vector<dim, spacedim>::ShapeFunctionData>
         &shape_function_data,
+      const std::vector<unsigned int> &nonzero_shape_functions,
       std::vector<
         typename ProductType<Number, dealii::Tensor<order + 1, spacedim>>::type>
         &derivatives)
@@ -657,16 +670,11 @@ namespace FEValuesViews
         typename ProductType<Number,
                              dealii::Tensor<order + 1, spacedim>>::type());
 
-      for (unsigned int shape_function = 0; shape_function < dofs_per_cell;
-           ++shape_function)
+      for (const unsigned int shape_function : nonzero_shape_functions)
         {
           const int snc =
             shape_function_data[shape_function].single_nonzero_component;
 
-          if (snc == -2)
-            // shape function is zero for the selected components
-            continue;
-
           const Number &value = dof_values[shape_function];
           // For auto-differentiable numbers, the fact that a DoF value is zero
           // does not imply that its derivatives are zero as well. So we
@@ -709,6 +717,7 @@ namespace FEValuesViews
       const Table<2, dealii::Tensor<1, spacedim>> &shape_gradients,
       const std::vector<typename Vector<dim, spacedim>::ShapeFunctionData>
         &shape_function_data,
+      const std::vector<unsigned int> &nonzero_shape_functions,
       std::vector<
         typename ProductType<Number,
                              dealii::SymmetricTensor<2, spacedim>>::type>
@@ -726,16 +735,11 @@ namespace FEValuesViews
         typename ProductType<Number,
                              dealii::SymmetricTensor<2, spacedim>>::type());
 
-      for (unsigned int shape_function = 0; shape_function < dofs_per_cell;
-           ++shape_function)
+      for (const unsigned int shape_function : nonzero_shape_functions)
         {
           const int snc =
             shape_function_data[shape_function].single_nonzero_component;
 
-          if (snc == -2)
-            // shape function is zero for the selected components
-            continue;
-
           const Number &value = dof_values[shape_function];
           // For auto-differentiable numbers, the fact that a DoF value is zero
           // does not imply that its derivatives are zero as well. So we
@@ -782,6 +786,7 @@ namespace FEValuesViews
       const Table<2, dealii::Tensor<1, spacedim>> &shape_gradients,
       const std::vector<typename Vector<dim, spacedim>::ShapeFunctionData>
         &                          shape_function_data,
+      const std::vector<unsigned int> &nonzero_shape_functions,
       std::vector<typename Vector<dim, spacedim>::template OutputType<
         Number>::divergence_type> &divergences)
     {
@@ -795,16 +800,11 @@ namespace FEValuesViews
                 typename Vector<dim, spacedim>::template OutputType<
                   Number>::divergence_type());
 
-      for (unsigned int shape_function = 0; shape_function < dofs_per_cell;
-           ++shape_function)
+      for (const unsigned int shape_function : nonzero_shape_functions)
         {
           const int snc =
             shape_function_data[shape_function].single_nonzero_component;
 
-          if (snc == -2)
-            // shape function is zero for the selected components
-            continue;
-
           const Number &value = dof_values[shape_function];
           // For auto-differentiable numbers, the fact that a DoF value is zero
           // does not imply that its derivatives are zero as well. So we
@@ -846,6 +846,7 @@ namespace FEValuesViews
       const Table<2, dealii::Tensor<1, spacedim>> &shape_gradients,
       const std::vector<typename Vector<dim, spacedim>::ShapeFunctionData>
         &shape_function_data,
+      const std::vector<unsigned int> &nonzero_shape_functions,
       std::vector<typename ProductType<
         Number,
         typename dealii::internal::CurlType<spacedim>::type>::type> &curls)
@@ -873,17 +874,11 @@ namespace FEValuesViews
 
           case 2:
             {
-              for (unsigned int shape_function = 0;
-                   shape_function < dofs_per_cell;
-                   ++shape_function)
+              for (const unsigned int shape_function : nonzero_shape_functions)
                 {
                   const int snc = shape_function_data[shape_function]
                                     .single_nonzero_component;
 
-                  if (snc == -2)
-                    // shape function is zero for the selected components
-                    continue;
-
                   const Number &value = dof_values[shape_function];
                   // For auto-differentiable numbers, the fact that a DoF value
                   // is zero does not imply that its derivatives are zero as
@@ -957,17 +952,11 @@ namespace FEValuesViews
 
           case 3:
             {
-              for (unsigned int shape_function = 0;
-                   shape_function < dofs_per_cell;
-                   ++shape_function)
+              for (const unsigned int shape_function : nonzero_shape_functions)
                 {
                   const int snc = shape_function_data[shape_function]
                                     .single_nonzero_component;
 
-                  if (snc == -2)
-                    // shape function is zero for the selected components
-                    continue;
-
                   const Number &value = dof_values[shape_function];
                   // For auto-differentiable numbers, the fact that a DoF value
                   // is zero does not imply that its derivatives are zero as
@@ -1110,6 +1099,7 @@ namespace FEValuesViews
       const Table<2, dealii::Tensor<2, spacedim>> &shape_hessians,
       const std::vector<typename Vector<dim, spacedim>::ShapeFunctionData>
         &                         shape_function_data,
+      const std::vector<unsigned int> &nonzero_shape_functions,
       std::vector<typename Vector<dim, spacedim>::template OutputType<
         Number>::laplacian_type> &laplacians)
     {
@@ -1123,16 +1113,11 @@ namespace FEValuesViews
                 typename Vector<dim, spacedim>::template OutputType<
                   Number>::laplacian_type());
 
-      for (unsigned int shape_function = 0; shape_function < dofs_per_cell;
-           ++shape_function)
+      for (const unsigned int shape_function : nonzero_shape_functions)
         {
           const int snc =
             shape_function_data[shape_function].single_nonzero_component;
 
-          if (snc == -2)
-            // shape function is zero for the selected components
-            continue;
-
           const Number &value = dof_values[shape_function];
           // For auto-differentiable numbers, the fact that a DoF value is zero
           // does not imply that its derivatives are zero as well. So we
@@ -1179,6 +1164,7 @@ namespace FEValuesViews
       const std::vector<
         typename SymmetricTensor<2, dim, spacedim>::ShapeFunctionData>
         &shape_function_data,
+      const std::vector<unsigned int> &nonzero_shape_functions,
       std::vector<
         typename ProductType<Number,
                              dealii::SymmetricTensor<2, spacedim>>::type>
@@ -1195,16 +1181,11 @@ namespace FEValuesViews
         typename ProductType<Number,
                              dealii::SymmetricTensor<2, spacedim>>::type());
 
-      for (unsigned int shape_function = 0; shape_function < dofs_per_cell;
-           ++shape_function)
+      for (const unsigned int shape_function : nonzero_shape_functions)
         {
           const int snc =
             shape_function_data[shape_function].single_nonzero_component;
 
-          if (snc == -2)
-            // shape function is zero for the selected components
-            continue;
-
           const Number &value = dof_values[shape_function];
           // For auto-differentiable numbers, the fact that a DoF value is zero
           // does not imply that its derivatives are zero as well. So we
@@ -1253,6 +1234,7 @@ namespace FEValuesViews
       const std::vector<
         typename SymmetricTensor<2, dim, spacedim>::ShapeFunctionData>
         &shape_function_data,
+      const std::vector<unsigned int> &nonzero_shape_functions,
       std::vector<typename SymmetricTensor<2, dim, spacedim>::
                     template OutputType<Number>::divergence_type> &divergences)
     {
@@ -1266,16 +1248,11 @@ namespace FEValuesViews
                 typename SymmetricTensor<2, dim, spacedim>::template OutputType<
                   Number>::divergence_type());
 
-      for (unsigned int shape_function = 0; shape_function < dofs_per_cell;
-           ++shape_function)
+      for (const unsigned int shape_function : nonzero_shape_functions)
         {
           const int snc =
             shape_function_data[shape_function].single_nonzero_component;
 
-          if (snc == -2)
-            // shape function is zero for the selected components
-            continue;
-
           const Number &value = dof_values[shape_function];
           // For auto-differentiable numbers, the fact that a DoF value is zero
           // does not imply that its derivatives are zero as well. So we
@@ -1361,6 +1338,7 @@ namespace FEValuesViews
       const dealii::Table<2, double> &shape_values,
       const std::vector<typename Tensor<2, dim, spacedim>::ShapeFunctionData>
         &shape_function_data,
+      const std::vector<unsigned int> &nonzero_shape_functions,
       std::vector<
         typename ProductType<Number, dealii::Tensor<2, spacedim>>::type>
         &values)
@@ -1375,16 +1353,11 @@ namespace FEValuesViews
         values.end(),
         typename ProductType<Number, dealii::Tensor<2, spacedim>>::type());
 
-      for (unsigned int shape_function = 0; shape_function < dofs_per_cell;
-           ++shape_function)
+      for (const unsigned int shape_function : nonzero_shape_functions)
         {
           const int snc =
             shape_function_data[shape_function].single_nonzero_component;
 
-          if (snc == -2)
-            // shape function is zero for the selected components
-            continue;
-
           const Number &value = dof_values[shape_function];
           // For auto-differentiable numbers, the fact that a DoF value is zero
           // does not imply that its derivatives are zero as well. So we
@@ -1433,6 +1406,7 @@ namespace FEValuesViews
       const Table<2, dealii::Tensor<1, spacedim>> &shape_gradients,
       const std::vector<typename Tensor<2, dim, spacedim>::ShapeFunctionData>
         &                          shape_function_data,
+      const std::vector<unsigned int> &nonzero_shape_functions,
       std::vector<typename Tensor<2, dim, spacedim>::template OutputType<
         Number>::divergence_type> &divergences)
     {
@@ -1446,16 +1420,11 @@ namespace FEValuesViews
                 typename Tensor<2, dim, spacedim>::template OutputType<
                   Number>::divergence_type());
 
-      for (unsigned int shape_function = 0; shape_function < dofs_per_cell;
-           ++shape_function)
+      for (const unsigned int shape_function : nonzero_shape_functions)
         {
           const int snc =
             shape_function_data[shape_function].single_nonzero_component;
 
-          if (snc == -2)
-            // shape function is zero for the selected components
-            continue;
-
           const Number &value = dof_values[shape_function];
           // For auto-differentiable numbers, the fact that a DoF value is zero
           // does not imply that its derivatives are zero as well. So we
@@ -1504,6 +1473,7 @@ namespace FEValuesViews
       const Table<2, dealii::Tensor<1, spacedim>> &shape_gradients,
       const std::vector<typename Tensor<2, dim, spacedim>::ShapeFunctionData>
         &                        shape_function_data,
+      const std::vector<unsigned int> &nonzero_shape_functions,
       std::vector<typename Tensor<2, dim, spacedim>::template OutputType<
         Number>::gradient_type> &gradients)
     {
@@ -1517,16 +1487,11 @@ namespace FEValuesViews
                 typename Tensor<2, dim, spacedim>::template OutputType<
                   Number>::gradient_type());
 
-      for (unsigned int shape_function = 0; shape_function < dofs_per_cell;
-           ++shape_function)
+      for (const unsigned int shape_function : nonzero_shape_functions)
         {
           const int snc =
             shape_function_data[shape_function].single_nonzero_component;
 
-          if (snc == -2)
-            // shape function is zero for the selected components
-            continue;
-
           const Number &value = dof_values[shape_function];
           // For auto-differentiable numbers, the fact that a DoF value is zero
           // does not imply that its derivatives are zero as well. So we
@@ -1597,6 +1562,7 @@ namespace FEValuesViews
       make_array_view(dof_values.begin(), dof_values.end()),
       fe_values->finite_element_output.shape_values,
       shape_function_data,
+      nonzero_shape_functions,
       values);
   }
 
@@ -1622,6 +1588,7 @@ namespace FEValuesViews
       make_array_view(dof_values.begin(), dof_values.end()),
       fe_values->finite_element_output.shape_values,
       shape_function_data,
+      nonzero_shape_functions,
       values);
   }
 
@@ -1653,6 +1620,7 @@ namespace FEValuesViews
       make_array_view(dof_values.begin(), dof_values.end()),
       fe_values->finite_element_output.shape_gradients,
       shape_function_data,
+      nonzero_shape_functions,
       gradients);
   }
 
@@ -1678,6 +1646,7 @@ namespace FEValuesViews
       make_array_view(dof_values.begin(), dof_values.end()),
       fe_values->finite_element_output.shape_gradients,
       shape_function_data,
+      nonzero_shape_functions,
       gradients);
   }
 
@@ -1709,6 +1678,7 @@ namespace FEValuesViews
       make_array_view(dof_values.begin(), dof_values.end()),
       fe_values->finite_element_output.shape_hessians,
       shape_function_data,
+      nonzero_shape_functions,
       hessians);
   }
 
@@ -1734,6 +1704,7 @@ namespace FEValuesViews
       make_array_view(dof_values.begin(), dof_values.end()),
       fe_values->finite_element_output.shape_hessians,
       shape_function_data,
+      nonzero_shape_functions,
       hessians);
   }
 
@@ -1765,6 +1736,7 @@ namespace FEValuesViews
       make_array_view(dof_values.begin(), dof_values.end()),
       fe_values->finite_element_output.shape_hessians,
       shape_function_data,
+      nonzero_shape_functions,
       laplacians);
   }
 
@@ -1790,6 +1762,7 @@ namespace FEValuesViews
       make_array_view(dof_values.begin(), dof_values.end()),
       fe_values->finite_element_output.shape_hessians,
       shape_function_data,
+      nonzero_shape_functions,
       laplacians);
   }
 
@@ -1821,6 +1794,7 @@ namespace FEValuesViews
       make_array_view(dof_values.begin(), dof_values.end()),
       fe_values->finite_element_output.shape_3rd_derivatives,
       shape_function_data,
+      nonzero_shape_functions,
       third_derivatives);
   }
 
@@ -1845,6 +1819,7 @@ namespace FEValuesViews
       make_array_view(dof_values.begin(), dof_values.end()),
       fe_values->finite_element_output.shape_3rd_derivatives,
       shape_function_data,
+      nonzero_shape_functions,
       third_derivatives);
   }
 
@@ -1876,6 +1851,7 @@ namespace FEValuesViews
       make_array_view(dof_values.begin(), dof_values.end()),
       fe_values->finite_element_output.shape_values,
       shape_function_data,
+      nonzero_shape_functions,
       values);
   }
 
@@ -1901,6 +1877,7 @@ namespace FEValuesViews
       make_array_view(dof_values.begin(), dof_values.end()),
       fe_values->finite_element_output.shape_values,
       shape_function_data,
+      nonzero_shape_functions,
       values);
   }
 
@@ -1932,6 +1909,7 @@ namespace FEValuesViews
       make_array_view(dof_values.begin(), dof_values.end()),
       fe_values->finite_element_output.shape_gradients,
       shape_function_data,
+      nonzero_shape_functions,
       gradients);
   }
 
@@ -1957,6 +1935,7 @@ namespace FEValuesViews
       make_array_view(dof_values.begin(), dof_values.end()),
       fe_values->finite_element_output.shape_gradients,
       shape_function_data,
+      nonzero_shape_functions,
       gradients);
   }
 
@@ -1988,6 +1967,7 @@ namespace FEValuesViews
       make_array_view(dof_values.begin(), dof_values.end()),
       fe_values->finite_element_output.shape_gradients,
       shape_function_data,
+      nonzero_shape_functions,
       symmetric_gradients);
   }
 
@@ -2012,6 +1992,7 @@ namespace FEValuesViews
       make_array_view(dof_values.begin(), dof_values.end()),
       fe_values->finite_element_output.shape_gradients,
       shape_function_data,
+      nonzero_shape_functions,
       symmetric_gradients);
   }
 
@@ -2044,6 +2025,7 @@ namespace FEValuesViews
       make_array_view(dof_values.begin(), dof_values.end()),
       fe_values->finite_element_output.shape_gradients,
       shape_function_data,
+      nonzero_shape_functions,
       divergences);
   }
 
@@ -2069,6 +2051,7 @@ namespace FEValuesViews
       make_array_view(dof_values.begin(), dof_values.end()),
       fe_values->finite_element_output.shape_gradients,
       shape_function_data,
+      nonzero_shape_functions,
       divergences);
   }
 
@@ -2100,6 +2083,7 @@ namespace FEValuesViews
       make_array_view(dof_values.begin(), dof_values.end()),
       fe_values->finite_element_output.shape_gradients,
       shape_function_data,
+      nonzero_shape_functions,
       curls);
   }
 
@@ -2125,6 +2109,7 @@ namespace FEValuesViews
       make_array_view(dof_values.begin(), dof_values.end()),
       fe_values->finite_element_output.shape_gradients,
       shape_function_data,
+      nonzero_shape_functions,
       curls);
   }
 
@@ -2156,6 +2141,7 @@ namespace FEValuesViews
       make_array_view(dof_values.begin(), dof_values.end()),
       fe_values->finite_element_output.shape_hessians,
       shape_function_data,
+      nonzero_shape_functions,
       hessians);
   }
 
@@ -2181,6 +2167,7 @@ namespace FEValuesViews
       make_array_view(dof_values.begin(), dof_values.end()),
       fe_values->finite_element_output.shape_hessians,
       shape_function_data,
+      nonzero_shape_functions,
       hessians);
   }
 
@@ -2217,6 +2204,7 @@ namespace FEValuesViews
       make_array_view(dof_values.begin(), dof_values.end()),
       fe_values->finite_element_output.shape_hessians,
       shape_function_data,
+      nonzero_shape_functions,
       laplacians);
   }
 
@@ -2245,6 +2233,7 @@ namespace FEValuesViews
       make_array_view(dof_values.begin(), dof_values.end()),
       fe_values->finite_element_output.shape_hessians,
       shape_function_data,
+      nonzero_shape_functions,
       laplacians);
   }
 
@@ -2276,6 +2265,7 @@ namespace FEValuesViews
       make_array_view(dof_values.begin(), dof_values.end()),
       fe_values->finite_element_output.shape_3rd_derivatives,
       shape_function_data,
+      nonzero_shape_functions,
       third_derivatives);
   }
 
@@ -2300,6 +2290,7 @@ namespace FEValuesViews
       make_array_view(dof_values.begin(), dof_values.end()),
       fe_values->finite_element_output.shape_3rd_derivatives,
       shape_function_data,
+      nonzero_shape_functions,
       third_derivatives);
   }
 
@@ -2331,6 +2322,7 @@ namespace FEValuesViews
       make_array_view(dof_values.begin(), dof_values.end()),
       fe_values->finite_element_output.shape_values,
       shape_function_data,
+      nonzero_shape_functions,
       values);
   }
 
@@ -2356,6 +2348,7 @@ namespace FEValuesViews
       make_array_view(dof_values.begin(), dof_values.end()),
       fe_values->finite_element_output.shape_values,
       shape_function_data,
+      nonzero_shape_functions,
       values);
   }
 
@@ -2388,6 +2381,7 @@ namespace FEValuesViews
       make_array_view(dof_values.begin(), dof_values.end()),
       fe_values->finite_element_output.shape_gradients,
       shape_function_data,
+      nonzero_shape_functions,
       divergences);
   }
 
@@ -2414,6 +2408,7 @@ namespace FEValuesViews
       make_array_view(dof_values.begin(), dof_values.end()),
       fe_values->finite_element_output.shape_gradients,
       shape_function_data,
+      nonzero_shape_functions,
       divergences);
   }
 
@@ -2445,6 +2440,7 @@ namespace FEValuesViews
       make_array_view(dof_values.begin(), dof_values.end()),
       fe_values->finite_element_output.shape_values,
       shape_function_data,
+      nonzero_shape_functions,
       values);
   }
 
@@ -2470,6 +2466,7 @@ namespace FEValuesViews
       make_array_view(dof_values.begin(), dof_values.end()),
       fe_values->finite_element_output.shape_values,
       shape_function_data,
+      nonzero_shape_functions,
       values);
   }
 
@@ -2502,6 +2499,7 @@ namespace FEValuesViews
       make_array_view(dof_values.begin(), dof_values.end()),
       fe_values->finite_element_output.shape_gradients,
       shape_function_data,
+      nonzero_shape_functions,
       divergences);
   }
 
@@ -2527,6 +2525,7 @@ namespace FEValuesViews
       make_array_view(dof_values.begin(), dof_values.end()),
       fe_values->finite_element_output.shape_gradients,
       shape_function_data,
+      nonzero_shape_functions,
       divergences);
   }
 
@@ -2559,6 +2558,7 @@ namespace FEValuesViews
       make_array_view(dof_values.begin(), dof_values.end()),
       fe_values->finite_element_output.shape_gradients,
       shape_function_data,
+      nonzero_shape_functions,
       gradients);
   }
 
@@ -2584,6 +2584,7 @@ namespace FEValuesViews
       make_array_view(dof_values.begin(), dof_values.end()),
       fe_values->finite_element_output.shape_gradients,
       shape_function_data,
+      nonzero_shape_functions,
       gradients);
   }
 
@@ -3071,6 +3072,434 @@ namespace internal
         MemoryConsumption::memory_consumption(shape_3rd_derivatives) +
         MemoryConsumption::memory_consumption(shape_function_to_row_table));
     }
+
+
+
+    /**
+     * A class that evaluates finite element functions and their gradients
+     * in the quadrature points of a cell with the sum factorization kernels
+     * of the matrix-free framework, see the documentation of
+     * FEValuesBase::tensor_product_evaluator for when this is possible. The
+     * results agree with the ones computed from the full shape function
+     * matrices up to roundoff.
+     */
+    template <int dim>
+    class TensorProductEvaluator
+    {
+    public:
+      /**
+       * Constructor. Sets up the one-dimensional shape data of the base
+       * element of @p fe in the points of @p quadrature_1d.
+       */
+      TensorProductEvaluator(const FiniteElement<dim> &fe,
+                             const Quadrature<1> &     quadrature_1d);
+
+      /**
+       * Compute the values of a scalar finite element function with the
+       * local coefficients @p dof_values.
+       */
+      void
+      get_function_values(const double *       dof_values,
+                          std::vector<double> &values) const;
+
+      /**
+       * Compute the values of all components of a vector-valued finite
+       * element function with the local coefficients @p dof_values.
+       */
+      void
+      get_function_values(const double *                dof_values,
+                          std::vector<Vector<double>> &values) const;
+
+      /**
+       * Compute the gradients of a scalar finite element function with the
+       * local coefficients @p dof_values. The gradients on the reference
+       * cell are transformed to the real cell by @p mapping.
+       */
+      template <int spacedim>
+      void
+      get_function_gradients(
+        const double *                                           dof_values,
+        const Mapping<dim, spacedim> &                           mapping,
+        const typename Mapping<dim, spacedim>::InternalDataBase &mapping_data,
+        std::vector<Tensor<1, spacedim>> &gradients) const;
+
+      /**
+       * Same as above for all components of a vector-valued finite element
+       * function.
+       */
+      template <int spacedim>
+      void
+      get_function_gradients(
+        const double *                                           dof_values,
+        const Mapping<dim, spacedim> &                           mapping,
+        const typename Mapping<dim, spacedim>::InternalDataBase &mapping_data,
+        std::vector<std::vector<Tensor<1, spacedim>>> &gradients) const;
+
+    private:
+      /**
+       * Scratch arrays for the input and the output of the kernels. The
+       * gradients are stored component by component, and for each component
+       * direction by direction.
+       */
+      struct ScratchData
+      {
+        AlignedVector<double> values_dofs;
+        AlignedVector<double> values_quad;
+        AlignedVector<double> gradients_quad;
+        AlignedVector<double> scratch;
+
+        /**
+         * Reference-cell gradients of one component, used as input to
+         * Mapping::transform().
+         */
+        std::vector<Tensor<1, dim>> unit_gradients;
+      };
+
+      /**
+       * Return the scratch arrays of the current thread, setting them up
+       * upon the first call on this thread.
+       */
+      ScratchData &
+      get_scratch_data() const;
+
+      /**
+       * Run the sum factorization kernels on the local coefficients
+       * @p dof_values given in the numbering of the finite element, filling
+       * the fields values_quad and, if requested, gradients_quad of
+       * @p scratch_data.
+       */
+      void
+      evaluate(const double *dof_values,
+               const bool    evaluate_gradients,
+               ScratchData & scratch_data) const;
+
+      /**
+       * Transform the reference-cell gradients of component @p component
+       * computed by the last call to evaluate() with @p scratch_data to the
+       * real cell.
+       */
+      template <int spacedim>
+      void
+      transform_gradients(
+        const unsigned int                                       component,
+        const Mapping<dim, spacedim> &                           mapping,
+        const typename Mapping<dim, spacedim>::InternalDataBase &mapping_data,
+        ScratchData &                                            scratch_data,
+        std::vector<Tensor<1, spacedim>> &gradients) const;
+
+      /**
+       * The one-dimensional shape data and the renumbering of degrees of
+       * freedom into the lexicographic order used by the kernels.
+       */
+      MatrixFreeFunctions::ShapeInfo<double> shape_info;
+
+      /**
+       * The number of vector components of the finite element.
+       */
+      const unsigned int n_components;
+
+      /**
+       * The scratch arrays, one set for each thread, such that the const
+       * member functions of this class, and thus the
+       * FEValuesBase::get_function_values() and
+       * FEValuesBase::get_function_gradients() functions that use them, can
+       * be called concurrently on the same object.
+       */
+      mutable Threads::ThreadLocalStorage<ScratchData> scratch_data;
+    };
+
+
+
+    template <int dim>
+    TensorProductEvaluator<dim>::TensorProductEvaluator(
+      const FiniteElement<dim> &fe,
+      const Quadrature<1> &     quadrature_1d)
+      : shape_info(quadrature_1d, fe, 0)
+      , n_components(fe.n_components())
+    {}
+
+
+
+    template <int dim>
+    typename TensorProductEvaluator<dim>::ScratchData &
+    TensorProductEvaluator<dim>::get_scratch_data() const
+    {
+      bool         exists = false;
+      ScratchData &data   = scratch_data.get(exists);
+      if (exists == false)
+        {
+          const unsigned int dofs_per_component =
+            shape_info.dofs_per_component_on_cell;
+          const unsigned int n_q_points = shape_info.n_q_points;
+
+          data.values_dofs.resize(n_components * dofs_per_component);
+          data.values_quad.resize(n_components * n_q_points);
+          data.gradients_quad.resize(n_components * dim * n_q_points);
+          data.scratch.resize(3 * std::max(dofs_per_component, n_q_points));
+          data.unit_gradients.resize(n_q_points);
+        }
+      return data;
+    }
+
+
+
+    template <int dim>
+    void
+    TensorProductEvaluator<dim>::evaluate(const double *dof_values,
+                                          const bool    evaluate_gradients,
+                                          ScratchData & scratch_data) const
+    {
+      const std::vector<unsigned int> &renumber =
+        shape_info.lexicographic_numbering;
+      for (unsigned int i = 0; i < scratch_data.values_dofs.size(); ++i)
+        scratch_data.values_dofs[i] = dof_values[renumber[i]];
+
+      const unsigned int dofs_per_component =
+        shape_info.dofs_per_component_on_cell;
+      const unsigned int n_q_points = shape_info.n_q_points;
+      for (unsigned int c = 0; c < n_components; ++c)
+        SelectEvaluator<dim, -1, 0, 1, double>::evaluate(
+          shape_info,
+          scratch_data.values_dofs.begin() + c * dofs_per_component,
+          scratch_data.values_quad.begin() + c * n_q_points,
+          scratch_data.gradients_quad.begin() + c * dim * n_q_points,
+          nullptr,
+          scratch_data.scratch.begin(),
+          true,
+          evaluate_gradients,
+          false);
+    }
+
+
+
+    template <int dim>
+    void
+    TensorProductEvaluator<dim>::get_function_values(
+      const double *       dof_values,
+      std::vector<double> &values) const
+    {
+      AssertDimension(n_components, 1);
+      AssertDimension(values.size(), shape_info.n_q_points);
+
+      ScratchData &scratch_data = get_scratch_data();
+      evaluate(dof_values, false, scratch_data);
+      std::copy(scratch_data.values_quad.begin(),
+                scratch_data.values_quad.end(),
+                values.begin());
+    }
+
+
+
+    template <int dim>
+    void
+    TensorProductEvaluator<dim>::get_function_values(
+      const double *                dof_values,
+      std::vector<Vector<double>> &values) const
+    {
+      const unsigned int n_q_points = shape_info.n_q_points;
+      AssertDimension(values.size(), n_q_points);
+
+      ScratchData &scratch_data = get_scratch_data();
+      evaluate(dof_values, false, scratch_data);
+      for (unsigned int q = 0; q < n_q_points; ++q)
+        {
+          AssertDimension(values[q].size(), n_components);
+          for (unsigned int c = 0; c < n_components; ++c)
+            values[q](c) = scratch_data.values_quad[c * n_q_points + q];
+        }
+    }
+
+
+
+    template <int dim>
+    template <int spacedim>
+    void
+    TensorProductEvaluator<dim>::transform_gradients(
+      const unsigned int                                       component,
+      const Mapping<dim, spacedim> &                           mapping,
+      const typename Mapping<dim, spacedim>::InternalDataBase &mapping_data,
+      ScratchData &                                            scratch_data,
+      std::vector<Tensor<1, spacedim>> &                       gradients) const
+    {
+      const unsigned int n_q_points = shape_info.n_q_points;
+      const double *     gradients_component =
+        scratch_data.gradients_quad.begin() + component * dim * n_q_points;
+      for (unsigned int q = 0; q < n_q_points; ++q)
+        for (unsigned int d = 0; d < dim; ++d)
+          scratch_data.unit_gradients[q][d] =
+            gradients_component[d * n_q_points + q];
+
+      mapping.transform(make_array_view(scratch_data.unit_gradients),
+                        mapping_covariant,
+                        mapping_data,
+                        make_array_view(gradients));
+    }
+
+
+
+    template <int dim>
+    template <int spacedim>
+    void
+    TensorProductEvaluator<dim>::get_function_gradients(
+      const double *                                           dof_values,
+      const Mapping<dim, spacedim> &                           mapping,
+      const typename Mapping<dim, spacedim>::InternalDataBase &mapping_data,
+      std::vector<Tensor<1, spacedim>> &                       gradients) const
+    {
+      AssertDimension(n_components, 1);
+      AssertDimension(gradients.size(), shape_info.n_q_points);
+
+      ScratchData &scratch_data = get_scratch_data();
+      evaluate(dof_values, true, scratch_data);
+      transform_gradients(0, mapping, mapping_data, scratch_data, gradients);
+    }
+
+
+
+    template <int dim>
+    template <int spacedim>
+    void
+    TensorProductEvaluator<dim>::get_function_gradients(
+      const double *                                           dof_values,
+      const Mapping<dim, spacedim> &                           mapping,
+      const typename Mapping<dim, spacedim>::InternalDataBase &mapping_data,
+      std::vector<std::vector<Tensor<1, spacedim>>> &          gradients) const
+    {
+      const unsigned int n_q_points = shape_info.n_q_points;
+      AssertDimension(gradients.size(), n_q_points);
+
+      ScratchData &scratch_data = get_scratch_data();
+      evaluate(dof_values, true, scratch_data);
+      std::vector<Tensor<1, spacedim>> gradients_component(n_q_points);
+      for (unsigned int c = 0; c < n_components; ++c)
+        {
+          transform_gradients(
+            c, mapping, mapping_data, scratch_data, gradients_component);
+          for (unsigned int q = 0; q < n_q_points; ++q)
+            {
+              AssertDimension(gradients[q].size(), n_components);
+              gradients[q][c] = gradients_component[q];
+            }
+        }
+    }
+
+
+
+    /**
+     * Set up a TensorProductEvaluator if the finite element and the
+     * quadrature formula allow for it, and return an empty pointer
+     * otherwise. The matrix-free shape data is only available for
+     * <tt>dim==spacedim</tt>, so this general version always returns an
+     * empty pointer.
+     */
+    template <int dim, int spacedim>
+    std::unique_ptr<TensorProductEvaluator<dim>>
+    make_tensor_product_evaluator(const FiniteElement<dim, spacedim> &,
+                                  const Quadrature<dim> &)
+    {
+      return std::unique_ptr<TensorProductEvaluator<dim>>();
+    }
+
+
+
+    template <int dim>
+    std::unique_ptr<TensorProductEvaluator<dim>>
+    make_tensor_product_evaluator(const FiniteElement<dim> &fe,
+                                  const Quadrature<dim> &   quadrature)
+    {
+      if (fe.dofs_per_cell == 0 || fe.n_base_elements() != 1 ||
+          quadrature.is_tensor_product() == false)
+        return std::unique_ptr<TensorProductEvaluator<dim>>();
+
+      // for linear elements, the product with the shape function matrix is
+      // as cheap as sum factorization. FE_DGQ elements without support points
+      // (like FE_DGQLegendre) cannot be decoded into 1D shape functions.
+      const FiniteElement<dim> &base = fe.base_element(0);
+      if (base.degree < 2 || base.has_support_points() == false ||
+          (dynamic_cast<const FE_Q<dim> *>(&base) == nullptr &&
+           dynamic_cast<const FE_DGQ<dim> *>(&base) == nullptr))
+        return std::unique_ptr<TensorProductEvaluator<dim>>();
+
+      const auto &quadrature_1d = quadrature.get_tensor_basis();
+      for (unsigned int d = 1; d < dim; ++d)
+        if (!(quadrature_1d[d] == quadrature_1d[0]))
+          return std::unique_ptr<TensorProductEvaluator<dim>>();
+
+      return std_cxx14::make_unique<TensorProductEvaluator<dim>>(
+        fe, quadrature_1d[0]);
+    }
+
+
+
+    /**
+     * Evaluate the values of a finite element function with sum
+     * factorization if an evaluator is given. Return whether this was
+     * done. The kernels work on double precision numbers, so this general
+     * version for other number types does nothing.
+     */
+    template <int dim, typename Number, typename OutputType>
+    bool
+    tensor_product_function_values(const TensorProductEvaluator<dim> *,
+                                   const Number *,
+                                   OutputType &)
+    {
+      return false;
+    }
+
+
+
+    template <int dim, typename OutputType>
+    bool
+    tensor_product_function_values(const TensorProductEvaluator<dim> *evaluator,
+                                   const double *dof_values,
+                                   OutputType &  values)
+    {
+      if (evaluator == nullptr)
+        return false;
+
+      evaluator->get_function_values(dof_values, values);
+      return true;
+    }
+
+
+
+    /**
+     * Same as tensor_product_function_values() for the gradients, which
+     * additionally need the covariant transformation of the mapping.
+     */
+    template <int dim, int spacedim, typename Number, typename OutputType>
+    bool
+    tensor_product_function_gradients(
+      const TensorProductEvaluator<dim> *,
+      const Mapping<dim, spacedim> &,
+      const typename Mapping<dim, spacedim>::InternalDataBase &,
+      const Number *,
+      OutputType &)
+    {
+      return false;
+    }
+
+
+
+    template <int dim, int spacedim, typename OutputType>
+    bool
+    tensor_product_function_gradients(
+      const TensorProductEvaluator<dim> *                      evaluator,
+      const Mapping<dim, spacedim> &                           mapping,
+      const typename Mapping<dim, spacedim>::InternalDataBase &mapping_data,
+      const double *                                           dof_values,
+      OutputType &                                             gradients)
+    {
+      if (evaluator == nullptr ||
+          (mapping_data.update_each & update_covariant_transformation) == 0)
+        return false;
+
+      evaluator->get_function_gradients(dof_values,
+                                        mapping,
+                                        mapping_data,
+                                        gradients);
+      return true;
+    }
   } // namespace FEValuesImplementation
 } // namespace internal
 
@@ -3591,6 +4020,9 @@ FEValuesBase<dim, spacedim>::get_function_values(
   // get function values of dofs on this cell
   Vector<Number> dof_values(dofs_per_cell);
   present_cell->get_interpolated_dof_values(fe_function, dof_values);
+  if (internal::FEValuesImplementation::tensor_product_function_values(
+        tensor_product_evaluator.get(), dof_values.begin(), values))
+    return;
   internal::do_function_values(dof_values.begin(),
                                this->finite_element_output.shape_values,
                                values);
@@ -3640,6 +4072,9 @@ FEValuesBase<dim, spacedim>::get_function_values(
   // get function values of dofs on this cell
   Vector<Number> dof_values(dofs_per_cell);
   present_cell->get_interpolated_dof_values(fe_function, dof_values);
+  if (internal::FEValuesImplementation::tensor_product_function_values(
+        tensor_product_evaluator.get(), dof_values.begin(), values))
+    return;
   internal::do_function_values(
     dof_values.begin(),
     this->finite_element_output.shape_values,
@@ -3733,6 +4168,13 @@ FEValuesBase<dim, spacedim>::get_function_gradients(
   // get function values of dofs on this cell
   Vector<Number> dof_values(dofs_per_cell);
   present_cell->get_interpolated_dof_values(fe_function, dof_values);
+  if (internal::FEValuesImplementation::tensor_product_function_gradients(
+        tensor_product_evaluator.get(),
+        *mapping,
+        *mapping_data,
+        dof_values.begin(),
+        gradients))
+    return;
   internal::do_function_derivatives(dof_values.begin(),
                                     this->finite_element_output.shape_gradients,
                                     gradients);
@@ -3784,6 +4226,13 @@ FEValuesBase<dim, spacedim>::get_function_gradients(
   // get function values of dofs on this cell
   Vector<Number> dof_values(dofs_per_cell);
   present_cell->get_interpolated_dof_values(fe_function, dof_values);
+  if (internal::FEValuesImplementation::tensor_product_function_gradients(
+        tensor_product_evaluator.get(),
+        *mapping,
+        *mapping_data,
+        dof_values.begin(),
+        gradients))
+    return;
   internal::do_function_derivatives(
     dof_values.begin(),
     this->finite_element_output.shape_gradients,
@@ -4493,6 +4942,11 @@ FEValues<dim, spacedim>::initialize(const UpdateFlags update_flags)
   else
     this->mapping_data = std_cxx14::make_unique<
       typename Mapping<dim, spacedim>::InternalDataBase>();
+
+  if (flags & (update_values | update_gradients))
+    this->tensor_product_evaluator =
+      internal::FEValuesImplementation::make_tensor_product_evaluator(
+        *this->fe, quadrature);
 }
 
 
@@ -279,21 +279,29 @@ MappingQ<dim, spacedim>::fill_fe_values(
        cell_similarity);
 
   // depending on the results above, decide whether the Q1 mapping or
-  // the Qp mapping needs to handle this cell
+  // the Qp mapping needs to handle this cell. both write into the same
+  // output_data, so the data one of them computed for a previous cell can
+  // not be reused once the other one has been called
   if (data.use_mapping_q1_on_current_cell)
-    q1_mapping->fill_fe_values(cell,
-                               updated_cell_similarity,
-                               quadrature,
-                               *data.mapping_q1_data,
-                               output_data);
+    {
+      data.mapping_qp_data->affine_jacobian_is_current = false;
+      return q1_mapping->fill_fe_values(cell,
+                                        updated_cell_similarity,
+                                        quadrature,
+                                        *data.mapping_q1_data,
+                                        output_data);
+    }
   else
-    qp_mapping->fill_fe_values(cell,
-                               updated_cell_similarity,
-                               quadrature,
-                               *data.mapping_qp_data,
-                               output_data);
-
-  return updated_cell_similarity;
+    {
+      if (data.mapping_q1_data != nullptr)
+        data.mapping_q1_data->affine_jacobian_is_current = false;
+      qp_mapping->fill_fe_values(cell,
+                                 updated_cell_similarity,
+                                 quadrature,
+                                 *data.mapping_qp_data,
+                                 output_data);
+      return updated_cell_similarity;
+    }
 }
 
 
@@ -531,6 +539,26 @@ MappingQ<dim, spacedim>::transform_real_to_unit_cell(
 
 
 
+template <int dim, int spacedim>
+void
+MappingQ<dim, spacedim>::transform_points_real_to_unit_cell(
+  const typename Triangulation<dim, spacedim>::cell_iterator &cell,
+  const ArrayView<const Point<spacedim>> &                    real_points,
+  const ArrayView<Point<dim>> &                               unit_points) const
+{
+  if (cell->has_boundary_lines() || use_mapping_q_on_all_cells ||
+      (dim != spacedim))
+    qp_mapping->transform_points_real_to_unit_cell(cell,
+                                                   real_points,
+                                                   unit_points);
+  else
+    q1_mapping->transform_points_real_to_unit_cell(cell,
+                                                   real_points,
+                                                   unit_points);
+}
+
+
+
 template <int dim, int spacedim>
 std::unique_ptr<Mapping<dim, spacedim>>
 MappingQ<dim, spacedim>::clone() const
@@ -14,10 +14,31 @@
 // ---------------------------------------------------------------------
 
 #include <deal.II/base/memory_consumption.h>
+#include <deal.II/base/quadrature_lib.h>
+#include <deal.II/base/table.h>
 #include <deal.II/base/work_stream.h>
 
+#include <deal.II/dofs/dof_accessor.h>
+
+#include <deal.II/fe/fe.h>
+#include <deal.II/fe/fe_tools.h>
 #include <deal.II/fe/mapping_q_cache.h>
 
+#include <deal.II/grid/tria_iterator.h>
+
+#include <deal.II/lac/block_vector.h>
+#include <deal.II/lac/la_parallel_block_vector.h>
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/la_vector.h>
+#include <deal.II/lac/petsc_block_vector.h>
+#include <deal.II/lac/petsc_vector.h>
+#include <deal.II/lac/trilinos_epetra_vector.h>
+#include <deal.II/lac/trilinos_parallel_block_vector.h>
+#include <deal.II/lac/trilinos_tpetra_vector.h>
+#include <deal.II/lac/trilinos_vector.h>
+#include <deal.II/lac/vector.h>
+#include <deal.II/lac/vector_element_access.h>
+
 #include <functional>
 
 DEAL_II_NAMESPACE_OPEN
@@ -35,6 +56,7 @@ MappingQCache<dim, spacedim>::MappingQCache(
   const MappingQCache<dim, spacedim> &mapping)
   : MappingQGeneric<dim, spacedim>(mapping)
   , support_point_cache(mapping.support_point_cache)
+  , displacement_cache(mapping.displacement_cache)
 {}
 
 
@@ -47,6 +69,7 @@ MappingQCache<dim, spacedim>::~MappingQCache()
   // invalid memory that has been left back by freeing an object of this
   // class.
   support_point_cache.reset();
+  displacement_cache.reset();
   clear_signal.disconnect();
 }
 
@@ -78,14 +101,40 @@ MappingQCache<dim, spacedim>::initialize(
 {
   AssertDimension(this->get_degree(), mapping.get_degree());
 
-  clear_signal = triangulation.signals.any_change.connect(
-    [&]() -> void { this->support_point_cache.reset(); });
+  initialize(
+    triangulation,
+    [&mapping](
+      const typename Triangulation<dim, spacedim>::cell_iterator &cell) {
+      return mapping.compute_mapping_support_points(cell);
+    });
+}
+
+
+
+template <int dim, int spacedim>
+void
+MappingQCache<dim, spacedim>::initialize(
+  const Triangulation<dim, spacedim> &triangulation,
+  const std::function<std::vector<Point<spacedim>>(
+    const typename Triangulation<dim, spacedim>::cell_iterator &)>
+    &compute_points_on_cell)
+{
+  clear_signal.disconnect();
+  clear_signal = triangulation.signals.any_change.connect([&]() -> void {
+    this->support_point_cache.reset();
+    this->displacement_cache.reset();
+  });
 
   support_point_cache =
     std::make_shared<std::vector<std::vector<std::vector<Point<spacedim>>>>>(
       triangulation.n_levels());
   for (unsigned int l = 0; l < triangulation.n_levels(); ++l)
     (*support_point_cache)[l].resize(triangulation.n_raw_cells(l));
+  displacement_cache.reset();
+
+  const unsigned int n_support_points =
+    Utilities::pow(this->get_degree() + 1, dim);
+  (void)n_support_points;
 
   WorkStream::run(
     triangulation.begin(),
@@ -94,7 +143,191 @@ MappingQCache<dim, spacedim>::initialize(
         void *,
         void *) {
       (*support_point_cache)[cell->level()][cell->index()] =
-        mapping.compute_mapping_support_points(cell);
+        compute_points_on_cell(cell);
+      AssertDimension(
+        (*support_point_cache)[cell->level()][cell->index()].size(),
+        n_support_points);
+    },
+    /* copier */ std::function<void(void *)>(),
+    /* scratch_data */ nullptr,
+    /* copy_data */ nullptr,
+    2 * MultithreadInfo::n_threads(),
+    /* chunk_size = */ 1);
+}
+
+
+
+template <int dim, int spacedim>
+template <typename VectorType>
+void
+MappingQCache<dim, spacedim>::initialize(
+  const MappingQGeneric<dim, spacedim> &mapping,
+  const DoFHandler<dim, spacedim> &     dof_handler,
+  const VectorType &                    displacement)
+{
+  initialize_with_displacement(
+    mapping,
+    dof_handler,
+    [&](const typename Triangulation<dim, spacedim>::cell_iterator &cell,
+        std::vector<double> &local_values) -> bool {
+      if (cell->active() == false || cell->is_artificial())
+        return false;
+
+      const typename DoFHandler<dim, spacedim>::cell_iterator dof_cell(
+        &dof_handler.get_triangulation(),
+        cell->level(),
+        cell->index(),
+        &dof_handler);
+      std::vector<types::global_dof_index> dof_indices(
+        dof_cell->get_fe().dofs_per_cell);
+      dof_cell->get_dof_indices(dof_indices);
+
+      local_values.resize(dof_indices.size());
+      for (unsigned int i = 0; i < dof_indices.size(); ++i)
+        local_values[i] =
+          internal::ElementAccess<VectorType>::get(displacement,
+                                                   dof_indices[i]);
+      return true;
+    });
+}
+
+
+
+template <int dim, int spacedim>
+template <typename VectorType>
+void
+MappingQCache<dim, spacedim>::initialize(
+  const MappingQGeneric<dim, spacedim> &mapping,
+  const DoFHandler<dim, spacedim> &     dof_handler,
+  const MGLevelObject<VectorType> &     displacement)
+{
+  Assert(dof_handler.has_level_dofs(),
+         ExcMessage("The multigrid variant of MappingQCache::initialize() "
+                    "needs level degrees of freedom. Call "
+                    "DoFHandler::distribute_mg_dofs() first."));
+
+  initialize_with_displacement(
+    mapping,
+    dof_handler,
+    [&](const typename Triangulation<dim, spacedim>::cell_iterator &cell,
+        std::vector<double> &local_values) -> bool {
+      const unsigned int level = cell->level();
+      if (level < displacement.min_level() ||
+          level > displacement.max_level() ||
+          cell->level_subdomain_id() == numbers::artificial_subdomain_id)
+        return false;
+
+      const typename DoFHandler<dim, spacedim>::level_cell_iterator dof_cell(
+        &dof_handler.get_triangulation(),
+        cell->level(),
+        cell->index(),
+        &dof_handler);
+      std::vector<types::global_dof_index> dof_indices(
+        dof_cell->get_fe().dofs_per_cell);
+      dof_cell->get_mg_dof_indices(dof_indices);
+
+      local_values.resize(dof_indices.size());
+      for (unsigned int i = 0; i < dof_indices.size(); ++i)
+        local_values[i] =
+          internal::ElementAccess<VectorType>::get(displacement[level],
+                                                   dof_indices[i]);
+      return true;
+    });
+}
+
+
+
+template <int dim, int spacedim>
+void
+MappingQCache<dim, spacedim>::initialize_with_displacement(
+  const MappingQGeneric<dim, spacedim> &mapping,
+  const DoFHandler<dim, spacedim> &     dof_handler,
+  const std::function<bool(
+    const typename Triangulation<dim, spacedim>::cell_iterator &,
+    std::vector<double> &)> &get_local_values)
+{
+  AssertDimension(this->get_degree(), mapping.get_degree());
+
+  const Triangulation<dim, spacedim> &triangulation =
+    dof_handler.get_triangulation();
+  const FiniteElement<dim, spacedim> &fe = dof_handler.get_fe();
+  AssertDimension(fe.n_components(), spacedim);
+
+  // we can update the cache incrementally if it has been filled by a
+  // previous call to this function on the same mesh; any change of the
+  // triangulation resets both caches through the signal
+  bool incremental =
+    support_point_cache.get() != nullptr &&
+    displacement_cache.get() != nullptr &&
+    support_point_cache->size() == triangulation.n_levels() &&
+    clear_signal.connected();
+  for (unsigned int l = 0; incremental && l < triangulation.n_levels(); ++l)
+    if ((*support_point_cache)[l].size() != triangulation.n_raw_cells(l))
+      incremental = false;
+
+  if (incremental == false)
+    {
+      clear_signal.disconnect();
+      clear_signal = triangulation.signals.any_change.connect([&]() -> void {
+        this->support_point_cache.reset();
+        this->displacement_cache.reset();
+      });
+
+      support_point_cache = std::make_shared<
+        std::vector<std::vector<std::vector<Point<spacedim>>>>>(
+        triangulation.n_levels());
+      displacement_cache =
+        std::make_shared<std::vector<std::vector<std::vector<double>>>>(
+          triangulation.n_levels());
+      for (unsigned int l = 0; l < triangulation.n_levels(); ++l)
+        {
+          (*support_point_cache)[l].resize(triangulation.n_raw_cells(l));
+          (*displacement_cache)[l].resize(triangulation.n_raw_cells(l));
+        }
+    }
+
+  // evaluate the shape functions of the displacement field in the mapping
+  // support points, which are numbered like the degrees of freedom of an
+  // FE_Q element, i.e., vertices first, then the points on lines, quads, and
+  // hexes
+  const unsigned int        degree = this->get_degree();
+  const QGaussLobatto<dim>  points(degree + 1);
+  std::vector<unsigned int> h2l(points.size());
+  FETools::hierarchic_to_lexicographic_numbering<dim>(degree, h2l);
+  Table<3, double> shape_values(fe.dofs_per_cell, points.size(), spacedim);
+  for (unsigned int i = 0; i < fe.dofs_per_cell; ++i)
+    for (unsigned int q = 0; q < points.size(); ++q)
+      for (unsigned int d = 0; d < spacedim; ++d)
+        shape_values(i, q, d) =
+          fe.shape_value_component(i, points.point(h2l[q]), d);
+
+  WorkStream::run(
+    triangulation.begin(),
+    triangulation.end(),
+    [&](const typename Triangulation<dim, spacedim>::cell_iterator &cell,
+        void *,
+        void *) {
+      std::vector<double> local_values;
+      if (get_local_values(cell, local_values) == false)
+        local_values.clear();
+
+      std::vector<Point<spacedim>> &support_points =
+        (*support_point_cache)[cell->level()][cell->index()];
+      std::vector<double> &old_values =
+        (*displacement_cache)[cell->level()][cell->index()];
+
+      // skip the cell if its displacement did not change since the last
+      // call
+      if (!support_points.empty() && old_values == local_values)
+        return;
+
+      support_points = mapping.compute_mapping_support_points(cell);
+      AssertDimension(support_points.size(), points.size());
+      for (unsigned int i = 0; i < local_values.size(); ++i)
+        for (unsigned int q = 0; q < support_points.size(); ++q)
+          for (unsigned int d = 0; d < spacedim; ++d)
+            support_points[q][d] += local_values[i] * shape_values(i, q, d);
+      old_values.swap(local_values);
     },
     /* copier */ std::function<void(void *)>(),
     /* scratch_data */ nullptr,
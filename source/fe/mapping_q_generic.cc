@@ -23,6 +23,7 @@
 #include <deal.II/base/std_cxx14/memory.h>
 #include <deal.II/base/table.h>
 #include <deal.II/base/tensor_product_polynomials.h>
+#include <deal.II/base/vectorization.h>
 
 #include <deal.II/fe/fe_base.h>
 #include <deal.II/fe/fe_tools.h>
@@ -45,6 +46,7 @@
 #include <algorithm>
 #include <array>
 #include <cmath>
+#include <limits>
 #include <memory>
 #include <numeric>
 
@@ -651,7 +653,20 @@ MappingQGeneric<dim, spacedim>::InternalData::InternalData(
   , n_shape_functions(Utilities::fixed_power<dim>(polynomial_degree + 1))
   , line_support_points(QGaussLobatto<1>(polynomial_degree + 1))
   , tensor_product_quadrature(false)
-{}
+  , evaluate_from_1d_polynomials(false)
+  , affine_jacobian_is_current(false)
+  , current_cell_is_affine(false)
+{
+  // the mapping support points are numbered like the degrees of freedom of
+  // an FE_Q element, i.e., vertices first, then the points on lines, quads,
+  // and hexes
+  const QGaussLobatto<dim>  points(polynomial_degree + 1);
+  std::vector<unsigned int> h2l(points.size());
+  FETools::hierarchic_to_lexicographic_numbering<dim>(polynomial_degree, h2l);
+  unit_support_points.resize(points.size());
+  for (unsigned int i = 0; i < points.size(); ++i)
+    unit_support_points[i] = points.point(h2l[i]);
+}
 
 
 
@@ -663,6 +678,10 @@ MappingQGeneric<dim, spacedim>::InternalData::memory_consumption() const
     Mapping<dim, spacedim>::InternalDataBase::memory_consumption() +
     MemoryConsumption::memory_consumption(shape_values) +
     MemoryConsumption::memory_consumption(shape_derivatives) +
+    MemoryConsumption::memory_consumption(shape_second_derivatives) +
+    MemoryConsumption::memory_consumption(polynomial_values_1d) +
+    MemoryConsumption::memory_consumption(lexicographic_to_hierarchic) +
+    MemoryConsumption::memory_consumption(sum_factorization_scratch) +
     MemoryConsumption::memory_consumption(covariant) +
     MemoryConsumption::memory_consumption(contravariant) +
     MemoryConsumption::memory_consumption(unit_tangentials) +
@@ -670,6 +689,8 @@ MappingQGeneric<dim, spacedim>::InternalData::memory_consumption() const
     MemoryConsumption::memory_consumption(mapping_support_points) +
     MemoryConsumption::memory_consumption(cell_of_current_support_points) +
     MemoryConsumption::memory_consumption(volume_elements) +
+    MemoryConsumption::memory_consumption(unit_support_points) +
+    MemoryConsumption::memory_consumption(face_quadrature_points) +
     MemoryConsumption::memory_consumption(polynomial_degree) +
     MemoryConsumption::memory_consumption(n_shape_functions));
 }
@@ -688,46 +709,6 @@ MappingQGeneric<dim, spacedim>::InternalData::initialize(
 
   const unsigned int n_q_points = q.size();
 
-  // see if we need the (transformation) shape function values
-  // and/or gradients and resize the necessary arrays
-  if (this->update_each & update_quadrature_points)
-    shape_values.resize(n_shape_functions * n_q_points);
-
-  if (this->update_each &
-      (update_covariant_transformation | update_contravariant_transformation |
-       update_JxW_values | update_boundary_forms | update_normal_vectors |
-       update_jacobians | update_jacobian_grads | update_inverse_jacobians |
-       update_jacobian_pushed_forward_grads | update_jacobian_2nd_derivatives |
-       update_jacobian_pushed_forward_2nd_derivatives |
-       update_jacobian_3rd_derivatives |
-       update_jacobian_pushed_forward_3rd_derivatives))
-    shape_derivatives.resize(n_shape_functions * n_q_points);
-
-  if (this->update_each & update_covariant_transformation)
-    covariant.resize(n_original_q_points);
-
-  if (this->update_each & update_contravariant_transformation)
-    contravariant.resize(n_original_q_points);
-
-  if (this->update_each & update_volume_elements)
-    volume_elements.resize(n_original_q_points);
-
-  if (this->update_each &
-      (update_jacobian_grads | update_jacobian_pushed_forward_grads))
-    shape_second_derivatives.resize(n_shape_functions * n_q_points);
-
-  if (this->update_each & (update_jacobian_2nd_derivatives |
-                           update_jacobian_pushed_forward_2nd_derivatives))
-    shape_third_derivatives.resize(n_shape_functions * n_q_points);
-
-  if (this->update_each & (update_jacobian_3rd_derivatives |
-                           update_jacobian_pushed_forward_3rd_derivatives))
-    shape_fourth_derivatives.resize(n_shape_functions * n_q_points);
-
-  const std::vector<Point<dim>> &ref_q_points = q.get_points();
-  // now also fill the various fields with their correct values
-  compute_shape_function_values(ref_q_points);
-
   tensor_product_quadrature = q.is_tensor_product();
 
   // use of MatrixFree only for higher order elements
@@ -788,6 +769,94 @@ MappingQGeneric<dim, spacedim>::InternalData::initialize(
             }
         }
     }
+
+  // the quadrature points, the Jacobians and their first derivatives are
+  // computed by sum factorization in these two cases, so the respective
+  // tables of the shape functions would only take up memory. the tables of
+  // the higher derivatives are still needed, though
+  const bool use_shape_tables =
+    !(dim > 1 && (tensor_product_quadrature || evaluate_from_1d_polynomials));
+
+  // see if we need the (transformation) shape function values
+  // and/or gradients and resize the necessary arrays
+  if (use_shape_tables && (this->update_each & update_quadrature_points))
+    shape_values.resize(n_shape_functions * n_q_points);
+
+  if (use_shape_tables &&
+      (this->update_each &
+       (update_covariant_transformation | update_contravariant_transformation |
+        update_JxW_values | update_boundary_forms | update_normal_vectors |
+        update_jacobians | update_jacobian_grads | update_inverse_jacobians |
+        update_jacobian_pushed_forward_grads | update_jacobian_2nd_derivatives |
+        update_jacobian_pushed_forward_2nd_derivatives |
+        update_jacobian_3rd_derivatives |
+        update_jacobian_pushed_forward_3rd_derivatives)))
+    shape_derivatives.resize(n_shape_functions * n_q_points);
+
+  if (this->update_each & update_covariant_transformation)
+    covariant.resize(n_original_q_points);
+
+  if (this->update_each & update_contravariant_transformation)
+    contravariant.resize(n_original_q_points);
+
+  if (this->update_each & update_volume_elements)
+    volume_elements.resize(n_original_q_points);
+
+  if (use_shape_tables &&
+      (this->update_each &
+       (update_jacobian_grads | update_jacobian_pushed_forward_grads)))
+    shape_second_derivatives.resize(n_shape_functions * n_q_points);
+
+  if (this->update_each & (update_jacobian_2nd_derivatives |
+                           update_jacobian_pushed_forward_2nd_derivatives))
+    shape_third_derivatives.resize(n_shape_functions * n_q_points);
+
+  if (this->update_each & (update_jacobian_3rd_derivatives |
+                           update_jacobian_pushed_forward_3rd_derivatives))
+    shape_fourth_derivatives.resize(n_shape_functions * n_q_points);
+
+  const std::vector<Point<dim>> &ref_q_points = q.get_points();
+  // now also fill the various fields with their correct values
+  compute_shape_function_values(ref_q_points);
+
+  if (dim > 1 && evaluate_from_1d_polynomials)
+    {
+      const unsigned int n_points_1d = polynomial_degree + 1;
+      const std::vector<Polynomials::Polynomial<double>> polynomials =
+        Polynomials::generate_complete_Lagrange_basis(
+          line_support_points.get_points());
+
+      polynomial_values_1d.resize(n_q_points * dim * n_points_1d * 3);
+      for (unsigned int point = 0; point < n_q_points; ++point)
+        for (unsigned int d = 0; d < dim; ++d)
+          for (unsigned int i = 0; i < n_points_1d; ++i)
+            polynomials[i].value(
+              ref_q_points[point][d],
+              2,
+              &polynomial_values_1d[((point * dim + d) * n_points_1d + i) * 3]);
+
+      lexicographic_to_hierarchic =
+        FETools::lexicographic_to_hierarchic_numbering(FiniteElementData<dim>(
+          internal::MappingQGenericImplementation::get_dpo_vector<dim>(
+            polynomial_degree),
+          1,
+          polynomial_degree));
+
+      // the sum factorization needs space for the support points in
+      // lexicographic order and two buffers for the partially contracted
+      // support points, with up to three derivatives in each of the
+      // contracted directions
+      unsigned int max_size      = 0;
+      unsigned int n_derivatives = 1;
+      unsigned int n_remaining   = n_shape_functions;
+      for (unsigned int d = 0; d < dim; ++d)
+        {
+          n_derivatives *= 3;
+          n_remaining /= n_points_1d;
+          max_size = std::max(max_size, n_derivatives * n_remaining);
+        }
+      sum_factorization_scratch.resize(n_shape_functions + 2 * max_size);
+    }
 }
 
 
@@ -799,23 +868,16 @@ MappingQGeneric<dim, spacedim>::InternalData::initialize_face(
   const Quadrature<dim> &q,
   const unsigned int     n_original_q_points)
 {
+  // the quadrature points projected to all faces do not form a tensor
+  // product, but the mapping can still be evaluated by sum factorization
+  // point by point. this avoids the tables of the shape functions on all
+  // faces in all orientations, whose size grows quickly with the degree
+  evaluate_from_1d_polynomials = (dim > 1 && polynomial_degree > 1);
+
   initialize(update_flags, q, n_original_q_points);
 
-  if (dim > 1 && tensor_product_quadrature)
-    {
-      const unsigned int  facedim = dim > 1 ? dim - 1 : 1;
-      const FE_Q<facedim> fe(polynomial_degree);
-      shape_info.reinit(q.get_tensor_basis()[0], fe);
-
-      const unsigned int n_shape_values = fe.n_dofs_per_cell();
-      const unsigned int n_q_points     = q.size();
-      const unsigned int max_size       = std::max(n_q_points, n_shape_values);
-      const unsigned int vec_length = VectorizedArray<double>::n_array_elements;
-      const unsigned int n_comp     = 1 + (spacedim - 1) / vec_length;
-
-      scratch.resize((dim - 1) * max_size);
-      values_dofs.resize(n_comp * n_shape_values);
-    }
+  if (this->update_each & update_quadrature_points)
+    face_quadrature_points = q.get_points();
 
   if (dim > 1)
     {
@@ -1511,10 +1573,401 @@ namespace internal
         return p_unit;
       }
 
+      /**
+       * Check whether the mapping support points @p support_points of a cell
+       * are the image of the points @p unit_support_points on the unit cell
+       * under an affine map. If so, return true and set @p jacobian to the
+       * (constant) Jacobian of that map. The Jacobian is computed from the
+       * vertices adjacent to vertex zero, and the cell is considered affine
+       * if all other support points deviate from their affine image by no
+       * more than roundoff.
+       */
+      template <int dim, int spacedim>
+      bool
+      compute_affine_jacobian(
+        const std::vector<Point<spacedim>> &support_points,
+        const std::vector<Point<dim>> &     unit_support_points,
+        DerivativeForm<1, dim, spacedim> &  jacobian)
+      {
+        AssertDimension(support_points.size(), unit_support_points.size());
+
+        for (unsigned int d = 0; d < dim; ++d)
+          {
+            const Tensor<1, spacedim> column =
+              support_points[1U << d] - support_points[0];
+            for (unsigned int e = 0; e < spacedim; ++e)
+              jacobian[e][d] = column[e];
+          }
+
+        const double tolerance =
+          Utilities::fixed_power<2>(1e-12 * jacobian.norm());
+        for (unsigned int k = 1; k < support_points.size(); ++k)
+          {
+            Tensor<1, spacedim> deviation =
+              support_points[k] - support_points[0];
+            for (unsigned int e = 0; e < spacedim; ++e)
+              for (unsigned int d = 0; d < dim; ++d)
+                deviation[e] -= jacobian[e][d] * unit_support_points[k][d];
+            if (deviation.norm_square() > tolerance)
+              return false;
+          }
+
+        return true;
+      }
+
+
+
+      /**
+       * Implementation of transform_points_real_to_unit_cell() for
+       * dim==spacedim. On input, @p unit_points contains the initial guesses
+       * for all points with <tt>converged[i]==false</tt>, the other points
+       * are left untouched. On output, <tt>converged[i]</tt> is set for all
+       * points whose transformation succeeded.
+       *
+       * If the cell is affine, the points are mapped with the inverse of the
+       * affine map. Otherwise, the Newton iteration of
+       * do_transform_real_to_unit_cell_internal() including its line search
+       * is run for VectorizedArray<double>::n_array_elements points at a
+       * time. The shape functions of the mapping are tensor products of the
+       * 1D Lagrange polynomials in the Gauss-Lobatto points, which we
+       * evaluate directly at the current iterates in all lanes.
+       */
+      template <int dim>
+      void
+      do_transform_points_real_to_unit_cell(
+        const unsigned int                 polynomial_degree,
+        const std::vector<Point<dim>> &    support_points,
+        const double                       cell_diameter,
+        const ArrayView<const Point<dim>> &real_points,
+        const ArrayView<Point<dim>> &      unit_points,
+        std::vector<bool> &                converged)
+      {
+        using VectorizedDouble            = VectorizedArray<double>;
+        constexpr unsigned int n_lanes    = VectorizedDouble::n_array_elements;
+        const unsigned int     n_points   = real_points.size();
+        const unsigned int     n_shapes   = support_points.size();
+        const unsigned int     n_shapes_1d = polynomial_degree + 1;
+
+        std::vector<unsigned int> h2l(n_shapes);
+        FETools::hierarchic_to_lexicographic_numbering<dim>(polynomial_degree,
+                                                            h2l);
+
+        // check for an affine cell, in which case the transformation is
+        // exact and cheap
+        {
+          const QGaussLobatto<dim> points(n_shapes_1d);
+          std::vector<Point<dim>>  unit_support_points(n_shapes);
+          for (unsigned int i = 0; i < n_shapes; ++i)
+            unit_support_points[i] = points.point(h2l[i]);
+
+          DerivativeForm<1, dim, dim> jacobian;
+          if (compute_affine_jacobian(support_points,
+                                      unit_support_points,
+                                      jacobian))
+            {
+              const Tensor<2, dim> jacobian_tensor = jacobian;
+              if (determinant(jacobian_tensor) > 0)
+                {
+                  const Tensor<2, dim> inverse = invert(jacobian_tensor);
+                  for (unsigned int i = 0; i < n_points; ++i)
+                    if (converged[i] == false)
+                      {
+                        unit_points[i] =
+                          Point<dim>(inverse * (real_points[i] -
+                                                support_points[0]));
+                        converged[i] = true;
+                      }
+                }
+              return;
+            }
+        }
+
+        // support points in lexicographic order and the denominators of the
+        // 1D Lagrange polynomials
+        std::vector<Point<dim>> lexicographic_points(n_shapes);
+        for (unsigned int i = 0; i < n_shapes; ++i)
+          lexicographic_points[h2l[i]] = support_points[i];
+
+        const QGaussLobatto<1> line_points(n_shapes_1d);
+        Table<2, double>       inverse_distances(n_shapes_1d, n_shapes_1d);
+        for (unsigned int j = 0; j < n_shapes_1d; ++j)
+          for (unsigned int k = 0; k < n_shapes_1d; ++k)
+            if (j != k)
+              inverse_distances(j, k) =
+                1. / (line_points.point(j)[0] - line_points.point(k)[0]);
+
+        Table<2, VectorizedDouble> values_1d(dim, n_shapes_1d);
+        Table<2, VectorizedDouble> derivatives_1d(dim, n_shapes_1d);
+
+        // compute the mapped location and the Jacobian at the points
+        // p_unit in all lanes
+        const auto evaluate =
+          [&](const Tensor<1, dim, VectorizedDouble> &p_unit,
+              Tensor<1, dim, VectorizedDouble> &      p_real,
+              Tensor<2, dim, VectorizedDouble> &      jacobian) {
+            for (unsigned int d = 0; d < dim; ++d)
+              for (unsigned int j = 0; j < n_shapes_1d; ++j)
+                {
+                  VectorizedDouble value      = make_vectorized_array(1.);
+                  VectorizedDouble derivative = make_vectorized_array(0.);
+                  for (unsigned int k = 0; k < n_shapes_1d; ++k)
+                    if (k != j)
+                      {
+                        const VectorizedDouble factor =
+                          (p_unit[d] - line_points.point(k)[0]) *
+                          inverse_distances(j, k);
+                        derivative =
+                          derivative * factor + value * inverse_distances(j, k);
+                        value = value * factor;
+                      }
+                  values_1d(d, j)      = value;
+                  derivatives_1d(d, j) = derivative;
+                }
+
+            p_real   = Tensor<1, dim, VectorizedDouble>();
+            jacobian = Tensor<2, dim, VectorizedDouble>();
+            for (unsigned int i = 0; i < n_shapes; ++i)
+              {
+                VectorizedDouble shape = make_vectorized_array(1.);
+                Tensor<1, dim, VectorizedDouble> shape_gradient;
+                for (unsigned int d = 0; d < dim; ++d)
+                  shape_gradient[d] = 1.;
+                for (unsigned int d = 0, index = i; d < dim;
+                     ++d, index /= n_shapes_1d)
+                  {
+                    const unsigned int j = index % n_shapes_1d;
+                    shape *= values_1d(d, j);
+                    for (unsigned int e = 0; e < dim; ++e)
+                      shape_gradient[e] *=
+                        (e == d ? derivatives_1d(d, j) : values_1d(d, j));
+                  }
+
+                const Point<dim> &point = lexicographic_points[i];
+                for (unsigned int e = 0; e < dim; ++e)
+                  {
+                    p_real[e] += shape * point[e];
+                    for (unsigned int d = 0; d < dim; ++d)
+                      jacobian[e][d] += shape_gradient[d] * point[e];
+                  }
+              }
+          };
+
+        const auto lane_norm_square =
+          [](const Tensor<1, dim, VectorizedDouble> &t, const unsigned int v) {
+            double result = 0;
+            for (unsigned int d = 0; d < dim; ++d)
+              result += t[d][v] * t[d][v];
+            return result;
+          };
+
+        // same parameters as in do_transform_real_to_unit_cell_internal()
+        const double       eps                    = 1.e-11;
+        const unsigned int newton_iteration_limit = 20;
+
+        std::vector<unsigned int> remaining_points;
+        for (unsigned int i = 0; i < n_points; ++i)
+          if (converged[i] == false)
+            remaining_points.push_back(i);
+
+        for (unsigned int begin = 0; begin < remaining_points.size();
+             begin += n_lanes)
+          {
+            const unsigned int n_active =
+              std::min<unsigned int>(n_lanes, remaining_points.size() - begin);
+
+            // fill unused lanes with the last point of the batch, but mark
+            // them as converged right away
+            Tensor<1, dim, VectorizedDouble> p_unit, p_target;
+            for (unsigned int v = 0; v < n_lanes; ++v)
+              {
+                const unsigned int i =
+                  remaining_points[begin + std::min(v, n_active - 1)];
+                for (unsigned int d = 0; d < dim; ++d)
+                  {
+                    p_unit[d][v]   = unit_points[i][d];
+                    p_target[d][v] = real_points[i][d];
+                  }
+              }
+
+            Tensor<1, dim, VectorizedDouble> p_real;
+            Tensor<2, dim, VectorizedDouble> jacobian;
+            evaluate(p_unit, p_real, jacobian);
+            Tensor<1, dim, VectorizedDouble> f = p_real - p_target;
+
+            std::array<bool, n_lanes> done, failed;
+            for (unsigned int v = 0; v < n_lanes; ++v)
+              {
+                failed[v] = false;
+                done[v] =
+                  (v >= n_active) || (lane_norm_square(f, v) <
+                                      1e-24 * cell_diameter * cell_diameter);
+              }
+
+            for (unsigned int newton_iteration = 0;; ++newton_iteration)
+              {
+                bool all_finished = true;
+                for (unsigned int v = 0; v < n_lanes; ++v)
+                  if (!done[v] && !failed[v])
+                    {
+                      if (newton_iteration == newton_iteration_limit)
+                        failed[v] = true;
+                      else
+                        all_finished = false;
+                    }
+                if (all_finished)
+                  break;
+
+                // Solve [f'(x)]d=f(x) in all lanes that are still active,
+                // replacing the Jacobian of the other lanes by the identity
+                // in order not to produce floating point exceptions
+                const VectorizedDouble det = determinant(jacobian);
+                for (unsigned int v = 0; v < n_lanes; ++v)
+                  {
+                    if (!done[v] && !failed[v] && !(det[v] > 0))
+                      failed[v] = true;
+                    if (done[v] || failed[v])
+                      for (unsigned int d = 0; d < dim; ++d)
+                        for (unsigned int e = 0; e < dim; ++e)
+                          jacobian[d][e][v] = (d == e) ? 1. : 0.;
+                  }
+                const Tensor<2, dim, VectorizedDouble> jacobian_inverse =
+                  invert(jacobian);
+                const Tensor<1, dim, VectorizedDouble> delta =
+                  jacobian_inverse * f;
+
+                // do a line search in each lane, accepting the trial point
+                // as soon as it reduces the residual
+                VectorizedDouble step_length = make_vectorized_array(1.);
+                std::array<bool, n_lanes> accepted;
+                for (unsigned int v = 0; v < n_lanes; ++v)
+                  accepted[v] = done[v] || failed[v];
+                while (std::find(accepted.begin(), accepted.end(), false) !=
+                       accepted.end())
+                  {
+                    Tensor<1, dim, VectorizedDouble> p_unit_trial;
+                    for (unsigned int d = 0; d < dim; ++d)
+                      p_unit_trial[d] = p_unit[d] - step_length * delta[d];
+
+                    Tensor<1, dim, VectorizedDouble> p_real_trial;
+                    Tensor<2, dim, VectorizedDouble> jacobian_trial;
+                    evaluate(p_unit_trial, p_real_trial, jacobian_trial);
+                    const Tensor<1, dim, VectorizedDouble> f_trial =
+                      p_real_trial - p_target;
+
+                    for (unsigned int v = 0; v < n_lanes; ++v)
+                      if (accepted[v] == false)
+                        {
+                          if (lane_norm_square(f_trial, v) <
+                              lane_norm_square(f, v))
+                            {
+                              for (unsigned int d = 0; d < dim; ++d)
+                                {
+                                  p_unit[d][v] = p_unit_trial[d][v];
+                                  f[d][v]      = f_trial[d][v];
+                                  for (unsigned int e = 0; e < dim; ++e)
+                                    jacobian[d][e][v] =
+                                      jacobian_trial[d][e][v];
+                                }
+                              accepted[v] = true;
+                            }
+                          else if (step_length[v] > 0.05)
+                            step_length[v] /= 2;
+                          else
+                            {
+                              failed[v]   = true;
+                              accepted[v] = true;
+                            }
+                        }
+                  }
+
+                const Tensor<1, dim, VectorizedDouble> f_weighted =
+                  jacobian_inverse * f;
+                for (unsigned int v = 0; v < n_lanes; ++v)
+                  if (!done[v] && !failed[v] &&
+                      lane_norm_square(f_weighted, v) <= eps * eps)
+                    done[v] = true;
+              }
+
+            for (unsigned int v = 0; v < n_active; ++v)
+              if (done[v] && !failed[v])
+                {
+                  const unsigned int i = remaining_points[begin + v];
+                  for (unsigned int d = 0; d < dim; ++d)
+                    unit_points[i][d] = p_unit[d][v];
+                  converged[i] = true;
+                }
+          }
+      }
+
+
+
+      /**
+       * The vectorized Newton iteration above is only available for
+       * dim==spacedim. This overload should never be called.
+       */
+      template <int dim, int spacedim>
+      void
+      do_transform_points_real_to_unit_cell(
+        const unsigned int,
+        const std::vector<Point<spacedim>> &,
+        const double,
+        const ArrayView<const Point<spacedim>> &,
+        const ArrayView<Point<dim>> &,
+        std::vector<bool> &)
+      {
+        Assert(false, ExcInternalError());
+      }
+
+
+
+      /**
+       * Push forward the derivative @p unit_grad of the Jacobian with respect
+       * to the unit coordinates to the real cell coordinates, using the
+       * covariant transformation @p covariant of a quadrature point.
+       */
+      template <int dim, int spacedim>
+      inline void
+      push_forward_jacobian_grad(
+        const double (&unit_grad)[spacedim][dim][dim],
+        const DerivativeForm<1, dim, spacedim> &covariant,
+        Tensor<3, spacedim> &                   jacobian_pushed_forward_grad)
+      {
+        double tmp[spacedim][spacedim][spacedim];
+
+        // first push forward the j-components
+        for (unsigned int i = 0; i < spacedim; ++i)
+          for (unsigned int j = 0; j < spacedim; ++j)
+            for (unsigned int l = 0; l < dim; ++l)
+              {
+                tmp[i][j][l] = unit_grad[i][0][l] * covariant[j][0];
+                for (unsigned int jr = 1; jr < dim; ++jr)
+                  {
+                    tmp[i][j][l] += unit_grad[i][jr][l] * covariant[j][jr];
+                  }
+              }
+
+        // now, pushing forward the l-components
+        for (unsigned int i = 0; i < spacedim; ++i)
+          for (unsigned int j = 0; j < spacedim; ++j)
+            for (unsigned int l = 0; l < spacedim; ++l)
+              {
+                jacobian_pushed_forward_grad[i][j][l] =
+                  tmp[i][j][0] * covariant[l][0];
+                for (unsigned int lr = 1; lr < dim; ++lr)
+                  {
+                    jacobian_pushed_forward_grad[i][j][l] +=
+                      tmp[i][j][lr] * covariant[l][lr];
+                  }
+              }
+      }
+
+
+
       /**
        * In case the quadrature formula is a tensor product, this is a
-       * replacement for maybe_compute_q_points(), maybe_update_Jacobians() and
-       * maybe_update_jacobian_grads()
+       * replacement for maybe_compute_q_points(), maybe_update_Jacobians(),
+       * maybe_update_jacobian_grads() and
+       * maybe_update_jacobian_pushed_forward_grads()
        */
       template <int dim, int spacedim>
       void
@@ -1523,7 +1976,8 @@ namespace internal
         const typename dealii::MappingQGeneric<dim, spacedim>::InternalData
           &                                            data,
         std::vector<Point<spacedim>> &                 quadrature_points,
-        std::vector<DerivativeForm<2, dim, spacedim>> &jacobian_grads)
+        std::vector<DerivativeForm<2, dim, spacedim>> &jacobian_grads,
+        std::vector<Tensor<3, spacedim>> &jacobian_pushed_forward_grads)
       {
         const UpdateFlags update_flags = data.update_each;
 
@@ -1540,7 +1994,8 @@ namespace internal
           (update_flags & update_contravariant_transformation);
         const bool evaluate_hessians =
           (cell_similarity != CellSimilarity::translation) &&
-          (update_flags & update_jacobian_grads);
+          (update_flags &
+           (update_jacobian_grads | update_jacobian_pushed_forward_grads));
 
         Assert(!evaluate_values || n_q_points > 0, ExcInternalError());
         Assert(!evaluate_values || n_q_points == quadrature_points.size(),
@@ -1549,8 +2004,14 @@ namespace internal
                ExcInternalError());
         Assert(!evaluate_gradients || n_q_points == data.contravariant.size(),
                ExcDimensionMismatch(n_q_points, data.contravariant.size()));
-        Assert(!evaluate_hessians || n_q_points == jacobian_grads.size(),
+        Assert(!evaluate_hessians || !(update_flags & update_jacobian_grads) ||
+                 n_q_points == jacobian_grads.size(),
                ExcDimensionMismatch(n_q_points, jacobian_grads.size()));
+        Assert(!evaluate_hessians ||
+                 !(update_flags & update_jacobian_pushed_forward_grads) ||
+                 n_q_points == jacobian_pushed_forward_grads.size(),
+               ExcDimensionMismatch(n_q_points,
+                                    jacobian_pushed_forward_grads.size()));
 
         // prepare arrays
         if (evaluate_values || evaluate_gradients || evaluate_hessians)
@@ -1642,36 +2103,217 @@ namespace internal
               {0, 0}, {1, 1}, {2, 2}, {0, 1}, {0, 2}, {1, 2}};
             constexpr int desymmetrize_2d[3][2] = {{0, 0}, {1, 1}, {0, 1}};
 
-            // We need to reinterpret the data after evaluate has been applied.
-            for (unsigned int out_comp = 0; out_comp < n_comp; ++out_comp)
-              for (unsigned int point = 0; point < n_q_points; ++point)
-                for (unsigned int j = 0; j < n_hessians; ++j)
-                  for (unsigned int in_comp = 0;
-                       in_comp < vec_length &&
-                       in_comp < spacedim - out_comp * vec_length;
-                       ++in_comp)
-                    {
-                      const unsigned int total_number = point * n_hessians + j;
-                      const unsigned int new_point = total_number % n_q_points;
-                      const unsigned int new_hessian_comp =
-                        total_number / n_q_points;
-                      const unsigned int new_hessian_comp_i =
-                        dim == 2 ? desymmetrize_2d[new_hessian_comp][0] :
-                                   desymmetrize_3d[new_hessian_comp][0];
-                      const unsigned int new_hessian_comp_j =
-                        dim == 2 ? desymmetrize_2d[new_hessian_comp][1] :
-                                   desymmetrize_3d[new_hessian_comp][1];
-                      const double value =
-                        data.hessians_quad[(out_comp * n_q_points + point) *
-                                             n_hessians +
-                                           j][in_comp];
-                      jacobian_grads[new_point][out_comp * vec_length + in_comp]
-                                    [new_hessian_comp_i][new_hessian_comp_j] =
-                                      value;
-                      jacobian_grads[new_point][out_comp * vec_length + in_comp]
-                                    [new_hessian_comp_j][new_hessian_comp_i] =
-                                      value;
-                    }
+            // the evaluator stores the hessians component by component, and
+            // within each component entry by entry for all points
+            for (unsigned int point = 0; point < n_q_points; ++point)
+              {
+                double result[spacedim][dim][dim];
+                for (unsigned int out_comp = 0; out_comp < n_comp; ++out_comp)
+                  for (unsigned int j = 0; j < n_hessians; ++j)
+                    for (unsigned int in_comp = 0;
+                         in_comp < vec_length &&
+                         in_comp < spacedim - out_comp * vec_length;
+                         ++in_comp)
+                      {
+                        const unsigned int hessian_comp_i =
+                          dim == 2 ? desymmetrize_2d[j][0] :
+                                     desymmetrize_3d[j][0];
+                        const unsigned int hessian_comp_j =
+                          dim == 2 ? desymmetrize_2d[j][1] :
+                                     desymmetrize_3d[j][1];
+                        const double value =
+                          data.hessians_quad[(out_comp * n_hessians + j) *
+                                               n_q_points +
+                                             point][in_comp];
+                        const unsigned int comp =
+                          out_comp * vec_length + in_comp;
+                        result[comp][hessian_comp_i][hessian_comp_j] = value;
+                        result[comp][hessian_comp_j][hessian_comp_i] = value;
+                      }
+
+                if (update_flags & update_jacobian_grads)
+                  for (unsigned int i = 0; i < spacedim; ++i)
+                    for (unsigned int j = 0; j < dim; ++j)
+                      for (unsigned int l = 0; l < dim; ++l)
+                        jacobian_grads[point][i][j][l] = result[i][j][l];
+
+                if (update_flags & update_jacobian_pushed_forward_grads)
+                  push_forward_jacobian_grad<dim, spacedim>(
+                    result,
+                    data.covariant[point],
+                    jacobian_pushed_forward_grads[point]);
+              }
+          }
+      }
+
+
+
+      /**
+       * The counterpart of maybe_update_q_points_Jacobians_and_grads_tensor()
+       * for quadrature formulas that are not a tensor product, in particular
+       * the quadrature points projected to the faces and subfaces of the
+       * reference cell. The mapping is evaluated in each quadrature point
+       * separately by sum factorization, using the one-dimensional
+       * polynomials stored in data.polynomial_values_1d: the support points
+       * are first contracted with the polynomials in x direction for all
+       * derivatives up to the needed order, then in y direction and so on.
+       * This replaces maybe_compute_q_points(), maybe_update_Jacobians(),
+       * maybe_update_jacobian_grads() and
+       * maybe_update_jacobian_pushed_forward_grads() without the need for the
+       * tables of the shape functions in all quadrature points.
+       */
+      template <int dim, int spacedim>
+      void
+      maybe_update_q_points_Jacobians_and_grads_1d(
+        const typename QProjector<dim>::DataSetDescriptor data_set,
+        const unsigned int                                n_q_points,
+        const typename dealii::MappingQGeneric<dim, spacedim>::InternalData
+          &                                            data,
+        std::vector<Point<spacedim>> &                 quadrature_points,
+        std::vector<DerivativeForm<2, dim, spacedim>> &jacobian_grads,
+        std::vector<Tensor<3, spacedim>> &jacobian_pushed_forward_grads)
+      {
+        const UpdateFlags update_flags = data.update_each;
+
+        // find out the highest derivative we need in the quadrature points
+        int max_derivative = -1;
+        if (update_flags & update_quadrature_points)
+          max_derivative = 0;
+        if (update_flags & update_contravariant_transformation)
+          max_derivative = 1;
+        if (update_flags &
+            (update_jacobian_grads | update_jacobian_pushed_forward_grads))
+          max_derivative = 2;
+        if (max_derivative < 0)
+          return;
+
+        Assert(!(update_flags & update_quadrature_points) ||
+                 n_q_points == quadrature_points.size(),
+               ExcDimensionMismatch(n_q_points, quadrature_points.size()));
+        Assert(!(update_flags & update_contravariant_transformation) ||
+                 n_q_points == data.contravariant.size(),
+               ExcDimensionMismatch(n_q_points, data.contravariant.size()));
+        Assert(!(update_flags & update_jacobian_grads) ||
+                 n_q_points == jacobian_grads.size(),
+               ExcDimensionMismatch(n_q_points, jacobian_grads.size()));
+        Assert(!(update_flags & update_jacobian_pushed_forward_grads) ||
+                 n_q_points == jacobian_pushed_forward_grads.size(),
+               ExcDimensionMismatch(n_q_points,
+                                    jacobian_pushed_forward_grads.size()));
+
+        const unsigned int n_points_1d       = data.polynomial_degree + 1;
+        const unsigned int n_shape_functions = data.n_shape_functions;
+        AssertDimension(data.lexicographic_to_hierarchic.size(),
+                        n_shape_functions);
+        AssertIndexRange((data_set + n_q_points) * dim * n_points_1d * 3,
+                         data.polynomial_values_1d.size() + 1);
+
+        // the scratch array holds the support points in lexicographic order,
+        // followed by two buffers for the partial sums that are used in
+        // turns for the contractions in the individual directions
+        Tensor<1, spacedim> *support_points =
+          data.sum_factorization_scratch.data();
+        const unsigned int buffer_size =
+          (data.sum_factorization_scratch.size() - n_shape_functions) / 2;
+        Tensor<1, spacedim> *buffers[2] = {support_points + n_shape_functions,
+                                           support_points + n_shape_functions +
+                                             buffer_size};
+        for (unsigned int i = 0; i < n_shape_functions; ++i)
+          support_points[i] =
+            data.mapping_support_points[data.lexicographic_to_hierarchic[i]];
+
+        // the derivatives are numbered by a multi-index that holds the order
+        // of the derivative in direction d in the d-th digit in base 3
+        unsigned int derivative_stride[dim];
+        for (unsigned int d = 0, stride = 1; d < dim; ++d, stride *= 3)
+          derivative_stride[d] = stride;
+
+        for (unsigned int point = 0; point < n_q_points; ++point)
+          {
+            const double *values_1d =
+              &data.polynomial_values_1d[(point + data_set) * dim *
+                                         n_points_1d * 3];
+
+            const Tensor<1, spacedim> *in            = support_points;
+            unsigned int               n_derivatives = 1;
+            unsigned int               n_remaining   = n_shape_functions;
+            for (unsigned int d = 0; d < dim; ++d)
+              {
+                Tensor<1, spacedim> *out  = buffers[d % 2];
+                const unsigned int   n_in = n_remaining;
+                const double *values_d    = values_1d + d * n_points_1d * 3;
+                n_remaining /= n_points_1d;
+
+                for (unsigned int m = 0; m < n_derivatives; ++m)
+                  {
+                    int order = 0;
+                    for (unsigned int digits = m; digits > 0; digits /= 3)
+                      order += digits % 3;
+                    if (order > max_derivative)
+                      continue;
+
+                    const Tensor<1, spacedim> *in_m = in + m * n_in;
+                    for (int k = 0; k <= max_derivative - order; ++k)
+                      {
+                        Tensor<1, spacedim> *out_mk =
+                          out + (m + k * n_derivatives) * n_remaining;
+                        for (unsigned int r = 0; r < n_remaining; ++r)
+                          {
+                            const Tensor<1, spacedim> *in_r =
+                              in_m + r * n_points_1d;
+                            Tensor<1, spacedim> sum = values_d[k] * in_r[0];
+                            for (unsigned int i = 1; i < n_points_1d; ++i)
+                              sum += values_d[i * 3 + k] * in_r[i];
+                            out_mk[r] = sum;
+                          }
+                      }
+                  }
+
+                in = out;
+                n_derivatives *= 3;
+              }
+
+            // 'in' now holds the position and its derivatives in the
+            // current point
+            if (update_flags & update_quadrature_points)
+              quadrature_points[point] = Point<spacedim>(in[0]);
+
+            if (update_flags & update_contravariant_transformation)
+              for (unsigned int i = 0; i < spacedim; ++i)
+                for (unsigned int j = 0; j < dim; ++j)
+                  data.contravariant[point][i][j] =
+                    in[derivative_stride[j]][i];
+
+            if (update_flags & update_covariant_transformation)
+              data.covariant[point] =
+                data.contravariant[point].covariant_form();
+
+            if (update_flags & update_volume_elements)
+              data.volume_elements[point] =
+                data.contravariant[point].determinant();
+
+            if (update_flags &
+                (update_jacobian_grads | update_jacobian_pushed_forward_grads))
+              {
+                double result[spacedim][dim][dim];
+                for (unsigned int i = 0; i < spacedim; ++i)
+                  for (unsigned int j = 0; j < dim; ++j)
+                    for (unsigned int l = 0; l < dim; ++l)
+                      result[i][j][l] =
+                        in[derivative_stride[j] + derivative_stride[l]][i];
+
+                if (update_flags & update_jacobian_grads)
+                  for (unsigned int i = 0; i < spacedim; ++i)
+                    for (unsigned int j = 0; j < dim; ++j)
+                      for (unsigned int l = 0; l < dim; ++l)
+                        jacobian_grads[point][i][j][l] = result[i][j][l];
+
+                if (update_flags & update_jacobian_pushed_forward_grads)
+                  push_forward_jacobian_grad<dim, spacedim>(
+                    result,
+                    data.covariant[point],
+                    jacobian_pushed_forward_grads[point]);
+              }
           }
       }
 
@@ -1862,7 +2504,6 @@ namespace internal
 
             if (cell_similarity != CellSimilarity::translation)
               {
-                double tmp[spacedim][spacedim][spacedim];
                 for (unsigned int point = 0; point < n_q_points; ++point)
                   {
                     const Tensor<2, dim> *second =
@@ -1881,33 +2522,10 @@ namespace internal
                               (second[k][j][l] *
                                data.mapping_support_points[k][i]);
 
-                    // first push forward the j-components
-                    for (unsigned int i = 0; i < spacedim; ++i)
-                      for (unsigned int j = 0; j < spacedim; ++j)
-                        for (unsigned int l = 0; l < dim; ++l)
-                          {
-                            tmp[i][j][l] =
-                              result[i][0][l] * data.covariant[point][j][0];
-                            for (unsigned int jr = 1; jr < dim; ++jr)
-                              {
-                                tmp[i][j][l] += result[i][jr][l] *
-                                                data.covariant[point][j][jr];
-                              }
-                          }
-
-                    // now, pushing forward the l-components
-                    for (unsigned int i = 0; i < spacedim; ++i)
-                      for (unsigned int j = 0; j < spacedim; ++j)
-                        for (unsigned int l = 0; l < spacedim; ++l)
-                          {
-                            jacobian_pushed_forward_grads[point][i][j][l] =
-                              tmp[i][j][0] * data.covariant[point][l][0];
-                            for (unsigned int lr = 1; lr < dim; ++lr)
-                              {
-                                jacobian_pushed_forward_grads[point][i][j][l] +=
-                                  tmp[i][j][lr] * data.covariant[point][l][lr];
-                              }
-                          }
+                    push_forward_jacobian_grad<dim, spacedim>(
+                      result,
+                      data.covariant[point],
+                      jacobian_pushed_forward_grads[point]);
                   }
               }
           }
@@ -2383,7 +3001,11 @@ MappingQGeneric<1, 1>::transform_real_to_unit_cell_internal(
   const int dim      = 1;
   const int spacedim = 1;
 
-  const Quadrature<dim> point_quadrature(initial_p_unit);
+  // use a quadrature formula that is not flagged as a tensor product, such
+  // that the tables of the shape functions needed by the Newton iteration
+  // are set up
+  const Quadrature<dim> point_quadrature(
+    std::vector<Point<dim>>(1, initial_p_unit));
 
   UpdateFlags update_flags = update_quadrature_points | update_jacobians;
   if (spacedim > dim)
@@ -2409,7 +3031,11 @@ MappingQGeneric<2, 2>::transform_real_to_unit_cell_internal(
   const int dim      = 2;
   const int spacedim = 2;
 
-  const Quadrature<dim> point_quadrature(initial_p_unit);
+  // use a quadrature formula that is not flagged as a tensor product, such
+  // that the tables of the shape functions needed by the Newton iteration
+  // are set up
+  const Quadrature<dim> point_quadrature(
+    std::vector<Point<dim>>(1, initial_p_unit));
 
   UpdateFlags update_flags = update_quadrature_points | update_jacobians;
   if (spacedim > dim)
@@ -2435,7 +3061,11 @@ MappingQGeneric<3, 3>::transform_real_to_unit_cell_internal(
   const int dim      = 3;
   const int spacedim = 3;
 
-  const Quadrature<dim> point_quadrature(initial_p_unit);
+  // use a quadrature formula that is not flagged as a tensor product, such
+  // that the tables of the shape functions needed by the Newton iteration
+  // are set up
+  const Quadrature<dim> point_quadrature(
+    std::vector<Point<dim>>(1, initial_p_unit));
 
   UpdateFlags update_flags = update_quadrature_points | update_jacobians;
   if (spacedim > dim)
@@ -2463,7 +3093,11 @@ MappingQGeneric<1, 2>::transform_real_to_unit_cell_internal(
   const int dim      = 1;
   const int spacedim = 2;
 
-  const Quadrature<dim> point_quadrature(initial_p_unit);
+  // use a quadrature formula that is not flagged as a tensor product, such
+  // that the tables of the shape functions needed by the Newton iteration
+  // are set up
+  const Quadrature<dim> point_quadrature(
+    std::vector<Point<dim>>(1, initial_p_unit));
 
   UpdateFlags update_flags = update_quadrature_points | update_jacobians;
   if (spacedim > dim)
@@ -2494,7 +3128,11 @@ MappingQGeneric<2, 3>::transform_real_to_unit_cell_internal(
   const int dim      = 2;
   const int spacedim = 3;
 
-  const Quadrature<dim> point_quadrature(initial_p_unit);
+  // use a quadrature formula that is not flagged as a tensor product, such
+  // that the tables of the shape functions needed by the Newton iteration
+  // are set up
+  const Quadrature<dim> point_quadrature(
+    std::vector<Point<dim>>(1, initial_p_unit));
 
   UpdateFlags update_flags = update_quadrature_points | update_jacobians;
   if (spacedim > dim)
@@ -2662,6 +3300,99 @@ MappingQGeneric<dim, spacedim>::transform_real_to_unit_cell(
 
 
 
+template <int dim, int spacedim>
+void
+MappingQGeneric<dim, spacedim>::transform_points_real_to_unit_cell(
+  const typename Triangulation<dim, spacedim>::cell_iterator &cell,
+  const ArrayView<const Point<spacedim>> &                    real_points,
+  const ArrayView<Point<dim>> &                               unit_points) const
+{
+  // the vectorized Newton iteration is only implemented for dim==spacedim
+  if (dim != spacedim)
+    {
+      Mapping<dim, spacedim>::transform_points_real_to_unit_cell(cell,
+                                                                 real_points,
+                                                                 unit_points);
+      return;
+    }
+
+  AssertDimension(real_points.size(), unit_points.size());
+  const unsigned int n_points = real_points.size();
+  if (n_points == 0)
+    return;
+
+  const std::vector<Point<spacedim>> support_points =
+    this->compute_mapping_support_points(cell);
+  std::vector<bool> converged(n_points, false);
+
+  // use the exact formula of transform_real_to_unit_cell() for Q1 mappings
+  // in 2D for all points it maps into the unit cell
+  if (polynomial_degree == 1 && dim == 2)
+    {
+      std::array<Point<spacedim>, GeometryInfo<dim>::vertices_per_cell>
+        vertices;
+      std::copy(support_points.begin(),
+                support_points.begin() + GeometryInfo<dim>::vertices_per_cell,
+                vertices.begin());
+      for (unsigned int i = 0; i < n_points; ++i)
+        try
+          {
+            const Point<dim> point =
+              internal::MappingQ1::transform_real_to_unit_cell(vertices,
+                                                               real_points[i]);
+            const double eps = 1e-15;
+            if (-eps <= point(1) && point(1) <= 1 + eps && -eps <= point(0) &&
+                point(0) <= 1 + eps)
+              {
+                unit_points[i] = point;
+                converged[i]   = true;
+              }
+          }
+        catch (
+          const typename Mapping<spacedim, spacedim>::ExcTransformationFailed &)
+          {}
+    }
+
+  // find the initial values for the Newton iteration as in
+  // transform_real_to_unit_cell(), but set up the triangulation for the
+  // affine approximation only once
+  Triangulation<dim, spacedim> vertex_tria;
+  if (!this->preserves_vertex_locations())
+    {
+      std::vector<Point<spacedim>> vertices(
+        support_points.begin(),
+        support_points.begin() + GeometryInfo<dim>::vertices_per_cell);
+      std::vector<CellData<dim>> cells(1);
+      for (unsigned int i = 0; i < GeometryInfo<dim>::vertices_per_cell; ++i)
+        cells[0].vertices[i] = i;
+      vertex_tria.create_triangulation(vertices, cells, SubCellData());
+    }
+  for (unsigned int i = 0; i < n_points; ++i)
+    if (converged[i] == false)
+      unit_points[i] = GeometryInfo<dim>::project_to_unit_cell(
+        this->preserves_vertex_locations() ?
+          cell->real_to_unit_cell_affine_approximation(real_points[i]) :
+          vertex_tria.begin_active()->real_to_unit_cell_affine_approximation(
+            real_points[i]));
+
+  internal::MappingQGenericImplementation::
+    do_transform_points_real_to_unit_cell(polynomial_degree,
+                                          support_points,
+                                          cell->diameter(),
+                                          real_points,
+                                          unit_points,
+                                          converged);
+
+  for (unsigned int i = 0; i < n_points; ++i)
+    if (converged[i] == false)
+      {
+        unit_points[i]    = Point<dim>();
+        unit_points[i][0] = std::numeric_limits<double>::infinity();
+      }
+}
+
+
+
 template <int dim, int spacedim>
 UpdateFlags
 MappingQGeneric<dim, spacedim>::requires_update_flags(
@@ -2787,6 +3518,13 @@ MappingQGeneric<dim, spacedim>::fill_fe_values(
 
   const unsigned int n_q_points = quadrature.size();
 
+  // if nothing is requested that depends on the geometry of the cell (e.g.,
+  // if only the values of shape functions are needed), there is nothing to
+  // compute. in particular, we need not ask the manifold for the support
+  // points of the cell
+  if (!(data.update_each & update_mapping))
+    return (polynomial_degree == 1 ? cell_similarity : CellSimilarity::none);
+
   // recompute the support points of the transformation of this
   // cell. we tried to be clever here in an earlier version of the
   // library by checking whether the cell is the same as the one we
@@ -2807,6 +3545,24 @@ MappingQGeneric<dim, spacedim>::fill_fe_values(
   const CellSimilarity::Similarity computed_cell_similarity =
     (polynomial_degree == 1 ? cell_similarity : CellSimilarity::none);
 
+  // if the cell is the image of the reference cell under an affine map, the
+  // Jacobian is the same in all quadrature points and all of its derivatives
+  // vanish, so we only need to compute it once
+  DerivativeForm<1, dim, spacedim> affine_jacobian;
+  if (dim == spacedim &&
+      internal::MappingQGenericImplementation::compute_affine_jacobian(
+        data.mapping_support_points,
+        data.unit_support_points,
+        affine_jacobian))
+    return fill_fe_values_affine(cell,
+                                 computed_cell_similarity,
+                                 affine_jacobian,
+                                 quadrature,
+                                 data,
+                                 output_data);
+
+  data.affine_jacobian_is_current = false;
+
   if (dim > 1 && data.tensor_product_quadrature)
     {
       internal::MappingQGenericImplementation::
@@ -2814,7 +3570,8 @@ MappingQGeneric<dim, spacedim>::fill_fe_values(
           computed_cell_similarity,
           data,
           output_data.quadrature_points,
-          output_data.jacobian_grads);
+          output_data.jacobian_grads,
+          output_data.jacobian_pushed_forward_grads);
     }
   else
     {
@@ -2836,14 +3593,14 @@ MappingQGeneric<dim, spacedim>::fill_fe_values(
                   QProjector<dim>::DataSetDescriptor::cell(),
                   data,
                   output_data.jacobian_grads);
-    }
 
-  internal::MappingQGenericImplementation::
-    maybe_update_jacobian_pushed_forward_grads<dim, spacedim>(
-      computed_cell_similarity,
-      QProjector<dim>::DataSetDescriptor::cell(),
-      data,
-      output_data.jacobian_pushed_forward_grads);
+      internal::MappingQGenericImplementation::
+        maybe_update_jacobian_pushed_forward_grads<dim, spacedim>(
+          computed_cell_similarity,
+          QProjector<dim>::DataSetDescriptor::cell(),
+          data,
+          output_data.jacobian_pushed_forward_grads);
+    }
 
   internal::MappingQGenericImplementation::
     maybe_update_jacobian_2nd_derivatives<dim, spacedim>(
@@ -2992,6 +3749,127 @@ MappingQGeneric<dim, spacedim>::fill_fe_values(
 
 
 
+template <int dim, int spacedim>
+CellSimilarity::Similarity
+MappingQGeneric<dim, spacedim>::fill_fe_values_affine(
+  const typename Triangulation<dim, spacedim>::cell_iterator &cell,
+  const CellSimilarity::Similarity                            cell_similarity,
+  const DerivativeForm<1, dim, spacedim> &                    jacobian,
+  const Quadrature<dim> &                                     quadrature,
+  const InternalData &                                        data,
+  internal::FEValuesImplementation::MappingRelatedData<dim, spacedim>
+    &output_data) const
+{
+  Assert(dim == spacedim, ExcNotImplemented());
+
+  const UpdateFlags  update_flags = data.update_each;
+  const unsigned int n_q_points   = quadrature.size();
+
+  if (update_flags & update_quadrature_points)
+    {
+      AssertDimension(output_data.quadrature_points.size(), n_q_points);
+      const Point<spacedim> &origin = data.mapping_support_points[0];
+      for (unsigned int point = 0; point < n_q_points; ++point)
+        output_data.quadrature_points[point] =
+          origin + apply_transformation(jacobian, quadrature.point(point));
+    }
+
+  // if the Jacobian is exactly the same as the one of the cell last seen by
+  // this object, all quantities derived from it are still valid, and we can
+  // also tell the finite element that it does not need to recompute the
+  // derivatives of the shape functions. since a re-computation would produce
+  // exactly the same numbers, this does not introduce any dependence on the
+  // order in which the cells are visited, unlike the check for translated
+  // cells in FEValues that is based on the vertex positions
+  bool jacobian_is_unchanged = data.affine_jacobian_is_current &&
+                               cell_similarity !=
+                                 CellSimilarity::invalid_next_cell;
+  for (unsigned int e = 0; e < spacedim && jacobian_is_unchanged; ++e)
+    for (unsigned int d = 0; d < dim; ++d)
+      if (jacobian[e][d] != data.affine_jacobian[e][d])
+        {
+          jacobian_is_unchanged = false;
+          break;
+        }
+
+  if (jacobian_is_unchanged || cell_similarity == CellSimilarity::translation)
+    return CellSimilarity::translation;
+
+  data.affine_jacobian            = jacobian;
+  data.affine_jacobian_is_current = true;
+
+  if (update_flags & update_contravariant_transformation)
+    std::fill(data.contravariant.begin(), data.contravariant.end(), jacobian);
+
+  if (update_flags & update_covariant_transformation)
+    std::fill(data.covariant.begin(),
+              data.covariant.end(),
+              jacobian.covariant_form());
+
+  const double determinant = jacobian.determinant();
+  if (update_flags & update_volume_elements)
+    std::fill(data.volume_elements.begin(),
+              data.volume_elements.end(),
+              determinant);
+
+  if (update_flags & (update_normal_vectors | update_JxW_values))
+    {
+      AssertDimension(output_data.JxW_values.size(), n_q_points);
+
+      // check for distorted cells, see fill_fe_values()
+      Assert(determinant >
+               1e-12 * Utilities::fixed_power<dim>(cell->diameter() /
+                                                   std::sqrt(double(dim))),
+             (typename Mapping<dim, spacedim>::ExcDistortedMappedCell(
+               cell->center(), determinant, 0)));
+      (void)cell;
+
+      const std::vector<double> &weights = quadrature.get_weights();
+      for (unsigned int point = 0; point < n_q_points; ++point)
+        output_data.JxW_values[point] = weights[point] * determinant;
+    }
+
+  if (update_flags & update_jacobians)
+    {
+      AssertDimension(output_data.jacobians.size(), n_q_points);
+      std::fill(output_data.jacobians.begin(),
+                output_data.jacobians.end(),
+                jacobian);
+    }
+
+  if (update_flags & update_inverse_jacobians)
+    {
+      AssertDimension(output_data.inverse_jacobians.size(), n_q_points);
+      std::fill(output_data.inverse_jacobians.begin(),
+                output_data.inverse_jacobians.end(),
+                jacobian.covariant_form().transpose());
+    }
+
+  // all derivatives of the Jacobian vanish
+  std::fill(output_data.jacobian_grads.begin(),
+            output_data.jacobian_grads.end(),
+            DerivativeForm<2, dim, spacedim>());
+  std::fill(output_data.jacobian_pushed_forward_grads.begin(),
+            output_data.jacobian_pushed_forward_grads.end(),
+            Tensor<3, spacedim>());
+  std::fill(output_data.jacobian_2nd_derivatives.begin(),
+            output_data.jacobian_2nd_derivatives.end(),
+            DerivativeForm<3, dim, spacedim>());
+  std::fill(output_data.jacobian_pushed_forward_2nd_derivatives.begin(),
+            output_data.jacobian_pushed_forward_2nd_derivatives.end(),
+            Tensor<4, spacedim>());
+  std::fill(output_data.jacobian_3rd_derivatives.begin(),
+            output_data.jacobian_3rd_derivatives.end(),
+            DerivativeForm<4, dim, spacedim>());
+  std::fill(output_data.jacobian_pushed_forward_3rd_derivatives.begin(),
+            output_data.jacobian_pushed_forward_3rd_derivatives.end(),
+            Tensor<5, spacedim>());
+
+  return CellSimilarity::none;
+}
+
+
+
 namespace internal
 {
   namespace MappingQGenericImplementation
@@ -3192,13 +4070,15 @@ namespace internal
         internal::FEValuesImplementation::MappingRelatedData<dim, spacedim>
           &output_data)
       {
-        if (dim > 1 && data.tensor_product_quadrature)
+        if (dim > 1 && data.evaluate_from_1d_polynomials)
           {
-            maybe_update_q_points_Jacobians_and_grads_tensor<dim, spacedim>(
-              CellSimilarity::none,
+            maybe_update_q_points_Jacobians_and_grads_1d<dim, spacedim>(
+              data_set,
+              quadrature.size(),
               data,
               output_data.quadrature_points,
-              output_data.jacobian_grads);
+              output_data.jacobian_grads,
+              output_data.jacobian_pushed_forward_grads);
           }
         else
           {
@@ -3209,12 +4089,12 @@ namespace internal
                                                   data);
             maybe_update_jacobian_grads<dim, spacedim>(
               CellSimilarity::none, data_set, data, output_data.jacobian_grads);
+            maybe_update_jacobian_pushed_forward_grads<dim, spacedim>(
+              CellSimilarity::none,
+              data_set,
+              data,
+              output_data.jacobian_pushed_forward_grads);
           }
-        maybe_update_jacobian_pushed_forward_grads<dim, spacedim>(
-          CellSimilarity::none,
-          data_set,
-          data,
-          output_data.jacobian_pushed_forward_grads);
         maybe_update_jacobian_2nd_derivatives<dim, spacedim>(
           CellSimilarity::none,
           data_set,
@@ -3245,6 +4125,148 @@ namespace internal
                                 data,
                                 output_data);
       }
+
+
+      /**
+       * The counterpart of do_fill_fe_face_values() for cells whose mapping
+       * is affine with the Jacobian stored in data.affine_jacobian. In that
+       * case, the quadrature points follow from the precomputed points on
+       * the reference faces stored in data.face_quadrature_points, and the
+       * Jacobian, the normal vector and the boundary form are the same in
+       * all quadrature points of the face. The JxW values are scaled by
+       * @p area_ratio, the ratio between the area of a subface and its
+       * parent face.
+       */
+      template <int dim, int spacedim>
+      void
+      do_fill_fe_face_values_affine(
+        const unsigned int                                face_no,
+        const double                                      area_ratio,
+        const typename QProjector<dim>::DataSetDescriptor data_set,
+        const Quadrature<dim - 1> &                       quadrature,
+        const typename dealii::MappingQGeneric<dim, spacedim>::InternalData
+          &data,
+        internal::FEValuesImplementation::MappingRelatedData<dim, spacedim>
+          &output_data)
+      {
+        const UpdateFlags                       update_flags = data.update_each;
+        const unsigned int                      n_q_points = quadrature.size();
+        const DerivativeForm<1, dim, spacedim> &jacobian = data.affine_jacobian;
+
+        if (update_flags & update_quadrature_points)
+          {
+            AssertDimension(output_data.quadrature_points.size(), n_q_points);
+            AssertIndexRange(data_set + n_q_points,
+                             data.face_quadrature_points.size() + 1);
+            const Point<spacedim> &origin = data.mapping_support_points[0];
+            for (unsigned int point = 0; point < n_q_points; ++point)
+              output_data.quadrature_points[point] =
+                origin +
+                apply_transformation(
+                  jacobian, data.face_quadrature_points[data_set + point]);
+          }
+
+        if (update_flags & update_contravariant_transformation)
+          std::fill(data.contravariant.begin(),
+                    data.contravariant.end(),
+                    jacobian);
+
+        if (update_flags & update_covariant_transformation)
+          std::fill(data.covariant.begin(),
+                    data.covariant.end(),
+                    jacobian.covariant_form());
+
+        if (update_flags & update_volume_elements)
+          std::fill(data.volume_elements.begin(),
+                    data.volume_elements.end(),
+                    jacobian.determinant());
+
+        if (update_flags &
+            (update_boundary_forms | update_normal_vectors | update_JxW_values))
+          {
+            // the boundary form is the cross product of the mapped unit
+            // tangentials, see maybe_compute_face_data()
+            Tensor<1, spacedim> boundary_form;
+            switch (dim)
+              {
+                case 1:
+                  boundary_form[0] = (face_no == 0 ? -1 : +1);
+                  break;
+                case 2:
+                  boundary_form = cross_product_2d(
+                    apply_transformation(jacobian,
+                                         data.unit_tangentials[face_no][0]));
+                  break;
+                case 3:
+                  boundary_form = cross_product_3d(
+                    apply_transformation(jacobian,
+                                         data.unit_tangentials[face_no][0]),
+                    apply_transformation(
+                      jacobian,
+                      data.unit_tangentials
+                        [face_no + GeometryInfo<dim>::faces_per_cell][0]));
+                  break;
+                default:
+                  Assert(false, ExcNotImplemented());
+              }
+
+            if (update_flags & update_boundary_forms)
+              {
+                AssertDimension(output_data.boundary_forms.size(), n_q_points);
+                std::fill(output_data.boundary_forms.begin(),
+                          output_data.boundary_forms.end(),
+                          boundary_form);
+              }
+
+            const double area_element = boundary_form.norm();
+            if (update_flags & update_normal_vectors)
+              {
+                AssertDimension(output_data.normal_vectors.size(), n_q_points);
+                std::fill(output_data.normal_vectors.begin(),
+                          output_data.normal_vectors.end(),
+                          Point<spacedim>(boundary_form / area_element));
+              }
+
+            if (update_flags & update_JxW_values)
+              {
+                AssertDimension(output_data.JxW_values.size(), n_q_points);
+                const std::vector<double> &weights = quadrature.get_weights();
+                for (unsigned int point = 0; point < n_q_points; ++point)
+                  output_data.JxW_values[point] =
+                    area_element * weights[point] * area_ratio;
+              }
+          }
+
+        if (update_flags & update_jacobians)
+          std::fill(output_data.jacobians.begin(),
+                    output_data.jacobians.end(),
+                    jacobian);
+
+        if (update_flags & update_inverse_jacobians)
+          std::fill(output_data.inverse_jacobians.begin(),
+                    output_data.inverse_jacobians.end(),
+                    jacobian.covariant_form().transpose());
+
+        // all derivatives of the Jacobian vanish
+        std::fill(output_data.jacobian_grads.begin(),
+                  output_data.jacobian_grads.end(),
+                  DerivativeForm<2, dim, spacedim>());
+        std::fill(output_data.jacobian_pushed_forward_grads.begin(),
+                  output_data.jacobian_pushed_forward_grads.end(),
+                  Tensor<3, spacedim>());
+        std::fill(output_data.jacobian_2nd_derivatives.begin(),
+                  output_data.jacobian_2nd_derivatives.end(),
+                  DerivativeForm<3, dim, spacedim>());
+        std::fill(output_data.jacobian_pushed_forward_2nd_derivatives.begin(),
+                  output_data.jacobian_pushed_forward_2nd_derivatives.end(),
+                  Tensor<4, spacedim>());
+        std::fill(output_data.jacobian_3rd_derivatives.begin(),
+                  output_data.jacobian_3rd_derivatives.end(),
+                  DerivativeForm<4, dim, spacedim>());
+        std::fill(output_data.jacobian_pushed_forward_3rd_derivatives.begin(),
+                  output_data.jacobian_pushed_forward_3rd_derivatives.end(),
+                  Tensor<5, spacedim>());
+      }
     } // namespace
   }   // namespace MappingQGenericImplementation
 } // namespace internal
@@ -3277,21 +4299,39 @@ MappingQGeneric<dim, spacedim>::fill_fe_face_values(
     {
       data.mapping_support_points = this->compute_mapping_support_points(cell);
       data.cell_of_current_support_points = cell;
+      data.current_cell_is_affine =
+        (dim == spacedim &&
+         internal::MappingQGenericImplementation::compute_affine_jacobian(
+           data.mapping_support_points,
+           data.unit_support_points,
+           data.affine_jacobian));
     }
 
-  internal::MappingQGenericImplementation::do_fill_fe_face_values(
-    *this,
-    cell,
-    face_no,
-    numbers::invalid_unsigned_int,
+  const typename QProjector<dim>::DataSetDescriptor data_set =
     QProjector<dim>::DataSetDescriptor::face(face_no,
                                              cell->face_orientation(face_no),
                                              cell->face_flip(face_no),
                                              cell->face_rotation(face_no),
-                                             quadrature.size()),
-    quadrature,
-    data,
-    output_data);
+                                             quadrature.size());
+
+  if (data.current_cell_is_affine)
+    internal::MappingQGenericImplementation::do_fill_fe_face_values_affine(
+      face_no,
+      1.,
+      data_set,
+      quadrature,
+      data,
+      output_data);
+  else
+    internal::MappingQGenericImplementation::do_fill_fe_face_values(
+      *this,
+      cell,
+      face_no,
+      numbers::invalid_unsigned_int,
+      data_set,
+      quadrature,
+      data,
+      output_data);
 }
 
 
@@ -3323,23 +4363,42 @@ MappingQGeneric<dim, spacedim>::fill_fe_subface_values(
     {
       data.mapping_support_points = this->compute_mapping_support_points(cell);
       data.cell_of_current_support_points = cell;
+      data.current_cell_is_affine =
+        (dim == spacedim &&
+         internal::MappingQGenericImplementation::compute_affine_jacobian(
+           data.mapping_support_points,
+           data.unit_support_points,
+           data.affine_jacobian));
     }
 
-  internal::MappingQGenericImplementation::do_fill_fe_face_values(
-    *this,
-    cell,
-    face_no,
-    subface_no,
+  const typename QProjector<dim>::DataSetDescriptor data_set =
     QProjector<dim>::DataSetDescriptor::subface(face_no,
                                                 subface_no,
                                                 cell->face_orientation(face_no),
                                                 cell->face_flip(face_no),
                                                 cell->face_rotation(face_no),
                                                 quadrature.size(),
-                                                cell->subface_case(face_no)),
-    quadrature,
-    data,
-    output_data);
+                                                cell->subface_case(face_no));
+
+  if (data.current_cell_is_affine)
+    internal::MappingQGenericImplementation::do_fill_fe_face_values_affine(
+      face_no,
+      GeometryInfo<dim>::subface_ratio(cell->subface_case(face_no),
+                                       subface_no),
+      data_set,
+      quadrature,
+      data,
+      output_data);
+  else
+    internal::MappingQGenericImplementation::do_fill_fe_face_values(
+      *this,
+      cell,
+      face_no,
+      subface_no,
+      data_set,
+      quadrature,
+      data,
+      output_data);
 }
 
 
@@ -27,9 +27,17 @@
 
 #include <algorithm>
 #include <cctype>
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
 #include <fstream>
 #include <functional>
+#include <limits>
 #include <map>
+#include <sstream>
+#include <type_traits>
+#include <unordered_map>
 
 
 #ifdef DEAL_II_WITH_NETCDF
@@ -91,6 +99,205 @@ namespace
     // vertices except in 1d
     Assert(dim != 1, ExcInternalError());
   }
+
+
+
+  /**
+   * Parse the null-terminated string @p token as a number of the signed
+   * integral type @p T. Return whether the whole string was a number that
+   * fits into @p T.
+   */
+  template <typename T>
+  typename std::enable_if<std::is_integral<T>::value &&
+                            std::is_signed<T>::value,
+                          bool>::type
+  parse_ascii_number(const char *token, T &value)
+  {
+    char *end;
+    errno             = 0;
+    const long long v = std::strtoll(token, &end, 10);
+    if (errno != 0 || end == token || *end != '\0' ||
+        v < std::numeric_limits<T>::min() || v > std::numeric_limits<T>::max())
+      return false;
+    value = static_cast<T>(v);
+    return true;
+  }
+
+
+
+  /**
+   * Parse the null-terminated string @p token as a number of the unsigned
+   * integral type @p T. Return whether the whole string was a number that
+   * fits into @p T.
+   */
+  template <typename T>
+  typename std::enable_if<std::is_integral<T>::value &&
+                            !std::is_signed<T>::value,
+                          bool>::type
+  parse_ascii_number(const char *token, T &value)
+  {
+    char *end;
+    errno                      = 0;
+    const unsigned long long v = std::strtoull(token, &end, 10);
+    if (errno != 0 || end == token || *end != '\0' ||
+        v > std::numeric_limits<T>::max())
+      return false;
+    value = static_cast<T>(v);
+    return true;
+  }
+
+
+
+  /**
+   * Parse the null-terminated string @p token as a floating point number.
+   * Return whether the whole string was a number.
+   */
+  template <typename T>
+  typename std::enable_if<std::is_floating_point<T>::value, bool>::type
+  parse_ascii_number(const char *token, T &value)
+  {
+    char *end;
+    value = static_cast<T>(std::strtod(token, &end));
+    return (end != token && *end == '\0');
+  }
+
+
+
+  /**
+   * Read a whitespace-separated number of type @p T from the text in @p in.
+   * This does the same as <tt>in >> value</tt>, but takes the characters
+   * directly from the stream buffer and converts them with the C library
+   * functions, which avoids the locale handling of the stream operators and
+   * is several times faster for the large vertex and cell lists of mesh
+   * files. Like the stream operators, this sets the failbit of @p in if no
+   * number could be read, and the eofbit if the end of the input was
+   * reached.
+   */
+  template <typename T>
+  void
+  read_ascii_number(std::istream &in, T &value)
+  {
+    if (!in)
+      return;
+
+    std::streambuf &buffer = *in.rdbuf();
+    using traits           = std::char_traits<char>;
+
+    traits::int_type c = buffer.sgetc();
+    while (!traits::eq_int_type(c, traits::eof()) &&
+           std::isspace(traits::to_char_type(c)))
+      c = buffer.snextc();
+
+    // numbers in mesh files are never longer than this, so there is no need
+    // to handle longer tokens other than reporting them as invalid input
+    char         token[64];
+    unsigned int length = 0;
+    while (!traits::eq_int_type(c, traits::eof()) &&
+           !std::isspace(traits::to_char_type(c)) &&
+           length < sizeof(token) - 1)
+      {
+        token[length++] = traits::to_char_type(c);
+        c               = buffer.snextc();
+      }
+    token[length] = '\0';
+
+    if (traits::eq_int_type(c, traits::eof()))
+      in.setstate(std::ios::eofbit);
+    if (length == 0 || !parse_ascii_number(token, value))
+      in.setstate(std::ios::failbit);
+  }
+
+
+
+  /**
+   * Read an object of type @p T from the binary representation used in
+   * legacy VTK files. These always store data in big endian byte order, so
+   * the bytes have to be reversed on little endian machines.
+   */
+  template <typename T>
+  T
+  read_vtk_binary(std::istream &in)
+  {
+    char bytes[sizeof(T)];
+    in.read(bytes, sizeof(T));
+    AssertThrow(in, ExcIO());
+
+    const unsigned int one = 1;
+    if (*reinterpret_cast<const unsigned char *>(&one) == 1)
+      std::reverse(bytes, bytes + sizeof(T));
+
+    T value;
+    std::memcpy(&value, bytes, sizeof(T));
+    return value;
+  }
+
+
+
+  /**
+   * Read a number stored with the VTK data type @p type, such as
+   * <tt>int</tt> or <tt>double</tt>, from the binary representation used in
+   * legacy VTK files.
+   */
+  double
+  read_vtk_binary(std::istream &in, const std::string &type)
+  {
+    if (type == "double")
+      return read_vtk_binary<double>(in);
+    else if (type == "float")
+      return read_vtk_binary<float>(in);
+    else if (type == "int")
+      return read_vtk_binary<std::int32_t>(in);
+    else if (type == "unsigned_int")
+      return read_vtk_binary<std::uint32_t>(in);
+    else if (type == "short")
+      return read_vtk_binary<std::int16_t>(in);
+    else if (type == "unsigned_short")
+      return read_vtk_binary<std::uint16_t>(in);
+    else if (type == "char")
+      return read_vtk_binary<std::int8_t>(in);
+    else if (type == "unsigned_char")
+      return read_vtk_binary<std::uint8_t>(in);
+
+    AssertThrow(false,
+                ExcMessage("While reading VTK file, found binary data of the "
+                           "unsupported type <" +
+                           type + ">"));
+    return 0;
+  }
+
+
+
+  /**
+   * Read an object of type @p T from the binary representation used in
+   * binary Gmsh files. Gmsh writes these in the native byte order of the
+   * machine that created the file; read_msh() verifies that this matches
+   * the byte order of the current machine when reading the header.
+   */
+  template <typename T>
+  T
+  read_gmsh_binary(std::istream &in)
+  {
+    T value;
+    in.read(reinterpret_cast<char *>(&value), sizeof(T));
+    AssertThrow(in, ExcIO());
+    return value;
+  }
+
+
+
+  /**
+   * Read a number of type @p T from a Gmsh file, either in its text form or,
+   * if @p binary is set, in its binary representation.
+   */
+  template <typename T>
+  void
+  read_gmsh_number(std::istream &in, const bool binary, T &value)
+  {
+    if (binary)
+      value = read_gmsh_binary<T>(in);
+    else
+      read_ascii_number(in, value);
+  }
 } // namespace
 
 template <int dim, int spacedim>
@@ -115,10 +322,14 @@ GridIn<dim, spacedim>::read_vtk(std::istream &in)
 {
   std::string line;
 
+  // whether the data is stored in binary form instead of as text
+  bool binary = false;
+
   // verify that the first, third and fourth lines match
   // expectations. the second line of the file may essentially be
   // anything the author of the file chose to identify what's in
-  // there, so we just ensure that we can read it
+  // there, so we just ensure that we can read it. the third line
+  // may also announce binary data
   {
     std::string text[4];
     text[0] = "# vtk DataFile Version 3.0";
@@ -129,7 +340,9 @@ GridIn<dim, spacedim>::read_vtk(std::istream &in)
     for (unsigned int i = 0; i < 4; ++i)
       {
         getline(in, line);
-        if (i != 1)
+        if (i == 2 && line == "BINARY")
+          binary = true;
+        else if (i != 1)
           AssertThrow(
             line.compare(text[i]) == 0,
             ExcMessage(
@@ -139,6 +352,26 @@ GridIn<dim, spacedim>::read_vtk(std::istream &in)
       }
   }
 
+  // read an entry of the connectivity or the cell types, which binary files
+  // store as 32 bit integers
+  const auto read_int = [&in, &binary]() -> unsigned int {
+    if (binary)
+      return read_vtk_binary<std::int32_t>(in);
+    unsigned int value = 0;
+    read_ascii_number(in, value);
+    return value;
+  };
+
+  // read a number stored with the VTK data type 'type', which only matters
+  // for binary files
+  const auto read_value = [&in, &binary](const std::string &type) -> double {
+    if (binary)
+      return read_vtk_binary(in, type);
+    double value = 0;
+    read_ascii_number(in, value);
+    return value;
+  };
+
   ///////////////////Declaring storage and mappings//////////////////
 
   std::vector<Point<spacedim>> vertices;
@@ -156,13 +389,19 @@ GridIn<dim, spacedim>::read_vtk(std::istream &in)
       unsigned int n_vertices;
       in >> n_vertices;
 
-      in >> keyword; // float, double, int, char, etc.
+      std::string type;
+      in >> type; // float, double, int, char, etc.
+
+      // binary data starts right after the end of the line
+      if (binary)
+        in.get();
 
       for (unsigned int vertex = 0; vertex < n_vertices; ++vertex)
         {
           // VTK format always specifies vertex coordinates with 3 components
           Point<3> x;
-          in >> x(0) >> x(1) >> x(2);
+          for (unsigned int d = 0; d < 3; ++d)
+            x(d) = read_value(type);
 
           vertices.emplace_back();
           for (unsigned int d = 0; d < spacedim; ++d)
@@ -185,12 +424,14 @@ GridIn<dim, spacedim>::read_vtk(std::istream &in)
       in >> n_geometric_objects;
       in >> n_ints; // Ignore this, since we don't need it.
 
+      if (binary)
+        in.get();
+
       if (dim == 3)
         {
           for (unsigned int count = 0; count < n_geometric_objects; count++)
             {
-              unsigned int type;
-              in >> type;
+              const unsigned int type = read_int();
 
               if (type == 8)
                 {
@@ -203,7 +444,7 @@ GridIn<dim, spacedim>::read_vtk(std::istream &in)
                   cells.emplace_back();
 
                   for (unsigned int j = 0; j < type; j++) // loop to feed data
-                    in >> cells.back().vertices[j];
+                    cells.back().vertices[j] = read_int();
 
                   cells.back().material_id = 0;
                 }
@@ -219,7 +460,8 @@ GridIn<dim, spacedim>::read_vtk(std::istream &in)
 
                   for (unsigned int j = 0; j < type;
                        j++) // loop to feed the data to the boundary
-                    in >> subcelldata.boundary_quads.back().vertices[j];
+                    subcelldata.boundary_quads.back().vertices[j] =
+                      read_int();
 
                   subcelldata.boundary_quads.back().material_id = 0;
                 }
@@ -229,7 +471,8 @@ GridIn<dim, spacedim>::read_vtk(std::istream &in)
 
                   for (unsigned int j = 0; j < type;
                        j++) // loop to feed the data to the boundary
-                    in >> subcelldata.boundary_lines.back().vertices[j];
+                    subcelldata.boundary_lines.back().vertices[j] =
+                      read_int();
 
                   subcelldata.boundary_lines.back().material_id = 0;
                 }
@@ -246,8 +489,7 @@ GridIn<dim, spacedim>::read_vtk(std::istream &in)
         {
           for (unsigned int count = 0; count < n_geometric_objects; count++)
             {
-              unsigned int type;
-              in >> type;
+              const unsigned int type = read_int();
 
               if (type == 4)
                 {
@@ -259,7 +501,7 @@ GridIn<dim, spacedim>::read_vtk(std::istream &in)
                   cells.emplace_back();
 
                   for (unsigned int j = 0; j < type; j++) // loop to feed data
-                    in >> cells.back().vertices[j];
+                    cells.back().vertices[j] = read_int();
 
                   cells.back().material_id = 0;
                 }
@@ -273,7 +515,8 @@ GridIn<dim, spacedim>::read_vtk(std::istream &in)
                   for (unsigned int j = 0; j < type;
                        j++) // loop to feed the data to the boundary
                     {
-                      in >> subcelldata.boundary_lines.back().vertices[j];
+                      subcelldata.boundary_lines.back().vertices[j] =
+                        read_int();
                     }
 
                   subcelldata.boundary_lines.back().material_id = 0;
@@ -290,8 +533,7 @@ GridIn<dim, spacedim>::read_vtk(std::istream &in)
         {
           for (unsigned int count = 0; count < n_geometric_objects; count++)
             {
-              unsigned int type;
-              in >> type;
+              const unsigned int type = read_int();
 
               AssertThrow(
                 type == 2,
@@ -300,7 +542,7 @@ GridIn<dim, spacedim>::read_vtk(std::istream &in)
               cells.emplace_back();
 
               for (unsigned int j = 0; j < type; j++) // loop to feed data
-                in >> cells.back().vertices[j];
+                cells.back().vertices[j] = read_int();
 
               cells.back().material_id = 0;
             }
@@ -336,9 +578,10 @@ GridIn<dim, spacedim>::read_vtk(std::istream &in)
                    Utilities::int_to_string(subcelldata.boundary_lines.size()) +
                    ") in 2d."));
 
-      int tmp_int;
+      if (binary)
+        in.get();
       for (unsigned int i = 0; i < n_ints; ++i)
-        in >> tmp_int;
+        read_int();
 
       // Ignore everything up to CELL_DATA
       while (in >> keyword)
@@ -388,10 +631,12 @@ GridIn<dim, spacedim>::read_vtk(std::istream &in)
                         continue;
 
                       // Now we got somewhere. Proceed from here.
-                      // Ignore everything till the end of the line.
-                      // SCALARS MaterialID 1
+                      // Read the data type from the rest of the line.
+                      // SCALARS MaterialID int 1
                       // (the last number is optional)
-                      in.ignore(256, '\n');
+                      std::string type;
+                      getline(in, line);
+                      std::istringstream(line) >> type;
 
                       in >> keyword;
                       AssertThrow(
@@ -405,6 +650,9 @@ GridIn<dim, spacedim>::read_vtk(std::istream &in)
                         ExcMessage(
                           "While reading VTK file, missing keyword default"));
 
+                      if (binary)
+                        in.get();
+
                       // read material or manifold ids first for all cells,
                       // then for all faces, and finally for all lines. the
                       // assumption that cells come before all faces and
@@ -412,8 +660,7 @@ GridIn<dim, spacedim>::read_vtk(std::istream &in)
                       // the order used in the following blocks makes sense
                       for (unsigned int i = 0; i < cells.size(); i++)
                         {
-                          double id;
-                          in >> id;
+                          const double id = read_value(type);
                           if (set == "MaterialID")
                             cells[i].material_id =
                               static_cast<types::material_id>(id);
@@ -428,8 +675,7 @@ GridIn<dim, spacedim>::read_vtk(std::istream &in)
                         {
                           for (auto &boundary_quad : subcelldata.boundary_quads)
                             {
-                              double id;
-                              in >> id;
+                              const double id = read_value(type);
                               if (set == "MaterialID")
                                 boundary_quad.material_id =
                                   static_cast<types::material_id>(id);
@@ -441,8 +687,7 @@ GridIn<dim, spacedim>::read_vtk(std::istream &in)
                             }
                           for (auto &boundary_line : subcelldata.boundary_lines)
                             {
-                              double id;
-                              in >> id;
+                              const double id = read_value(type);
                               if (set == "MaterialID")
                                 boundary_line.material_id =
                                   static_cast<types::material_id>(id);
@@ -457,8 +702,7 @@ GridIn<dim, spacedim>::read_vtk(std::istream &in)
                         {
                           for (auto &boundary_line : subcelldata.boundary_lines)
                             {
-                              double id;
-                              in >> id;
+                              const double id = read_value(type);
                               if (set == "MaterialID")
                                 boundary_line.material_id =
                                   static_cast<types::material_id>(id);
@@ -1415,6 +1659,21 @@ GridIn<dim, spacedim>::read_msh(std::istream &in)
   // points, curves, surfaces and volumes. We use this information later to
   // assign boundary ids.
   std::array<std::map<int, int>, 4> tag_maps;
+  // Whether the file is stored in the binary variant of the format. This is
+  // only supported for version 4.1, in which all node and element tags as
+  // well as counts are stored as std::size_t and all entity information as
+  // int.
+  bool binary = false;
+
+  // read a node or element tag or a count of objects. in binary files, these
+  // are stored as std::size_t
+  const auto read_tag = [&in, &binary]() -> unsigned long {
+    if (binary)
+      return read_gmsh_binary<std::size_t>(in);
+    unsigned long value = 0;
+    read_ascii_number(in, value);
+    return value;
+  };
 
   in >> line;
 
@@ -1439,9 +1698,25 @@ GridIn<dim, spacedim>::read_msh(std::istream &in)
       Assert((version >= 2.0) && (version <= 4.1), ExcNotImplemented());
       gmsh_file_format = static_cast<unsigned int>(version * 10);
 
-      Assert(file_type == 0, ExcNotImplemented());
+      AssertThrow(file_type == 0 || (file_type == 1 && gmsh_file_format == 41),
+                  ExcMessage("Binary Gmsh files are only supported for "
+                             "version 4.1 of the file format."));
       Assert(data_size == sizeof(double), ExcNotImplemented());
 
+      if (file_type == 1)
+        {
+          binary = true;
+
+          // skip the end of the line and read the integer one that Gmsh
+          // writes in binary form to allow detecting the byte order
+          in.get();
+          const int one = read_gmsh_binary<int>(in);
+          AssertThrow(one == 1,
+                      ExcMessage("The binary Gmsh file has been written on a "
+                                 "machine with a different byte order, which "
+                                 "is not supported."));
+        }
+
       // read the end of the header and the first line of the nodes description
       // to synch ourselves with the format 1 handling above
       in >> line;
@@ -1459,8 +1734,45 @@ GridIn<dim, spacedim>::read_msh(std::istream &in)
           in >> line;
         }
 
-      // if the next block is of kind $Entities, parse it
-      if (line == "$Entities")
+      // if the next block is of kind $Entities, parse it. in binary files,
+      // each entity is stored as its tag, its bounding box (only a point for
+      // points), its physical tags, and the tags of the entities bounding it
+      if (line == "$Entities" && binary)
+        {
+          in.get();
+          std::array<std::size_t, 4> n_entities;
+          for (std::size_t &n : n_entities)
+            n = read_gmsh_binary<std::size_t>(in);
+
+          for (unsigned int entity_dim = 0; entity_dim < 4; ++entity_dim)
+            for (std::size_t i = 0; i < n_entities[entity_dim]; ++i)
+              {
+                const int tag = read_gmsh_binary<int>(in);
+                for (unsigned int d = 0; d < (entity_dim == 0 ? 3 : 6); ++d)
+                  read_gmsh_binary<double>(in);
+
+                const std::size_t n_physicals =
+                  read_gmsh_binary<std::size_t>(in);
+                AssertThrow(n_physicals < 2,
+                            ExcMessage("More than one tag is not supported!"));
+                int physical_tag = 0;
+                for (std::size_t j = 0; j < n_physicals; ++j)
+                  physical_tag = read_gmsh_binary<int>(in);
+                tag_maps[entity_dim][tag] = physical_tag;
+
+                if (entity_dim > 0)
+                  {
+                    const std::size_t n_bounding =
+                      read_gmsh_binary<std::size_t>(in);
+                    for (std::size_t j = 0; j < n_bounding; ++j)
+                      read_gmsh_binary<int>(in);
+                  }
+              }
+          in >> line;
+          AssertThrow(line == "$EndEntities", ExcInvalidGMSHInput(line));
+          in >> line;
+        }
+      else if (line == "$Entities")
         {
           unsigned long n_points, n_curves, n_surfaces, n_volumes;
 
@@ -1580,6 +1892,9 @@ GridIn<dim, spacedim>::read_msh(std::istream &in)
       // if the next block is of kind $PartitionedEntities, ignore it
       if (line == "$PartitionedEntities")
         {
+          AssertThrow(binary == false,
+                      ExcMessage("Partitioned binary Gmsh files are not "
+                                 "supported."));
           do
             {
               in >> line;
@@ -1596,11 +1911,15 @@ GridIn<dim, spacedim>::read_msh(std::istream &in)
 
   // now read the nodes list
   int n_entity_blocks = 1;
+  if (binary)
+    in.get();
   if (gmsh_file_format > 40)
     {
-      int min_node_tag;
-      int max_node_tag;
-      in >> n_entity_blocks >> n_vertices >> min_node_tag >> max_node_tag;
+      n_entity_blocks = read_tag();
+      n_vertices      = read_tag();
+      // skip the minimal and maximal node tag
+      read_tag();
+      read_tag();
     }
   else if (gmsh_file_format == 40)
     {
@@ -1611,8 +1930,12 @@ GridIn<dim, spacedim>::read_msh(std::istream &in)
   std::vector<Point<spacedim>> vertices(n_vertices);
   // set up mapping between numbering
   // in msh-file (nod) and in the
-  // vertices vector
-  std::map<int, int> vertex_indices;
+  // vertices vector. we only ever look up
+  // individual entries, so a hash map
+  // is much cheaper than a sorted map for
+  // large meshes
+  std::unordered_map<int, int> vertex_indices;
+  vertex_indices.reserve(n_vertices);
 
   {
     unsigned int global_vertex = 0;
@@ -1631,19 +1954,21 @@ GridIn<dim, spacedim>::read_msh(std::istream &in)
             // for gmsh_file_format 4.1 the order of tag and dim is reversed,
             // but we are ignoring both anyway.
             int tagEntity, dimEntity;
-            in >> tagEntity >> dimEntity >> parametric >> numNodes;
+            read_gmsh_number(in, binary, tagEntity);
+            read_gmsh_number(in, binary, dimEntity);
+            read_gmsh_number(in, binary, parametric);
+            numNodes = read_tag();
           }
 
         std::vector<int> vertex_numbers;
-        int              vertex_number;
         if (gmsh_file_format > 40)
-          for (unsigned long vertex_per_entity = 0;
-               vertex_per_entity < numNodes;
-               ++vertex_per_entity)
-            {
-              in >> vertex_number;
-              vertex_numbers.push_back(vertex_number);
-            }
+          {
+            vertex_numbers.resize(numNodes);
+            for (unsigned long vertex_per_entity = 0;
+                 vertex_per_entity < numNodes;
+                 ++vertex_per_entity)
+              vertex_numbers[vertex_per_entity] = read_tag();
+          }
 
         for (unsigned long vertex_per_entity = 0; vertex_per_entity < numNodes;
              ++vertex_per_entity, ++global_vertex)
@@ -1655,10 +1980,15 @@ GridIn<dim, spacedim>::read_msh(std::istream &in)
             if (gmsh_file_format > 40)
               {
                 vertex_number = vertex_numbers[vertex_per_entity];
-                in >> x[0] >> x[1] >> x[2];
+                for (double &x_d : x)
+                  read_gmsh_number(in, binary, x_d);
               }
             else
-              in >> vertex_number >> x[0] >> x[1] >> x[2];
+              {
+                read_ascii_number(in, vertex_number);
+                for (double &x_d : x)
+                  read_ascii_number(in, x_d);
+              }
 
             for (unsigned int d = 0; d < spacedim; ++d)
               vertices[global_vertex](d) = x[d];
@@ -1670,7 +2000,8 @@ GridIn<dim, spacedim>::read_msh(std::istream &in)
               {
                 double u = 0.;
                 double v = 0.;
-                in >> u >> v;
+                read_gmsh_number(in, binary, u);
+                read_gmsh_number(in, binary, v);
                 (void)u;
                 (void)v;
               }
@@ -1692,11 +2023,15 @@ GridIn<dim, spacedim>::read_msh(std::istream &in)
               ExcInvalidGMSHInput(line));
 
   // now read the cell list
+  if (binary)
+    in.get();
   if (gmsh_file_format > 40)
     {
-      int min_node_tag;
-      int max_node_tag;
-      in >> n_entity_blocks >> n_cells >> min_node_tag >> max_node_tag;
+      n_entity_blocks = read_tag();
+      n_cells         = read_tag();
+      // skip the minimal and maximal element tag
+      read_tag();
+      read_tag();
     }
   else if (gmsh_file_format == 40)
     {
@@ -1732,14 +2067,20 @@ GridIn<dim, spacedim>::read_msh(std::istream &in)
         else if (gmsh_file_format == 40)
           {
             int tagEntity, dimEntity;
-            in >> tagEntity >> dimEntity >> cell_type >> numElements;
+            read_ascii_number(in, tagEntity);
+            read_ascii_number(in, dimEntity);
+            read_ascii_number(in, cell_type);
+            read_ascii_number(in, numElements);
             material_id = tag_maps[dimEntity][tagEntity];
           }
         else
           {
             // for gmsh_file_format 4.1 the order of tag and dim is reversed,
             int tagEntity, dimEntity;
-            in >> dimEntity >> tagEntity >> cell_type >> numElements;
+            read_gmsh_number(in, binary, dimEntity);
+            read_gmsh_number(in, binary, tagEntity);
+            read_gmsh_number(in, binary, cell_type);
+            numElements = read_tag();
             material_id = tag_maps[dimEntity][tagEntity];
           }
 
@@ -1776,38 +2117,37 @@ GridIn<dim, spacedim>::read_msh(std::istream &in)
             unsigned int elm_number = 0;
             if (gmsh_file_format < 40)
               {
-                in >> elm_number // ELM-NUMBER
-                  >> cell_type;  // ELM-TYPE
+                read_ascii_number(in, elm_number); // ELM-NUMBER
+                read_ascii_number(in, cell_type);  // ELM-TYPE
               }
 
             if (gmsh_file_format < 20)
               {
-                in >> material_id // REG-PHYS
-                  >> dummy        // reg_elm
-                  >> nod_num;
+                read_ascii_number(in, material_id); // REG-PHYS
+                read_ascii_number(in, dummy);       // reg_elm
+                read_ascii_number(in, nod_num);
               }
             else if (gmsh_file_format < 40)
               {
                 // read the tags; ignore all but the first one which we will
                 // interpret as the material_id (for cells) or boundary_id
                 // (for faces)
-                unsigned int n_tags;
-                in >> n_tags;
+                unsigned int n_tags = 0;
+                read_ascii_number(in, n_tags);
                 if (n_tags > 0)
-                  in >> material_id;
+                  read_ascii_number(in, material_id);
                 else
                   material_id = 0;
 
                 for (unsigned int i = 1; i < n_tags; ++i)
-                  in >> dummy;
+                  read_ascii_number(in, dummy);
 
                 nod_num = GeometryInfo<dim>::vertices_per_cell;
               }
             else
               {
                 // ignore tag
-                int tag;
-                in >> tag;
+                read_tag();
                 nod_num = GeometryInfo<dim>::vertices_per_cell;
               }
 
@@ -1842,7 +2182,7 @@ GridIn<dim, spacedim>::read_msh(std::istream &in)
                 for (unsigned int i = 0;
                      i < GeometryInfo<dim>::vertices_per_cell;
                      ++i)
-                  in >> cells.back().vertices[i];
+                  cells.back().vertices[i] = read_tag();
 
                 // to make sure that the cast won't fail
                 Assert(material_id <=
@@ -1883,8 +2223,9 @@ GridIn<dim, spacedim>::read_msh(std::istream &in)
               // boundary info
               {
                 subcelldata.boundary_lines.emplace_back();
-                in >> subcelldata.boundary_lines.back().vertices[0] >>
-                  subcelldata.boundary_lines.back().vertices[1];
+                for (unsigned int &vertex :
+                     subcelldata.boundary_lines.back().vertices)
+                  vertex = read_tag();
 
                 // to make sure that the cast won't fail
                 Assert(material_id <=
@@ -1923,10 +2264,9 @@ GridIn<dim, spacedim>::read_msh(std::istream &in)
               // boundary info
               {
                 subcelldata.boundary_quads.emplace_back();
-                in >> subcelldata.boundary_quads.back().vertices[0] >>
-                  subcelldata.boundary_quads.back().vertices[1] >>
-                  subcelldata.boundary_quads.back().vertices[2] >>
-                  subcelldata.boundary_quads.back().vertices[3];
+                for (unsigned int &vertex :
+                     subcelldata.boundary_quads.back().vertices)
+                  vertex = read_tag();
 
                 // to make sure that the cast won't fail
                 Assert(material_id <=
@@ -1967,11 +2307,11 @@ GridIn<dim, spacedim>::read_msh(std::istream &in)
                 if (gmsh_file_format < 20)
                   {
                     for (unsigned int i = 0; i < nod_num; ++i)
-                      in >> node_index;
+                      read_ascii_number(in, node_index);
                   }
                 else
                   {
-                    in >> node_index;
+                    node_index = read_tag();
                   }
 
                 // we only care about boundary indicators assigned to individual
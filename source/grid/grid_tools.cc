@@ -5358,6 +5358,146 @@ namespace GridTools
                                          used_vertices_rtree);
   }
 
+
+
+  template <int dim, int spacedim>
+#ifndef DOXYGEN
+  std::vector<
+    std::pair<typename Triangulation<dim, spacedim>::active_cell_iterator,
+              Point<dim>>>
+#else
+  return_type
+#endif
+  find_active_cells_around_points(
+    const Cache<dim, spacedim> &        cache,
+    const std::vector<Point<spacedim>> &points,
+    const std::vector<
+      typename Triangulation<dim, spacedim>::active_cell_iterator>
+      &          cell_hints,
+    const double tolerance)
+  {
+    using active_cell_iterator =
+      typename Triangulation<dim, spacedim>::active_cell_iterator;
+
+    Assert(cell_hints.empty() || cell_hints.size() == points.size(),
+           ExcDimensionMismatch(cell_hints.size(), points.size()));
+
+    const Mapping<dim, spacedim> &mapping = cache.get_mapping();
+
+    std::vector<std::pair<active_cell_iterator, Point<dim>>> cells_and_points(
+      points.size());
+
+    // check whether the given cell contains point i and, if so, store the
+    // cell and the reference coordinates of the point
+    const auto point_in_cell = [&](const active_cell_iterator &cell,
+                                   const unsigned int          i) -> bool {
+      try
+        {
+          const Point<dim> p_unit =
+            mapping.transform_real_to_unit_cell(cell, points[i]);
+          if (GeometryInfo<dim>::is_inside_unit_cell(p_unit, tolerance))
+            {
+              cells_and_points[i] = std::make_pair(cell, p_unit);
+              return true;
+            }
+        }
+      catch (const typename Mapping<dim, spacedim>::ExcTransformationFailed &)
+        {}
+      return false;
+    };
+
+    // process the points grouped by their hint cell. we sort by level and
+    // index of the cells rather than by the cell iterators because the
+    // latter can not be compared if they are invalid
+    const auto cell_key = [&](const unsigned int i) {
+      return (cell_hints.empty() ||
+              cell_hints[i].state() != IteratorState::valid) ?
+               std::make_pair(-1, -1) :
+               std::make_pair(cell_hints[i]->level(), cell_hints[i]->index());
+    };
+    std::vector<unsigned int> permutation(points.size());
+    std::iota(permutation.begin(), permutation.end(), 0U);
+    if (!cell_hints.empty())
+      std::stable_sort(permutation.begin(),
+                       permutation.end(),
+                       [&](const unsigned int a, const unsigned int b) {
+                         return cell_key(a) < cell_key(b);
+                       });
+
+    std::vector<Point<spacedim>> hint_real_points;
+    std::vector<Point<dim>>      hint_unit_points;
+    for (unsigned int begin = 0; begin < permutation.size();)
+      {
+        const active_cell_iterator cell_hint =
+          cell_hints.empty() ? active_cell_iterator() :
+                               cell_hints[permutation[begin]];
+
+        unsigned int end = begin + 1;
+        if (cell_hint.state() == IteratorState::valid)
+          while (end < permutation.size() &&
+                 cell_key(permutation[end]) == cell_key(permutation[begin]))
+            ++end;
+
+        // transform all points with the same hint cell at once, which lets
+        // the mapping share the work that only depends on the cell
+        if (cell_hint.state() == IteratorState::valid)
+          {
+            hint_real_points.resize(end - begin);
+            hint_unit_points.resize(end - begin);
+            for (unsigned int k = begin; k < end; ++k)
+              hint_real_points[k - begin] = points[permutation[k]];
+            mapping.transform_points_real_to_unit_cell(
+              cell_hint,
+              make_array_view(hint_real_points),
+              make_array_view(hint_unit_points));
+          }
+
+        for (unsigned int k = begin; k < end; ++k)
+          {
+            const unsigned int i = permutation[k];
+
+            if (cell_hint.state() == IteratorState::valid)
+              {
+                if (GeometryInfo<dim>::is_inside_unit_cell(
+                      hint_unit_points[k - begin], tolerance))
+                  {
+                    cells_and_points[i] =
+                      std::make_pair(cell_hint, hint_unit_points[k - begin]);
+                    continue;
+                  }
+
+                // most points that left their cell have moved into one of
+                // the face neighbors
+                bool found = false;
+                for (unsigned int f = 0;
+                     f < GeometryInfo<dim>::faces_per_cell && !found;
+                     ++f)
+                  if (!cell_hint->at_boundary(f) &&
+                      cell_hint->neighbor(f)->active() &&
+                      !cell_hint->neighbor(f)->is_artificial())
+                    found = point_in_cell(cell_hint->neighbor(f), i);
+                if (found)
+                  continue;
+              }
+
+            // fall back to the general search using the cache
+            try
+              {
+                cells_and_points[i] =
+                  find_active_cell_around_point(cache, points[i], cell_hint);
+              }
+            catch (const ExcPointNotFound<spacedim> &)
+              {
+                cells_and_points[i].first = active_cell_iterator();
+              }
+          }
+
+        begin = end;
+      }
+
+    return cells_and_points;
+  }
+
   template <int spacedim>
   std::vector<std::vector<BoundingBox<spacedim>>>
   exchange_local_bounding_boxes(
@@ -26,24 +26,67 @@ DEAL_II_NAMESPACE_OPEN
 
 namespace GridTools
 {
+  namespace
+  {
+    /**
+     * The objects of the Cache class that can be updated incrementally
+     * after a refinement step.
+     */
+    const CacheUpdateFlags incremental_update_flags =
+      update_vertex_to_cell_map | update_used_vertices |
+      update_used_vertices_rtree | update_cell_bounding_boxes_rtree;
+  } // namespace
+
+
+
   template <int dim, int spacedim>
   Cache<dim, spacedim>::Cache(const Triangulation<dim, spacedim> &tria,
                               const Mapping<dim, spacedim> &      mapping)
     : update_flags(update_all)
     , tria(&tria)
     , mapping(&mapping)
+    , refinement_in_progress(false)
+    , n_full_updates_counter(0)
+    , n_incremental_updates_counter(0)
   {
-    tria_signal =
-      tria.signals.any_change.connect([&]() { mark_for_update(update_all); });
+    tria_signals.push_back(
+      tria.signals.pre_refinement.connect([&]() {
+        refinement_in_progress = true;
+      }));
+    tria_signals.push_back(tria.signals.pre_coarsening_on_cell.connect(
+      [&](const typename Triangulation<dim, spacedim>::cell_iterator &cell) {
+        for (unsigned int c = 0; c < cell->n_children(); ++c)
+          record_removed_cell(cell->child(c));
+        record_added_cell(cell);
+      }));
+    tria_signals.push_back(tria.signals.post_refinement_on_cell.connect(
+      [&](const typename Triangulation<dim, spacedim>::cell_iterator &cell) {
+        record_removed_cell(cell);
+        for (unsigned int c = 0; c < cell->n_children(); ++c)
+          record_added_cell(cell->child(c));
+      }));
+    tria_signals.push_back(tria.signals.any_change.connect([&]() {
+      if (refinement_in_progress && records_changes())
+        // everything that cannot be updated incrementally has to be
+        // recomputed. the vertex to cell center directions are marked
+        // without the vertex to cell map they depend on
+        mark_for_update(update_vertex_kdtree | update_covering_rtree |
+                        (update_vertex_to_cell_centers_directions &
+                         ~update_vertex_to_cell_map));
+      else
+        mark_for_update(update_all);
+      refinement_in_progress = false;
+    }));
   }
 
   template <int dim, int spacedim>
   Cache<dim, spacedim>::~Cache()
   {
-    // Make sure that the signals that was attached to the triangulation
-    // is removed here.
-    if (tria_signal.connected())
-      tria_signal.disconnect();
+    // Make sure that the signals that were attached to the triangulation
+    // are removed here.
+    for (auto &connection : tria_signals)
+      if (connection.connected())
+        connection.disconnect();
   }
 
 
@@ -53,6 +96,243 @@ namespace GridTools
   Cache<dim, spacedim>::mark_for_update(const CacheUpdateFlags &flags)
   {
     update_flags |= flags;
+
+    // recorded changes are of no use if all objects they could be applied
+    // to are recomputed anyway
+    if ((update_flags & incremental_update_flags) == incremental_update_flags)
+      {
+        added_cells.clear();
+        removed_cells.clear();
+        removed_cell_boxes.clear();
+        affected_vertices.clear();
+      }
+  }
+
+
+
+  template <int dim, int spacedim>
+  bool
+  Cache<dim, spacedim>::records_changes() const
+  {
+    return (update_flags & incremental_update_flags) !=
+             incremental_update_flags &&
+           mapping->preserves_vertex_locations();
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  Cache<dim, spacedim>::record_removed_cell(
+    const typename Triangulation<dim, spacedim>::cell_iterator &cell)
+  {
+    if (!records_changes())
+      return;
+
+    const std::pair<int, int> key(cell->level(), cell->index());
+
+    // a cell that has been added since the last update is not stored in any
+    // of the objects yet
+    if (added_cells.erase(key) == 0 &&
+        !(update_flags & update_cell_bounding_boxes_rtree))
+      removed_cell_boxes.emplace_back(mapping->get_bounding_box(cell), key);
+    removed_cells.insert(key);
+
+    for (unsigned int v = 0; v < GeometryInfo<dim>::vertices_per_cell; ++v)
+      affected_vertices.push_back(cell->vertex_index(v));
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  Cache<dim, spacedim>::record_added_cell(
+    const typename Triangulation<dim, spacedim>::cell_iterator &cell)
+  {
+    if (records_changes())
+      added_cells.emplace(cell->level(), cell->index());
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  Cache<dim, spacedim>::apply_recorded_changes() const
+  {
+    if (added_cells.empty() && removed_cells.empty())
+      return;
+
+    using active_cell_iterator =
+      typename Triangulation<dim, spacedim>::active_cell_iterator;
+
+    std::vector<active_cell_iterator> new_cells;
+    new_cells.reserve(added_cells.size());
+    for (const auto &key : added_cells)
+      new_cells.emplace_back(&*tria, key.first, key.second);
+
+    // collect the vertices whose entries may have changed, without
+    // duplicates
+    std::vector<bool>         is_affected(tria->n_vertices(), false);
+    std::vector<unsigned int> vertices;
+    const auto                add_vertex = [&](const unsigned int v) {
+      if (v >= is_affected.size())
+        is_affected.resize(v + 1, false);
+      if (is_affected[v] == false)
+        {
+          is_affected[v] = true;
+          vertices.push_back(v);
+        }
+    };
+    for (const unsigned int v : affected_vertices)
+      add_vertex(v);
+    for (const auto &cell : new_cells)
+      for (unsigned int v = 0; v < GeometryInfo<dim>::vertices_per_cell; ++v)
+        add_vertex(cell->vertex_index(v));
+
+    bool updated = false;
+
+    if (!(update_flags & update_cell_bounding_boxes_rtree))
+      {
+        namespace bgi = boost::geometry::index;
+        using value_type = std::pair<BoundingBox<spacedim>, active_cell_iterator>;
+
+        // the iterators stored for removed cells may no longer point to
+        // valid cells, so find their entries through the stored bounding
+        // boxes and compare only level and index
+        for (const auto &box_and_key : removed_cell_boxes)
+          {
+            std::vector<value_type> entries;
+            cell_bounding_boxes_rtree.query(
+              bgi::intersects(box_and_key.first) &&
+                bgi::satisfies([&](const value_type &entry) {
+                  return entry.second->level() == box_and_key.second.first &&
+                         entry.second->index() == box_and_key.second.second;
+                }),
+              std::back_inserter(entries));
+            Assert(entries.size() == 1, ExcInternalError());
+            for (const auto &entry : entries)
+              cell_bounding_boxes_rtree.remove(entry);
+          }
+
+        for (const auto &cell : new_cells)
+          cell_bounding_boxes_rtree.insert(
+            std::make_pair(mapping->get_bounding_box(cell), cell));
+
+        updated = true;
+      }
+
+    if (!(update_flags & update_vertex_to_cell_map))
+      {
+        vertex_to_cells.resize(tria->n_vertices());
+
+        // every cell that contributes to the entry of an affected vertex is
+        // either new or was already stored in the entry of one of the
+        // affected vertices before the change
+        std::set<active_cell_iterator> cells(new_cells.begin(),
+                                             new_cells.end());
+        for (const unsigned int v : vertices)
+          if (v < vertex_to_cells.size())
+            {
+              for (const auto &cell : vertex_to_cells[v])
+                if (removed_cells.find(std::make_pair(cell->level(),
+                                                      cell->index())) ==
+                    removed_cells.end())
+                  cells.insert(cell);
+              vertex_to_cells[v].clear();
+            }
+
+        // now redo what GridTools::vertex_to_cell_map() does for these
+        // cells, restricted to the affected vertices
+        const auto insert = [&](const unsigned int        v,
+                                const active_cell_iterator &cell) {
+          if (v < is_affected.size() && is_affected[v])
+            vertex_to_cells[v].insert(cell);
+        };
+        for (const auto &cell : cells)
+          {
+            for (unsigned int v = 0; v < GeometryInfo<dim>::vertices_per_cell;
+                 ++v)
+              insert(cell->vertex_index(v), cell);
+
+            for (unsigned int f = 0; f < GeometryInfo<dim>::faces_per_cell; ++f)
+              if ((cell->at_boundary(f) == false) &&
+                  (cell->neighbor(f)->active()))
+                for (unsigned int v = 0;
+                     v < GeometryInfo<dim>::vertices_per_face;
+                     ++v)
+                  insert(cell->face(f)->vertex_index(v), cell->neighbor(f));
+
+            if (dim == 3)
+              for (unsigned int l = 0; l < GeometryInfo<dim>::lines_per_cell;
+                   ++l)
+                if (cell->line(l)->has_children())
+                  insert(cell->line(l)->child(0)->vertex_index(1), cell);
+          }
+
+        updated = true;
+      }
+
+    if (!(update_flags & update_used_vertices))
+      {
+        const bool update_rtree = !(update_flags & update_used_vertices_rtree);
+
+        for (const unsigned int v : vertices)
+          if (tria->vertex_used(v) == false)
+            {
+              const auto entry = used_vertices.find(v);
+              if (entry != used_vertices.end())
+                {
+                  if (update_rtree)
+                    used_vertices_rtree.remove(std::make_pair(entry->second, v));
+                  used_vertices.erase(entry);
+                }
+            }
+
+        // new vertices (possibly reusing the index of a vertex that has been
+        // removed) are always vertices of new cells
+        for (const auto &cell : new_cells)
+          {
+            const auto cell_vertices = mapping->get_vertices(cell);
+            for (unsigned int i = 0; i < GeometryInfo<dim>::vertices_per_cell;
+                 ++i)
+              {
+                const unsigned int v     = cell->vertex_index(i);
+                const auto         entry = used_vertices.find(v);
+                if (entry == used_vertices.end())
+                  {
+                    used_vertices.emplace(v, cell_vertices[i]);
+                    if (update_rtree)
+                      used_vertices_rtree.insert(
+                        std::make_pair(cell_vertices[i], v));
+                  }
+                else if (entry->second != cell_vertices[i])
+                  {
+                    if (update_rtree)
+                      {
+                        used_vertices_rtree.remove(
+                          std::make_pair(entry->second, v));
+                        used_vertices_rtree.insert(
+                          std::make_pair(cell_vertices[i], v));
+                      }
+                    entry->second = cell_vertices[i];
+                  }
+              }
+          }
+
+        updated = true;
+      }
+    else
+      // the rtree cannot be updated without the old positions of the
+      // vertices
+      update_flags |= update_used_vertices_rtree;
+
+    if (updated)
+      ++n_incremental_updates_counter;
+
+    added_cells.clear();
+    removed_cells.clear();
+    removed_cell_boxes.clear();
+    affected_vertices.clear();
   }
 
 
@@ -62,10 +342,12 @@ namespace GridTools
     std::set<typename Triangulation<dim, spacedim>::active_cell_iterator>> &
   Cache<dim, spacedim>::get_vertex_to_cell_map() const
   {
+    apply_recorded_changes();
     if (update_flags & update_vertex_to_cell_map)
       {
         vertex_to_cells = GridTools::vertex_to_cell_map(*tria);
         update_flags    = update_flags & ~update_vertex_to_cell_map;
+        ++n_full_updates_counter;
       }
     return vertex_to_cells;
   }
@@ -91,10 +373,12 @@ namespace GridTools
   const std::map<unsigned int, Point<spacedim>> &
   Cache<dim, spacedim>::get_used_vertices() const
   {
+    apply_recorded_changes();
     if (update_flags & update_used_vertices)
       {
         used_vertices = GridTools::extract_used_vertices(*tria, *mapping);
         update_flags  = update_flags & ~update_used_vertices;
+        ++n_full_updates_counter;
       }
     return used_vertices;
   }
@@ -105,6 +389,7 @@ namespace GridTools
   const RTree<std::pair<Point<spacedim>, unsigned int>> &
   Cache<dim, spacedim>::get_used_vertices_rtree() const
   {
+    apply_recorded_changes();
     if (update_flags & update_used_vertices_rtree)
       {
         const auto &used_vertices = get_used_vertices();
@@ -114,6 +399,8 @@ namespace GridTools
         for (const auto &it : used_vertices)
           vertices[i++] = std::make_pair(it.second, it.first);
         used_vertices_rtree = pack_rtree(vertices);
+        update_flags        = update_flags & ~update_used_vertices_rtree;
+        ++n_full_updates_counter;
       }
     return used_vertices_rtree;
   }
@@ -126,6 +413,7 @@ namespace GridTools
               typename Triangulation<dim, spacedim>::active_cell_iterator>> &
   Cache<dim, spacedim>::get_cell_bounding_boxes_rtree() const
   {
+    apply_recorded_changes();
     if (update_flags & update_cell_bounding_boxes_rtree)
       {
         std::vector<std::pair<
@@ -137,6 +425,8 @@ namespace GridTools
           boxes[i++] = std::make_pair(mapping->get_bounding_box(cell), cell);
 
         cell_bounding_boxes_rtree = pack_rtree(boxes);
+        update_flags = update_flags & ~update_cell_bounding_boxes_rtree;
+        ++n_full_updates_counter;
       }
     return cell_bounding_boxes_rtree;
   }
@@ -198,6 +488,24 @@ namespace GridTools
     return covering_rtree;
   }
 
+
+
+  template <int dim, int spacedim>
+  unsigned int
+  Cache<dim, spacedim>::n_full_updates() const
+  {
+    return n_full_updates_counter;
+  }
+
+
+
+  template <int dim, int spacedim>
+  unsigned int
+  Cache<dim, spacedim>::n_incremental_updates() const
+  {
+    return n_incremental_updates_counter;
+  }
+
 #include "grid_tools_cache.inst"
 
 } // namespace GridTools
@@ -14,9 +14,13 @@
 // ---------------------------------------------------------------------
 
 
+#include <deal.II/base/flat_binary_archive.h>
 #include <deal.II/base/geometry_info.h>
 #include <deal.II/base/memory_consumption.h>
+#include <deal.II/base/parallel.h>
 #include <deal.II/base/std_cxx14/memory.h>
+#include <deal.II/base/thread_management.h>
+#include <deal.II/base/utilities.h>
 
 #include <deal.II/fe/mapping_q1.h>
 
@@ -39,6 +43,7 @@
 #include <list>
 #include <map>
 #include <numeric>
+#include <tuple>
 
 
 DEAL_II_NAMESPACE_OPEN
@@ -898,16 +903,38 @@ namespace
     // have to use the opposite of the
     // left_right_offset in this case as we want
     // the offset of the neighbor, not our own.
-    for (cell = triangulation.begin(); cell != endc; ++cell)
-      for (unsigned int f = 0; f < GeometryInfo<dim>::faces_per_cell; ++f)
-        {
-          const unsigned int offset =
-            (cell->direction_flag() ?
-               left_right_offset[dim - 2][f][cell->face_orientation(f)] :
-               1 - left_right_offset[dim - 2][f][cell->face_orientation(f)]);
-          cell->set_neighbor(
-            f, adjacent_cells[2 * cell->face(f)->index() + 1 - offset]);
-        }
+    //
+    // in contrast to the loop above, every cell
+    // only writes its own neighbor entries here,
+    // so we can work on chunks of cells of each
+    // level in parallel
+    for (unsigned int level = 0; level < triangulation.n_levels(); ++level)
+      parallel::apply_to_subranges(
+        0U,
+        triangulation.n_raw_cells(level),
+        [&](const unsigned int begin, const unsigned int end) {
+          for (unsigned int index = begin; index < end; ++index)
+            {
+              const TriaRawIterator<CellAccessor<dim, spacedim>> cell(
+                &triangulation, level, index);
+              if (cell->used() == false)
+                continue;
+
+              for (unsigned int f = 0; f < GeometryInfo<dim>::faces_per_cell;
+                   ++f)
+                {
+                  const unsigned int offset =
+                    (cell->direction_flag() ?
+                       left_right_offset[dim - 2][f]
+                                        [cell->face_orientation(f)] :
+                       1 - left_right_offset[dim - 2][f]
+                                            [cell->face_orientation(f)]);
+                  cell->set_neighbor(
+                    f, adjacent_cells[2 * cell->face(f)->index() + 1 - offset]);
+                }
+            }
+        },
+        /* grainsize = */ 512);
   }
 
 
@@ -4211,6 +4238,88 @@ namespace internal
       }
 
 
+      /**
+       * Compute the locations of the vertices created during refinement.
+       * The vertex with index <tt>std::get<0>(new_vertices[i])</tt> is
+       * placed at the center of the object
+       * <tt>std::get<1>(new_vertices[i])</tt>, computed by respecting the
+       * manifold and, if <tt>std::get<2>(new_vertices[i])</tt> is set, by
+       * interpolating from the surrounding points.
+       *
+       * The refinement functions reserve the slots of all new vertices,
+       * lines, quads, and cells sequentially, so that the numbering of the
+       * new objects is the same as if they were created one after the
+       * other. The locations of the new vertices, whose computation
+       * involves the manifolds and makes up the bulk of the work, are then
+       * filled in by this function. Every entry only reads the existing
+       * vertices and writes a different vertex, so the entries are
+       * processed on several threads.
+       */
+      template <int dim, int spacedim, typename IteratorType>
+      static void
+      compute_new_vertex_locations(
+        Triangulation<dim, spacedim> &triangulation,
+        const std::vector<std::tuple<unsigned int, IteratorType, bool>>
+          &new_vertices)
+      {
+        parallel::apply_to_subranges(
+          0U,
+          static_cast<unsigned int>(new_vertices.size()),
+          [&](const unsigned int begin, const unsigned int end) {
+            for (unsigned int i = begin; i < end; ++i)
+              triangulation.vertices[std::get<0>(new_vertices[i])] =
+                std::get<1>(new_vertices[i])
+                  ->center(true, std::get<2>(new_vertices[i]));
+          },
+          /* grainsize = */ 64);
+      }
+
+
+
+      /**
+       * Once all new vertices have been placed, check the children of the
+       * refined cells @p refined_cells for distortion (if requested) and
+       * inform all listeners that the cells have been refined, in the
+       * order in which the cells were refined. The checks only read the
+       * triangulation and are done on several threads.
+       */
+      template <int dim, int spacedim>
+      static void
+      finish_refined_cells(
+        Triangulation<dim, spacedim> &triangulation,
+        const std::vector<typename Triangulation<dim, spacedim>::cell_iterator>
+          &        refined_cells,
+        const bool check_for_distorted_cells,
+        typename Triangulation<dim, spacedim>::DistortedCellList
+          &cells_with_distorted_children)
+      {
+        if (check_for_distorted_cells == true)
+          {
+            std::vector<char> is_distorted(refined_cells.size(), 0);
+            parallel::apply_to_subranges(
+              0U,
+              static_cast<unsigned int>(refined_cells.size()),
+              [&](const unsigned int begin, const unsigned int end) {
+                for (unsigned int i = begin; i < end; ++i)
+                  is_distorted[i] = has_distorted_children(
+                    refined_cells[i],
+                    std::integral_constant<int, dim>(),
+                    std::integral_constant<int, spacedim>());
+              },
+              /* grainsize = */ 64);
+
+            for (unsigned int i = 0; i < refined_cells.size(); ++i)
+              if (is_distorted[i])
+                cells_with_distorted_children.distorted_cells.push_back(
+                  refined_cells[i]);
+          }
+
+        for (const auto &cell : refined_cells)
+          triangulation.signals.post_refinement_on_cell(cell);
+      }
+
+
+
       /**
        * Create the children of a 2d
        * cell. The arguments indicate
@@ -4227,6 +4336,13 @@ namespace internal
        * lines, quads and cells have to
        * be passed, which point at (or
        * "before") the reserved space.
+       *
+       * The location of the new vertex
+       * in the center of the cell is not
+       * computed here. Instead, the
+       * vertex is appended to
+       * @p new_center_vertices, see
+       * compute_new_vertex_locations().
        */
       template <int spacedim>
       static void create_children(
@@ -4236,7 +4352,11 @@ namespace internal
           &next_unused_line,
         typename Triangulation<2, spacedim>::raw_cell_iterator
           &                                                 next_unused_cell,
-        typename Triangulation<2, spacedim>::cell_iterator &cell)
+        typename Triangulation<2, spacedim>::cell_iterator &cell,
+        std::vector<
+          std::tuple<unsigned int,
+                     typename Triangulation<2, spacedim>::cell_iterator,
+                     bool>> &new_center_vertices)
       {
         const unsigned int dim = 2;
         // clear refinement flag
@@ -4375,21 +4495,15 @@ namespace internal
             // boundary object
             if (dim == spacedim)
               {
-                // triangulation.vertices[next_unused_vertex] = new_point;
-                triangulation.vertices[next_unused_vertex] = cell->center(true);
-
                 // if the user_flag is set, i.e. if the cell is at the
                 // boundary, use a different calculation of the middle vertex
                 // here. this is of advantage if the boundary is strongly
                 // curved (whereas the cell is not) and the cell has a high
                 // aspect ratio.
-                if (cell->user_flag_set())
-                  {
-                    // first reset the user_flag and then refine
-                    cell->clear_user_flag();
-                    triangulation.vertices[next_unused_vertex] =
-                      cell->center(true, true);
-                  }
+                new_center_vertices.emplace_back(next_unused_vertex,
+                                                 cell,
+                                                 cell->user_flag_set());
+                cell->clear_user_flag();
               }
             else
               {
@@ -4402,7 +4516,9 @@ namespace internal
 
                 // new vertex is placed on the surface according to
                 // the information stored in the boundary class
-                triangulation.vertices[next_unused_vertex] = cell->center(true);
+                new_center_vertices.emplace_back(next_unused_vertex,
+                                                 cell,
+                                                 false);
               }
           }
 
@@ -5094,6 +5210,14 @@ namespace internal
           typename Triangulation<dim, spacedim>::raw_line_iterator
             next_unused_line = triangulation.begin_raw_line();
 
+          // the midpoints of the lines are computed after all lines have
+          // been set up, see compute_new_vertex_locations()
+          std::vector<
+            std::tuple<unsigned int,
+                       typename Triangulation<dim, spacedim>::line_iterator,
+                       bool>>
+            new_vertices;
+
           for (; line != endl; ++line)
             if (line->user_flag_set())
               {
@@ -5109,7 +5233,7 @@ namespace internal
                     "Internal error: During refinement, the triangulation wants to access an element of the 'vertices' array but it turns out that the array is not large enough."));
                 triangulation.vertices_used[next_unused_vertex] = true;
 
-                triangulation.vertices[next_unused_vertex] = line->center(true);
+                new_vertices.emplace_back(next_unused_vertex, line, false);
 
                 // now that we created the right point, make up the
                 // two child lines.  To this end, find a pair of
@@ -5174,6 +5298,8 @@ namespace internal
                 // refinement
                 line->clear_user_flag();
               }
+
+          compute_new_vertex_locations(triangulation, new_vertices);
         }
 
 
@@ -5191,6 +5317,18 @@ namespace internal
         typename Triangulation<dim, spacedim>::raw_line_iterator
           next_unused_line = triangulation.begin_raw_line();
 
+        // the cells are set up one after the other, but the vertices in
+        // their centers are placed and the children are checked only
+        // afterwards, see compute_new_vertex_locations() and
+        // finish_refined_cells()
+        std::vector<typename Triangulation<dim, spacedim>::cell_iterator>
+          refined_cells;
+        std::vector<
+          std::tuple<unsigned int,
+                     typename Triangulation<dim, spacedim>::cell_iterator,
+                     bool>>
+          new_vertices;
+
         for (int level = 0;
              level < static_cast<int>(triangulation.levels.size()) - 1;
              ++level)
@@ -5222,20 +5360,22 @@ namespace internal
                                   next_unused_vertex,
                                   next_unused_line,
                                   next_unused_cell,
-                                  cell);
-
-                  if ((check_for_distorted_cells == true) &&
-                      has_distorted_children(
-                        cell,
-                        std::integral_constant<int, dim>(),
-                        std::integral_constant<int, spacedim>()))
-                    cells_with_distorted_children.distorted_cells.push_back(
-                      cell);
-                  // inform all listeners that cell refinement is done
-                  triangulation.signals.post_refinement_on_cell(cell);
+                                  cell,
+                                  new_vertices);
+
+                  refined_cells.push_back(cell);
                 }
           }
 
+        compute_new_vertex_locations(triangulation, new_vertices);
+
+        // check the children for distortion and inform all listeners
+        // that cell refinement is done
+        finish_refined_cells(triangulation,
+                             refined_cells,
+                             check_for_distorted_cells,
+                             cells_with_distorted_children);
+
         return cells_with_distorted_children;
       }
 
@@ -5576,6 +5716,14 @@ namespace internal
           typename Triangulation<dim, spacedim>::raw_line_iterator
             next_unused_line = triangulation.begin_raw_line();
 
+          // the midpoints of the lines are computed after all lines have
+          // been set up, see compute_new_vertex_locations()
+          std::vector<
+            std::tuple<unsigned int,
+                       typename Triangulation<dim, spacedim>::line_iterator,
+                       bool>>
+            new_vertices;
+
           for (; line != endl; ++line)
             if (line->user_flag_set())
               {
@@ -5591,7 +5739,7 @@ namespace internal
                     "Internal error: During refinement, the triangulation wants to access an element of the 'vertices' array but it turns out that the array is not large enough."));
                 triangulation.vertices_used[next_unused_vertex] = true;
 
-                triangulation.vertices[next_unused_vertex] = line->center(true);
+                new_vertices.emplace_back(next_unused_vertex, line, false);
 
                 // now that we created the right point, make up the
                 // two child lines (++ takes care of the end of the
@@ -5649,6 +5797,8 @@ namespace internal
                 // for refinement
                 line->clear_user_flag();
               }
+
+          compute_new_vertex_locations(triangulation, new_vertices);
         }
 
 
@@ -5675,6 +5825,21 @@ namespace internal
         // anisotropically (this is transformed to case c), however we
         // might have to renumber/rename children...)
 
+        // the new vertices on the inner lines of anisotropically refined
+        // quads and in the centers of the quads are placed after all
+        // quads have been refined, see compute_new_vertex_locations().
+        // the latter depend on the former, so they are kept apart
+        std::vector<
+          std::tuple<unsigned int,
+                     typename Triangulation<dim, spacedim>::line_iterator,
+                     bool>>
+          new_middle_line_vertices;
+        std::vector<
+          std::tuple<unsigned int,
+                     typename Triangulation<dim, spacedim>::quad_iterator,
+                     bool>>
+          new_quad_vertices;
+
         // we need a loop in cases c) and d), as the anisotropic
         // children migt have a lower index than the mother quad
         for (unsigned int loop = 0; loop < 2; ++loop)
@@ -6263,8 +6428,8 @@ namespace internal
                             // quads can only happen in the interior
                             // of the domain, so we need not care
                             // about boundary quads here
-                            triangulation.vertices[next_unused_vertex] =
-                              middle_line->center(true);
+                            new_middle_line_vertices.emplace_back(
+                              next_unused_vertex, middle_line, false);
                             triangulation.vertices_used[next_unused_vertex] =
                               true;
 
@@ -6357,8 +6522,9 @@ namespace internal
                     // optimal shape. their description uses the formulas
                     // underlying the TransfiniteInterpolationManifold
                     // implementation
-                    triangulation.vertices[next_unused_vertex] =
-                      quad->center(true, true);
+                    new_quad_vertices.emplace_back(next_unused_vertex,
+                                                   quad,
+                                                   true);
                     triangulation.vertices_used[next_unused_vertex] = true;
 
                     // now that we created the right point, make up
@@ -6605,6 +6771,9 @@ namespace internal
               }     // for all quads
           }         // looped two times over all quads, all quads refined now
 
+        compute_new_vertex_locations(triangulation, new_middle_line_vertices);
+        compute_new_vertex_locations(triangulation, new_quad_vertices);
+
         ///////////////////////////////////
         // Now, finally, set up the new
         // cells
@@ -6613,6 +6782,17 @@ namespace internal
         typename Triangulation<3, spacedim>::DistortedCellList
           cells_with_distorted_children;
 
+        // as for the quads, the vertices in the centers of the hexes are
+        // placed and the children are checked only after all hexes have
+        // been refined
+        std::vector<typename Triangulation<dim, spacedim>::cell_iterator>
+          refined_cells;
+        std::vector<
+          std::tuple<unsigned int,
+                     typename Triangulation<dim, spacedim>::cell_iterator,
+                     bool>>
+          new_vertices;
+
         for (unsigned int level = 0; level != triangulation.levels.size() - 1;
              ++level)
           {
@@ -8926,8 +9106,9 @@ namespace internal
                           // Manifolds. Let the cell compute its own
                           // center, by querying the underlying manifold
                           // object.
-                          triangulation.vertices[next_unused_vertex] =
-                            hex->center(true, true);
+                          new_vertices.emplace_back(next_unused_vertex,
+                                                    hex,
+                                                    true);
 
                           // set the data of the six lines.  first collect
                           // the indices of the seven vertices (consider
@@ -9684,24 +9865,22 @@ namespace internal
                         new_hexes[current_child]->set_face_rotation(f, f_ro[f]);
                       }
 
-                  // now see if we have created cells that are
-                  // distorted and if so add them to our list
-                  if ((check_for_distorted_cells == true) &&
-                      has_distorted_children(
-                        hex,
-                        std::integral_constant<int, dim>(),
-                        std::integral_constant<int, spacedim>()))
-                    cells_with_distorted_children.distorted_cells.push_back(
-                      hex);
-
                   // note that the refinement flag was already cleared
                   // at the beginning of this loop
-
-                  // inform all listeners that cell refinement is done
-                  triangulation.signals.post_refinement_on_cell(hex);
+                  refined_cells.push_back(hex);
                 }
           }
 
+        compute_new_vertex_locations(triangulation, new_vertices);
+
+        // now see if we have created cells that are distorted and if so
+        // add them to our list, and inform all listeners that cell
+        // refinement is done
+        finish_refined_cells(triangulation,
+                             refined_cells,
+                             check_for_distorted_cells,
+                             cells_with_distorted_children);
+
         // clear user data on quads. we used some of this data to
         // indicate anisotropic refinemnt cases on faces. all data
         // should be cleared by now, but the information whether we
@@ -10086,6 +10265,128 @@ namespace internal
           }
         return true;
       }
+
+
+
+      /**
+       * Return the cells of @p triangulation for which @p predicate
+       * returns true, in the order in which
+       * Triangulation::cell_iterators() visits them.
+       *
+       * This function is used by those passes of fix_coarsen_flags() and
+       * Triangulation::prepare_coarsening_and_refinement() in which the
+       * decision about a cell does not depend on the flags set or cleared
+       * for any other cell in the same pass. The cells of each level are
+       * then tested on several threads, and the flags are changed
+       * afterwards on the selected cells in their original order. The
+       * flags can not be changed on several threads since the flags of a
+       * level are stored in a std::vector<bool>, i.e., several flags share
+       * the same memory location.
+       */
+      template <int dim, int spacedim, typename Predicate>
+      static std::vector<typename Triangulation<dim, spacedim>::cell_iterator>
+      select_cells(const Triangulation<dim, spacedim> &triangulation,
+                   const Predicate &                   predicate)
+      {
+        std::vector<typename Triangulation<dim, spacedim>::cell_iterator>
+                          selected_cells;
+        std::vector<char> is_selected;
+
+        for (unsigned int level = 0; level < triangulation.n_levels(); ++level)
+          {
+            const unsigned int n_raw_cells = triangulation.n_raw_cells(level);
+            is_selected.assign(n_raw_cells, 0);
+
+            parallel::apply_to_subranges(
+              0U,
+              n_raw_cells,
+              [&](const unsigned int begin, const unsigned int end) {
+                for (unsigned int index = begin; index < end; ++index)
+                  {
+                    const typename Triangulation<dim, spacedim>::
+                      raw_cell_iterator raw_cell(&triangulation, level, index);
+                    if (raw_cell->used() &&
+                        predicate(
+                          typename Triangulation<dim, spacedim>::cell_iterator(
+                            raw_cell)))
+                      is_selected[index] = 1;
+                  }
+              },
+              /* grainsize = */ 256);
+
+            for (unsigned int index = 0; index < n_raw_cells; ++index)
+              if (is_selected[index])
+                selected_cells.emplace_back(&triangulation, level, index);
+          }
+
+        return selected_cells;
+      }
+
+
+
+      /**
+       * Store in @p vertex_level the highest level any of the active cells
+       * adjacent to a vertex will have after refinement and coarsening,
+       * tentatively assuming that all cells flagged for coarsening will be
+       * coarsened. This is the first step of the mesh smoothing with the
+       * Triangulation::limit_level_difference_at_vertices flag.
+       *
+       * The cells are visited on several threads, each of which collects
+       * the levels in its own vector. These vectors are then combined by
+       * taking the maximum, so the result does not depend on the order in
+       * which the cells are visited.
+       */
+      template <int dim, int spacedim>
+      static void
+      compute_vertex_levels(const Triangulation<dim, spacedim> &triangulation,
+                            std::vector<int> &                  vertex_level)
+      {
+        const std::vector<int> zero_levels(triangulation.n_vertices(), 0);
+        Threads::ThreadLocalStorage<std::vector<int>> local_vertex_level(
+          zero_levels);
+
+        for (unsigned int level = 0; level < triangulation.n_levels(); ++level)
+          parallel::apply_to_subranges(
+            0U,
+            triangulation.n_raw_cells(level),
+            [&](const unsigned int begin, const unsigned int end) {
+              std::vector<int> &levels = local_vertex_level.get();
+              for (unsigned int index = begin; index < end; ++index)
+                {
+                  const typename Triangulation<dim, spacedim>::
+                    raw_cell_iterator cell(&triangulation, level, index);
+                  if (!cell->used() || cell->has_children())
+                    continue;
+
+                  // if coarsen flag is set then tentatively assume that
+                  // the cell will be coarsened. this isn't always true
+                  // (the coarsen flag could be removed again) and so we
+                  // may make an error here
+                  const int cell_level =
+                    (cell->refine_flag_set() ?
+                       cell->level() + 1 :
+                       (cell->coarsen_flag_set() ? cell->level() - 1 :
+                                                   cell->level()));
+                  for (unsigned int vertex = 0;
+                       vertex < GeometryInfo<dim>::vertices_per_cell;
+                       ++vertex)
+                    levels[cell->vertex_index(vertex)] =
+                      std::max(levels[cell->vertex_index(vertex)],
+                               cell_level);
+                }
+            },
+            /* grainsize = */ 256);
+
+        vertex_level = zero_levels;
+#ifdef DEAL_II_WITH_THREADS
+        for (const std::vector<int> &levels :
+             local_vertex_level.get_implementation())
+          for (unsigned int v = 0; v < vertex_level.size(); ++v)
+            vertex_level[v] = std::max(vertex_level[v], levels[v]);
+#else
+        vertex_level = local_vertex_level.get();
+#endif
+      }
     };
 
 
@@ -13322,9 +13623,13 @@ Triangulation<dim, spacedim>::execute_coarsening_and_refinement()
     Assert(satisfies_level1_at_vertex_rule(*this) == true, ExcInternalError());
 
   // finally build up neighbor connectivity information, and set
-  // active cell indices
+  // active cell indices. the two operations write to different
+  // arrays, so we can do them concurrently
+  Threads::Task<void> set_active_cell_indices =
+    Threads::new_task(&Triangulation<dim, spacedim>::reset_active_cell_indices,
+                      *this);
   update_neighbors(*this);
-  reset_active_cell_indices();
+  set_active_cell_indices.join();
 
   // Inform all listeners about end of refinement.
   signals.post_refinement();
@@ -13474,10 +13779,14 @@ Triangulation<dim, spacedim>::execute_coarsening()
   // this line. in 3D, this is used later on to decide which lines can
   // be deleted after coarsening a cell. in other dimensions it will
   // be ignored
+  //
+  // both counts only read from the triangulation, so compute the one
+  // for quads in the background
+  Threads::Task<std::vector<unsigned int>> count_quads =
+    Threads::new_task(&count_cells_bounded_by_quad<dim, spacedim>, *this);
   std::vector<unsigned int> line_cell_count =
     count_cells_bounded_by_line(*this);
-  std::vector<unsigned int> quad_cell_count =
-    count_cells_bounded_by_quad(*this);
+  std::vector<unsigned int> quad_cell_count = count_quads.return_value();
 
   // loop over all cells. Flag all cells of which all children are
   // flagged for coarsening and delete the childrens' flags. In
@@ -13576,41 +13885,8 @@ Triangulation<dim, spacedim>::fix_coarsen_flags()
 
           // store highest level one of the cells adjacent to a vertex
           // belongs to
-          std::fill(vertex_level.begin(), vertex_level.end(), 0);
-          active_cell_iterator cell = begin_active(), endc = end();
-          for (; cell != endc; ++cell)
-            {
-              if (cell->refine_flag_set())
-                for (unsigned int vertex = 0;
-                     vertex < GeometryInfo<dim>::vertices_per_cell;
-                     ++vertex)
-                  vertex_level[cell->vertex_index(vertex)] =
-                    std::max(vertex_level[cell->vertex_index(vertex)],
-                             cell->level() + 1);
-              else if (!cell->coarsen_flag_set())
-                for (unsigned int vertex = 0;
-                     vertex < GeometryInfo<dim>::vertices_per_cell;
-                     ++vertex)
-                  vertex_level[cell->vertex_index(vertex)] =
-                    std::max(vertex_level[cell->vertex_index(vertex)],
-                             cell->level());
-              else
-                {
-                  // if coarsen flag is set then tentatively assume
-                  // that the cell will be coarsened. this isn't
-                  // always true (the coarsen flag could be removed
-                  // again) and so we may make an error here. we try
-                  // to correct this by iterating over the entire
-                  // process until we are converged
-                  Assert(cell->coarsen_flag_set(), ExcInternalError());
-                  for (unsigned int vertex = 0;
-                       vertex < GeometryInfo<dim>::vertices_per_cell;
-                       ++vertex)
-                    vertex_level[cell->vertex_index(vertex)] =
-                      std::max(vertex_level[cell->vertex_index(vertex)],
-                               cell->level() - 1);
-                }
-            }
+          internal::TriangulationImplementation::Implementation::
+            compute_vertex_levels(*this, vertex_level);
 
 
           // loop over all cells in reverse order. do so because we
@@ -13622,7 +13898,7 @@ Triangulation<dim, spacedim>::fix_coarsen_flags()
           // refinement flags, but we will also have to remove
           // coarsening flags on cells adjacent to vertices that will
           // see refinement
-          for (cell = last_active(); cell != endc; --cell)
+          for (active_cell_iterator cell = last_active(); cell != end(); --cell)
             if (cell->refine_flag_set() == false)
               {
                 for (unsigned int vertex = 0;
@@ -13669,43 +13945,36 @@ Triangulation<dim, spacedim>::fix_coarsen_flags()
       // In effect, all coarsen flags are turned into user flags of
       // the mother cell if coarsening is possible or deleted
       // otherwise.
+      //
+      // whether all children of a cell are flagged does not depend on
+      // any other cell, so first find these cells and only then clear
+      // the coarsen flags
       clear_user_flags();
-      // Coarsen flags of cells with no mother cell, i.e. on the
-      // coarsest level are deleted explicitly.
-      active_cell_iterator acell = begin_active(0), end_ac = end_active(0);
-      for (; acell != end_ac; ++acell)
-        acell->clear_coarsen_flag();
-
-      cell_iterator cell = begin(), endc = end();
-      for (; cell != endc; ++cell)
-        {
-          // nothing to do if we are already on the finest level
-          if (cell->active())
-            continue;
-
-          const unsigned int n_children       = cell->n_children();
-          unsigned int       flagged_children = 0;
-          for (unsigned int child = 0; child < n_children; ++child)
-            if (cell->child(child)->active() &&
-                cell->child(child)->coarsen_flag_set())
-              {
-                ++flagged_children;
-                // clear flag since we don't need it anymore
-                cell->child(child)->clear_coarsen_flag();
-              }
+      const std::vector<cell_iterator> cells_with_flagged_children =
+        internal::TriangulationImplementation::Implementation::select_cells(
+          *this, [](const cell_iterator &cell) {
+            // nothing to do if we are already on the finest level
+            if (cell->active())
+              return false;
+
+            for (unsigned int child = 0; child < cell->n_children(); ++child)
+              if (!cell->child(child)->active() ||
+                  !cell->child(child)->coarsen_flag_set())
+                return false;
+            return true;
+          });
 
-          // flag this cell for coarsening if all children were
-          // flagged
-          if (flagged_children == n_children)
-            cell->set_user_flag();
-        }
+      // every active cell is either on the coarsest level, where it has
+      // no mother cell and can not be coarsened, or the child of some
+      // cell, so all coarsen flags go away now since we don't need them
+      // anymore
+      for (const auto &level : levels)
+        level->coarsen_flags.assign(level->coarsen_flags.size(), false);
 
-        // in principle no coarsen flags should be set any more at this
-        // point
-#if DEBUG
-      for (cell = begin(); cell != endc; ++cell)
-        Assert(cell->coarsen_flag_set() == false, ExcInternalError());
-#endif
+      // flag the cells for coarsening of which all children were
+      // flagged
+      for (const auto &cell : cells_with_flagged_children)
+        cell->set_user_flag();
 
       // now loop over all cells which have the user flag set. their
       // children were flagged for coarsening. set the coarsen flag
@@ -13720,23 +13989,27 @@ Triangulation<dim, spacedim>::fix_coarsen_flags()
       // refinement between neighbors in 1d, so this whole procedure
       // is only necessary if we are not in 1d
       //
-      // since we remove some coarsening/user flags in the process, we
-      // have to work from the finest level to the coarsest one, since
-      // we occasionally inspect user flags of cells on finer levels
-      // and need to be sure that these flags are final
-      for (cell = last(); cell != endc; --cell)
-        if (cell->user_flag_set())
-          // if allowed: flag the
-          // children for coarsening
-          if (internal::TriangulationImplementation::Implementation::
-                template coarsening_allowed<dim, spacedim>(cell))
-            for (unsigned int c = 0; c < cell->n_children(); ++c)
-              {
-                Assert(cell->child(c)->refine_flag_set() == false,
-                       ExcInternalError());
+      // we occasionally inspect user flags of cells on finer levels. since
+      // only coarsen flags are set in the process, the user and refine
+      // flags the decision for a cell depends on are final, and the cells
+      // for which coarsening is allowed can be found independently of each
+      // other before setting any flags
+      const std::vector<cell_iterator> cells_to_coarsen =
+        internal::TriangulationImplementation::Implementation::select_cells(
+          *this, [](const cell_iterator &cell) {
+            return cell->user_flag_set() &&
+                   internal::TriangulationImplementation::Implementation::
+                     template coarsening_allowed<dim, spacedim>(cell);
+          });
+      for (const auto &cell : cells_to_coarsen)
+        // flag the children for coarsening
+        for (unsigned int c = 0; c < cell->n_children(); ++c)
+          {
+            Assert(cell->child(c)->refine_flag_set() == false,
+                   ExcInternalError());
 
-                cell->child(c)->set_coarsen_flag();
-              }
+            cell->child(c)->set_coarsen_flag();
+          }
 
       // clear all user flags again, now that we don't need them any
       // more
@@ -14252,38 +14525,9 @@ Triangulation<dim, spacedim>::prepare_coarsening_and_refinement()
 
           // store highest level one of the cells adjacent to a vertex
           // belongs to
-          std::vector<int> vertex_level(vertices.size(), 0);
-          for (const auto &cell : active_cell_iterators())
-            {
-              if (cell->refine_flag_set())
-                for (unsigned int vertex = 0;
-                     vertex < GeometryInfo<dim>::vertices_per_cell;
-                     ++vertex)
-                  vertex_level[cell->vertex_index(vertex)] =
-                    std::max(vertex_level[cell->vertex_index(vertex)],
-                             cell->level() + 1);
-              else if (!cell->coarsen_flag_set())
-                for (unsigned int vertex = 0;
-                     vertex < GeometryInfo<dim>::vertices_per_cell;
-                     ++vertex)
-                  vertex_level[cell->vertex_index(vertex)] =
-                    std::max(vertex_level[cell->vertex_index(vertex)],
-                             cell->level());
-              else
-                {
-                  // if coarsen flag is set then tentatively assume
-                  // that the cell will be coarsened. this isn't
-                  // always true (the coarsen flag could be removed
-                  // again) and so we may make an error here
-                  Assert(cell->coarsen_flag_set(), ExcInternalError());
-                  for (unsigned int vertex = 0;
-                       vertex < GeometryInfo<dim>::vertices_per_cell;
-                       ++vertex)
-                    vertex_level[cell->vertex_index(vertex)] =
-                      std::max(vertex_level[cell->vertex_index(vertex)],
-                               cell->level() - 1);
-                }
-            }
+          std::vector<int> vertex_level;
+          internal::TriangulationImplementation::Implementation::
+            compute_vertex_levels(*this, vertex_level);
 
 
           // loop over all cells in reverse order. do so because we
@@ -14387,32 +14631,50 @@ Triangulation<dim, spacedim>::prepare_coarsening_and_refinement()
           // active).  If the refine flag of at least one of the
           // children is set then set_refine_flag and
           // clear_coarsen_flag of all children.
-          for (const auto &cell : cell_iterators())
-            if (!cell->active())
-              {
+          //
+          // the children of different cells are different, so the
+          // patches that need to be refined can be found independently
+          // of each other before any flags are changed
+          const auto combined_refinement_case = [](const cell_iterator &cell) {
+            RefinementCase<dim> combined_ref_case =
+              RefinementCase<dim>::no_refinement;
+            for (unsigned int i = 0; i < cell->n_children(); ++i)
+              combined_ref_case =
+                combined_ref_case | cell->child(i)->refine_flag_set();
+            return combined_ref_case;
+          };
+
+          const std::vector<cell_iterator> patches_to_refine =
+            internal::TriangulationImplementation::Implementation::select_cells(
+              *this, [&](const cell_iterator &cell) {
+                if (cell->active())
+                  return false;
+
                 // ensure the invariant. we can then check whether all
                 // of its children are further refined or not by
                 // simply looking at the first child
                 Assert(cell_is_patch_level_1(cell), ExcInternalError());
                 if (cell->child(0)->has_children() == true)
-                  continue;
+                  return false;
 
                 // cell is found to be a patch.  combine the refine
                 // cases of all children
-                RefinementCase<dim> combined_ref_case =
-                  RefinementCase<dim>::no_refinement;
-                for (unsigned int i = 0; i < cell->n_children(); ++i)
-                  combined_ref_case =
-                    combined_ref_case | cell->child(i)->refine_flag_set();
-                if (combined_ref_case != RefinementCase<dim>::no_refinement)
-                  for (unsigned int i = 0; i < cell->n_children(); ++i)
-                    {
-                      cell_iterator child = cell->child(i);
+                return (combined_refinement_case(cell) !=
+                        RefinementCase<dim>::no_refinement);
+              });
 
-                      child->clear_coarsen_flag();
-                      child->set_refine_flag(combined_ref_case);
-                    }
-              }
+          for (const auto &cell : patches_to_refine)
+            {
+              const RefinementCase<dim> combined_ref_case =
+                combined_refinement_case(cell);
+              for (unsigned int i = 0; i < cell->n_children(); ++i)
+                {
+                  cell_iterator child = cell->child(i);
+
+                  child->clear_coarsen_flag();
+                  child->set_refine_flag(combined_ref_case);
+                }
+            }
 
           // The code above dealt with the case where we may get a
           // non-patch_level_1 mesh from refinement. Now also deal
@@ -14423,82 +14685,90 @@ Triangulation<dim, spacedim>::prepare_coarsening_and_refinement()
           //
           // for a case where this is a bit tricky, take a look at the
           // mesh_smoothing_0[12] testcases
-          for (const auto &cell : cell_iterators())
-            {
-              // check if this cell has active grandchildren. note
-              // that we know that it is patch_level_1, i.e. if one of
-              // its children is active then so are all, and it isn't
-              // going to have any grandchildren at all:
-              if (cell->active() || cell->child(0)->active())
-                continue;
-
-              // cell is not active, and so are none of its
-              // children. check the grandchildren. note that the
-              // children are also patch_level_1, and so we only ever
-              // need to check their first child
-              const unsigned int n_children               = cell->n_children();
-              bool               has_active_grandchildren = false;
-
-              for (unsigned int i = 0; i < n_children; ++i)
-                if (cell->child(i)->child(0)->active())
-                  {
-                    has_active_grandchildren = true;
-                    break;
-                  }
-
-              if (has_active_grandchildren == false)
-                continue;
+          //
+          // as above, the grandchildren of different cells are
+          // different, so the cells whose grandchildren must not be
+          // coarsened can be found first
+          const std::vector<cell_iterator> patches_not_to_coarsen =
+            internal::TriangulationImplementation::Implementation::select_cells(
+              *this, [](const cell_iterator &cell) {
+                // check if this cell has active grandchildren. note
+                // that we know that it is patch_level_1, i.e. if one of
+                // its children is active then so are all, and it isn't
+                // going to have any grandchildren at all:
+                if (cell->active() || cell->child(0)->active())
+                  return false;
+
+                // cell is not active, and so are none of its
+                // children. check the grandchildren. note that the
+                // children are also patch_level_1, and so we only ever
+                // need to check their first child
+                const unsigned int n_children = cell->n_children();
+                bool               has_active_grandchildren = false;
+
+                for (unsigned int i = 0; i < n_children; ++i)
+                  if (cell->child(i)->child(0)->active())
+                    {
+                      has_active_grandchildren = true;
+                      break;
+                    }
 
+                if (has_active_grandchildren == false)
+                  return false;
 
-              // ok, there are active grandchildren. see if either all
-              // or none of them are flagged for coarsening
-              unsigned int n_grandchildren = 0;
 
-              // count all coarsen flags of the grandchildren.
-              unsigned int n_coarsen_flags = 0;
+                // ok, there are active grandchildren. see if either all
+                // or none of them are flagged for coarsening
+                unsigned int n_grandchildren = 0;
 
-              // cell is not a patch (of level 1) as it has a
-              // grandchild.  Is cell a patch of level 2??  Therefore:
-              // find out whether all cell->child(i) are patches
-              for (unsigned int c = 0; c < n_children; ++c)
-                {
-                  // get at the child. by assumption (A), and the
-                  // check by which we got here, the child is not
-                  // active
-                  cell_iterator child = cell->child(c);
-
-                  const unsigned int nn_children = child->n_children();
-                  n_grandchildren += nn_children;
-
-                  // if child is found to be a patch of active cells
-                  // itself, then add up how many of its children are
-                  // supposed to be coarsened
-                  if (child->child(0)->active())
-                    for (unsigned int cc = 0; cc < nn_children; ++cc)
-                      if (child->child(cc)->coarsen_flag_set())
-                        ++n_coarsen_flags;
-                }
+                // count all coarsen flags of the grandchildren.
+                unsigned int n_coarsen_flags = 0;
 
-              // if not all grandchildren are supposed to be coarsened
-              // (e.g. because some simply don't have the flag set, or
-              // because they are not active and therefore cannot
-              // carry the flag), then remove the coarsen flag from
-              // all of the active grandchildren. note that there may
-              // be coarsen flags on the grandgrandchildren -- we
-              // don't clear them here, but we'll get to them in later
-              // iterations if necessary
-              //
-              // there is nothing we have to do if no coarsen flags
-              // have been set at all
-              if ((n_coarsen_flags != n_grandchildren) && (n_coarsen_flags > 0))
+                // cell is not a patch (of level 1) as it has a
+                // grandchild.  Is cell a patch of level 2??  Therefore:
+                // find out whether all cell->child(i) are patches
                 for (unsigned int c = 0; c < n_children; ++c)
                   {
-                    const cell_iterator child = cell->child(c);
+                    // get at the child. by assumption (A), and the
+                    // check by which we got here, the child is not
+                    // active
+                    cell_iterator child = cell->child(c);
+
+                    const unsigned int nn_children = child->n_children();
+                    n_grandchildren += nn_children;
+
+                    // if child is found to be a patch of active cells
+                    // itself, then add up how many of its children are
+                    // supposed to be coarsened
                     if (child->child(0)->active())
-                      for (unsigned int cc = 0; cc < child->n_children(); ++cc)
-                        child->child(cc)->clear_coarsen_flag();
+                      for (unsigned int cc = 0; cc < nn_children; ++cc)
+                        if (child->child(cc)->coarsen_flag_set())
+                          ++n_coarsen_flags;
                   }
-            }
+
+                // if not all grandchildren are supposed to be coarsened
+                // (e.g. because some simply don't have the flag set, or
+                // because they are not active and therefore cannot
+                // carry the flag), then remove the coarsen flag from
+                // all of the active grandchildren. note that there may
+                // be coarsen flags on the grandgrandchildren -- we
+                // don't clear them here, but we'll get to them in later
+                // iterations if necessary
+                //
+                // there is nothing we have to do if no coarsen flags
+                // have been set at all
+                return ((n_coarsen_flags != n_grandchildren) &&
+                        (n_coarsen_flags > 0));
+              });
+
+          for (const auto &cell : patches_not_to_coarsen)
+            for (unsigned int c = 0; c < cell->n_children(); ++c)
+              {
+                const cell_iterator child = cell->child(c);
+                if (child->child(0)->active())
+                  for (unsigned int cc = 0; cc < child->n_children(); ++cc)
+                    child->child(cc)->clear_coarsen_flag();
+              }
         }
 
       //////////////////////////////////
@@ -15103,6 +15373,33 @@ Triangulation<dim, spacedim>::memory_consumption() const
 }
 
 
+
+template <int dim, int spacedim>
+void
+Triangulation<dim, spacedim>::save_flat_binary(
+  const std::string &filename) const
+{
+  FlatBinaryArchive::OutputArchive archive(
+    filename,
+    "Triangulation<" + Utilities::int_to_string(dim) + "," +
+      Utilities::int_to_string(spacedim) + ">");
+  save(archive, 0);
+}
+
+
+
+template <int dim, int spacedim>
+void
+Triangulation<dim, spacedim>::load_flat_binary(const std::string &filename)
+{
+  FlatBinaryArchive::InputArchive archive(
+    filename,
+    "Triangulation<" + Utilities::int_to_string(dim) + "," +
+      Utilities::int_to_string(spacedim) + ">");
+  load(archive, 0);
+}
+
+
 // explicit instantiations
 #include "tria.inst"
 
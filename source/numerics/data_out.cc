@@ -65,6 +65,23 @@ namespace internal
 
 
 
+template <int dim, typename DoFHandlerType>
+DataOut<dim, DoFHandlerType>::DataOut()
+  : patch_triangulation(nullptr)
+  , patch_n_active_cells(0)
+  , patch_triangulation_changed(false)
+{}
+
+
+
+template <int dim, typename DoFHandlerType>
+DataOut<dim, DoFHandlerType>::~DataOut()
+{
+  patch_triangulation_listener.disconnect();
+}
+
+
+
 template <int dim, typename DoFHandlerType>
 void
 DataOut<dim, DoFHandlerType>::build_one_patch(
@@ -73,27 +90,38 @@ DataOut<dim, DoFHandlerType>::build_one_patch(
                                                 DoFHandlerType::space_dimension>
     &                    scratch_data,
   const unsigned int     n_subdivisions,
-  const CurvedCellRegion curved_cell_region)
+  const CurvedCellRegion curved_cell_region,
+  const unsigned int     first_patch_index,
+  const bool             update_data_only)
 {
-  // first create the output object that we will write into
+  // first create the output object that we will write into. if we only
+  // update the data of an existing patch, take over that patch, which
+  // already knows its vertices, neighbors, and points
   ::dealii::DataOutBase::Patch<DoFHandlerType::dimension,
                                DoFHandlerType::space_dimension>
     patch;
-  patch.n_subdivisions = n_subdivisions;
-
-  // set the vertices of the patch. if the mapping does not preserve locations
-  // (e.g. MappingQEulerian), we need to compute the offset of the vertex for
-  // the graphical output. Otherwise, we can just use the vertex info.
-  for (unsigned int vertex = 0;
-       vertex < GeometryInfo<DoFHandlerType::dimension>::vertices_per_cell;
-       ++vertex)
-    if (scratch_data.mapping_collection[0].preserves_vertex_locations())
-      patch.vertices[vertex] = cell_and_index->first->vertex(vertex);
-    else
-      patch.vertices[vertex] =
-        scratch_data.mapping_collection[0].transform_unit_to_real_cell(
-          cell_and_index->first,
-          GeometryInfo<DoFHandlerType::dimension>::unit_cell_vertex(vertex));
+  if (update_data_only)
+    patch.swap(this->patches[cell_and_index - patch_cells.data()]);
+  else
+    {
+      patch.n_subdivisions = n_subdivisions;
+
+      // set the vertices of the patch. if the mapping does not preserve
+      // locations (e.g. MappingQEulerian), we need to compute the offset of
+      // the vertex for the graphical output. Otherwise, we can just use the
+      // vertex info.
+      for (unsigned int vertex = 0;
+           vertex < GeometryInfo<DoFHandlerType::dimension>::vertices_per_cell;
+           ++vertex)
+        if (scratch_data.mapping_collection[0].preserves_vertex_locations())
+          patch.vertices[vertex] = cell_and_index->first->vertex(vertex);
+        else
+          patch.vertices[vertex] =
+            scratch_data.mapping_collection[0].transform_unit_to_real_cell(
+              cell_and_index->first,
+              GeometryInfo<DoFHandlerType::dimension>::unit_cell_vertex(
+                vertex));
+    }
 
   // create DoFHandlerType::active_cell_iterator and initialize FEValues
   scratch_data.reinit_all_fe_values(this->dof_data, cell_and_index->first);
@@ -110,10 +138,23 @@ DataOut<dim, DoFHandlerType>::build_one_patch(
   // want to produce curved cells everywhere
   //
   // note: a cell is *always* at the boundary if dim<spacedim
-  if (curved_cell_region == curved_inner_cells ||
-      (curved_cell_region == curved_boundary &&
-       (cell_and_index->first->at_boundary() ||
-        (DoFHandlerType::dimension != DoFHandlerType::space_dimension))))
+  //
+  // when only updating the data, the points (if any) are already there and
+  // the data vectors must produce the same number of output variables
+  if (update_data_only)
+    {
+      Assert(patch.data.size(0) ==
+               scratch_data.n_datasets +
+                 (patch.points_are_available ?
+                    DoFHandlerType::space_dimension :
+                    0),
+             ExcMessage("The number of output variables has changed since "
+                        "the patches were built."));
+    }
+  else if (curved_cell_region == curved_inner_cells ||
+           (curved_cell_region == curved_boundary &&
+            (cell_and_index->first->at_boundary() ||
+             (DoFHandlerType::dimension != DoFHandlerType::space_dimension))))
     {
       Assert(patch.space_dim == DoFHandlerType::space_dimension,
              ExcInternalError());
@@ -359,6 +400,11 @@ DataOut<dim, DoFHandlerType>::build_one_patch(
         }
     }
 
+  if (update_data_only)
+    {
+      this->patches[cell_and_index - patch_cells.data()].swap(patch);
+      return;
+    }
 
   for (unsigned int f = 0;
        f < GeometryInfo<DoFHandlerType::dimension>::faces_per_cell;
@@ -397,15 +443,22 @@ DataOut<dim, DoFHandlerType>::build_one_patch(
         }
 
       // now, there is a neighbor, so get its patch number and set it for the
-      // neighbor index
-      patch.neighbors[f] =
+      // neighbor index, unless the neighbor's patch is not part of the chunk
+      // of patches we are currently building
+      const unsigned int neighbor_patch_idx =
         (*scratch_data
             .cell_to_patch_index_map)[neighbor->level()][neighbor->index()];
+      if (neighbor_patch_idx < first_patch_index ||
+          neighbor_patch_idx - first_patch_index >= this->patches.size())
+        patch.neighbors[f] = numbers::invalid_unsigned_int;
+      else
+        patch.neighbors[f] = neighbor_patch_idx - first_patch_index;
     }
 
   const unsigned int patch_idx =
     (*scratch_data.cell_to_patch_index_map)[cell_and_index->first->level()]
-                                           [cell_and_index->first->index()];
+                                           [cell_and_index->first->index()] -
+    first_patch_index;
   // did we mess up the indices?
   Assert(patch_idx < this->patches.size(), ExcInternalError());
   patch.patch_index = patch_idx;
@@ -435,8 +488,162 @@ void
 DataOut<dim, DoFHandlerType>::build_patches(
   const Mapping<DoFHandlerType::dimension, DoFHandlerType::space_dimension>
     &                    mapping,
-  const unsigned int     n_subdivisions_,
+  const unsigned int     n_subdivisions,
   const CurvedCellRegion curved_region)
+{
+  build_patches_chunkwise(mapping,
+                          n_subdivisions,
+                          curved_region,
+                          numbers::invalid_unsigned_int,
+                          std::function<void()>());
+}
+
+
+
+template <int dim, typename DoFHandlerType>
+void
+DataOut<dim, DoFHandlerType>::build_patches_in_chunks(
+  const Mapping<DoFHandlerType::dimension, DoFHandlerType::space_dimension>
+    &                          mapping,
+  const unsigned int           n_subdivisions,
+  const CurvedCellRegion       curved_region,
+  const unsigned int           max_patches_per_chunk,
+  const std::function<void()> &process_chunk)
+{
+  Assert(max_patches_per_chunk > 0,
+         ExcMessage("The number of patches per chunk must be positive."));
+  Assert(process_chunk, ExcMessage("No function to process chunks given."));
+
+  build_patches_chunkwise(mapping,
+                          n_subdivisions,
+                          curved_region,
+                          max_patches_per_chunk,
+                          process_chunk);
+
+  // do not keep the patches of the last chunk around
+  this->patches.clear();
+  this->patches.shrink_to_fit();
+  patch_cells.clear();
+  patch_cells.shrink_to_fit();
+  patch_triangulation = nullptr;
+  patch_triangulation_listener.disconnect();
+}
+
+
+
+template <int dim, typename DoFHandlerType>
+void
+DataOut<dim, DoFHandlerType>::update_patch_data()
+{
+  update_patch_data(StaticMappingQ1<DoFHandlerType::dimension,
+                                    DoFHandlerType::space_dimension>::mapping);
+}
+
+
+
+template <int dim, typename DoFHandlerType>
+void
+DataOut<dim, DoFHandlerType>::update_patch_data(
+  const Mapping<DoFHandlerType::dimension, DoFHandlerType::space_dimension>
+    &mapping)
+{
+  Assert(this->triangulation != nullptr,
+         Exceptions::DataOutImplementation::ExcNoTriangulationSelected());
+
+  AssertThrow(patch_triangulation != nullptr,
+              ExcMessage("The patches to be updated must have been created by "
+                         "build_patches()."));
+  AssertThrow(this->triangulation == patch_triangulation &&
+                !patch_triangulation_changed &&
+                this->triangulation->n_active_cells() == patch_n_active_cells,
+              ExcMessage("The triangulation has changed since the patches "
+                         "were built. Call build_patches() instead."));
+  AssertThrow(this->dof_data.size() == patch_dof_handlers.size(),
+              ExcMessage("The data vectors have changed since the patches "
+                         "were built. Call build_patches() instead."));
+  for (unsigned int i = 0; i < this->dof_data.size(); ++i)
+    AssertThrow(this->dof_data[i]->dof_handler == patch_dof_handlers[i],
+                ExcMessage("The DoFHandler objects of the data vectors have "
+                           "changed since the patches were built. Call "
+                           "build_patches() instead."));
+  AssertThrow(patch_cells.size() == this->patches.size(),
+              ExcMessage("The patches to be updated must have been created by "
+                         "build_patches()."));
+
+  this->validate_dataset_names();
+
+  if (patch_cells.size() == 0)
+    return;
+
+  unsigned int n_datasets = 0;
+  for (unsigned int i = 0; i < this->cell_data.size(); ++i)
+    n_datasets += (this->cell_data[i]->is_complex_valued() ? 2 : 1);
+  for (unsigned int i = 0; i < this->dof_data.size(); ++i)
+    n_datasets += (this->dof_data[i]->n_output_variables *
+                   (this->dof_data[i]->is_complex_valued() ? 2 : 1));
+
+  std::vector<unsigned int> n_postprocessor_outputs(this->dof_data.size());
+  for (unsigned int dataset = 0; dataset < this->dof_data.size(); ++dataset)
+    if (this->dof_data[dataset]->postprocessor)
+      n_postprocessor_outputs[dataset] =
+        this->dof_data[dataset]->n_output_variables;
+    else
+      n_postprocessor_outputs[dataset] = 0;
+
+  // unlike in build_patches(), we do not need the quadrature points for
+  // curved cells, since the patches already store them. unless a
+  // postprocessor asks for more, we thus only need the values of the shape
+  // functions, which do not require evaluating the mapping on the cell
+  UpdateFlags update_flags = update_values;
+  for (unsigned int i = 0; i < this->dof_data.size(); ++i)
+    if (this->dof_data[i]->postprocessor)
+      update_flags |=
+        this->dof_data[i]->postprocessor->get_needed_update_flags();
+
+  // all patches have the same number of subdivisions
+  const unsigned int n_subdivisions = this->patches[0].n_subdivisions;
+
+  // the neighborship information of the patches does not change, so there is
+  // no need for a map from cells to patches
+  const std::vector<std::vector<unsigned int>> cell_to_patch_index_map;
+  internal::DataOutImplementation::ParallelData<DoFHandlerType::dimension,
+                                                DoFHandlerType::space_dimension>
+    thread_data(n_datasets,
+                n_subdivisions,
+                n_postprocessor_outputs,
+                mapping,
+                this->get_fes(),
+                update_flags,
+                cell_to_patch_index_map);
+
+  WorkStream::run(patch_cells.data(),
+                  patch_cells.data() + patch_cells.size(),
+                  std::bind(&DataOut<dim, DoFHandlerType>::build_one_patch,
+                            this,
+                            std::placeholders::_1,
+                            std::placeholders::_2,
+                            n_subdivisions,
+                            no_curved_cells,
+                            /* first_patch_index = */ 0,
+                            /* update_data_only = */ true),
+                  std::function<void(const int)>(),
+                  thread_data,
+                  /* dummy CopyData object = */ 0,
+                  8 * MultithreadInfo::n_threads(),
+                  64);
+}
+
+
+
+template <int dim, typename DoFHandlerType>
+void
+DataOut<dim, DoFHandlerType>::build_patches_chunkwise(
+  const Mapping<DoFHandlerType::dimension, DoFHandlerType::space_dimension>
+    &                          mapping,
+  const unsigned int           n_subdivisions_,
+  const CurvedCellRegion       curved_region,
+  const unsigned int           max_patches_per_chunk,
+  const std::function<void()> &process_chunk)
 {
   // Check consistency of redundant template parameter
   Assert(dim == DoFHandlerType::dimension,
@@ -528,7 +735,6 @@ DataOut<dim, DoFHandlerType>::build_patches(
   }
 
   this->patches.clear();
-  this->patches.resize(all_cells.size());
 
   // now create a default object for the WorkStream object to work with
   unsigned int n_datasets = 0;
@@ -575,32 +781,73 @@ DataOut<dim, DoFHandlerType>::build_patches(
                 update_flags,
                 cell_to_patch_index_map);
 
-  // now build the patches in parallel
-  if (all_cells.size() > 0)
-    WorkStream::run(
-      all_cells.data(),
-      all_cells.data() + all_cells.size(),
-      std::bind(&DataOut<dim, DoFHandlerType>::build_one_patch,
-                this,
-                std::placeholders::_1,
-                std::placeholders::_2,
-                /* no std::placeholders::_3, since this function doesn't
-                   actually need a copy data object -- it just writes everything
-                   right into the output array */
-                n_subdivisions,
-                curved_cell_region),
-      // no copy-local-to-global function needed here
-      std::function<void(const int)>(),
-      thread_data,
-      /* dummy CopyData object = */ 0,
-      // experimenting shows that we can make things run a bit
-      // faster if we increase the number of cells we work on
-      // per item (i.e., WorkStream's chunk_size argument,
-      // about 10% improvement) and the items in flight at any
-      // given time (another 5% on the testcase discussed in
-      // @ref workstream_paper, on 32 cores) and if
-      8 * MultithreadInfo::n_threads(),
-      64);
+  // now build the patches in parallel, one chunk of consecutive cells at a
+  // time. the patches of each chunk replace the ones of the previous chunk,
+  // so only the patches of one chunk are stored at any given time
+  const std::size_t n_patches = all_cells.size();
+  std::size_t       first_patch_index = 0;
+  while (first_patch_index < n_patches)
+    {
+      const std::size_t end_patch_index =
+        first_patch_index +
+        std::min<std::size_t>(max_patches_per_chunk,
+                              n_patches - first_patch_index);
+      this->patches.resize(end_patch_index - first_patch_index);
+
+      WorkStream::run(
+        all_cells.data() + first_patch_index,
+        all_cells.data() + end_patch_index,
+        std::bind(&DataOut<dim, DoFHandlerType>::build_one_patch,
+                  this,
+                  std::placeholders::_1,
+                  std::placeholders::_2,
+                  /* no std::placeholders::_3, since this function doesn't
+                     actually need a copy data object -- it just writes
+                     everything right into the output array */
+                  n_subdivisions,
+                  curved_cell_region,
+                  first_patch_index,
+                  /* update_data_only = */ false),
+        // no copy-local-to-global function needed here
+        std::function<void(const int)>(),
+        thread_data,
+        /* dummy CopyData object = */ 0,
+        // experimenting shows that we can make things run a bit
+        // faster if we increase the number of cells we work on
+        // per item (i.e., WorkStream's chunk_size argument,
+        // about 10% improvement) and the items in flight at any
+        // given time (another 5% on the testcase discussed in
+        // @ref workstream_paper, on 32 cores) and if
+        8 * MultithreadInfo::n_threads(),
+        64);
+
+      if (process_chunk)
+        process_chunk();
+
+      first_patch_index = end_patch_index;
+    }
+
+  // if all patches are stored, keep track of the cells they were created
+  // from, so that update_patch_data() can later recompute their data
+  if (this->patches.size() == n_patches)
+    patch_cells = std::move(all_cells);
+  else
+    patch_cells.clear();
+
+  // also record the state of the mesh and the DoFHandler objects, and watch
+  // for changes of the mesh, so that update_patch_data() can verify that the
+  // patches are still valid
+  patch_triangulation  = this->triangulation;
+  patch_n_active_cells = this->triangulation->n_active_cells();
+  patch_dof_handlers.clear();
+  for (unsigned int i = 0; i < this->dof_data.size(); ++i)
+    patch_dof_handlers.push_back(this->dof_data[i]->dof_handler);
+
+  patch_triangulation_changed = false;
+  patch_triangulation_listener.disconnect();
+  patch_triangulation_listener =
+    this->triangulation->signals.any_change.connect(
+      [this]() { this->patch_triangulation_changed = true; });
 }
 
 
@@ -0,0 +1,121 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+// Check is_element(), index_within_set() and nth_index_in_set() for index
+// sets that consist of many short ranges, for which IndexSet uses a bitmap
+// to speed up lookups, against a plain list of the elements.
+
+#include <deal.II/base/index_set.h>
+
+#include "../tests.h"
+
+
+void
+check(const IndexSet &set, const std::vector<bool> &is_element)
+{
+  std::vector<types::global_dof_index> elements;
+  for (unsigned int i = 0; i < is_element.size(); ++i)
+    if (is_element[i])
+      elements.push_back(i);
+
+  AssertThrow(set.n_elements() == elements.size(), ExcInternalError());
+
+  types::global_dof_index n = 0;
+  for (unsigned int i = 0; i < is_element.size(); ++i)
+    {
+      AssertThrow(set.is_element(i) == is_element[i], ExcInternalError());
+      if (is_element[i])
+        {
+          AssertThrow(set.index_within_set(i) == n, ExcInternalError());
+          ++n;
+        }
+      else
+        AssertThrow(set.index_within_set(i) == numbers::invalid_dof_index,
+                    ExcInternalError());
+    }
+
+  for (unsigned int i = 0; i < elements.size(); ++i)
+    AssertThrow(set.nth_index_in_set(i) == elements[i], ExcInternalError());
+
+  deallog << "n_elements: " << set.n_elements()
+          << ", n_intervals: " << set.n_intervals() << " OK" << std::endl;
+}
+
+
+
+void
+test(const std::vector<unsigned int> &indices, const bool with_large_range)
+{
+  const unsigned int size = 20000;
+  IndexSet           set(size);
+  std::vector<bool>  is_element(size, false);
+
+  for (const unsigned int i : indices)
+    {
+      set.add_index(i);
+      is_element[i] = true;
+    }
+
+  // a large range, like the locally owned range of a vector with ghosts
+  if (with_large_range)
+    {
+      set.add_range(5003, 14011);
+      for (unsigned int i = 5003; i < 14011; ++i)
+        is_element[i] = true;
+    }
+
+  set.compress();
+  check(set, is_element);
+
+  // copy the set and remove its last elements
+  IndexSet copy(set);
+  for (unsigned int i = 0; i < 3; ++i)
+    is_element[copy.pop_back()] = false;
+  check(copy, is_element);
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  // every stride-th index, plus a few pairs of neighbors
+  for (const unsigned int stride : {2, 3, 17, 64, 130})
+    {
+      deallog << "stride " << stride << std::endl;
+      std::vector<unsigned int> indices;
+      for (unsigned int i = 0; i < 20000; i += stride)
+        {
+          indices.push_back(i);
+          if (i % 7 == 0)
+            indices.push_back(i + 1);
+        }
+      test(indices, false);
+      test(indices, true);
+    }
+
+  // clusters of isolated indices far apart from each other
+  {
+    deallog << "clusters" << std::endl;
+    std::vector<unsigned int> indices;
+    for (unsigned int i = 0; i < 20000; i += 320)
+      for (unsigned int j = 0; j < 32; j += 2)
+        indices.push_back(i + j);
+    test(indices, false);
+    test(indices, true);
+  }
+}
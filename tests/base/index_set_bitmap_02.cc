@@ -0,0 +1,149 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// Check that compress() sets up the bitmap that is_element() and
+// index_within_set() use for lookups outside the largest range for sets
+// that look like the locally relevant indices of a parallel vector: a
+// locally owned range plus ghost indices scattered over the ranges of the
+// neighbors, or over the whole index space. The elements are added in
+// ascending order, so that compress() does not merge any ranges and the
+// additional memory after compress() is that of the bitmap. Also check that
+// the bitmap stays within its memory bound and is not created for sets
+// whose words would be too sparse.
+
+#include <deal.II/base/index_set.h>
+
+#include "../tests.h"
+
+
+void
+test(const std::string &                     name,
+     const types::global_dof_index           size,
+     const std::vector<types::global_dof_index> &begins,
+     const std::vector<types::global_dof_index> &ends)
+{
+  IndexSet          set(size);
+  std::vector<bool> is_element(size, false);
+  for (unsigned int r = 0; r < begins.size(); ++r)
+    {
+      set.add_range(begins[r], ends[r]);
+      for (types::global_dof_index i = begins[r]; i < ends[r]; ++i)
+        is_element[i] = true;
+    }
+
+  const std::size_t memory_without_bitmap = set.memory_consumption();
+  set.compress();
+  const std::size_t bitmap_memory =
+    set.memory_consumption() - memory_without_bitmap;
+  const std::size_t memory_bound =
+    4 * set.n_intervals() * 3 * sizeof(types::global_dof_index) +
+    set.n_elements();
+
+  types::global_dof_index n      = 0;
+  bool                    lookup = true;
+  for (types::global_dof_index i = 0; i < size; ++i)
+    {
+      lookup &= (set.is_element(i) == is_element[i]);
+      lookup &= (set.index_within_set(i) ==
+                 (is_element[i] ? n : numbers::invalid_dof_index));
+      if (is_element[i])
+        {
+          lookup &= (set.nth_index_in_set(n) == i);
+          ++n;
+        }
+    }
+
+  deallog << name << ": n_intervals " << set.n_intervals()
+          << ", bitmap: " << (bitmap_memory > 0 ? "yes" : "no")
+          << ", within memory bound: "
+          << (bitmap_memory <= memory_bound ? "yes" : "no")
+          << ", lookups: " << (lookup ? "OK" : "wrong") << std::endl;
+}
+
+
+
+// a locally owned range, plus every stride-th index of the given ranges of
+// ghost indices, in groups of block_size consecutive indices
+void
+test_ghosts(const std::string &                                name,
+            const types::global_dof_index                      size,
+            const std::pair<types::global_dof_index,
+                            types::global_dof_index> &         owned,
+            const std::vector<std::pair<types::global_dof_index,
+                                        types::global_dof_index>> &ghosts,
+            const types::global_dof_index                      stride,
+            const types::global_dof_index                      block_size)
+{
+  std::vector<types::global_dof_index> begins, ends;
+  const auto add = [&](const types::global_dof_index b,
+                       const types::global_dof_index e) {
+    if (!ends.empty() && b <= ends.back())
+      ends.back() = std::max(ends.back(), e);
+    else
+      {
+        begins.push_back(b);
+        ends.push_back(e);
+      }
+  };
+
+  std::vector<std::pair<types::global_dof_index, types::global_dof_index>>
+    ranges = ghosts;
+  ranges.push_back(owned);
+  std::sort(ranges.begin(), ranges.end());
+  for (const auto &range : ranges)
+    if (range == owned)
+      add(owned.first, owned.second);
+    else
+      for (types::global_dof_index i = range.first; i < range.second;
+           i += stride)
+        if (i < owned.first || i >= owned.second)
+          add(i, std::min(i + block_size, range.second));
+
+  test(name, size, begins, ends);
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  // ghost indices in the ranges of the two neighbors
+  test_ghosts("neighbors",
+              1000000,
+              {400000, 500000},
+              {{300000, 400000}, {500000, 600000}},
+              97,
+              1);
+
+  // ghost indices of discontinuous elements: blocks of consecutive indices
+  test_ghosts("neighbors, blocks",
+              1000000,
+              {400000, 500000},
+              {{300000, 400000}, {500000, 600000}},
+              200,
+              4);
+
+  // ghost indices scattered over the whole index space
+  test_ghosts("everywhere", 1000000, {400000, 500000}, {{0, 1000000}}, 997, 1);
+
+  // only a few ghost indices: searching the ranges is cheap enough
+  test_ghosts("few", 1000000, {400000, 500000}, {{0, 1000000}}, 100000, 1);
+
+  // ranges spanning several words each, far apart from each other
+  test_ghosts("sparse", 1000000, {0, 300}, {{0, 1000000}}, 10000, 300);
+}
@@ -0,0 +1,160 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+// Test Utilities::MPI::RemotePointEvaluation on a serial triangulation:
+// evaluate a finite element function at a set of points, move some of the
+// points with update_points(), and evaluate again.
+
+#include <deal.II/base/function.h>
+#include <deal.II/base/mpi_remote_point_evaluation.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_values.h>
+#include <deal.II/fe/mapping_q1.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/vector.h>
+
+#include <deal.II/numerics/vector_tools.h>
+
+#include "../tests.h"
+
+
+template <int dim>
+class LinearFunction : public Function<dim>
+{
+public:
+  virtual double
+  value(const Point<dim> &p, const unsigned int) const override
+  {
+    double result = 0;
+    for (unsigned int d = 0; d < dim; ++d)
+      result += (d + 1.) * p[d];
+    return result;
+  }
+};
+
+
+
+template <int dim>
+void
+evaluate(const Utilities::MPI::RemotePointEvaluation<dim> &evaluator,
+         const DoFHandler<dim> &                          dof_handler,
+         const Vector<double> &                           solution)
+{
+  const auto evaluation_function =
+    [&](const ArrayView<double> &values,
+        const typename Utilities::MPI::RemotePointEvaluation<dim>::CellData
+          &cell_data) {
+      for (unsigned int c = 0; c < cell_data.cells.size(); ++c)
+        {
+          const typename DoFHandler<dim>::active_cell_iterator cell(
+            &evaluator.get_triangulation(),
+            cell_data.cells[c].first,
+            cell_data.cells[c].second,
+            &dof_handler);
+
+          const unsigned int begin = cell_data.reference_point_ptrs[c];
+          const unsigned int end   = cell_data.reference_point_ptrs[c + 1];
+
+          FEValues<dim> fe_values(
+            evaluator.get_mapping(),
+            dof_handler.get_fe(),
+            Quadrature<dim>(std::vector<Point<dim>>(
+              cell_data.reference_point_values.begin() + begin,
+              cell_data.reference_point_values.begin() + end)),
+            update_values);
+          fe_values.reinit(cell);
+
+          std::vector<double> cell_values(end - begin);
+          fe_values.get_function_values(solution, cell_values);
+          for (unsigned int q = 0; q < cell_values.size(); ++q)
+            values[begin + q] = cell_values[q];
+        }
+    };
+
+  std::vector<double> output;
+  evaluator.template evaluate_and_process<double>(output, evaluation_function);
+
+  for (unsigned int i = 0; i < output.size(); ++i)
+    deallog << evaluator.get_points()[i] << ": "
+            << (evaluator.point_found(i) ? "found" : "not found") << ", "
+            << output[i] << std::endl;
+  deallog << "All points found: " << std::boolalpha
+          << evaluator.all_points_found() << std::endl;
+}
+
+
+
+template <int dim>
+void
+test()
+{
+  deallog << "dim=" << dim << std::endl;
+
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(3);
+
+  FE_Q<dim>       fe(1);
+  DoFHandler<dim> dof_handler(tria);
+  dof_handler.distribute_dofs(fe);
+
+  // a linear function is represented exactly
+  Vector<double> solution(dof_handler.n_dofs());
+  VectorTools::interpolate(dof_handler, LinearFunction<dim>(), solution);
+
+  std::vector<Point<dim>> points;
+  for (unsigned int i = 0; i < 4; ++i)
+    {
+      Point<dim> p;
+      for (unsigned int d = 0; d < dim; ++d)
+        p[d] = 0.1 + 0.2 * i + 0.05 * d;
+      points.push_back(p);
+    }
+  Point<dim> outside;
+  outside[0] = 1.5;
+  points.push_back(outside);
+
+  const MappingQ1<dim>                       mapping;
+  Utilities::MPI::RemotePointEvaluation<dim> evaluator;
+  evaluator.reinit(points, tria, mapping);
+  evaluate(evaluator, dof_handler, solution);
+
+  // move one point into another cell and the outside point into the domain
+  Point<dim> moved_1, moved_4;
+  for (unsigned int d = 0; d < dim; ++d)
+    {
+      moved_1[d] = 0.9;
+      moved_4[d] = 0.25;
+    }
+  evaluator.update_points({1, 4}, {moved_1, moved_4});
+  evaluate(evaluator, dof_handler, solution);
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test<2>();
+  test<3>();
+}
@@ -0,0 +1,179 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// Test Utilities::MPI::RemotePointEvaluation on a distributed
+// triangulation together with VectorTools::point_values and
+// VectorTools::point_gradients: every process asks for points that are
+// owned by other processes, and some of the points are moved with
+// update_points() between two evaluations.
+
+#include <deal.II/base/function.h>
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/mpi_remote_point_evaluation.h>
+
+#include <deal.II/distributed/shared_tria.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+#include <deal.II/fe/mapping_q1.h>
+
+#include <deal.II/grid/grid_generator.h>
+
+#include <deal.II/lac/vector.h>
+
+#include <deal.II/numerics/vector_tools.h>
+#include <deal.II/numerics/vector_tools_evaluate.h>
+
+#include "../tests.h"
+
+
+// a linear function, which is represented exactly by FE_Q(1)
+template <int dim>
+class LinearFunction : public Function<dim>
+{
+public:
+  LinearFunction()
+    : Function<dim>(2)
+  {}
+
+  virtual double
+  value(const Point<dim> &p, const unsigned int component) const override
+  {
+    double result = 0;
+    for (unsigned int d = 0; d < dim; ++d)
+      result += (component + 1.) * (d + 1.) * p[d];
+    return result;
+  }
+};
+
+
+
+template <int dim>
+void
+evaluate(const Utilities::MPI::RemotePointEvaluation<dim> &evaluation,
+         const DoFHandler<dim> &                          dof_handler,
+         const Vector<double> &                           solution)
+{
+  const std::vector<Vector<double>> values =
+    VectorTools::point_values(evaluation, dof_handler, solution);
+  const std::vector<std::vector<Tensor<1, dim>>> gradients =
+    VectorTools::point_gradients(evaluation, dof_handler, solution);
+
+  AssertDimension(values.size(), evaluation.get_points().size());
+  AssertDimension(gradients.size(), evaluation.get_points().size());
+
+  const LinearFunction<dim> function;
+  for (unsigned int i = 0; i < values.size(); ++i)
+    {
+      deallog << evaluation.get_points()[i] << ": "
+              << (evaluation.point_found(i) ? "found" : "not found")
+              << ", values " << values[i][0] << ' ' << values[i][1]
+              << ", gradients " << gradients[i][0] << ", " << gradients[i][1]
+              << std::endl;
+
+      if (evaluation.point_found(i))
+        for (unsigned int c = 0; c < 2; ++c)
+          {
+            AssertThrow(std::abs(values[i][c] -
+                                 function.value(evaluation.get_points()[i],
+                                                c)) < 1e-10,
+                        ExcInternalError());
+            for (unsigned int d = 0; d < dim; ++d)
+              AssertThrow(std::abs(gradients[i][c][d] - (c + 1.) * (d + 1.)) <
+                            1e-10,
+                          ExcInternalError());
+          }
+    }
+  deallog << "All points found: " << std::boolalpha
+          << evaluation.all_points_found() << std::endl;
+}
+
+
+
+template <int dim>
+void
+test()
+{
+  deallog << "dim=" << dim << std::endl;
+
+  const unsigned int my_rank = Utilities::MPI::this_mpi_process(MPI_COMM_WORLD);
+  const unsigned int n_ranks = Utilities::MPI::n_mpi_processes(MPI_COMM_WORLD);
+
+  parallel::shared::Triangulation<dim> tria(MPI_COMM_WORLD);
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(3);
+
+  FESystem<dim>   fe(FE_Q<dim>(1), 2);
+  DoFHandler<dim> dof_handler(tria);
+  dof_handler.distribute_dofs(fe);
+
+  Vector<double> solution(dof_handler.n_dofs());
+  VectorTools::interpolate(dof_handler, LinearFunction<dim>(), solution);
+
+  // the points of each process are spread over the whole domain, and are
+  // therefore mostly owned by other processes. the last point of the first
+  // process lies outside the domain
+  std::vector<Point<dim>> points;
+  for (unsigned int i = 0; i < 4; ++i)
+    {
+      Point<dim> p;
+      for (unsigned int d = 0; d < dim; ++d)
+        p[d] = (i + ((my_rank + d) % n_ranks + 0.5) / n_ranks) / 4.;
+      points.push_back(p);
+    }
+  if (my_rank == 0)
+    {
+      Point<dim> outside;
+      outside[0] = 1.5;
+      points.push_back(outside);
+    }
+
+  const MappingQ1<dim>                       mapping;
+  Utilities::MPI::RemotePointEvaluation<dim> evaluation;
+  evaluation.reinit(points, tria, mapping);
+  evaluate(evaluation, dof_handler, solution);
+
+  // move a point on every process but the last one, and the point outside
+  // the domain into it
+  std::vector<unsigned int> indices;
+  std::vector<Point<dim>>   new_points;
+  if (my_rank + 1 < n_ranks)
+    {
+      indices.push_back(1);
+      new_points.push_back(points[3] * 0.5);
+    }
+  if (my_rank == 0)
+    {
+      indices.push_back(4);
+      new_points.push_back(points[3] * 0.9);
+    }
+  evaluation.update_points(indices, new_points);
+  evaluate(evaluation, dof_handler, solution);
+}
+
+
+
+int
+main(int argc, char **argv)
+{
+  Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+  MPILogInitAll                    log;
+
+  test<2>();
+  test<3>();
+}
@@ -0,0 +1,125 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// Check that the compute() functions of TensorProductPolynomials and
+// PolynomialSpace that evaluate many points at once give the same result as
+// evaluating one point at a time, for polynomials in Lagrange product form
+// and in coefficient form, for piecewise polynomials, and for a number of
+// points that is not a multiple of the vectorization width
+
+#include <deal.II/base/polynomial.h>
+#include <deal.II/base/polynomial_space.h>
+#include <deal.II/base/polynomials_piecewise.h>
+#include <deal.II/base/quadrature_lib.h>
+#include <deal.II/base/table.h>
+#include <deal.II/base/tensor_product_polynomials.h>
+
+#include "../tests.h"
+
+
+template <int dim, typename PolynomialType>
+void
+check(const PolynomialType &poly, const std::string &name)
+{
+  std::vector<Point<dim>> points;
+  for (unsigned int q = 0; q < 13; ++q)
+    {
+      Point<dim> p;
+      for (unsigned int d = 0; d < dim; ++d)
+        p[d] = std::fmod(0.173 * (q + 1) * (d + 1.1), 1.);
+      points.push_back(p);
+    }
+
+  const unsigned int       n = poly.n();
+  Table<2, double>         values(n, points.size());
+  Table<2, Tensor<1, dim>> grads(n, points.size());
+  Table<2, double>         values_only(n, points.size());
+  Table<2, Tensor<1, dim>> no_grads;
+  poly.compute(points, values, grads);
+  poly.compute(points, values_only, no_grads);
+
+  std::vector<double>         point_values(n);
+  std::vector<Tensor<1, dim>> point_grads(n);
+  std::vector<Tensor<2, dim>> grad_grads;
+  std::vector<Tensor<3, dim>> third_derivatives;
+  std::vector<Tensor<4, dim>> fourth_derivatives;
+  double                      error = 0;
+  for (unsigned int q = 0; q < points.size(); ++q)
+    {
+      poly.compute(points[q],
+                   point_values,
+                   point_grads,
+                   grad_grads,
+                   third_derivatives,
+                   fourth_derivatives);
+      for (unsigned int i = 0; i < n; ++i)
+        {
+          error = std::max(error, std::abs(values(i, q) - point_values[i]));
+          error =
+            std::max(error, std::abs(values_only(i, q) - point_values[i]));
+          error = std::max(error, (grads(i, q) - point_grads[i]).norm());
+        }
+    }
+
+  deallog << "dim=" << dim << ", " << name << ", " << n << " polynomials: "
+          << (error < 1e-12 ? "OK" : "FAILED") << std::endl;
+}
+
+
+
+template <int dim>
+void
+test()
+{
+  const std::vector<Polynomials::Polynomial<double>> lagrange =
+    Polynomials::generate_complete_Lagrange_basis(
+      QGaussLobatto<1>(4).get_points());
+  const std::vector<Polynomials::Polynomial<double>> legendre =
+    Polynomials::Legendre::generate_complete_basis(3);
+
+  check<dim>(TensorProductPolynomials<dim>(lagrange),
+             "TensorProductPolynomials<Lagrange>");
+
+  // a tensor product space with a non-trivial numbering
+  TensorProductPolynomials<dim> renumbered(legendre);
+  std::vector<unsigned int>     numbering(renumbered.n());
+  for (unsigned int i = 0; i < numbering.size(); ++i)
+    numbering[i] = numbering.size() - 1 - i;
+  renumbered.set_numbering(numbering);
+  check<dim>(renumbered, "TensorProductPolynomials<Legendre>");
+
+  check<dim>(
+    TensorProductPolynomials<dim, Polynomials::PiecewisePolynomial<double>>(
+      Polynomials::generate_complete_Lagrange_basis_on_subdivisions(2, 2)),
+    "TensorProductPolynomials<PiecewisePolynomial>");
+
+  check<dim>(PolynomialSpace<dim>(legendre), "PolynomialSpace<Legendre>");
+  check<dim>(PolynomialSpace<dim>(
+               Polynomials::Monomial<double>::generate_complete_basis(4)),
+             "PolynomialSpace<Monomial>");
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test<1>();
+  test<2>();
+  test<3>();
+}
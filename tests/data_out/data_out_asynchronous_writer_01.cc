@@ -0,0 +1,125 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+// Check DataOutAsynchronousWriter: the files it writes must be the same as
+// the ones written directly, even if the object they were taken from is
+// changed right after the call to write(), the number of pending writes must
+// not exceed the limit given to the constructor, and the failure to open a
+// file must be reported by wait().
+
+#include <deal.II/base/data_out_asynchronous_writer.h>
+#include <deal.II/base/data_out_base.h>
+
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../tests.h"
+#include "patches.h"
+
+
+template <int dim, int spacedim>
+class TestDataOut : public DataOutInterface<dim, spacedim>
+{
+public:
+  std::vector<DataOutBase::Patch<dim, spacedim>> patches;
+  std::vector<std::string>                       names;
+
+protected:
+  virtual const std::vector<DataOutBase::Patch<dim, spacedim>> &
+  get_patches() const override
+  {
+    return patches;
+  }
+
+  virtual std::vector<std::string>
+  get_dataset_names() const override
+  {
+    return names;
+  }
+};
+
+
+std::string
+read_file(const std::string &filename)
+{
+  std::ifstream in(filename);
+  AssertThrow(in, ExcFileNotOpen(filename));
+  std::ostringstream contents;
+  contents << in.rdbuf();
+  return contents.str();
+}
+
+
+template <int dim, int spacedim>
+void
+check()
+{
+  TestDataOut<dim, spacedim> data_out;
+  data_out.patches.resize(4);
+  create_patches(data_out.patches);
+  data_out.names = {"x1", "x2", "x3", "x4", "i"};
+
+  DataOutBase::VtkFlags flags;
+  flags.print_date_and_time = false;
+  data_out.set_flags(flags);
+  data_out.set_default_format(DataOutBase::gnuplot);
+
+  std::ostringstream vtu, gnuplot;
+  data_out.write(vtu, DataOutBase::vtu);
+  data_out.write(gnuplot);
+
+  const std::string name = "output_" + Utilities::int_to_string(dim) +
+                           Utilities::int_to_string(spacedim);
+
+  DataOutAsynchronousWriter<dim, spacedim> writer(2);
+  writer.write(data_out, name + ".vtu", DataOutBase::vtu);
+  writer.write(data_out, name + ".gnuplot");
+  writer.write(data_out, "nonexistent_directory/" + name + ".vtu");
+  deallog << "Pending writes: " << writer.n_pending_writes() << std::endl;
+
+  // the writer must have taken a snapshot of the patches
+  data_out.patches.clear();
+
+  try
+    {
+      writer.wait();
+      deallog << "No exception" << std::endl;
+    }
+  catch (const ExceptionBase &exc)
+    {
+      deallog << exc.get_exc_name() << std::endl;
+    }
+  deallog << "Pending writes: " << writer.n_pending_writes() << std::endl;
+
+  AssertThrow(read_file(name + ".vtu") == vtu.str(), ExcInternalError());
+  AssertThrow(read_file(name + ".gnuplot") == gnuplot.str(),
+              ExcInternalError());
+
+  // the error has been reported, so waiting again must not throw
+  writer.wait();
+  deallog << dim << spacedim << " OK" << std::endl;
+}
+
+
+int
+main()
+{
+  initlog();
+
+  check<2, 2>();
+  check<3, 3>();
+}
@@ -0,0 +1,94 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+// Check VtkFlags::compression_block_size: a block size larger than any of
+// the data arrays must give the same output as the default of a single
+// block, and the output with small blocks must not depend on the number of
+// threads used to compress them.
+
+#include <deal.II/base/data_out_base.h>
+#include <deal.II/base/multithread_info.h>
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../tests.h"
+#include "patches.h"
+
+
+template <int dim, int spacedim>
+std::string
+write(const DataOutBase::VtkFlags &flags)
+{
+  const unsigned int np = 4;
+
+  std::vector<DataOutBase::Patch<dim, spacedim>> patches(np);
+
+  create_patches(patches);
+
+  std::vector<std::string> names(5);
+  names[0] = "x1";
+  names[1] = "x2";
+  names[2] = "x3";
+  names[3] = "x4";
+  names[4] = "i";
+  std::vector<
+    std::tuple<unsigned int,
+               unsigned int,
+               std::string,
+               DataComponentInterpretation::DataComponentInterpretation>>
+    vectors;
+
+  std::ostringstream out;
+  DataOutBase::write_vtu(patches, names, vectors, flags, out);
+  return out.str();
+}
+
+
+template <int dim, int spacedim>
+void
+check()
+{
+  DataOutBase::VtkFlags flags;
+  flags.print_date_and_time = false;
+
+  const std::string single_block = write<dim, spacedim>(flags);
+
+  flags.compression_block_size = 1000000;
+  const std::string large_blocks = write<dim, spacedim>(flags);
+  AssertThrow(large_blocks == single_block, ExcInternalError());
+
+  flags.compression_block_size = 64;
+  MultithreadInfo::set_thread_limit(1);
+  const std::string blocks_sequential = write<dim, spacedim>(flags);
+  MultithreadInfo::set_thread_limit();
+  const std::string blocks_parallel = write<dim, spacedim>(flags);
+  AssertThrow(blocks_parallel == blocks_sequential, ExcInternalError());
+  AssertThrow(blocks_parallel != single_block, ExcInternalError());
+
+  deallog << dim << spacedim << " OK" << std::endl;
+}
+
+
+int
+main()
+{
+  initlog();
+
+  check<1, 1>();
+  check<2, 2>();
+  check<3, 3>();
+}
@@ -0,0 +1,207 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// Check VtkFlags::lz4_compressed: decode and decompress all data arrays of a
+// VTU file, once as a single block and once split into many small blocks,
+// and compare them with the arrays of the same file written in raw binary
+// format
+
+#include <deal.II/base/data_out_base.h>
+
+#include <lz4.h>
+
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../tests.h"
+#include "patches.h"
+
+
+std::vector<unsigned char>
+decode_base64(const std::string &encoded)
+{
+  const std::string alphabet =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+  AssertThrow(encoded.size() % 4 == 0, ExcInternalError());
+
+  std::vector<unsigned char> decoded;
+  for (std::size_t i = 0; i < encoded.size(); i += 4)
+    {
+      unsigned int bits = 0, n_padding = 0;
+      for (std::size_t j = i; j < i + 4; ++j)
+        if (encoded[j] == '=')
+          {
+            bits <<= 6;
+            ++n_padding;
+          }
+        else
+          {
+            const std::size_t value = alphabet.find(encoded[j]);
+            AssertThrow(value != std::string::npos, ExcInternalError());
+            bits = (bits << 6) | value;
+          }
+      for (unsigned int k = 0; k < 3 - n_padding; ++k)
+        decoded.push_back((bits >> (16 - 8 * k)) & 0xff);
+    }
+  return decoded;
+}
+
+
+
+// decode an array written with VtkFlags::lz4_compressed. the header with
+// the number of blocks, the block sizes, and the compressed block sizes is
+// encoded separately from the compressed blocks
+std::vector<char>
+decompress_array(const std::string &encoded)
+{
+  const std::vector<unsigned char> first_entries =
+    decode_base64(encoded.substr(0, 16));
+  uint32_t n_blocks;
+  std::memcpy(&n_blocks, first_entries.data(), sizeof(n_blocks));
+
+  const std::size_t header_length = 4 * ((4 * (3 + n_blocks) + 2) / 3);
+  const std::vector<unsigned char> header_bytes =
+    decode_base64(encoded.substr(0, header_length));
+  std::vector<uint32_t> header(3 + n_blocks);
+  std::memcpy(header.data(), header_bytes.data(), 4 * header.size());
+
+  const std::vector<unsigned char> compressed_data =
+    decode_base64(encoded.substr(header_length));
+
+  std::vector<char> data;
+  std::size_t       position = 0;
+  for (uint32_t b = 0; b < n_blocks; ++b)
+    {
+      const uint32_t block_size = (b == n_blocks - 1 ? header[2] : header[1]);
+      std::vector<char> block(block_size);
+      const int         size = LZ4_decompress_safe(
+        reinterpret_cast<const char *>(compressed_data.data()) + position,
+        block.data(),
+        header[3 + b],
+        block_size);
+      AssertThrow(size == static_cast<int>(block_size), ExcInternalError());
+      data.insert(data.end(), block.begin(), block.end());
+      position += header[3 + b];
+    }
+  AssertThrow(position == compressed_data.size(), ExcInternalError());
+  return data;
+}
+
+
+
+// return the arrays of a VTU file in raw binary format
+std::vector<std::vector<char>>
+raw_arrays(const std::string &file)
+{
+  const std::string marker = "<AppendedData encoding=\"raw\">\n_";
+  const std::size_t start  = file.find(marker) + marker.size();
+
+  std::vector<std::vector<char>> arrays;
+  std::size_t position = file.find("offset=\"");
+  while (position != std::string::npos)
+    {
+      const std::size_t offset = std::stoul(file.substr(position + 8));
+      uint32_t          n_bytes;
+      std::memcpy(&n_bytes, &file[start + offset], sizeof(n_bytes));
+      arrays.emplace_back(file.begin() + start + offset + sizeof(n_bytes),
+                          file.begin() + start + offset + sizeof(n_bytes) +
+                            n_bytes);
+      position = file.find("offset=\"", position + 1);
+    }
+  return arrays;
+}
+
+
+
+// return the arrays of a VTU file compressed with LZ4
+std::vector<std::vector<char>>
+lz4_arrays(const std::string &file)
+{
+  AssertThrow(file.find("compressor=\"vtkLZ4DataCompressor\"") !=
+                std::string::npos,
+              ExcInternalError());
+
+  std::vector<std::vector<char>> arrays;
+  std::istringstream             in(file);
+  std::string                    line;
+  while (std::getline(in, line))
+    if (line.find("format=\"binary\"") != std::string::npos)
+      {
+        // the closing tag may follow the data on the same line
+        std::getline(in, line);
+        arrays.push_back(decompress_array(line.substr(0, line.find(' '))));
+      }
+  return arrays;
+}
+
+
+
+template <int dim, int spacedim>
+void
+check()
+{
+  std::vector<DataOutBase::Patch<dim, spacedim>> patches(4);
+  create_patches(patches);
+
+  std::vector<std::string> names(5);
+  names[0] = "x1";
+  names[1] = "x2";
+  names[2] = "x3";
+  names[3] = "x4";
+  names[4] = "i";
+  std::vector<
+    std::tuple<unsigned int,
+               unsigned int,
+               std::string,
+               DataComponentInterpretation::DataComponentInterpretation>>
+    vectors;
+
+  DataOutBase::VtkFlags flags;
+  flags.print_date_and_time = false;
+
+  flags.data_format = DataOutBase::VtkFlags::raw_appended;
+  std::ostringstream raw_out;
+  DataOutBase::write_vtu(patches, names, vectors, flags, raw_out);
+  const std::vector<std::vector<char>> reference = raw_arrays(raw_out.str());
+
+  flags.data_format = DataOutBase::VtkFlags::lz4_compressed;
+  for (const unsigned int block_size : {0, 16})
+    {
+      flags.compression_block_size = block_size;
+      std::ostringstream lz4_out;
+      DataOutBase::write_vtu(patches, names, vectors, flags, lz4_out);
+      const std::vector<std::vector<char>> arrays = lz4_arrays(lz4_out.str());
+
+      deallog << dim << spacedim << ", block size " << block_size << ": "
+              << arrays.size() << " arrays, "
+              << (arrays == reference ? "identical" : "different")
+              << std::endl;
+    }
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  check<1, 1>();
+  check<2, 2>();
+  check<3, 3>();
+}
@@ -0,0 +1,126 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+// Check VtkFlags::raw_appended: write the XML part of the file and then
+// decode the data arrays from the raw binary block at the end of the file,
+// using the offsets given in the XML part.
+
+#include <deal.II/base/data_out_base.h>
+
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../tests.h"
+#include "patches.h"
+
+
+template <typename T>
+void
+print_array(const std::string &data, const std::size_t offset)
+{
+  uint32_t n_bytes;
+  std::memcpy(&n_bytes, &data[offset], sizeof(n_bytes));
+  AssertThrow(n_bytes % sizeof(T) == 0, ExcInternalError());
+
+  std::vector<T> values(n_bytes / sizeof(T));
+  std::memcpy(values.data(), &data[offset + sizeof(n_bytes)], n_bytes);
+  for (const T value : values)
+    deallog << ' ' << +value;
+  deallog << std::endl;
+}
+
+
+template <int dim, int spacedim>
+void
+check()
+{
+  std::vector<DataOutBase::Patch<dim, spacedim>> patches(1);
+  create_patches(patches);
+
+  std::vector<std::string> names(5);
+  names[0] = "x1";
+  names[1] = "x2";
+  names[2] = "x3";
+  names[3] = "x4";
+  names[4] = "i";
+  std::vector<
+    std::tuple<unsigned int,
+               unsigned int,
+               std::string,
+               DataComponentInterpretation::DataComponentInterpretation>>
+    vectors;
+
+  DataOutBase::VtkFlags flags;
+  flags.print_date_and_time = false;
+  flags.data_format         = DataOutBase::VtkFlags::raw_appended;
+
+  std::ostringstream out;
+  DataOutBase::write_vtu(patches, names, vectors, flags, out);
+  const std::string file = out.str();
+
+  const std::string marker = "<AppendedData encoding=\"raw\">\n_";
+  const std::string end    = "\n</AppendedData>\n</VTKFile>\n";
+  const std::size_t start  = file.find(marker);
+  AssertThrow(start != std::string::npos, ExcInternalError());
+  AssertThrow(file.compare(file.size() - end.size(), end.size(), end) == 0,
+              ExcInternalError());
+  const std::string data = file.substr(start + marker.size());
+
+  deallog << dim << spacedim << std::endl;
+  std::istringstream xml(file.substr(0, start));
+  std::string        line;
+  while (std::getline(xml, line))
+    {
+      if (line.find("<!--") != std::string::npos)
+        {
+          // skip the comment with the version of deal.II
+          while (line.find("-->") == std::string::npos)
+            std::getline(xml, line);
+          continue;
+        }
+      if (line.find_first_not_of(' ') == std::string::npos)
+        continue;
+
+      deallog << line << std::endl;
+
+      const std::size_t offset_position = line.find("offset=\"");
+      if (offset_position != std::string::npos)
+        {
+          const std::size_t offset =
+            std::stoul(line.substr(offset_position + 8));
+          if (line.find("\"Float32\"") != std::string::npos)
+            print_array<float>(data, offset);
+          else if (line.find("\"Int32\"") != std::string::npos)
+            print_array<int32_t>(data, offset);
+          else if (line.find("\"UInt8\"") != std::string::npos)
+            print_array<uint8_t>(data, offset);
+          else
+            AssertThrow(false, ExcInternalError());
+        }
+    }
+}
+
+
+int
+main()
+{
+  initlog();
+
+  check<1, 1>();
+  check<2, 2>();
+  check<3, 3>();
+}
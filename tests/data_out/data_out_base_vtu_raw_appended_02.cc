@@ -0,0 +1,126 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// VtkFlags::raw_appended needs a separate stream for the data arrays of
+// files written piece by piece: check that write_vtu_main() without one and
+// write_vtu_in_parallel() throw an exception, the latter before creating the
+// file, and that the offsets that write_vtu() writes into the XML
+// description before it computes the data arrays match the data arrays
+
+#include <deal.II/base/data_out_base.h>
+#include <deal.II/base/mpi.h>
+
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../tests.h"
+#include "patches.h"
+
+
+std::vector<DataOutBase::Patch<2, 2>> patches;
+std::vector<std::string>              names;
+
+class DataOutX : public DataOutInterface<2, 2>
+{
+  virtual const std::vector<::DataOutBase::Patch<2, 2>> &
+  get_patches() const
+  {
+    return patches;
+  }
+
+  virtual std::vector<std::string>
+  get_dataset_names() const
+  {
+    return names;
+  }
+};
+
+
+
+int
+main(int argc, char **argv)
+{
+  Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+  initlog();
+
+  patches.resize(2);
+  create_patches(patches);
+  names = {"x1", "x2", "x3", "x4", "i"};
+
+  DataOutX              data_out;
+  DataOutBase::VtkFlags flags;
+  flags.print_date_and_time = false;
+  flags.data_format         = DataOutBase::VtkFlags::raw_appended;
+  data_out.set_flags(flags);
+
+  try
+    {
+      std::ostringstream out;
+      data_out.write_vtu_main(out);
+    }
+  catch (const ExceptionBase &e)
+    {
+      deallog << "write_vtu_main: " << e.get_exc_name() << std::endl;
+    }
+
+  try
+    {
+      data_out.write_vtu_in_parallel("output.vtu", MPI_COMM_WORLD);
+    }
+  catch (const ExceptionBase &e)
+    {
+      deallog << "write_vtu_in_parallel: " << e.get_exc_name() << std::endl;
+    }
+  deallog << "output.vtu exists: "
+          << (std::ifstream("output.vtu").good() ? "yes" : "no") << std::endl;
+
+  // the XML description is written before the data arrays are computed,
+  // so check that the offsets given there match the arrays that follow
+  std::ostringstream out;
+  data_out.write_vtu(out);
+  const std::string file   = out.str();
+  const std::string marker = "<AppendedData encoding=\"raw\">\n_";
+  const std::string end    = "\n</AppendedData>\n</VTKFile>\n";
+  const std::size_t start  = file.find(marker);
+  AssertThrow(start != std::string::npos, ExcInternalError());
+  const std::string data = file.substr(start + marker.size(),
+                                       file.size() - start - marker.size() -
+                                         end.size());
+
+  std::istringstream xml(file.substr(0, start));
+  std::string        line;
+  std::size_t        next_offset = 0;
+  bool               consistent  = true;
+  while (std::getline(xml, line))
+    {
+      const std::size_t offset_position = line.find("offset=\"");
+      if (offset_position == std::string::npos)
+        continue;
+
+      const std::size_t offset = std::stoul(line.substr(offset_position + 8));
+      deallog << "offset " << offset << std::endl;
+      consistent &= (offset == next_offset);
+
+      uint32_t n_bytes;
+      std::memcpy(&n_bytes, &data[offset], sizeof(n_bytes));
+      next_offset = offset + sizeof(n_bytes) + n_bytes;
+    }
+  consistent &= (next_offset == data.size());
+  deallog << "offsets consistent with appended data: "
+          << (consistent ? "yes" : "no") << std::endl;
+}
@@ -0,0 +1,171 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// Write a VTU file in raw binary format piece by piece, collecting the data
+// arrays in a separate stream: with a single piece, the file must be the
+// same as the one written by write_vtu(), and with several pieces, the
+// offsets of the data arrays must be consistent with the appended data
+
+#include <deal.II/base/data_out_base.h>
+
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../tests.h"
+#include "patches.h"
+
+
+void
+check_offsets(const std::string &file)
+{
+  const std::string marker = "<AppendedData encoding=\"raw\">\n_";
+  const std::string end    = "\n</AppendedData>\n</VTKFile>\n";
+  const std::size_t start  = file.find(marker);
+  AssertThrow(start != std::string::npos, ExcInternalError());
+  const std::string data = file.substr(start + marker.size(),
+                                       file.size() - start - marker.size() -
+                                         end.size());
+
+  std::istringstream xml(file.substr(0, start));
+  std::string        line;
+  std::size_t        next_offset = 0;
+  unsigned int       n_pieces = 0, n_arrays = 0;
+  bool               consistent = true;
+  while (std::getline(xml, line))
+    {
+      if (line.find("<Piece") != std::string::npos)
+        ++n_pieces;
+
+      const std::size_t offset_position = line.find("offset=\"");
+      if (offset_position == std::string::npos)
+        continue;
+
+      const std::size_t offset = std::stoul(line.substr(offset_position + 8));
+      consistent &= (offset == next_offset);
+      ++n_arrays;
+
+      uint32_t n_bytes;
+      std::memcpy(&n_bytes, &data[offset], sizeof(n_bytes));
+      next_offset = offset + sizeof(n_bytes) + n_bytes;
+    }
+  consistent &= (next_offset == data.size());
+  deallog << "pieces: " << n_pieces << ", data arrays: " << n_arrays
+          << ", offsets consistent with appended data: "
+          << (consistent ? "yes" : "no") << std::endl;
+}
+
+
+
+template <int dim, int spacedim>
+void
+check()
+{
+  std::vector<DataOutBase::Patch<dim, spacedim>> patches(4);
+  create_patches(patches);
+
+  std::vector<std::string> names(5);
+  names[0] = "x1";
+  names[1] = "x2";
+  names[2] = "x3";
+  names[3] = "x4";
+  names[4] = "i";
+  std::vector<
+    std::tuple<unsigned int,
+               unsigned int,
+               std::string,
+               DataComponentInterpretation::DataComponentInterpretation>>
+    vectors;
+
+  DataOutBase::VtkFlags flags;
+  flags.print_date_and_time = false;
+  flags.data_format         = DataOutBase::VtkFlags::raw_appended;
+
+  std::ostringstream vtu;
+  DataOutBase::write_vtu(patches, names, vectors, flags, vtu);
+
+  for (const unsigned int n_pieces : {1, 2, 4})
+    {
+      std::ostringstream out;
+      std::stringstream  appended_data;
+      std::size_t        appended_data_size = 0;
+      DataOutBase::write_vtu_header(out, flags);
+      for (unsigned int piece = 0; piece < n_pieces; ++piece)
+        {
+          const unsigned int n_patches = patches.size() / n_pieces;
+          const std::vector<DataOutBase::Patch<dim, spacedim>> piece_patches(
+            patches.begin() + piece * n_patches,
+            patches.begin() + (piece + 1) * n_patches);
+          DataOutBase::write_vtu_main(piece_patches,
+                                      names,
+                                      vectors,
+                                      flags,
+                                      out,
+                                      appended_data,
+                                      appended_data_size);
+        }
+      AssertThrow(appended_data_size == appended_data.str().size(),
+                  ExcInternalError());
+      DataOutBase::write_vtu_footer(out, appended_data);
+
+      deallog << dim << spacedim << ", ";
+      check_offsets(out.str());
+      if (n_pieces == 1)
+        deallog << "same as write_vtu: "
+                << (out.str() == vtu.str() ? "yes" : "no") << std::endl;
+    }
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  check<1, 1>();
+  check<2, 2>();
+  check<3, 3>();
+
+  // the data arrays can only be written separately in raw binary format
+  std::vector<DataOutBase::Patch<2, 2>> patches(1);
+  create_patches(patches);
+  const std::vector<std::string> names = {"x1", "x2", "x3", "x4", "i"};
+  DataOutBase::VtkFlags          flags;
+  flags.data_format = DataOutBase::VtkFlags::zlib_compressed;
+  try
+    {
+      std::ostringstream out, appended_data;
+      std::size_t        appended_data_size = 0;
+      DataOutBase::write_vtu_main(
+        patches,
+        names,
+        std::vector<std::tuple<
+          unsigned int,
+          unsigned int,
+          std::string,
+          DataComponentInterpretation::DataComponentInterpretation>>(),
+        flags,
+        out,
+        appended_data,
+        appended_data_size);
+    }
+  catch (const ExceptionBase &e)
+    {
+      deallog << "zlib_compressed: " << e.get_exc_name() << std::endl;
+    }
+}
@@ -0,0 +1,157 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+// Check DataOut::build_patches_in_chunks: the patches of each chunk must be
+// the same as the corresponding ones created by build_patches, except that
+// patch and neighbor indices are relative to the chunk. Furthermore, writing
+// a single chunk with write_vtu_header, write_vtu_main, and write_vtu_footer
+// must give the same file as write_vtu.
+
+#include <deal.II/base/function_lib.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/mapping_q_generic.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/vector.h>
+
+#include <deal.II/numerics/data_out.h>
+#include <deal.II/numerics/vector_tools.h>
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../tests.h"
+
+
+template <int dim>
+class TestDataOut : public DataOut<dim>
+{
+public:
+  using DataOut<dim>::get_patches;
+};
+
+
+template <int dim>
+void
+check_chunks(
+  TestDataOut<dim> &                               data_out,
+  const Mapping<dim> &                             mapping,
+  const unsigned int                               max_patches_per_chunk,
+  const std::vector<DataOutBase::Patch<dim, dim>> &all_patches)
+{
+  unsigned int n_chunks          = 0;
+  unsigned int first_patch_index = 0;
+  data_out.build_patches_in_chunks(
+    mapping,
+    2,
+    DataOut<dim>::curved_boundary,
+    max_patches_per_chunk,
+    [&]() {
+      const std::vector<DataOutBase::Patch<dim, dim>> &patches =
+        data_out.get_patches();
+      AssertThrow(patches.size() > 0, ExcInternalError());
+      AssertThrow(patches.size() <= max_patches_per_chunk, ExcInternalError());
+
+      for (unsigned int p = 0; p < patches.size(); ++p)
+        {
+          DataOutBase::Patch<dim, dim> patch =
+            all_patches[first_patch_index + p];
+          patch.patch_index -= first_patch_index;
+          for (unsigned int f = 0; f < GeometryInfo<dim>::faces_per_cell; ++f)
+            if (patch.neighbors[f] < first_patch_index ||
+                patch.neighbors[f] >= first_patch_index + patches.size())
+              patch.neighbors[f] = numbers::invalid_unsigned_int;
+            else
+              patch.neighbors[f] -= first_patch_index;
+          AssertThrow(patches[p] == patch, ExcInternalError());
+        }
+
+      first_patch_index += patches.size();
+      ++n_chunks;
+    });
+  AssertThrow(first_patch_index == all_patches.size(), ExcInternalError());
+  AssertThrow(data_out.get_patches().empty(), ExcInternalError());
+
+  deallog << "max. patches per chunk " << max_patches_per_chunk << ": "
+          << n_chunks << " chunks" << std::endl;
+}
+
+
+template <int dim>
+void
+test(const unsigned int n_refinements)
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_ball(tria);
+  tria.refine_global(n_refinements);
+
+  FE_Q<dim>       fe(2);
+  DoFHandler<dim> dof_handler(tria);
+  dof_handler.distribute_dofs(fe);
+
+  Vector<double> solution(dof_handler.n_dofs());
+  VectorTools::interpolate(dof_handler,
+                           Functions::SquareFunction<dim>(),
+                           solution);
+
+  MappingQGeneric<dim> mapping(2);
+  TestDataOut<dim>     data_out;
+  data_out.attach_dof_handler(dof_handler);
+  data_out.add_data_vector(solution, "solution");
+
+  DataOutBase::VtkFlags flags;
+  flags.print_date_and_time = false;
+  data_out.set_flags(flags);
+
+  data_out.build_patches(mapping, 2, DataOut<dim>::curved_boundary);
+  const std::vector<DataOutBase::Patch<dim, dim>> all_patches =
+    data_out.get_patches();
+  std::ostringstream vtu;
+  data_out.write_vtu(vtu);
+
+  deallog << "dim=" << dim << ", " << all_patches.size() << " cells"
+          << std::endl;
+  for (const unsigned int max_patches_per_chunk : {1u, 7u, 56u, 1000u})
+    check_chunks(data_out, mapping, max_patches_per_chunk, all_patches);
+
+  std::ostringstream chunked_vtu;
+  data_out.write_vtu_header(chunked_vtu);
+  data_out.build_patches_in_chunks(mapping,
+                                   2,
+                                   DataOut<dim>::curved_boundary,
+                                   all_patches.size(),
+                                   [&]() {
+                                     data_out.write_vtu_main(chunked_vtu);
+                                   });
+  data_out.write_vtu_footer(chunked_vtu);
+  AssertThrow(chunked_vtu.str() == vtu.str(), ExcInternalError());
+  deallog << "write_vtu OK" << std::endl;
+}
+
+
+int
+main()
+{
+  initlog();
+
+  test<2>(2);
+  test<3>(1);
+}
@@ -0,0 +1,159 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// Check that a DataOutFilter can be reused in several time steps: after
+// DataOutFilter::clear_data_sets(), write_filtered_data() keeps the nodes and
+// cells and only records the new data sets, which must be the same as the
+// ones of a newly created filter. Also check that filling a filter that
+// still contains data sets, or filling it with patches of another mesh,
+// throws an exception.
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/vector.h>
+
+#include <deal.II/numerics/data_out.h>
+
+#include "../tests.h"
+
+
+bool
+same_filters(const DataOutBase::DataOutFilter &filter,
+             const DataOutBase::DataOutFilter &reference)
+{
+  if (filter.n_nodes() != reference.n_nodes() ||
+      filter.n_cells() != reference.n_cells() ||
+      filter.n_data_sets() != reference.n_data_sets())
+    return false;
+
+  std::vector<double> nodes, reference_nodes;
+  filter.fill_node_data(nodes);
+  reference.fill_node_data(reference_nodes);
+  std::vector<unsigned int> cells, reference_cells;
+  filter.fill_cell_data(0, cells);
+  reference.fill_cell_data(0, reference_cells);
+  if (nodes != reference_nodes || cells != reference_cells)
+    return false;
+
+  for (unsigned int i = 0; i < filter.n_data_sets(); ++i)
+    {
+      if (filter.get_data_set_name(i) != reference.get_data_set_name(i) ||
+          filter.get_data_set_dim(i) != reference.get_data_set_dim(i))
+        return false;
+      const unsigned int size = filter.n_nodes() * filter.get_data_set_dim(i);
+      if (!std::equal(filter.get_data_set(i),
+                      filter.get_data_set(i) + size,
+                      reference.get_data_set(i)))
+        return false;
+    }
+  return true;
+}
+
+
+
+template <int dim>
+void
+test()
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(2);
+
+  FESystem<dim>   fe(FE_Q<dim>(1), dim + 1);
+  DoFHandler<dim> dof_handler(tria);
+  dof_handler.distribute_dofs(fe);
+  Vector<double> solution(dof_handler.n_dofs());
+
+  std::vector<std::string> names(dim, "velocity");
+  names.emplace_back("pressure");
+  std::vector<DataComponentInterpretation::DataComponentInterpretation>
+    interpretation(dim,
+                   DataComponentInterpretation::component_is_part_of_vector);
+  interpretation.push_back(DataComponentInterpretation::component_is_scalar);
+
+  DataOut<dim> data_out;
+  data_out.attach_dof_handler(dof_handler);
+  data_out.add_data_vector(solution,
+                           names,
+                           DataOut<dim>::type_dof_data,
+                           interpretation);
+  data_out.build_patches();
+
+  const DataOutBase::DataOutFilterFlags flags(true, true);
+  DataOutBase::DataOutFilter            filter(flags);
+  for (unsigned int step = 0; step < 3; ++step)
+    {
+      for (unsigned int i = 0; i < solution.size(); ++i)
+        solution(i) = std::sin(1. * (step + 1) * i);
+
+      if (step > 0)
+        {
+          data_out.update_patch_data();
+          filter.clear_data_sets();
+        }
+      data_out.write_filtered_data(filter);
+
+      DataOutBase::DataOutFilter reference(flags);
+      data_out.write_filtered_data(reference);
+
+      deallog << "step " << step << ": " << filter.n_nodes() << " nodes, "
+              << filter.n_cells() << " cells, " << filter.n_data_sets()
+              << " data sets, same as new filter: "
+              << (same_filters(filter, reference) ? "yes" : "no")
+              << std::endl;
+    }
+
+  try
+    {
+      data_out.write_filtered_data(filter);
+    }
+  catch (const ExceptionBase &e)
+    {
+      deallog << "without clear_data_sets(): " << e.get_exc_name()
+              << std::endl;
+    }
+
+  tria.refine_global(1);
+  dof_handler.distribute_dofs(fe);
+  solution.reinit(dof_handler.n_dofs());
+  data_out.build_patches();
+  filter.clear_data_sets();
+  try
+    {
+      data_out.write_filtered_data(filter);
+    }
+  catch (const ExceptionBase &e)
+    {
+      deallog << "after refinement: " << e.get_exc_name() << std::endl;
+    }
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test<2>();
+  test<3>();
+}
@@ -0,0 +1,175 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+// Check DataOut::update_patch_data: after changing the values of the data
+// vectors, the patches it updates must be the same as the ones created from
+// scratch by build_patches, both for plain and for postprocessed data and
+// for cells with and without curved boundaries.
+
+#include <deal.II/base/function_lib.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/mapping_q_generic.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/vector.h>
+
+#include <deal.II/numerics/data_out.h>
+#include <deal.II/numerics/data_postprocessor.h>
+#include <deal.II/numerics/vector_tools.h>
+
+#include <vector>
+
+#include "../tests.h"
+
+
+template <int dim>
+class TestDataOut : public DataOut<dim>
+{
+public:
+  using DataOut<dim>::get_patches;
+};
+
+
+template <int dim>
+class Gradient : public DataPostprocessorVector<dim>
+{
+public:
+  Gradient()
+    : DataPostprocessorVector<dim>("gradient", update_gradients)
+  {}
+
+  virtual void
+  evaluate_scalar_field(const DataPostprocessorInputs::Scalar<dim> &input_data,
+                        std::vector<Vector<double>> &computed_quantities) const
+    override
+  {
+    for (unsigned int q = 0; q < input_data.solution_gradients.size(); ++q)
+      for (unsigned int d = 0; d < dim; ++d)
+        computed_quantities[q][d] = input_data.solution_gradients[q][d];
+  }
+};
+
+
+template <int dim>
+void
+compare(const std::vector<DataOutBase::Patch<dim, dim>> &patches,
+        const std::vector<DataOutBase::Patch<dim, dim>> &reference)
+{
+  AssertThrow(patches.size() == reference.size(), ExcInternalError());
+  for (unsigned int p = 0; p < patches.size(); ++p)
+    {
+      for (unsigned int v = 0; v < GeometryInfo<dim>::vertices_per_cell; ++v)
+        AssertThrow(patches[p].vertices[v] == reference[p].vertices[v],
+                    ExcInternalError());
+      for (unsigned int f = 0; f < GeometryInfo<dim>::faces_per_cell; ++f)
+        AssertThrow(patches[p].neighbors[f] == reference[p].neighbors[f],
+                    ExcInternalError());
+      AssertThrow(patches[p].patch_index == reference[p].patch_index,
+                  ExcInternalError());
+      AssertThrow(patches[p].n_subdivisions == reference[p].n_subdivisions,
+                  ExcInternalError());
+      AssertThrow(patches[p].points_are_available ==
+                    reference[p].points_are_available,
+                  ExcInternalError());
+      AssertThrow(patches[p].data.n_rows() == reference[p].data.n_rows(),
+                  ExcInternalError());
+      AssertThrow(patches[p].data.n_cols() == reference[p].data.n_cols(),
+                  ExcInternalError());
+      for (unsigned int i = 0; i < patches[p].data.n_rows(); ++i)
+        for (unsigned int j = 0; j < patches[p].data.n_cols(); ++j)
+          AssertThrow(std::abs(patches[p].data(i, j) -
+                               reference[p].data(i, j)) <=
+                        1e-6 * (1. + std::abs(reference[p].data(i, j))),
+                      ExcInternalError());
+    }
+}
+
+
+template <int dim>
+void
+test(const unsigned int n_refinements)
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_ball(tria);
+  tria.refine_global(n_refinements);
+
+  FE_Q<dim>       fe(2);
+  DoFHandler<dim> dof_handler(tria);
+  dof_handler.distribute_dofs(fe);
+
+  Vector<double> solution(dof_handler.n_dofs());
+  VectorTools::interpolate(dof_handler,
+                           Functions::SquareFunction<dim>(),
+                           solution);
+  Vector<double> cell_data(tria.n_active_cells());
+  for (unsigned int i = 0; i < cell_data.size(); ++i)
+    cell_data(i) = i;
+
+  MappingQGeneric<dim> mapping(2);
+  Gradient<dim>        gradient;
+
+  TestDataOut<dim> data_out;
+  data_out.attach_dof_handler(dof_handler);
+  data_out.add_data_vector(solution, "solution");
+  data_out.add_data_vector(solution, gradient);
+  data_out.add_data_vector(cell_data, "cell_data");
+  data_out.build_patches(mapping, 2, DataOut<dim>::curved_boundary);
+
+  // change the data vectors and only update the data of the patches
+  VectorTools::interpolate(dof_handler,
+                           Functions::CosineFunction<dim>(),
+                           solution);
+  for (unsigned int i = 0; i < cell_data.size(); ++i)
+    cell_data(i) = 2. * i + 1.;
+  data_out.update_patch_data(mapping);
+
+  // then compare with patches built from scratch
+  TestDataOut<dim> reference;
+  reference.attach_dof_handler(dof_handler);
+  reference.add_data_vector(solution, "solution");
+  reference.add_data_vector(solution, gradient);
+  reference.add_data_vector(cell_data, "cell_data");
+  reference.build_patches(mapping, 2, DataOut<dim>::curved_boundary);
+
+  compare(data_out.get_patches(), reference.get_patches());
+
+  // repeat, to make sure that updating the data also works more than once
+  VectorTools::interpolate(dof_handler,
+                           Functions::SquareFunction<dim>(),
+                           solution);
+  cell_data *= -1.;
+  data_out.update_patch_data(mapping);
+  reference.build_patches(mapping, 2, DataOut<dim>::curved_boundary);
+
+  compare(data_out.get_patches(), reference.get_patches());
+
+  deallog << "dim=" << dim << ", " << data_out.get_patches().size()
+          << " patches OK" << std::endl;
+}
+
+
+int
+main()
+{
+  initlog();
+
+  test<2>(2);
+  test<3>(1);
+}
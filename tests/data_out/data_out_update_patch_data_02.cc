@@ -0,0 +1,110 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// Check that DataOut::update_patch_data throws an exception if the patches
+// can not be reused: if they were never built, if they were built in chunks,
+// if the triangulation has been refined or its vertices moved since, if the
+// data vectors now belong to another DoFHandler, or if the patches have been
+// deleted by clear_data_vectors
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/grid_tools.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/vector.h>
+
+#include <deal.II/numerics/data_out.h>
+
+#include "../tests.h"
+
+
+void
+try_update(DataOut<2> &data_out, const std::string &situation)
+{
+  try
+    {
+      data_out.update_patch_data();
+      deallog << situation << ": OK" << std::endl;
+    }
+  catch (const ExceptionBase &e)
+    {
+      deallog << situation << ": " << e.get_exc_name() << std::endl;
+    }
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  Triangulation<2> tria;
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(1);
+
+  FE_Q<2>       fe(1);
+  DoFHandler<2> dof_handler(tria);
+  dof_handler.distribute_dofs(fe);
+  Vector<double> solution(dof_handler.n_dofs());
+  for (unsigned int i = 0; i < solution.size(); ++i)
+    solution(i) = i;
+
+  DataOut<2> data_out;
+  data_out.attach_dof_handler(dof_handler);
+  data_out.add_data_vector(solution, "solution");
+  try_update(data_out, "before build_patches");
+
+  data_out.build_patches();
+  solution *= 2.;
+  try_update(data_out, "after build_patches");
+
+  data_out.build_patches_in_chunks(StaticMappingQ1<2>::mapping,
+                                   1,
+                                   DataOut<2>::no_curved_cells,
+                                   2,
+                                   []() {});
+  try_update(data_out, "after build_patches_in_chunks");
+
+  data_out.build_patches();
+  GridTools::transform([](const Point<2> &p) { return 2. * p; }, tria);
+  try_update(data_out, "after moving the vertices");
+
+  data_out.build_patches();
+  try_update(data_out, "after build_patches");
+
+  // use the same number of DoFs, on another DoFHandler
+  DoFHandler<2> other_dof_handler(tria);
+  other_dof_handler.distribute_dofs(fe);
+  data_out.clear_data_vectors();
+  data_out.add_data_vector(other_dof_handler, solution, "solution");
+  try_update(data_out, "with another DoFHandler");
+
+  // clear_data_vectors() also deletes the patches
+  data_out.clear_data_vectors();
+  data_out.add_data_vector(solution, "solution");
+  try_update(data_out, "after clear_data_vectors");
+
+  data_out.build_patches();
+  tria.refine_global(1);
+  dof_handler.distribute_dofs(fe);
+  solution.reinit(dof_handler.n_dofs());
+  try_update(data_out, "after refinement");
+}
@@ -0,0 +1,138 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+// Check that DoFHandler::distribute_dofs() and DoFRenumbering produce the
+// same numbering when the work is split between several threads as when it
+// is done by a single thread. distribute_dofs() only uses several threads
+// for meshes with at least 4096 active cells, so all meshes are at least
+// twice as large.
+
+#include <deal.II/base/multithread_info.h>
+
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_renumbering.h>
+
+#include <deal.II/fe/fe_dgq.h>
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include "../tests.h"
+
+
+// return the dof indices on all cells after distribute_dofs() (first
+// element) and after the subsequent Cuthill-McKee renumbering (second
+// element)
+template <int dim>
+std::pair<std::vector<types::global_dof_index>,
+          std::vector<types::global_dof_index>>
+get_numbering(const Triangulation<dim> & tria,
+              const FiniteElement<dim> &fe,
+              const unsigned int        n_threads)
+{
+  MultithreadInfo::set_thread_limit(n_threads);
+  AssertThrow(MultithreadInfo::n_threads() == n_threads, ExcInternalError());
+
+  DoFHandler<dim> dof_handler(tria);
+  dof_handler.distribute_dofs(fe);
+
+  std::vector<types::global_dof_index> dof_indices(fe.dofs_per_cell);
+
+  std::pair<std::vector<types::global_dof_index>,
+            std::vector<types::global_dof_index>>
+    numbering;
+  for (const auto &cell : dof_handler.active_cell_iterators())
+    {
+      cell->get_dof_indices(dof_indices);
+      numbering.first.insert(numbering.first.end(),
+                             dof_indices.begin(),
+                             dof_indices.end());
+    }
+
+  DoFRenumbering::Cuthill_McKee(dof_handler);
+  for (const auto &cell : dof_handler.active_cell_iterators())
+    {
+      cell->get_dof_indices(dof_indices);
+      numbering.second.insert(numbering.second.end(),
+                              dof_indices.begin(),
+                              dof_indices.end());
+    }
+
+  return numbering;
+}
+
+
+
+template <int dim>
+void
+test(const Triangulation<dim> &tria, const FiniteElement<dim> &fe)
+{
+  const auto serial   = get_numbering(tria, fe, 1);
+  const auto threaded = get_numbering(tria, fe, testing_max_num_threads());
+
+  deallog << fe.get_name() << ", " << tria.n_active_cells()
+          << " cells: distribute_dofs "
+          << (serial.first == threaded.first ? "OK" : "failed")
+          << ", Cuthill_McKee "
+          << (serial.second == threaded.second ? "OK" : "failed")
+          << std::endl;
+}
+
+
+
+template <int dim>
+void
+test(const unsigned int n_refinements)
+{
+  // two coarse cells, refined to 8192 cells
+  Triangulation<dim>        tria;
+  std::vector<unsigned int> repetitions(dim, 1);
+  repetitions[0] = 2;
+  Point<dim> p2;
+  for (unsigned int d = 0; d < dim; ++d)
+    p2[d] = 1;
+  GridGenerator::subdivided_hyper_rectangle(tria,
+                                            repetitions,
+                                            Point<dim>(),
+                                            p2);
+  tria.refine_global(n_refinements);
+
+  test(tria, FE_Q<dim>(1));
+  test(tria, FE_Q<dim>(dim < 3 ? 3 : 2));
+  test(tria, FE_DGQ<dim>(1));
+  test(tria, FESystem<dim>(FE_Q<dim>(dim < 3 ? 2 : 1), dim, FE_Q<dim>(1), 1));
+
+  // refine some cells to get hanging nodes and cells on several levels
+  for (const auto &cell : tria.active_cell_iterators())
+    if (cell->center()[0] < 0.3)
+      cell->set_refine_flag();
+  tria.execute_coarsening_and_refinement();
+
+  test(tria, FE_Q<dim>(dim < 3 ? 2 : 1));
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test<1>(12);
+  test<2>(6);
+  test<3>(4);
+}
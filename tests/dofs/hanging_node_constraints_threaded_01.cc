@@ -0,0 +1,234 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+// Check that DoFTools::make_hanging_node_constraints() and
+// AffineConstraints::close() produce the same constraints when the work is
+// split between several threads as when it is done by a single thread, and
+// that the closed constraints of a Lagrange element still form a partition
+// of unity. Also compare the result of close(), which resolves chains of
+// constraints level by level, with the algorithm it used before, which
+// substituted constrained entries until no chains were left. The two only
+// differ by round-off since close() now merges and rescales the entries of
+// each line before substituting it into the lines of the next level.
+
+#include <deal.II/base/multithread_info.h>
+
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/affine_constraints.h>
+
+#include <map>
+
+#include "../tests.h"
+
+
+using Entries = std::vector<std::pair<types::global_dof_index, double>>;
+
+
+// the algorithm used by AffineConstraints::close() before chains of
+// constraints were resolved level by level
+std::map<types::global_dof_index, Entries>
+close_serially(const AffineConstraints<double> &constraints)
+{
+  std::map<types::global_dof_index, Entries> lines;
+  for (const auto &line : constraints.get_lines())
+    {
+      Entries &entries = lines[line.index];
+      for (const auto &entry : line.entries)
+        if (entry.second != 0.)
+          entries.push_back(entry);
+    }
+
+  // replace constrained entries until no chains are left. the expansion of
+  // an entry overwrites it and is otherwise appended to the line, where it
+  // is looked at once more
+  bool chained_constraint_replaced = true;
+  while (chained_constraint_replaced)
+    {
+      chained_constraint_replaced = false;
+      for (auto &line : lines)
+        {
+          Entries &   entries = line.second;
+          std::size_t entry   = 0;
+          while (entry < entries.size())
+            if (lines.find(entries[entry].first) != lines.end())
+              {
+                chained_constraint_replaced = true;
+                const Entries constrained_entries =
+                  lines[entries[entry].first];
+                const double weight = entries[entry].second;
+                AssertThrow(constrained_entries.size() > 0,
+                            ExcInternalError());
+
+                entries[entry] = {constrained_entries[0].first,
+                                  constrained_entries[0].second * weight};
+                for (std::size_t i = 1; i < constrained_entries.size(); ++i)
+                  entries.emplace_back(constrained_entries[i].first,
+                                       constrained_entries[i].second *
+                                         weight);
+              }
+            else
+              ++entry;
+        }
+    }
+
+  // sort the entries, merge duplicates, and rescale the weights if they
+  // almost sum up to one
+  for (auto &line : lines)
+    {
+      Entries &entries = line.second;
+      std::sort(entries.begin(),
+                entries.end(),
+                [](const std::pair<types::global_dof_index, double> &a,
+                   const std::pair<types::global_dof_index, double> &b) {
+                  return (a.first < b.first) ||
+                         (a.first == b.first &&
+                          std::abs(a.second) < std::abs(b.second));
+                });
+
+      Entries merged_entries;
+      for (const auto &entry : entries)
+        if (merged_entries.size() > 0 &&
+            merged_entries.back().first == entry.first)
+          merged_entries.back().second += entry.second;
+        else
+          merged_entries.push_back(entry);
+
+      double sum = 0.;
+      for (const auto &entry : merged_entries)
+        sum += entry.second;
+      if (std::abs(sum - 1.) < 1.e-13)
+        for (auto &entry : merged_entries)
+          entry.second /= sum;
+
+      entries.swap(merged_entries);
+    }
+
+  return lines;
+}
+
+
+
+template <int dim>
+void
+make_constraints(const DoFHandler<dim> &    dof_handler,
+                 const unsigned int         n_threads,
+                 AffineConstraints<double> &constraints)
+{
+  MultithreadInfo::set_thread_limit(n_threads);
+
+  constraints.clear();
+  DoFTools::make_hanging_node_constraints(dof_handler, constraints);
+  constraints.close();
+}
+
+
+
+template <int dim>
+void
+test(const unsigned int fe_degree, const unsigned int n_refinements)
+{
+  // refine the mesh towards one corner so that there are plenty of chains
+  // of constraints between the different refinement levels
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(2);
+  for (unsigned int i = 0; i < n_refinements; ++i)
+    {
+      for (const auto &cell : tria.active_cell_iterators())
+        if (cell->center().norm() < 0.6 / (i + 1))
+          cell->set_refine_flag();
+      tria.execute_coarsening_and_refinement();
+    }
+
+  FE_Q<dim>       fe(fe_degree);
+  DoFHandler<dim> dof_handler(tria);
+  dof_handler.distribute_dofs(fe);
+
+  AffineConstraints<double> serial_constraints, threaded_constraints;
+  make_constraints(dof_handler, 1, serial_constraints);
+  make_constraints(dof_handler, 4, threaded_constraints);
+
+  AffineConstraints<double> unclosed_constraints;
+  DoFTools::make_hanging_node_constraints(dof_handler, unclosed_constraints);
+  const std::map<types::global_dof_index, Entries> reference_lines =
+    close_serially(unclosed_constraints);
+
+  AssertThrow(serial_constraints.n_constraints() > 0, ExcInternalError());
+  AssertThrow(serial_constraints.n_constraints() ==
+                threaded_constraints.n_constraints(),
+              ExcInternalError());
+  AssertThrow(serial_constraints.n_constraints() == reference_lines.size(),
+              ExcInternalError());
+  for (types::global_dof_index i = 0; i < dof_handler.n_dofs(); ++i)
+    {
+      AssertThrow(serial_constraints.is_constrained(i) ==
+                    threaded_constraints.is_constrained(i),
+                  ExcInternalError());
+      if (serial_constraints.is_constrained(i) == false)
+        continue;
+
+      const auto &serial_entries =
+        *serial_constraints.get_constraint_entries(i);
+      const auto &threaded_entries =
+        *threaded_constraints.get_constraint_entries(i);
+      const Entries &reference_entries = reference_lines.at(i);
+      AssertThrow(serial_entries.size() == threaded_entries.size(),
+                  ExcInternalError());
+      AssertThrow(serial_entries.size() == reference_entries.size(),
+                  ExcInternalError());
+
+      double sum = 0;
+      for (unsigned int j = 0; j < serial_entries.size(); ++j)
+        {
+          AssertThrow(serial_entries[j].first == threaded_entries[j].first,
+                      ExcInternalError());
+          AssertThrow(std::abs(serial_entries[j].second -
+                               threaded_entries[j].second) < 1e-12,
+                      ExcInternalError());
+          AssertThrow(serial_entries[j].first == reference_entries[j].first,
+                      ExcInternalError());
+          AssertThrow(std::abs(serial_entries[j].second -
+                               reference_entries[j].second) < 1e-12,
+                      ExcInternalError());
+          AssertThrow(serial_constraints.is_constrained(
+                        serial_entries[j].first) == false,
+                      ExcInternalError());
+          sum += serial_entries[j].second;
+        }
+      AssertThrow(std::abs(sum - 1.) < 1e-12, ExcInternalError());
+    }
+
+  deallog << "dim=" << dim << ", " << fe.get_name() << ": OK" << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test<2>(1, 5);
+  test<2>(3, 5);
+  test<3>(1, 3);
+  test<3>(2, 3);
+}
@@ -0,0 +1,158 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+// FEValues evaluates function values and gradients of FE_Q and FE_DGQ
+// elements (and systems of them) in tensor-product quadrature formulas with
+// sum factorization. Check that the results agree with the sums over
+// shape_value() and shape_grad() on a curved mesh.
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_dgq.h>
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+#include <deal.II/fe/fe_values.h>
+#include <deal.II/fe/mapping_q_generic.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/grid_tools.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/vector.h>
+
+#include "../tests.h"
+
+
+template <int dim>
+Point<dim>
+deform(const Point<dim> &p)
+{
+  Point<dim> q = p;
+  q[0] += 0.1 * std::sin(numbers::PI * p[dim - 1]);
+  q[dim - 1] *= 1. + 0.2 * p[0];
+  return q;
+}
+
+
+
+template <int dim>
+void
+test(const FiniteElement<dim> &fe, const Quadrature<dim> &quadrature)
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(1);
+  GridTools::transform(&deform<dim>, tria);
+
+  DoFHandler<dim> dof_handler(tria);
+  dof_handler.distribute_dofs(fe);
+
+  Vector<double> solution(dof_handler.n_dofs());
+  for (unsigned int i = 0; i < solution.size(); ++i)
+    solution(i) = std::cos(0.7 * i);
+
+  const MappingQGeneric<dim> mapping(2);
+
+  FEValues<dim> fe_values(mapping,
+                          fe,
+                          quadrature,
+                          update_values | update_gradients);
+
+  const unsigned int n_q_points      = quadrature.size();
+  const unsigned int n_components    = fe.n_components();
+  double             error_values    = 0;
+  double             error_gradients = 0;
+
+  std::vector<Vector<double>> values(n_q_points, Vector<double>(n_components));
+  std::vector<std::vector<Tensor<1, dim>>> gradients(
+    n_q_points, std::vector<Tensor<1, dim>>(n_components));
+  std::vector<double>         scalar_values(n_q_points);
+  std::vector<Tensor<1, dim>> scalar_gradients(n_q_points);
+  std::vector<types::global_dof_index> dof_indices(fe.dofs_per_cell);
+
+  for (const auto &cell : dof_handler.active_cell_iterators())
+    {
+      fe_values.reinit(cell);
+      cell->get_dof_indices(dof_indices);
+
+      fe_values.get_function_values(solution, values);
+      fe_values.get_function_gradients(solution, gradients);
+      if (n_components == 1)
+        {
+          fe_values.get_function_values(solution, scalar_values);
+          fe_values.get_function_gradients(solution, scalar_gradients);
+        }
+
+      for (unsigned int q = 0; q < n_q_points; ++q)
+        for (unsigned int c = 0; c < n_components; ++c)
+          {
+            double         value = 0;
+            Tensor<1, dim> gradient;
+            for (unsigned int i = 0; i < fe.dofs_per_cell; ++i)
+              {
+                value += solution(dof_indices[i]) *
+                         fe_values.shape_value_component(i, q, c);
+                gradient += solution(dof_indices[i]) *
+                            fe_values.shape_grad_component(i, q, c);
+              }
+
+            error_values =
+              std::max(error_values, std::abs(values[q](c) - value));
+            error_gradients = std::max(error_gradients,
+                                       (gradients[q][c] - gradient).norm());
+            if (n_components == 1)
+              {
+                error_values =
+                  std::max(error_values, std::abs(scalar_values[q] - value));
+                error_gradients =
+                  std::max(error_gradients,
+                           (scalar_gradients[q] - gradient).norm());
+              }
+          }
+    }
+
+  deallog << fe.get_name() << " with " << quadrature.size()
+          << " points: values " << (error_values < 1e-12 ? "OK" : "FAILED")
+          << ", gradients " << (error_gradients < 1e-11 ? "OK" : "FAILED")
+          << std::endl;
+}
+
+
+
+template <int dim>
+void
+test()
+{
+  // elements and quadrature formulas that take the sum factorization path,
+  // followed by ones that do not
+  test(FE_Q<dim>(2), QGauss<dim>(3));
+  test(FE_Q<dim>(4), QGauss<dim>(5));
+  test(FE_Q<dim>(3), QGaussLobatto<dim>(4));
+  test(FE_DGQ<dim>(3), QGauss<dim>(2));
+  test(FESystem<dim>(FE_Q<dim>(3), dim), QGauss<dim>(4));
+  test(FE_Q<dim>(1), QGauss<dim>(2));
+  test(FESystem<dim>(FE_Q<dim>(2), 1, FE_DGQ<dim>(1), 1), QGauss<dim>(3));
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test<2>();
+  test<3>();
+}
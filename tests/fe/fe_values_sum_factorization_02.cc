@@ -0,0 +1,113 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// FEValues evaluates function values and gradients of FE_Q elements with
+// sum factorization, using scratch arrays. Check that the const functions
+// get_function_values() and get_function_gradients() can be called
+// concurrently on the same FEValues object, like the other const functions
+// of FEValues.
+
+#include <deal.II/base/quadrature_lib.h>
+#include <deal.II/base/thread_management.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+#include <deal.II/fe/fe_values.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/vector.h>
+
+#include "../tests.h"
+
+
+template <int dim>
+void
+test(const FiniteElement<dim> &fe)
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_ball(tria);
+
+  DoFHandler<dim> dof_handler(tria);
+  dof_handler.distribute_dofs(fe);
+
+  const QGauss<dim> quadrature(fe.degree + 1);
+  FEValues<dim>     fe_values(fe, quadrature, update_values | update_gradients);
+  fe_values.reinit(dof_handler.begin_active());
+
+  const unsigned int n_q_points   = quadrature.size();
+  const unsigned int n_components = fe.n_components();
+
+  // evaluate many different functions on the same cell, first one after
+  // the other and then on several threads at once
+  const unsigned int          n_functions = 64;
+  std::vector<Vector<double>> solutions(n_functions,
+                                        Vector<double>(dof_handler.n_dofs()));
+  for (unsigned int f = 0; f < n_functions; ++f)
+    for (unsigned int i = 0; i < dof_handler.n_dofs(); ++i)
+      solutions[f](i) = std::cos(0.7 * i + 0.3 * f);
+
+  using Values    = std::vector<Vector<double>>;
+  using Gradients = std::vector<std::vector<Tensor<1, dim>>>;
+  const auto evaluate = [&](const unsigned int f,
+                            Values &           values,
+                            Gradients &        gradients) {
+    values.assign(n_q_points, Vector<double>(n_components));
+    gradients.assign(n_q_points, std::vector<Tensor<1, dim>>(n_components));
+    fe_values.get_function_values(solutions[f], values);
+    fe_values.get_function_gradients(solutions[f], gradients);
+  };
+
+  std::vector<Values>    serial_values(n_functions);
+  std::vector<Gradients> serial_gradients(n_functions);
+  for (unsigned int f = 0; f < n_functions; ++f)
+    evaluate(f, serial_values[f], serial_gradients[f]);
+
+  std::vector<Values>    parallel_values(n_functions);
+  std::vector<Gradients> parallel_gradients(n_functions);
+  Threads::TaskGroup<>   tasks;
+  for (unsigned int f = 0; f < n_functions; ++f)
+    tasks += Threads::new_task([&, f]() {
+      evaluate(f, parallel_values[f], parallel_gradients[f]);
+    });
+  tasks.join_all();
+
+  bool identical = true;
+  for (unsigned int f = 0; f < n_functions; ++f)
+    for (unsigned int q = 0; q < n_q_points; ++q)
+      for (unsigned int c = 0; c < n_components; ++c)
+        if (serial_values[f][q](c) != parallel_values[f][q](c) ||
+            serial_gradients[f][q][c] != parallel_gradients[f][q][c])
+          identical = false;
+
+  deallog << fe.get_name() << ": " << (identical ? "OK" : "FAILED")
+          << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test(FE_Q<2>(3));
+  test(FESystem<2>(FE_Q<2>(2), 2));
+  test(FE_Q<3>(3));
+}
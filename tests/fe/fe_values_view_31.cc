@@ -0,0 +1,158 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// Check FEValuesViews::Scalar/Vector::get_nonzero_shape_function_indices()
+// for an FESystem with primitive and non-primitive base elements: all shape
+// functions not in the list must be zero for the view, and the evaluation of
+// functions through the view must agree with a loop over all shape functions
+
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_raviart_thomas.h>
+#include <deal.II/fe/fe_system.h>
+#include <deal.II/fe/fe_values.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/grid_tools.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/vector.h>
+
+#include "../tests.h"
+
+
+template <int dim, typename ViewType>
+void
+check_zero(const FEValues<dim> &fe_values, const ViewType &view)
+{
+  const std::vector<unsigned int> &indices =
+    view.get_nonzero_shape_function_indices();
+  double max_outside = 0;
+  for (unsigned int i = 0; i < fe_values.dofs_per_cell; ++i)
+    if (std::find(indices.begin(), indices.end(), i) == indices.end())
+      for (unsigned int q = 0; q < fe_values.n_quadrature_points; ++q)
+        max_outside = std::max(max_outside,
+                               view.value(i, q) * view.value(i, q) +
+                                 view.gradient(i, q).norm_square());
+  deallog << indices.size() << " nonzero shape functions, outside the list "
+          << (max_outside == 0 ? "zero" : "nonzero") << std::endl;
+}
+
+
+
+template <int dim>
+void
+test()
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube(tria, 0., 1.);
+  GridTools::distort_random(0.1, tria, false);
+
+  const FESystem<dim> fe(
+    FE_Q<dim>(2), dim, FE_Q<dim>(1), 1, FE_RaviartThomas<dim>(0), 1);
+  const QGauss<dim> quadrature(3);
+  FEValues<dim>     fe_values(fe,
+                          quadrature,
+                          update_values | update_gradients |
+                            update_quadrature_points);
+  fe_values.reinit(tria.begin_active());
+
+  Vector<double> dof_values(fe.dofs_per_cell);
+  for (unsigned int i = 0; i < fe.dofs_per_cell; ++i)
+    dof_values(i) = random_value<double>();
+
+  const FEValuesExtractors::Vector velocities(0);
+  const FEValuesExtractors::Scalar pressure(dim);
+  const FEValuesExtractors::Vector flux(dim + 1);
+
+  deallog << "dim=" << dim << ", " << fe.dofs_per_cell << " shape functions"
+          << std::endl;
+
+  // scalar part
+  {
+    deallog << "Scalar: ";
+    check_zero(fe_values, fe_values[pressure]);
+
+    std::vector<double>         values(quadrature.size());
+    std::vector<Tensor<1, dim>> gradients(quadrature.size());
+    fe_values[pressure].get_function_values_from_local_dof_values(dof_values,
+                                                                  values);
+    fe_values[pressure].get_function_gradients_from_local_dof_values(
+      dof_values, gradients);
+    double error = 0;
+    for (unsigned int q = 0; q < quadrature.size(); ++q)
+      {
+        double         value = 0;
+        Tensor<1, dim> gradient;
+        for (unsigned int i = 0; i < fe.dofs_per_cell; ++i)
+          {
+            value += dof_values(i) * fe_values[pressure].value(i, q);
+            gradient += dof_values(i) * fe_values[pressure].gradient(i, q);
+          }
+        error = std::max(error, std::abs(value - values[q]));
+        error = std::max(error, (gradient - gradients[q]).norm());
+      }
+    deallog << "Scalar function evaluation: "
+            << (error < 1e-12 ? "OK" : "FAILED") << std::endl;
+  }
+
+  // vector parts, with a primitive and a non-primitive element
+  for (const auto &extractor : {velocities, flux})
+    {
+      const FEValuesViews::Vector<dim> &view = fe_values[extractor];
+      deallog << "Vector: ";
+      check_zero(fe_values, view);
+
+      std::vector<Tensor<1, dim>> values(quadrature.size());
+      std::vector<Tensor<2, dim>> gradients(quadrature.size());
+      std::vector<double>         divergences(quadrature.size());
+      view.get_function_values_from_local_dof_values(dof_values, values);
+      view.get_function_gradients_from_local_dof_values(dof_values,
+                                                        gradients);
+      view.get_function_divergences_from_local_dof_values(dof_values,
+                                                          divergences);
+      double error = 0;
+      for (unsigned int q = 0; q < quadrature.size(); ++q)
+        {
+          Tensor<1, dim> value;
+          Tensor<2, dim> gradient;
+          double         divergence = 0;
+          for (unsigned int i = 0; i < fe.dofs_per_cell; ++i)
+            {
+              value += dof_values(i) * view.value(i, q);
+              gradient += dof_values(i) * view.gradient(i, q);
+              divergence += dof_values(i) * view.divergence(i, q);
+            }
+          error = std::max(error, (value - values[q]).norm());
+          error = std::max(error, (gradient - gradients[q]).norm());
+          error = std::max(error, std::abs(divergence - divergences[q]));
+        }
+      deallog << "Vector function evaluation: "
+              << (error < 1e-12 ? "OK" : "FAILED") << std::endl;
+    }
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test<2>();
+  test<3>();
+}
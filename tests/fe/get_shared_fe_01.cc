@@ -0,0 +1,81 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// Check FETools::get_shared_fe_by_name() and FETools::get_shared_fe(),
+// including concurrent requests for the same element from several threads
+
+#include <deal.II/base/thread_management.h>
+
+#include <deal.II/fe/fe.h>
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_tools.h>
+
+#include "../tests.h"
+
+
+template <int dim>
+std::shared_ptr<const FiniteElement<dim>>
+get_system()
+{
+  return FETools::get_shared_fe_by_name<dim>("FESystem[FE_Q(3)^dim-FE_Q(2)]");
+}
+
+
+
+template <int dim>
+void
+test()
+{
+  const auto fe1 = FETools::get_shared_fe_by_name<dim>("FE_Q(2)");
+  const auto fe2 = FETools::get_shared_fe_by_name<dim>(" FE_Q(2)");
+  const auto fe3 = FETools::get_shared_fe(FE_Q<dim>(2));
+  const auto fe4 = FETools::get_shared_fe_by_name<dim>("FE_DGQ(2)");
+
+  deallog << fe1->get_name() << ": same object for different spellings "
+          << (fe1 == fe2 && fe1 == fe3 ? "yes" : "no") << std::endl;
+  deallog << fe4->get_name() << ": same object as " << fe1->get_name() << " "
+          << (fe1 == fe4 ? "yes" : "no") << std::endl;
+
+  // request a system from several threads at the same time
+  std::vector<Threads::Task<std::shared_ptr<const FiniteElement<dim>>>> tasks;
+  for (unsigned int i = 0; i < 4; ++i)
+    tasks.push_back(Threads::new_task(&get_system<dim>));
+  const auto system = get_system<dim>();
+  bool       same   = true;
+  for (auto &task : tasks)
+    same &= (task.return_value() == system);
+  deallog << system->get_name() << ": same object on all threads "
+          << (same ? "yes" : "no") << std::endl;
+
+  // after clearing the cache, a new object is created while the old one
+  // stays valid
+  FETools::clear_shared_fe_cache<dim>();
+  const auto fe5 = FETools::get_shared_fe_by_name<dim>("FE_Q(2)");
+  deallog << fe1->get_name() << " after clearing the cache: same object "
+          << (fe1 == fe5 ? "yes" : "no") << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test<1>();
+  test<2>();
+  test<3>();
+}
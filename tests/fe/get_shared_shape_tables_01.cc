@@ -0,0 +1,127 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// Check FETools::get_shared_shape_tables(): tables are computed once and
+// shared for equal elements, quadrature formulas, and flags, and released
+// once the last user is gone. Also check that FEValues objects set up with
+// the shared tables see the right shape functions.
+
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/fe/fe_dgq.h>
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_tools.h>
+#include <deal.II/fe/fe_values.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include "../tests.h"
+
+
+template <int dim>
+void
+test()
+{
+  const FE_Q<dim>   fe_q(2);
+  const FE_DGQ<dim> fe_dgq(2);
+  const QGauss<dim> quadrature(3);
+
+  // the tables computed here are dummies, so make sure they are all
+  // released before the FEValues objects below ask for the real ones
+  {
+    unsigned int n_computations  = 0;
+    const auto   compute_tables = [&](FETools::ShapeTables<dim> &tables) {
+      ++n_computations;
+      tables.values.reinit(1, 1);
+    };
+
+    auto tables_1 = FETools::get_shared_shape_tables<dim, dim>(
+      fe_q, quadrature, update_values, compute_tables);
+    auto tables_2 = FETools::get_shared_shape_tables<dim, dim>(
+      FE_Q<dim>(2), QGauss<dim>(3), update_values, compute_tables);
+    deallog << "equal arguments: same tables "
+            << (tables_1 == tables_2 ? "yes" : "no")
+            << ", computations: " << n_computations << std::endl;
+
+    // flags that do not affect the tables are ignored
+    auto tables_3 = FETools::get_shared_shape_tables<dim, dim>(
+      fe_q, quadrature, update_values | update_JxW_values, compute_tables);
+    deallog << "additional mapping flags: same tables "
+            << (tables_1 == tables_3 ? "yes" : "no") << std::endl;
+
+    const auto tables_4 = FETools::get_shared_shape_tables<dim, dim>(
+      fe_q, quadrature, update_values | update_gradients, compute_tables);
+    const auto tables_5 = FETools::get_shared_shape_tables<dim, dim>(
+      fe_q, QGauss<dim>(2), update_values, compute_tables);
+    const auto tables_6 = FETools::get_shared_shape_tables<dim, dim>(
+      fe_dgq, quadrature, update_values, compute_tables);
+    deallog << "different flags, quadrature, element: same tables "
+            << (tables_1 == tables_4 || tables_1 == tables_5 ||
+                    tables_1 == tables_6 ?
+                  "yes" :
+                  "no")
+            << ", computations: " << n_computations << std::endl;
+
+    // once all users are gone, the tables are computed anew
+    std::weak_ptr<const FETools::ShapeTables<dim>> old_tables = tables_1;
+    tables_1.reset();
+    tables_2.reset();
+    tables_3.reset();
+    deallog << "released: " << (old_tables.expired() ? "yes" : "no")
+            << std::endl;
+    FETools::get_shared_shape_tables<dim, dim>(fe_q,
+                                               quadrature,
+                                               update_values,
+                                               compute_tables);
+    deallog << "computations after release: " << n_computations << std::endl;
+  }
+
+  // two FEValues objects for the same element and quadrature use the same
+  // tables and get the values of the element
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube(tria);
+  FEValues<dim> fe_values_1(fe_q, quadrature, update_values | update_gradients);
+  FEValues<dim> fe_values_2(fe_q, quadrature, update_values | update_gradients);
+  fe_values_1.reinit(tria.begin_active());
+  fe_values_2.reinit(tria.begin_active());
+  double error = 0;
+  for (unsigned int i = 0; i < fe_q.dofs_per_cell; ++i)
+    for (unsigned int q = 0; q < quadrature.size(); ++q)
+      {
+        error += std::abs(fe_values_1.shape_value(i, q) -
+                          fe_q.shape_value(i, quadrature.point(q)));
+        error += std::abs(fe_values_2.shape_value(i, q) -
+                          fe_q.shape_value(i, quadrature.point(q)));
+        error += (fe_values_1.shape_grad(i, q) -
+                  fe_q.shape_grad(i, quadrature.point(q)))
+                   .norm();
+      }
+  deallog << "FEValues correct: " << (error < 1e-10 ? "yes" : "no")
+          << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test<1>();
+  test<2>();
+  test<3>();
+}
@@ -0,0 +1,266 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+// Use FEInterfaceValues within MeshWorker::mesh_loop on a mesh with hanging
+// nodes: check the size of the interface dof lists for continuous and
+// discontinuous elements, and check that the jumps and averages of an
+// interpolated linear function are computed correctly on interior and
+// boundary faces.
+
+#include <deal.II/base/function.h>
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_dgq.h>
+#include <deal.II/fe/fe_interface_values.h>
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/mapping_q1.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/vector.h>
+
+#include <deal.II/meshworker/mesh_loop.h>
+
+#include <deal.II/numerics/vector_tools.h>
+
+#include "../tests.h"
+
+
+template <int dim>
+class LinearFunction : public Function<dim>
+{
+public:
+  virtual double
+  value(const Point<dim> &p, const unsigned int = 0) const override
+  {
+    double result = 1.;
+    for (unsigned int d = 0; d < dim; ++d)
+      result += (d + 1.) * p[d];
+    return result;
+  }
+
+  virtual Tensor<1, dim>
+  gradient(const Point<dim> &, const unsigned int = 0) const override
+  {
+    Tensor<1, dim> result;
+    for (unsigned int d = 0; d < dim; ++d)
+      result[d] = d + 1.;
+    return result;
+  }
+};
+
+
+
+template <int dim>
+struct ScratchData
+{
+  ScratchData(const FiniteElement<dim> &fe,
+              const Quadrature<dim - 1> &quadrature,
+              const UpdateFlags          update_flags)
+    : fe_interface_values(fe, quadrature, update_flags)
+  {}
+
+  ScratchData(const ScratchData<dim> &scratch)
+    : fe_interface_values(scratch.fe_interface_values.get_mapping(),
+                          scratch.fe_interface_values.get_fe(),
+                          scratch.fe_interface_values.get_quadrature(),
+                          scratch.fe_interface_values.get_update_flags())
+  {}
+
+  FEInterfaceValues<dim> fe_interface_values;
+};
+
+
+
+struct CopyData
+{
+  double       interior_area    = 0;
+  double       boundary_area    = 0;
+  unsigned int min_n_dofs       = numbers::invalid_unsigned_int;
+  unsigned int max_n_dofs       = 0;
+  unsigned int n_boundary_dofs  = 0;
+  double       max_error        = 0;
+  bool         face_was_visited = false;
+};
+
+
+
+template <int dim>
+double
+check_interface(const FEInterfaceValues<dim> &fe_iv,
+                const Vector<double> &        solution)
+{
+  const LinearFunction<dim> function;
+  const auto &              dof_indices = fe_iv.get_interface_dof_indices();
+
+  double max_error = 0;
+  for (unsigned int q = 0; q < fe_iv.n_quadrature_points; ++q)
+    {
+      const Point<dim> &p = fe_iv.get_quadrature_points()[q];
+
+      double         jump = 0, average = 0;
+      Tensor<1, dim> jump_gradient, average_gradient;
+      for (unsigned int i = 0; i < fe_iv.n_current_interface_dofs(); ++i)
+        {
+          const double u = solution(dof_indices[i]);
+          jump += u * fe_iv.jump(i, q);
+          average += u * fe_iv.average(i, q);
+          jump_gradient += u * fe_iv.jump_gradient(i, q);
+          average_gradient += u * fe_iv.average_gradient(i, q);
+        }
+
+      // on the boundary, the jump is the value on the cell
+      const double expected_jump =
+        fe_iv.at_boundary() ? function.value(p) : 0.;
+      Tensor<1, dim> expected_jump_gradient;
+      if (fe_iv.at_boundary())
+        expected_jump_gradient = function.gradient(p);
+
+      max_error = std::max(max_error, std::abs(jump - expected_jump));
+      max_error = std::max(max_error, std::abs(average - function.value(p)));
+      max_error =
+        std::max(max_error, (jump_gradient - expected_jump_gradient).norm());
+      max_error = std::max(max_error,
+                           (average_gradient - function.gradient(p)).norm());
+    }
+  return max_error;
+}
+
+
+
+template <int dim>
+void
+test(const FiniteElement<dim> &fe)
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(1);
+  tria.begin_active()->set_refine_flag();
+  tria.execute_coarsening_and_refinement();
+
+  DoFHandler<dim> dof_handler(tria);
+  dof_handler.distribute_dofs(fe);
+
+  Vector<double> solution(dof_handler.n_dofs());
+  VectorTools::interpolate(dof_handler, LinearFunction<dim>(), solution);
+
+  using Iterator = typename DoFHandler<dim>::active_cell_iterator;
+
+  // the cell worker only resets the data collected on the faces of a cell
+  const auto cell_worker =
+    [](const Iterator &, ScratchData<dim> &, CopyData &copy) {
+      copy = CopyData();
+    };
+
+  const auto boundary_worker = [&](const Iterator &    cell,
+                                   const unsigned int &f,
+                                   ScratchData<dim> &  scratch,
+                                   CopyData &          copy) {
+    FEInterfaceValues<dim> &fe_iv = scratch.fe_interface_values;
+    fe_iv.reinit(cell, f);
+    AssertThrow(fe_iv.at_boundary(), ExcInternalError());
+
+    for (unsigned int q = 0; q < fe_iv.n_quadrature_points; ++q)
+      copy.boundary_area += fe_iv.JxW(q);
+    copy.n_boundary_dofs = fe_iv.n_current_interface_dofs();
+    copy.max_error = std::max(copy.max_error, check_interface(fe_iv, solution));
+    copy.face_was_visited = true;
+  };
+
+  const auto face_worker = [&](const Iterator &    cell,
+                               const unsigned int &f,
+                               const unsigned int &sf,
+                               const Iterator &    ncell,
+                               const unsigned int &nf,
+                               const unsigned int &nsf,
+                               ScratchData<dim> &  scratch,
+                               CopyData &          copy) {
+    FEInterfaceValues<dim> &fe_iv = scratch.fe_interface_values;
+    fe_iv.reinit(cell, f, sf, ncell, nf, nsf);
+    AssertThrow(!fe_iv.at_boundary(), ExcInternalError());
+
+    for (unsigned int q = 0; q < fe_iv.n_quadrature_points; ++q)
+      copy.interior_area += fe_iv.JxW(q);
+    copy.min_n_dofs =
+      std::min(copy.min_n_dofs, fe_iv.n_current_interface_dofs());
+    copy.max_n_dofs =
+      std::max(copy.max_n_dofs, fe_iv.n_current_interface_dofs());
+    copy.max_error = std::max(copy.max_error, check_interface(fe_iv, solution));
+    copy.face_was_visited = true;
+
+    // the normal vectors point from the first into the second cell
+    for (unsigned int q = 0; q < fe_iv.n_quadrature_points; ++q)
+      AssertThrow(fe_iv.normal(q) * (ncell->center() - cell->center()) > 0,
+                  ExcInternalError());
+  };
+
+  CopyData result;
+  const auto copier = [&](const CopyData &copy) {
+    if (copy.face_was_visited == false)
+      return;
+    result.interior_area += copy.interior_area;
+    result.boundary_area += copy.boundary_area;
+    result.min_n_dofs = std::min(result.min_n_dofs, copy.min_n_dofs);
+    result.max_n_dofs = std::max(result.max_n_dofs, copy.max_n_dofs);
+    if (copy.n_boundary_dofs > 0)
+      result.n_boundary_dofs = copy.n_boundary_dofs;
+    result.max_error = std::max(result.max_error, copy.max_error);
+  };
+
+  const QGauss<dim - 1>  quadrature(2);
+  const ScratchData<dim> scratch(fe,
+                                 quadrature,
+                                 update_values | update_gradients |
+                                   update_quadrature_points |
+                                   update_JxW_values | update_normal_vectors);
+
+  MeshWorker::mesh_loop(dof_handler.begin_active(),
+                        dof_handler.end(),
+                        cell_worker,
+                        copier,
+                        scratch,
+                        CopyData(),
+                        MeshWorker::assemble_own_cells |
+                          MeshWorker::assemble_boundary_faces |
+                          MeshWorker::assemble_own_interior_faces_once,
+                        boundary_worker,
+                        face_worker);
+
+  deallog << fe.get_name() << std::endl;
+  deallog << "Interior surface: " << result.interior_area << std::endl;
+  deallog << "Boundary surface: " << result.boundary_area << std::endl;
+  deallog << "Interface dofs on interior faces: " << result.min_n_dofs
+          << " to " << result.max_n_dofs << std::endl;
+  deallog << "Interface dofs on boundary faces: " << result.n_boundary_dofs
+          << std::endl;
+  deallog << "Error in jumps and averages: "
+          << (result.max_error < 1e-10 ? "OK" : "FAILED") << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test<2>(FE_Q<2>(1));
+  test<2>(FE_DGQ<2>(1));
+  test<3>(FE_Q<3>(1));
+  test<3>(FE_DGQ<3>(1));
+}
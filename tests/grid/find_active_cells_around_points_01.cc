@@ -0,0 +1,114 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+// Test GridTools::find_active_cells_around_points: locate a set of points
+// without hints, move them by a fraction of a cell, and locate them again
+// using the cells found before as hints. Compare with
+// GridTools::find_active_cell_around_point.
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/grid_tools.h>
+#include <deal.II/grid/grid_tools_cache.h>
+#include <deal.II/grid/tria.h>
+
+#include "../tests.h"
+
+
+template <int dim>
+void
+check(const GridTools::Cache<dim> &cache,
+      const std::vector<Point<dim>> &points,
+      const std::vector<
+        std::pair<typename Triangulation<dim>::active_cell_iterator,
+                  Point<dim>>> &cells_and_points)
+{
+  AssertThrow(cells_and_points.size() == points.size(), ExcInternalError());
+  for (unsigned int i = 0; i < points.size(); ++i)
+    {
+      const auto reference =
+        GridTools::find_active_cell_around_point(cache, points[i]);
+      AssertThrow(cells_and_points[i].first == reference.first,
+                  ExcInternalError());
+      AssertThrow(cells_and_points[i].second.distance(reference.second) <
+                    1e-10,
+                  ExcInternalError());
+    }
+}
+
+
+
+template <int dim>
+void
+test()
+{
+  deallog << "dim = " << dim << std::endl;
+
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(3);
+  tria.begin_active()->set_refine_flag();
+  tria.execute_coarsening_and_refinement();
+
+  GridTools::Cache<dim> cache(tria);
+
+  std::vector<Point<dim>> points;
+  for (unsigned int i = 0; i < 100; ++i)
+    {
+      Point<dim> p;
+      for (unsigned int d = 0; d < dim; ++d)
+        p[d] = 0.1 + 0.8 * random_value<double>();
+      points.push_back(p);
+    }
+
+  auto cells_and_points =
+    GridTools::find_active_cells_around_points(cache, points);
+  check(cache, points, cells_and_points);
+  deallog << "Points located without hints" << std::endl;
+
+  // move all points by a fraction of a cell and use the previous cells as
+  // hints
+  std::vector<typename Triangulation<dim>::active_cell_iterator> hints;
+  for (const auto &cell_and_point : cells_and_points)
+    hints.push_back(cell_and_point.first);
+  for (auto &p : points)
+    for (unsigned int d = 0; d < dim; ++d)
+      p[d] += 0.03 * (d + 1);
+
+  cells_and_points =
+    GridTools::find_active_cells_around_points(cache, points, hints);
+  check(cache, points, cells_and_points);
+  deallog << "Points located with hints" << std::endl;
+
+  // a point outside the domain is not found, but does not throw
+  points.assign(1, Point<dim>());
+  points[0][0] = 2.;
+  hints.resize(1);
+  cells_and_points =
+    GridTools::find_active_cells_around_points(cache, points, hints);
+  deallog << "Point outside found: " << std::boolalpha
+          << (cells_and_points[0].first.state() == IteratorState::valid)
+          << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test<2>();
+  test<3>();
+}
@@ -0,0 +1,97 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// check whether we obtain the same results when reading the ASCII and the
+// binary variant of a legacy VTK file. the binary files store the points as
+// double and float numbers, respectively, and the material ids as int and
+// double numbers
+
+#include <deal.II/grid/grid_in.h>
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/tria_accessor.h>
+#include <deal.II/grid/tria_iterator.h>
+
+#include "../tests.h"
+
+
+
+template <int dim>
+void
+vtk_grid(const char *name_ascii, const char *name_binary)
+{
+  Triangulation<dim> tria_ascii;
+  {
+    GridIn<dim> grid_in;
+    grid_in.attach_triangulation(tria_ascii);
+    std::ifstream input_file(name_ascii);
+    grid_in.read_vtk(input_file);
+  }
+
+  Triangulation<dim> tria_binary;
+  {
+    GridIn<dim> grid_in;
+    grid_in.attach_triangulation(tria_binary);
+    std::ifstream input_file(name_binary, std::ios::in | std::ios::binary);
+    grid_in.read_vtk(input_file);
+  }
+
+  // Both files describe the same mesh, so all information should match.
+  AssertThrow(tria_ascii.n_active_cells() == tria_binary.n_active_cells(),
+              ExcInternalError());
+  deallog << "  " << tria_ascii.n_active_cells() << " active cells"
+          << std::endl;
+
+  deallog << "  material ids:";
+  auto       cell_ascii  = tria_ascii.begin_active();
+  auto       cell_binary = tria_binary.begin_active();
+  const auto end_ascii   = tria_ascii.end();
+  for (; cell_ascii != end_ascii; ++cell_ascii, ++cell_binary)
+    {
+      if (cell_ascii->index() < 4)
+        deallog << ' ' << cell_binary->material_id();
+
+      AssertThrow(cell_ascii->material_id() == cell_binary->material_id(),
+                  ExcInternalError());
+      for (unsigned int i = 0; i < GeometryInfo<dim>::vertices_per_cell; ++i)
+        {
+          AssertThrow((cell_ascii->vertex(i) - cell_binary->vertex(i)).norm() <
+                        1.e-10,
+                      ExcInternalError());
+        }
+      for (unsigned int i = 0; i < GeometryInfo<dim>::faces_per_cell; ++i)
+        {
+          AssertThrow(cell_ascii->face(i)->boundary_id() ==
+                        cell_binary->face(i)->boundary_id(),
+                      ExcInternalError());
+        }
+    }
+  deallog << std::endl << "  OK" << std::endl;
+}
+
+
+int
+main()
+{
+  initlog();
+
+  deallog << "grid_in_vtk_3d_03_binary.vtk" << std::endl;
+  vtk_grid<3>(SOURCE_DIR "/grid_in_vtk_3d_03.vtk",
+              SOURCE_DIR "/grid_in_vtk_3d_03_binary.vtk");
+  deallog << "grid_in_vtk_3d_04_binary.vtk" << std::endl;
+  vtk_grid<3>(SOURCE_DIR "/grid_in_vtk_3d_04.vtk",
+              SOURCE_DIR "/grid_in_vtk_3d_04_binary.vtk");
+}
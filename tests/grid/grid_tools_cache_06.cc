@@ -0,0 +1,110 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+// Check that GridTools::Cache updates its vertex to cell map, used vertices
+// and rtrees incrementally after local refinement and coarsening, and that
+// the result agrees with the objects computed from scratch.
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/grid_tools.h>
+#include <deal.II/grid/grid_tools_cache.h>
+#include <deal.II/grid/tria.h>
+
+#include "../tests.h"
+
+
+template <int dim>
+void
+check(const GridTools::Cache<dim> &cache)
+{
+  const Triangulation<dim> &tria = cache.get_triangulation();
+
+  AssertThrow(cache.get_vertex_to_cell_map() ==
+                GridTools::vertex_to_cell_map(tria),
+              ExcInternalError());
+  AssertThrow(cache.get_vertex_to_cell_centers_directions() ==
+                GridTools::vertex_to_cell_centers_directions(
+                  tria, GridTools::vertex_to_cell_map(tria)),
+              ExcInternalError());
+
+  const auto used_vertices = GridTools::extract_used_vertices(tria);
+  AssertThrow(cache.get_used_vertices() == used_vertices, ExcInternalError());
+
+  const auto &vertex_rtree = cache.get_used_vertices_rtree();
+  AssertThrow(vertex_rtree.size() == used_vertices.size(), ExcInternalError());
+  for (const auto &v : used_vertices)
+    AssertThrow(vertex_rtree.count(std::make_pair(v.second, v.first)) == 1,
+                ExcInternalError());
+
+  const auto &box_rtree = cache.get_cell_bounding_boxes_rtree();
+  AssertThrow(box_rtree.size() == tria.n_active_cells(), ExcInternalError());
+  for (const auto &cell : tria.active_cell_iterators())
+    AssertThrow(box_rtree.count(std::make_pair(cell->bounding_box(), cell)) ==
+                  1,
+                ExcInternalError());
+
+  deallog << "full updates: " << cache.n_full_updates()
+          << ", incremental updates: " << cache.n_incremental_updates()
+          << std::endl;
+}
+
+
+
+template <int dim>
+void
+test()
+{
+  deallog << "dim=" << dim << std::endl;
+
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(2);
+
+  GridTools::Cache<dim> cache(tria);
+  check(cache);
+
+  for (unsigned int cycle = 0; cycle < 4; ++cycle)
+    {
+      // refine around a point that moves through the domain and coarsen
+      // away from it
+      Point<dim> center;
+      for (unsigned int d = 0; d < dim; ++d)
+        center[d] = 0.2 + 0.2 * cycle;
+
+      for (const auto &cell : tria.active_cell_iterators())
+        if (cell->center().distance(center) < 0.25 && cell->level() < 4)
+          cell->set_refine_flag();
+        else if (cell->center().distance(center) > 0.4 && cell->level() > 2)
+          cell->set_coarsen_flag();
+      tria.execute_coarsening_and_refinement();
+
+      check(cache);
+    }
+
+  // moving the mesh invalidates everything
+  GridTools::scale(2., tria);
+  check(cache);
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test<2>();
+  test<3>();
+}
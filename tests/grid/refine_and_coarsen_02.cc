@@ -0,0 +1,134 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// check the vertices and the numbering of the cells created by several
+// cycles of refinement and coarsening on curved meshes, with and without
+// mesh smoothing and anisotropic refinement of interior cells. the new
+// vertices are placed on several threads, the mesh smoothing makes its
+// decisions on several threads, and the refined cells are checked for
+// distortion on several threads, but the result has to be the same as if
+// the cells were processed one after the other
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/tria_accessor.h>
+#include <deal.II/grid/tria_iterator.h>
+
+#include "../tests.h"
+
+
+
+template <int dim>
+void
+print_mesh(const Triangulation<dim> &tria)
+{
+  deallog << "n_active_cells: " << tria.n_active_cells()
+          << ", n_used_vertices: " << tria.n_used_vertices() << std::endl;
+  for (const auto &cell : tria.active_cell_iterators())
+    {
+      deallog << cell->level() << '.' << cell->index() << ':';
+      for (unsigned int v = 0; v < GeometryInfo<dim>::vertices_per_cell; ++v)
+        deallog << ' ' << cell->vertex_index(v);
+      deallog << " center " << cell->center() << std::endl;
+    }
+}
+
+
+
+template <int dim>
+void
+refine_and_coarsen(Triangulation<dim> &tria,
+                   const unsigned int  n_cycles,
+                   const bool          anisotropic)
+{
+  std::vector<std::string> refined_cells;
+  tria.signals.post_refinement_on_cell.connect(
+    [&](const typename Triangulation<dim>::cell_iterator &cell) {
+      refined_cells.push_back(cell->id().to_string());
+    });
+
+  for (unsigned int cycle = 0; cycle < n_cycles; ++cycle)
+    {
+      unsigned int i = 0;
+      for (const auto &cell : tria.active_cell_iterators())
+        {
+          if ((7 * i + cycle) % 5 == 0)
+            cell->set_refine_flag(
+              anisotropic && !cell->at_boundary() ?
+                RefinementCase<dim>::cut_axis((i / 5) % dim) :
+                RefinementCase<dim>::isotropic_refinement);
+          else if ((i + cycle) % 3 == 0 && cell->level() > 0)
+            cell->set_coarsen_flag();
+          ++i;
+        }
+
+      refined_cells.clear();
+      try
+        {
+          tria.execute_coarsening_and_refinement();
+        }
+      catch (typename Triangulation<dim>::DistortedCellList &distorted)
+        {
+          deallog << "distorted cells:";
+          for (const auto &cell : distorted.distorted_cells)
+            deallog << ' ' << cell->id();
+          deallog << std::endl;
+        }
+
+      deallog << "cycle " << cycle << ", refined cells:";
+      for (const auto &id : refined_cells)
+        deallog << ' ' << id;
+      deallog << std::endl;
+      print_mesh(tria);
+    }
+}
+
+
+
+template <int dim>
+void
+check()
+{
+  {
+    deallog << "hyper_shell, maximum smoothing" << std::endl;
+    Triangulation<dim> tria(Triangulation<dim>::maximum_smoothing);
+    GridGenerator::hyper_shell(tria, Point<dim>(), 0.5, 1.);
+    refine_and_coarsen(tria, 5 - dim, false);
+  }
+  {
+    deallog << "hyper_shell, anisotropic refinement" << std::endl;
+    Triangulation<dim> tria(Triangulation<dim>::none, true);
+    GridGenerator::hyper_shell(tria, Point<dim>(), 0.5, 1.);
+    refine_and_coarsen(tria, 5 - dim, true);
+  }
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  deallog.push("2d");
+  check<2>();
+  deallog.pop();
+
+  deallog.push("3d");
+  check<3>();
+  deallog.pop();
+}
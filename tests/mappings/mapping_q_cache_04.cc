@@ -0,0 +1,178 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+// Test MappingQCache::initialize() with a displacement vector on the active
+// cells and on the multigrid levels, including an incremental update after
+// changing the displacement on some cells
+
+#include <deal.II/base/function.h>
+
+#include <deal.II/dofs/dof_accessor.h>
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+#include <deal.II/fe/mapping_q_cache.h>
+#include <deal.II/fe/mapping_q_generic.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/vector.h>
+
+#include <deal.II/numerics/vector_tools.h>
+
+#include "../tests.h"
+
+
+template <int dim>
+class Displacement : public Function<dim>
+{
+public:
+  Displacement(const double amplitude)
+    : Function<dim>(dim)
+    , amplitude(amplitude)
+  {}
+
+  virtual double
+  value(const Point<dim> &p, const unsigned int component) const override
+  {
+    return amplitude * std::sin(numbers::PI * p[(component + 1) % dim]) *
+           (1. + p[component]);
+  }
+
+private:
+  const double amplitude;
+};
+
+
+
+// compare the position of some points in the cache against the evaluation
+// of the displacement field on the cell
+template <int dim, typename CellIterator, typename VectorType>
+double
+check_cell(const MappingQCache<dim> &  mapping_cache,
+           const MappingQGeneric<dim> &mapping,
+           const CellIterator &        cell,
+           const VectorType &          local_values)
+{
+  const FiniteElement<dim> &fe    = cell->get_fe();
+  double                    error = 0;
+  for (unsigned int i = 0; i < 5; ++i)
+    {
+      Point<dim> unit_point;
+      for (unsigned int d = 0; d < dim; ++d)
+        unit_point[d] = 0.1 + 0.2 * i + 0.05 * d;
+      Point<dim> reference =
+        mapping.transform_unit_to_real_cell(cell, unit_point);
+      for (unsigned int j = 0; j < fe.dofs_per_cell; ++j)
+        for (unsigned int d = 0; d < dim; ++d)
+          reference[d] +=
+            local_values[j] * fe.shape_value_component(j, unit_point, d);
+      error = std::max(error,
+                       reference.distance(
+                         mapping_cache.transform_unit_to_real_cell(
+                           cell, unit_point)));
+    }
+  return error;
+}
+
+
+
+template <int dim>
+void
+test()
+{
+  Triangulation<dim> tria(
+    Triangulation<dim>::limit_level_difference_at_vertices);
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(1);
+  tria.begin_active()->set_refine_flag();
+  tria.execute_coarsening_and_refinement();
+
+  FESystem<dim>   fe(FE_Q<dim>(2), dim);
+  DoFHandler<dim> dof_handler(tria);
+  dof_handler.distribute_dofs(fe);
+  dof_handler.distribute_mg_dofs();
+
+  const MappingQGeneric<dim> mapping(2);
+  MappingQCache<dim>         mapping_cache(2);
+
+  Vector<double> displacement(dof_handler.n_dofs());
+  VectorTools::interpolate(dof_handler, Displacement<dim>(0.1), displacement);
+
+  Vector<double> local_values(fe.dofs_per_cell);
+  for (unsigned int step = 0; step < 2; ++step)
+    {
+      mapping_cache.initialize(mapping, dof_handler, displacement);
+
+      double error = 0;
+      for (const auto &cell : dof_handler.active_cell_iterators())
+        {
+          cell->get_dof_values(displacement, local_values);
+          error = std::max(
+            error, check_cell(mapping_cache, mapping, cell, local_values));
+        }
+      deallog << "dim=" << dim << ", active cells, step " << step << ": "
+              << (error < 1e-12 ? "OK" : "FAILED") << std::endl;
+
+      // change the displacement of the degrees of freedom on the first cell
+      // only, which touches some of the neighbors as well
+      std::vector<types::global_dof_index> dof_indices(fe.dofs_per_cell);
+      dof_handler.begin_active()->get_dof_indices(dof_indices);
+      for (const auto i : dof_indices)
+        displacement(i) *= 1.5;
+    }
+
+  // multigrid levels: interpolate the displacement on each level cell by
+  // its values in the support points of the finite element
+  MGLevelObject<Vector<double>> level_displacement(0, tria.n_levels() - 1);
+  for (unsigned int l = 0; l < tria.n_levels(); ++l)
+    level_displacement[l].reinit(dof_handler.n_dofs(l));
+  const Displacement<dim>              function(0.05);
+  std::vector<types::global_dof_index> dof_indices(fe.dofs_per_cell);
+  for (const auto &cell : dof_handler.cell_iterators())
+    {
+      cell->get_mg_dof_indices(dof_indices);
+      for (unsigned int i = 0; i < fe.dofs_per_cell; ++i)
+        level_displacement[cell->level()](dof_indices[i]) = function.value(
+          mapping.transform_unit_to_real_cell(cell,
+                                              fe.get_unit_support_points()[i]),
+          fe.system_to_component_index(i).first);
+    }
+
+  mapping_cache.initialize(mapping, dof_handler, level_displacement);
+  double error = 0;
+  for (const auto &cell : dof_handler.cell_iterators())
+    {
+      cell->get_mg_dof_indices(dof_indices);
+      for (unsigned int i = 0; i < fe.dofs_per_cell; ++i)
+        local_values(i) = level_displacement[cell->level()](dof_indices[i]);
+      error =
+        std::max(error, check_cell(mapping_cache, mapping, cell, local_values));
+    }
+  deallog << "dim=" << dim << ", level cells: "
+          << (error < 1e-12 ? "OK" : "FAILED") << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+  test<2>();
+  test<3>();
+}
@@ -0,0 +1,137 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+// Check the path of MappingQGeneric::fill_fe_values() for cells with an
+// affine mapping on a mesh that consists of both affine and bilinearly
+// deformed cells: the results must agree with the ones of an FEValues
+// object that is freshly created on every cell, and the data must be
+// reused on consecutive affine cells with the same Jacobian.
+
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_values.h>
+#include <deal.II/fe/mapping_q_generic.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/grid_tools.h>
+#include <deal.II/grid/tria.h>
+
+#include "../tests.h"
+
+
+template <int dim>
+Point<dim>
+deform(const Point<dim> &p)
+{
+  // shear the mesh and stretch the right half of it in y direction by a
+  // factor that depends on x. the cells in the left half are parallelograms
+  // and the ones in the right half are not
+  Point<dim> q = p;
+  q[0] += 0.25 * p[1];
+  q[1] *= 1. + std::max(0., p[0] - 0.5);
+  return q;
+}
+
+
+
+template <int dim>
+void
+test(const unsigned int mapping_degree)
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(dim == 2 ? 3 : 2);
+  GridTools::transform(&deform<dim>, tria);
+
+  const MappingQGeneric<dim> mapping(mapping_degree);
+  const FE_Q<dim>            fe(2);
+  const QGauss<dim>          quadrature(3);
+  const UpdateFlags          flags = update_values | update_gradients |
+                            update_quadrature_points | update_JxW_values |
+                            update_jacobians | update_inverse_jacobians;
+
+  // the gradient of the linear function sum_d (d+1) x_d
+  Tensor<1, dim> gradient;
+  for (unsigned int d = 0; d < dim; ++d)
+    gradient[d] = d + 1.;
+
+  FEValues<dim> fe_values(mapping, fe, quadrature, flags);
+  unsigned int  n_reused_cells = 0;
+  bool          identical      = true;
+  double        volume = 0, gradient_norm_square = 0;
+  for (const auto &cell : tria.active_cell_iterators())
+    {
+      fe_values.reinit(cell);
+      if (fe_values.get_cell_similarity() == CellSimilarity::translation)
+        ++n_reused_cells;
+
+      FEValues<dim> fresh_fe_values(mapping, fe, quadrature, flags);
+      fresh_fe_values.reinit(cell);
+
+      for (unsigned int q = 0; q < quadrature.size(); ++q)
+        {
+          identical &= (fe_values.JxW(q) == fresh_fe_values.JxW(q));
+          identical &= (fe_values.quadrature_point(q) ==
+                        fresh_fe_values.quadrature_point(q));
+          identical &= (Tensor<2, dim>(fe_values.jacobian(q)) ==
+                        Tensor<2, dim>(fresh_fe_values.jacobian(q)));
+          identical &= (Tensor<2, dim>(fe_values.inverse_jacobian(q)) ==
+                        Tensor<2, dim>(fresh_fe_values.inverse_jacobian(q)));
+          for (unsigned int i = 0; i < fe.dofs_per_cell; ++i)
+            {
+              identical &= (fe_values.shape_value(i, q) ==
+                            fresh_fe_values.shape_value(i, q));
+              identical &= (fe_values.shape_grad(i, q) ==
+                            fresh_fe_values.shape_grad(i, q));
+            }
+
+          // interpolate the linear function with the support points of the
+          // element and compute its gradient
+          Tensor<1, dim> function_gradient;
+          for (unsigned int i = 0; i < fe.dofs_per_cell; ++i)
+            function_gradient +=
+              gradient *
+              mapping.transform_unit_to_real_cell(cell,
+                                                  fe.unit_support_point(i)) *
+              fe_values.shape_grad(i, q);
+
+          volume += fe_values.JxW(q);
+          gradient_norm_square +=
+            function_gradient.norm_square() * fe_values.JxW(q);
+        }
+    }
+
+  deallog << "dim=" << dim << ", mapping degree " << mapping_degree
+          << std::endl;
+  deallog << "Volume: " << volume << std::endl;
+  deallog << "Integral of |grad u|^2: " << gradient_norm_square << std::endl;
+  deallog << "Cells with reused data: " << n_reused_cells << std::endl;
+  deallog << "Identical to fresh FEValues: " << (identical ? "yes" : "no")
+          << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test<2>(1);
+  test<2>(2);
+  test<3>(1);
+  test<3>(2);
+}
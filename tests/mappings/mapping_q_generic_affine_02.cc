@@ -0,0 +1,158 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+// Check the path of MappingQGeneric::fill_fe_face_values() and
+// fill_fe_subface_values() for cells with an affine mapping on a mesh that
+// consists of both affine and bilinearly deformed cells and has hanging
+// nodes. On each cell, the flux of the position vector x through the
+// boundary must equal dim times the volume of the cell, and the flux of
+// the gradient of a linear function must vanish.
+
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_values.h>
+#include <deal.II/fe/mapping_q_generic.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/grid_tools.h>
+#include <deal.II/grid/tria.h>
+
+#include "../tests.h"
+
+
+template <int dim>
+Point<dim>
+deform(const Point<dim> &p)
+{
+  // shear the mesh and stretch the right half of it in y direction by a
+  // factor that depends on x. the cells in the left half are parallelograms
+  // and the ones in the right half are not
+  Point<dim> q = p;
+  q[0] += 0.25 * p[1];
+  q[1] *= 1. + std::max(0., p[0] - 0.5);
+  return q;
+}
+
+
+
+// add the flux of x and of the gradient of the linear function u through
+// the current face to the given numbers
+template <int dim>
+void
+add_fluxes(const FEFaceValuesBase<dim> &  fe_values,
+           const std::vector<Point<dim>> &real_support_points,
+           const Tensor<1, dim> &         gradient,
+           double &                       flux_x,
+           double &                       flux_gradient)
+{
+  for (unsigned int q = 0; q < fe_values.n_quadrature_points; ++q)
+    {
+      Tensor<1, dim> function_gradient;
+      for (unsigned int i = 0; i < fe_values.dofs_per_cell; ++i)
+        function_gradient += (gradient * real_support_points[i]) *
+                             fe_values.shape_grad(i, q);
+
+      flux_x += fe_values.quadrature_point(q) * fe_values.normal_vector(q) *
+                fe_values.JxW(q);
+      flux_gradient +=
+        function_gradient * fe_values.normal_vector(q) * fe_values.JxW(q);
+    }
+}
+
+
+
+template <int dim>
+void
+test(const unsigned int mapping_degree)
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(dim == 2 ? 3 : 2);
+  tria.begin_active()->set_refine_flag();
+  tria.execute_coarsening_and_refinement();
+  GridTools::transform(&deform<dim>, tria);
+
+  const MappingQGeneric<dim> mapping(mapping_degree);
+  const FE_Q<dim>            fe(2);
+  const QGauss<dim - 1>      quadrature(3);
+  const UpdateFlags          flags = update_values | update_gradients |
+                            update_quadrature_points | update_JxW_values |
+                            update_normal_vectors;
+
+  // the gradient of the linear function sum_d (d+1) x_d
+  Tensor<1, dim> gradient;
+  for (unsigned int d = 0; d < dim; ++d)
+    gradient[d] = d + 1.;
+
+  FEFaceValues<dim>       fe_face_values(mapping, fe, quadrature, flags);
+  FESubfaceValues<dim>    fe_subface_values(mapping, fe, quadrature, flags);
+  std::vector<Point<dim>> real_support_points(fe.dofs_per_cell);
+  unsigned int            n_faces = 0, n_subfaces = 0;
+  double                  error_x = 0, error_gradient = 0;
+  for (const auto &cell : tria.active_cell_iterators())
+    {
+      for (unsigned int i = 0; i < fe.dofs_per_cell; ++i)
+        real_support_points[i] =
+          mapping.transform_unit_to_real_cell(cell, fe.unit_support_point(i));
+
+      double flux_x = 0, flux_gradient = 0;
+      for (unsigned int f = 0; f < GeometryInfo<dim>::faces_per_cell; ++f)
+        if (!cell->at_boundary(f) && cell->neighbor(f)->has_children())
+          for (unsigned int sf = 0; sf < cell->face(f)->n_children(); ++sf)
+            {
+              fe_subface_values.reinit(cell, f, sf);
+              add_fluxes(fe_subface_values,
+                         real_support_points,
+                         gradient,
+                         flux_x,
+                         flux_gradient);
+              ++n_subfaces;
+            }
+        else
+          {
+            fe_face_values.reinit(cell, f);
+            add_fluxes(fe_face_values,
+                       real_support_points,
+                       gradient,
+                       flux_x,
+                       flux_gradient);
+            ++n_faces;
+          }
+
+      error_x = std::max(error_x, std::abs(flux_x - dim * cell->measure()));
+      error_gradient = std::max(error_gradient, std::abs(flux_gradient));
+    }
+
+  deallog << "dim=" << dim << ", mapping degree " << mapping_degree << ": "
+          << n_faces << " faces, " << n_subfaces << " subfaces" << std::endl;
+  deallog << "Flux of x: " << (error_x < 1e-12 ? "OK" : "FAILED")
+          << std::endl;
+  deallog << "Flux of grad u: " << (error_gradient < 1e-11 ? "OK" : "FAILED")
+          << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test<2>(1);
+  test<2>(2);
+  test<3>(1);
+  test<3>(2);
+}
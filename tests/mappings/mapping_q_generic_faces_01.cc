@@ -0,0 +1,169 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+// Check the evaluation of a high order MappingQGeneric on faces and
+// subfaces, which is done by sum factorization rather than through tables
+// of the shape functions. The quadrature points, Jacobians, inverse
+// Jacobians, Jacobian gradients (also pushed forward), normal vectors and
+// JxW values computed by FEFaceValues and FESubfaceValues on a curved mesh
+// with hanging nodes are compared to the ones computed by FEValues in the
+// same points of the cell.
+
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_values.h>
+#include <deal.II/fe/mapping_q_generic.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include "../tests.h"
+
+
+template <int dim>
+void
+check(const MappingQGeneric<dim> &                       mapping,
+      const typename Triangulation<dim>::cell_iterator &cell,
+      const unsigned int                                 face_no,
+      const double                                       area_ratio,
+      const FEFaceValuesBase<dim> &                      fe_face_values)
+{
+  const unsigned int n_q_points = fe_face_values.n_quadrature_points;
+
+  std::vector<Point<dim>> unit_points(n_q_points);
+  for (unsigned int q = 0; q < n_q_points; ++q)
+    unit_points[q] = mapping.transform_real_to_unit_cell(
+      cell, fe_face_values.quadrature_point(q));
+
+  FE_Q<dim>     fe(1);
+  FEValues<dim> fe_values(mapping,
+                          fe,
+                          Quadrature<dim>(unit_points),
+                          update_quadrature_points | update_jacobians |
+                            update_inverse_jacobians | update_jacobian_grads |
+                            update_jacobian_pushed_forward_grads);
+  fe_values.reinit(cell);
+
+  const double tolerance = 1e-8;
+  for (unsigned int q = 0; q < n_q_points; ++q)
+    {
+      const Tensor<2, dim> jacobian = fe_values.jacobian(q);
+      const double         scale    = jacobian.norm();
+
+      AssertThrow((fe_values.quadrature_point(q) -
+                   fe_face_values.quadrature_point(q))
+                      .norm() < tolerance,
+                  ExcInternalError());
+      AssertThrow((Tensor<2, dim>(fe_face_values.jacobian(q)) - jacobian)
+                      .norm() < tolerance * scale,
+                  ExcInternalError());
+      AssertThrow((Tensor<2, dim>(fe_face_values.inverse_jacobian(q)) -
+                   Tensor<2, dim>(fe_values.inverse_jacobian(q)))
+                      .norm() < tolerance / scale,
+                  ExcInternalError());
+      AssertThrow((Tensor<3, dim>(fe_face_values.jacobian_grad(q)) -
+                   Tensor<3, dim>(fe_values.jacobian_grad(q)))
+                      .norm() <
+                    tolerance *
+                      (1. + Tensor<3, dim>(fe_values.jacobian_grad(q)).norm()),
+                  ExcInternalError());
+      AssertThrow(
+        (fe_face_values.jacobian_pushed_forward_grad(q) -
+         fe_values.jacobian_pushed_forward_grad(q))
+            .norm() <
+          tolerance * (1. + fe_values.jacobian_pushed_forward_grad(q).norm()),
+        ExcInternalError());
+
+      // the normal vector and the area element follow from the covariant
+      // transformation of the normal vector of the reference face
+      Tensor<1, dim> unit_normal;
+      unit_normal[GeometryInfo<dim>::unit_normal_direction[face_no]] =
+        GeometryInfo<dim>::unit_normal_orientation[face_no];
+      const Tensor<1, dim> boundary_form =
+        determinant(jacobian) * (transpose(invert(jacobian)) * unit_normal);
+      AssertThrow((fe_face_values.normal_vector(q) -
+                   boundary_form / boundary_form.norm())
+                      .norm() < tolerance,
+                  ExcInternalError());
+      AssertThrow(std::abs(fe_face_values.JxW(q) -
+                           boundary_form.norm() *
+                             fe_face_values.get_quadrature().weight(q) *
+                             area_ratio) <
+                    tolerance * fe_face_values.JxW(q),
+                  ExcInternalError());
+    }
+}
+
+
+
+template <int dim>
+void
+test(const unsigned int mapping_degree)
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_shell(tria, Point<dim>(), 0.5, 1., dim == 2 ? 8 : 6);
+  tria.refine_global(1);
+  tria.begin_active()->set_refine_flag();
+  tria.execute_coarsening_and_refinement();
+
+  MappingQGeneric<dim> mapping(mapping_degree);
+  FE_Q<dim>            fe(1);
+  QGauss<dim - 1>      quadrature(3);
+  const UpdateFlags    flags =
+    update_quadrature_points | update_JxW_values | update_normal_vectors |
+    update_jacobians | update_inverse_jacobians | update_jacobian_grads |
+    update_jacobian_pushed_forward_grads;
+  FEFaceValues<dim>    fe_face_values(mapping, fe, quadrature, flags);
+  FESubfaceValues<dim> fe_subface_values(mapping, fe, quadrature, flags);
+
+  unsigned int n_faces = 0, n_subfaces = 0;
+  for (const auto &cell : tria.active_cell_iterators())
+    for (unsigned int f = 0; f < GeometryInfo<dim>::faces_per_cell; ++f)
+      {
+        fe_face_values.reinit(cell, f);
+        check(mapping, cell, f, 1., fe_face_values);
+        ++n_faces;
+
+        if (cell->face(f)->has_children())
+          for (unsigned int sf = 0; sf < cell->face(f)->n_children(); ++sf)
+            {
+              fe_subface_values.reinit(cell, f, sf);
+              check(mapping,
+                    cell,
+                    f,
+                    1. / GeometryInfo<dim>::max_children_per_face,
+                    fe_subface_values);
+              ++n_subfaces;
+            }
+      }
+
+  deallog << "dim=" << dim << ", mapping degree " << mapping_degree
+          << ": checked " << n_faces << " faces and " << n_subfaces
+          << " subfaces" << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test<2>(2);
+  test<2>(6);
+  test<3>(2);
+  test<3>(6);
+}
@@ -0,0 +1,118 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+// Check that Mapping::transform_points_real_to_unit_cell() gives the same
+// result as calling transform_real_to_unit_cell() for each point, for
+// MappingQGeneric of several degrees on a mesh with curved and affine cells
+// and for MappingQ, which uses a Q1 mapping on interior cells.
+
+#include <deal.II/base/array_view.h>
+
+#include <deal.II/fe/mapping_q.h>
+#include <deal.II/fe/mapping_q_generic.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include "../tests.h"
+
+
+template <int dim>
+void
+test(const Mapping<dim> &mapping, const std::string &name)
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_ball(tria);
+  tria.refine_global(1);
+
+  // reference points inside and slightly outside the unit cell
+  std::vector<Point<dim>> reference_points;
+  for (unsigned int i = 0; i < 17; ++i)
+    {
+      Point<dim> p;
+      for (unsigned int d = 0; d < dim; ++d)
+        p[d] = std::fmod(0.137 * (i + 1) * (d + 1.3), 1.2) - 0.1;
+      reference_points.push_back(p);
+    }
+
+  unsigned int n_points = 0, n_inside = 0;
+  double       max_difference = 0;
+  for (const auto &cell : tria.active_cell_iterators())
+    {
+      std::vector<Point<dim>> real_points;
+      for (const auto &p : reference_points)
+        real_points.push_back(mapping.transform_unit_to_real_cell(cell, p));
+
+      std::vector<Point<dim>> unit_points(real_points.size());
+      mapping.transform_points_real_to_unit_cell(cell,
+                                                 make_array_view(real_points),
+                                                 make_array_view(unit_points));
+
+      for (unsigned int i = 0; i < real_points.size(); ++i)
+        {
+          const Point<dim> unit_point =
+            mapping.transform_real_to_unit_cell(cell, real_points[i]);
+          max_difference =
+            std::max(max_difference, unit_point.distance(unit_points[i]));
+          if (GeometryInfo<dim>::is_inside_unit_cell(unit_points[i]))
+            ++n_inside;
+          ++n_points;
+        }
+    }
+
+  deallog << name << ": " << n_points << " points, " << n_inside
+          << " inside, difference to single point version "
+          << (max_difference < 1e-10 ? "OK" : "FAILED") << std::endl;
+
+  // a point far away from the cell must be reported as a failed
+  // transformation or lie outside the unit cell
+  Point<dim> far_away;
+  for (unsigned int d = 0; d < dim; ++d)
+    far_away[d] = 10.;
+  std::vector<Point<dim>> unit_point(1);
+  mapping.transform_points_real_to_unit_cell(
+    tria.begin_active(),
+    ArrayView<const Point<dim>>(&far_away, 1),
+    make_array_view(unit_point));
+  deallog << "Point far away: "
+          << (GeometryInfo<dim>::is_inside_unit_cell(unit_point[0]) ?
+                "inside" :
+                "outside")
+          << std::endl;
+}
+
+
+
+template <int dim>
+void
+test()
+{
+  deallog << "dim=" << dim << std::endl;
+  for (unsigned int degree = 1; degree < 4; ++degree)
+    test(MappingQGeneric<dim>(degree),
+         "MappingQGeneric(" + Utilities::to_string(degree) + ")");
+  test(MappingQ<dim>(2), "MappingQ(2)");
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test<2>();
+  test<3>();
+}
@@ -0,0 +1,123 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// Check that MappingQGeneric::fill_fe_values() does not compute the support
+// points of the mapping, and thus does not query the manifold, if no
+// geometric quantities are requested, e.g., if FEValues only needs the
+// values of the shape functions. The shape values must still be right, also
+// when such cells are interleaved with ones for which the mapping is
+// evaluated.
+
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_values.h>
+#include <deal.II/fe/mapping_q_generic.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/manifold.h>
+#include <deal.II/grid/tria.h>
+
+#include "../tests.h"
+
+
+unsigned int n_queries = 0;
+
+template <int dim>
+class CountingManifold : public FlatManifold<dim>
+{
+public:
+  virtual std::unique_ptr<Manifold<dim>>
+  clone() const override
+  {
+    return std_cxx14::make_unique<CountingManifold<dim>>();
+  }
+
+  virtual void
+  get_new_points(const ArrayView<const Point<dim>> &surrounding_points,
+                 const Table<2, double> &           weights,
+                 ArrayView<Point<dim>>              new_points) const override
+  {
+    ++n_queries;
+    FlatManifold<dim>::get_new_points(surrounding_points, weights, new_points);
+  }
+};
+
+
+
+template <int dim>
+void
+test()
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(2);
+  tria.set_all_manifold_ids(0);
+  tria.set_manifold(0, CountingManifold<dim>());
+
+  const MappingQGeneric<dim> mapping(2);
+  const FE_Q<dim>            fe(2);
+  const QGauss<dim>          quadrature(3);
+
+  FEValues<dim> fe_values(mapping, fe, quadrature, update_values);
+  FEValues<dim> fe_values_jxw(mapping,
+                              fe,
+                              quadrature,
+                              update_values | update_JxW_values);
+
+  double       error       = 0;
+  unsigned int n_cells     = 0;
+  unsigned int jxw_queries = 0;
+  n_queries                = 0;
+  for (const auto &cell : tria.active_cell_iterators())
+    {
+      fe_values.reinit(cell);
+      for (unsigned int i = 0; i < fe.dofs_per_cell; ++i)
+        for (unsigned int q = 0; q < quadrature.size(); ++q)
+          error += std::abs(fe_values.shape_value(i, q) -
+                            fe.shape_value(i, quadrature.point(q)));
+
+      // every other cell, also evaluate the mapping on the same cell
+      if (n_cells % 2 == 0)
+        {
+          const unsigned int old_n_queries = n_queries;
+          fe_values_jxw.reinit(cell);
+          jxw_queries += n_queries - old_n_queries;
+          for (unsigned int i = 0; i < fe.dofs_per_cell; ++i)
+            for (unsigned int q = 0; q < quadrature.size(); ++q)
+              error += std::abs(fe_values_jxw.shape_value(i, q) -
+                                fe.shape_value(i, quadrature.point(q)));
+        }
+      ++n_cells;
+    }
+
+  deallog << "dim=" << dim << ", manifold queried for values only: "
+          << (n_queries > jxw_queries ? "yes" : "no")
+          << ", for JxW values: " << (jxw_queries > 0 ? "yes" : "no")
+          << ", shape values correct: " << (error < 1e-10 ? "yes" : "no")
+          << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test<2>();
+  test<3>();
+}
@@ -0,0 +1,160 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// test parallel::distributed::Triangulation::set_repartitioning_tolerance():
+// the cells of the first processor are made 30% heavier than all others,
+// and repartition() with a tolerance of 10% only shifts the boundaries
+// between the processors along the space-filling curve, so that only cells
+// next to the old boundaries migrate. check that the migrated cells and
+// bytes reported by get_repartitioning_statistics() match the cells that
+// have actually changed their owner, and that a second repartition()
+// leaves the mesh alone since the imbalance is within the tolerance.
+//
+// the coarse mesh consists of 12 cells, so that every processor initially
+// owns the refined children of four complete coarse cells
+
+#include <deal.II/base/utilities.h>
+
+#include <deal.II/distributed/tria.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/tria_accessor.h>
+#include <deal.II/grid/tria_iterator.h>
+
+#include <set>
+
+#include "../tests.h"
+
+
+// the number of bytes attached to every cell, in addition to the
+// CellStatus stored by the triangulation itself
+const unsigned int n_attached_bytes = 8;
+
+
+template <int dim>
+std::set<CellId>
+get_locally_owned_cells(const parallel::distributed::Triangulation<dim> &tr)
+{
+  std::set<CellId> cells;
+  for (const auto &cell : tr.active_cell_iterators())
+    if (cell->is_locally_owned())
+      cells.insert(cell->id());
+  return cells;
+}
+
+
+template <int dim>
+void
+print_statistics(const parallel::distributed::Triangulation<dim> &tr)
+{
+  const auto &statistics = tr.get_repartitioning_statistics();
+  deallog << "imbalance before: " << statistics.imbalance_before
+          << ", imbalance after: " << statistics.imbalance_after << std::endl;
+  deallog << "migrated cells: " << statistics.n_migrated_cells
+          << ", migrated bytes: " << statistics.n_migrated_bytes << std::endl;
+}
+
+
+template <int dim>
+void
+test()
+{
+  parallel::distributed::Triangulation<dim> tr(MPI_COMM_WORLD);
+
+  std::vector<unsigned int> repetitions(dim, 1);
+  repetitions[0] = 12;
+  Point<dim> p2;
+  p2[0] = 12;
+  for (unsigned int d = 1; d < dim; ++d)
+    p2[d] = 1;
+  GridGenerator::subdivided_hyper_rectangle(tr, repetitions, Point<dim>(), p2);
+  tr.refine_global(2);
+
+  // the weights are computed on the owner of each cell before the
+  // repartitioning
+  tr.signals.cell_weight.connect(
+    [](const typename parallel::distributed::Triangulation<dim>::cell_iterator
+         &cell,
+       const typename parallel::distributed::Triangulation<dim>::CellStatus)
+      -> unsigned int { return (cell->subdomain_id() == 0 ? 300 : 0); });
+  tr.set_repartitioning_tolerance(0.1);
+
+  const std::set<CellId> old_cells = get_locally_owned_cells(tr);
+
+  const unsigned int handle = tr.register_data_attach(
+    [](const typename parallel::distributed::Triangulation<dim>::cell_iterator
+         &,
+       const typename parallel::distributed::Triangulation<dim>::CellStatus) {
+      return std::vector<char>(n_attached_bytes, 'a');
+    },
+    /*returns_variable_size_data=*/false);
+
+  tr.repartition();
+
+  tr.notify_ready_to_unpack(
+    handle,
+    [](const typename parallel::distributed::Triangulation<dim>::cell_iterator
+         &,
+       const typename parallel::distributed::Triangulation<dim>::CellStatus,
+       const boost::iterator_range<std::vector<char>::const_iterator>
+         &data_range) {
+      AssertThrow(static_cast<unsigned int>(data_range.end() -
+                                            data_range.begin()) ==
+                    n_attached_bytes,
+                  ExcInternalError());
+    });
+
+  const std::set<CellId> new_cells = get_locally_owned_cells(tr);
+  unsigned int           n_received_cells = 0;
+  for (const auto &id : new_cells)
+    if (old_cells.find(id) == old_cells.end())
+      ++n_received_cells;
+
+  deallog << "locally owned cells: " << old_cells.size() << " -> "
+          << new_cells.size() << ", received cells: " << n_received_cells
+          << std::endl;
+  print_statistics(tr);
+
+  const std::uint64_t n_migrated_cells =
+    Utilities::MPI::sum(n_received_cells, MPI_COMM_WORLD);
+  const auto &statistics = tr.get_repartitioning_statistics();
+  AssertThrow(statistics.n_migrated_cells == n_migrated_cells,
+              ExcInternalError());
+  AssertThrow(statistics.n_migrated_bytes ==
+                n_migrated_cells *
+                  (sizeof(typename parallel::distributed::Triangulation<
+                          dim>::CellStatus) +
+                   n_attached_bytes),
+              ExcInternalError());
+  AssertThrow(statistics.imbalance_after <= 1.1, ExcInternalError());
+
+  // the remaining imbalance is within the tolerance, so nothing moves
+  tr.repartition();
+  AssertThrow(get_locally_owned_cells(tr) == new_cells, ExcInternalError());
+  print_statistics(tr);
+}
+
+
+int
+main(int argc, char *argv[])
+{
+  Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+  MPILogInitAll                    log;
+
+  test<2>();
+}
@@ -0,0 +1,142 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// check DoFHandler::save_flat_binary and load_flat_binary: store a
+// triangulation and a renumbered DoFHandler on it in the flat binary format,
+// load both into new objects, and compare the degrees of freedom on all
+// cells and faces. also check that loading into a DoFHandler with a
+// different finite element fails
+
+#include <deal.II/dofs/dof_accessor.h>
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_renumbering.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/tria_accessor.h>
+#include <deal.II/grid/tria_iterator.h>
+
+#include <vector>
+
+#include "serialization.h"
+
+
+template <int dim, int spacedim>
+void
+compare(const DoFHandler<dim, spacedim> &dof_1,
+        const DoFHandler<dim, spacedim> &dof_2)
+{
+  AssertThrow(dof_1.n_dofs() == dof_2.n_dofs(), ExcInternalError());
+  AssertThrow(dof_1.locally_owned_dofs() == dof_2.locally_owned_dofs(),
+              ExcInternalError());
+
+  const FiniteElement<dim, spacedim> &fe = dof_1.get_fe();
+  std::vector<types::global_dof_index> dofs_1(fe.dofs_per_cell),
+    dofs_2(fe.dofs_per_cell), face_dofs_1(fe.dofs_per_face),
+    face_dofs_2(fe.dofs_per_face);
+
+  typename DoFHandler<dim, spacedim>::active_cell_iterator
+    c1 = dof_1.begin_active(),
+    c2 = dof_2.begin_active();
+  for (; c1 != dof_1.end(); ++c1, ++c2)
+    {
+      AssertThrow(c2 != dof_2.end(), ExcInternalError());
+      AssertThrow(c1->id() == c2->id(), ExcInternalError());
+
+      c1->get_dof_indices(dofs_1);
+      c2->get_dof_indices(dofs_2);
+      AssertThrow(dofs_1 == dofs_2, ExcInternalError());
+
+      for (unsigned int f = 0; f < GeometryInfo<dim>::faces_per_cell; ++f)
+        {
+          c1->face(f)->get_dof_indices(face_dofs_1);
+          c2->face(f)->get_dof_indices(face_dofs_2);
+          AssertThrow(face_dofs_1 == face_dofs_2, ExcInternalError());
+        }
+    }
+  AssertThrow(c2 == dof_2.end(), ExcInternalError());
+}
+
+
+template <int dim, int spacedim>
+void
+test()
+{
+  Triangulation<dim, spacedim> tria_1;
+  GridGenerator::hyper_cube(tria_1);
+  tria_1.refine_global(2);
+  tria_1.begin_active()->set_refine_flag();
+  tria_1.execute_coarsening_and_refinement();
+
+  FESystem<dim, spacedim> fe(FE_Q<dim, spacedim>(2),
+                             dim,
+                             FE_Q<dim, spacedim>(1),
+                             1);
+
+  DoFHandler<dim, spacedim> dof_1(tria_1);
+  dof_1.distribute_dofs(fe);
+  DoFRenumbering::Cuthill_McKee(dof_1);
+
+  tria_1.save_flat_binary("tria");
+  dof_1.save_flat_binary("dof_handler");
+
+  // restart: load the triangulation, set up a DoFHandler with the same
+  // element, and replace its (unrenumbered) degrees of freedom by the
+  // stored ones
+  Triangulation<dim, spacedim> tria_2;
+  tria_2.load_flat_binary("tria");
+  DoFHandler<dim, spacedim> dof_2(tria_2);
+  dof_2.distribute_dofs(fe);
+  dof_2.load_flat_binary("dof_handler");
+
+  compare(dof_1, dof_2);
+
+  DoFHandler<dim, spacedim> dof_3(tria_2);
+  dof_3.distribute_dofs(FE_Q<dim, spacedim>(1));
+  try
+    {
+      dof_3.load_flat_binary("dof_handler");
+      deallog << "No exception" << std::endl;
+    }
+  catch (const ExceptionBase &exc)
+    {
+      deallog << exc.get_exc_name() << std::endl;
+    }
+
+  deallog << "dim=" << dim << ", spacedim=" << spacedim << ": OK"
+          << std::endl;
+}
+
+
+int
+main()
+{
+  deal_II_exceptions::disable_abort_on_exception();
+
+  initlog();
+  deallog << std::setprecision(3);
+
+  test<1, 1>();
+  test<1, 2>();
+  test<2, 2>();
+  test<2, 3>();
+  test<3, 3>();
+
+  deallog << "OK" << std::endl;
+}
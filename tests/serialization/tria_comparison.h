@@ -0,0 +1,137 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2010 - 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// common include file for the serialization tests of Triangulation: a
+// comparison operator for triangulations, and a function that sets boundary
+// indicators on all boundary faces
+
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/tria_accessor.h>
+#include <deal.II/grid/tria_iterator.h>
+
+
+namespace dealii
+{
+  template <int dim, int spacedim>
+  bool
+  operator==(const Triangulation<dim, spacedim> &t1,
+             const Triangulation<dim, spacedim> &t2)
+  {
+    // test a few attributes, though we can't
+    // test everything unfortunately...
+    if (t1.n_active_cells() != t2.n_active_cells())
+      return false;
+
+    if (t1.n_cells() != t2.n_cells())
+      return false;
+
+    if (t1.n_faces() != t2.n_faces())
+      return false;
+
+    typename Triangulation<dim, spacedim>::cell_iterator c1 = t1.begin(),
+                                                         c2 = t2.begin();
+    for (; (c1 != t1.end()) && (c2 != t2.end()); ++c1, ++c2)
+      {
+        for (unsigned int v = 0; v < GeometryInfo<dim>::vertices_per_cell; ++v)
+          {
+            if (c1->vertex(v) != c2->vertex(v))
+              return false;
+            if (c1->vertex_index(v) != c2->vertex_index(v))
+              return false;
+          }
+
+        for (unsigned int f = 0; f < GeometryInfo<dim>::faces_per_cell; ++f)
+          {
+            if (c1->face(f)->at_boundary() != c2->face(f)->at_boundary())
+              return false;
+
+            if (c1->face(f)->manifold_id() != c2->face(f)->manifold_id())
+              return false;
+
+            if (c1->face(f)->at_boundary())
+              {
+                if (c1->face(f)->boundary_id() != c2->face(f)->boundary_id())
+                  return false;
+              }
+            else
+              {
+                if (c1->neighbor(f)->level() != c2->neighbor(f)->level())
+                  return false;
+                if (c1->neighbor(f)->index() != c2->neighbor(f)->index())
+                  return false;
+              }
+          }
+
+        if (c1->active() && c2->active() &&
+            (c1->subdomain_id() != c2->subdomain_id()))
+          return false;
+
+        if (c1->level_subdomain_id() != c2->level_subdomain_id())
+          return false;
+
+        if (c1->material_id() != c2->material_id())
+          return false;
+
+        if (c1->user_index() != c2->user_index())
+          return false;
+
+        if (c1->user_flag_set() != c2->user_flag_set())
+          return false;
+
+        if (c1->manifold_id() != c2->manifold_id())
+          return false;
+
+        if (c1->active() && c2->active())
+          if (c1->active_cell_index() != c2->active_cell_index())
+            return false;
+
+        if (c1->level() > 0)
+          if (c1->parent_index() != c2->parent_index())
+            return false;
+      }
+
+    // also check the order of raw iterators as they contain
+    // something about the history of the triangulation
+    typename Triangulation<dim, spacedim>::cell_iterator r1 = t1.begin(),
+                                                         r2 = t2.begin();
+    for (; (r1 != t1.end()) && (r2 != t2.end()); ++r1, ++r2)
+      {
+        if (r1->level() != r2->level())
+          return false;
+        if (r1->index() != r2->index())
+          return false;
+      }
+
+    return true;
+  }
+} // namespace dealii
+
+
+template <int dim, int spacedim>
+void
+do_boundary(Triangulation<dim, spacedim> &t1)
+{
+  typename Triangulation<dim, spacedim>::cell_iterator c1 = t1.begin();
+  for (; c1 != t1.end(); ++c1)
+    for (unsigned int f = 0; f < GeometryInfo<dim>::faces_per_cell; ++f)
+      if (c1->at_boundary(f))
+        c1->face(f)->set_boundary_id(42);
+}
+
+
+template <int spacedim>
+void do_boundary(Triangulation<1, spacedim> &)
+{}
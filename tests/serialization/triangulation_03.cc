@@ -0,0 +1,150 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// check Triangulation::save_flat_binary and load_flat_binary. do the same as
+// in the _02 test, but write the triangulation to a file in the flat binary
+// format. also check that files for triangulations of other dimensions,
+// files written in other versions of the format, and truncated files are
+// rejected
+
+#include <deal.II/base/flat_binary_archive.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/tria_accessor.h>
+#include <deal.II/grid/tria_iterator.h>
+
+#include <fstream>
+#include <iterator>
+#include <string>
+
+#include "serialization.h"
+#include "tria_comparison.h"
+
+
+std::string
+read_file(const std::string &filename)
+{
+  std::ifstream in(filename, std::ios::in | std::ios::binary);
+  return std::string(std::istreambuf_iterator<char>(in),
+                     std::istreambuf_iterator<char>());
+}
+
+
+void
+write_file(const std::string &filename, const std::string &contents)
+{
+  std::ofstream out(filename, std::ios::out | std::ios::binary);
+  out << contents;
+}
+
+
+template <int dim, int spacedim>
+void
+check_failure(const std::string &filename)
+{
+  Triangulation<dim, spacedim> tria;
+  try
+    {
+      tria.load_flat_binary(filename);
+      deallog << "No exception" << std::endl;
+    }
+  catch (const ExceptionBase &exc)
+    {
+      deallog << exc.get_exc_name() << std::endl;
+    }
+}
+
+
+template <int dim, int spacedim>
+void
+test()
+{
+  Triangulation<dim, spacedim> tria_1, tria_2;
+
+  GridGenerator::hyper_cube(tria_1);
+  tria_1.refine_global(2);
+  // coarsen again as this takes away the finest level but may leave
+  // around some of this level's cells
+  for (typename Triangulation<dim, spacedim>::active_cell_iterator cell =
+         tria_1.begin_active(2);
+       cell != tria_1.end();
+       ++cell)
+    cell->set_coarsen_flag();
+  tria_1.execute_coarsening_and_refinement();
+  // now add one cell again
+  tria_1.begin_active()->set_refine_flag();
+  tria_1.execute_coarsening_and_refinement();
+
+  tria_1.begin_active()->set_subdomain_id(1);
+  tria_1.begin_active()->set_level_subdomain_id(4);
+  tria_1.begin_active()->set_material_id(2);
+  tria_1.begin_active()->set_user_index(3);
+  tria_1.begin_active()->set_user_flag();
+  tria_1.begin_active()->set_refine_flag(RefinementCase<dim>::cut_x);
+
+  do_boundary(tria_1);
+
+  tria_1.save_flat_binary("tria");
+  tria_2.load_flat_binary("tria");
+
+  AssertThrow(tria_1 == tria_2, ExcInternalError());
+
+  // loading the file a second time must replace the previous content, and
+  // the loaded triangulation must be as usable as the original one
+  tria_2.load_flat_binary("tria");
+  AssertThrow(tria_1 == tria_2, ExcInternalError());
+  tria_1.execute_coarsening_and_refinement();
+  tria_2.execute_coarsening_and_refinement();
+  AssertThrow(tria_1 == tria_2, ExcInternalError());
+
+  deallog << "dim=" << dim << ", spacedim=" << spacedim << ": OK"
+          << std::endl;
+}
+
+
+int
+main()
+{
+  deal_II_exceptions::disable_abort_on_exception();
+
+  initlog();
+  deallog << std::setprecision(3);
+
+  test<1, 1>();
+  test<1, 2>();
+  test<2, 2>();
+  test<2, 3>();
+  test<3, 3>();
+
+  // the file now holds a Triangulation<3,3>
+  check_failure<2, 2>("tria");
+
+  // the version of the format follows the eight bytes of the magic number
+  std::string         contents = read_file("tria");
+  const std::uint32_t version  = FlatBinaryArchive::format_version + 1;
+  contents.replace(8, sizeof(version), reinterpret_cast<const char *>(&version),
+                   sizeof(version));
+  write_file("tria_version", contents);
+  check_failure<3, 3>("tria_version");
+
+  write_file("tria_truncated", read_file("tria").substr(0, 1000));
+  check_failure<3, 3>("tria_truncated");
+
+  check_failure<3, 3>("nonexistent_file");
+
+  deallog << "OK" << std::endl;
+}